@@ -59,6 +59,8 @@ else:
     carb.log_info("")
     
     carb.log_info("📊 Profiling is enabled - watch console for FPS reports")
+    carb.log_info("   Per-stage p50/p95/p99 are logged on stop; for a Chrome trace:")
+    carb.log_info("   manager.animation_controller.export_profile_trace('tendroids_trace.json')")
     carb.log_info("")
     carb.log_info("🎮 Test creature movement now - hold W/A/S/D keys")
     carb.log_info("")
@@ -54,6 +54,7 @@ from .environment import (
     EnvironmentConfig,
     EnvironmentSetup,
     get_height_at,
+    get_heights_at,
 )
 
 # Builders (flared geometry, terrain conform)
@@ -121,6 +122,7 @@ __all__ = [
     "EnvironmentConfig",
     "EnvironmentSetup",
     "get_height_at",
+    "get_heights_at",
     # Builders
     "CylinderGenerator",
     "conform_base_to_terrain",
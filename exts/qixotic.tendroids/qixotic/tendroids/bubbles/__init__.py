@@ -18,6 +18,11 @@ from .sphere_geometry_helper import (
 )
 from .pop_particle import PopParticleVisual, PopParticleManager
 from .pop_particle_gpu_manager import PopParticleGPUManager
+from .instanced_visuals import (
+    PointInstancerVisual,
+    BubbleInstancerVisual,
+    ParticleInstancerVisual,
+)
 
 # GPU-accelerated bubble physics
 from .bubble_gpu_manager import BubbleGPUManager
@@ -35,6 +40,9 @@ __all__ = [
     "PopParticleVisual",
     "PopParticleManager",
     "PopParticleGPUManager",
+    "PointInstancerVisual",
+    "BubbleInstancerVisual",
+    "ParticleInstancerVisual",
     # GPU acceleration
     "BubbleGPUManager",
     "BubblePhysicsAdapter",
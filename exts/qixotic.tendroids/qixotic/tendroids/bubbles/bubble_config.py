@@ -44,6 +44,7 @@ class V2BubbleConfig:
     # === Performance ===
     max_bubbles_per_tendroid: int = 1
     max_particles: int = 30              # Reduced from 100
+    use_point_instancer: bool = False    # One PointInstancer for bubbles, one for particles
     
     # === Behavior ===
     hide_until_clear: bool = False      # Show bubble immediately (was True)
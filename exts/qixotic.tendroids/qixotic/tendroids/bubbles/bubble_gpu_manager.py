@@ -3,14 +3,40 @@ GPU-Accelerated Bubble Manager
 
 Manages bubble physics using Warp kernels for parallel processing.
 Complete lifecycle management with CPU ↔ GPU state synchronization.
+Host edits go through batched scatter launches; the concurrent limit
+runs on device, so bubble state is only downloaded for visuals.
 """
 
 import warp as wp
 import numpy as np
-from .bubble_physics import update_bubble_physics_kernel
+from .bubble_physics import (
+    age_sort_keys_kernel,
+    apply_concurrent_limit_kernel,
+    mark_concurrent_limit_kernel,
+    scatter_bubble_params_kernel,
+    scatter_bubble_states_kernel,
+    scatter_register_bubbles_kernel,
+    scatter_spawn_bubbles_kernel,
+    update_bubble_physics_frame_kernel,
+    update_bubble_physics_kernel,
+)
 
 wp.init()
 
+# Per-bubble device arrays (all sized max_bubbles)
+_BUBBLE_ARRAYS = (
+    ('y_positions_gpu', float), ('velocities_x_gpu', float),
+    ('velocities_y_gpu', float), ('velocities_z_gpu', float),
+    ('world_x_gpu', float), ('world_y_gpu', float), ('world_z_gpu', float),
+    ('phases_gpu', int), ('ages_gpu', float), ('release_timers_gpu', float),
+    ('current_radius_gpu', float), ('respawn_timers_gpu', float),
+    ('tendroid_x_gpu', float), ('tendroid_y_gpu', float), ('tendroid_z_gpu', float),
+    ('tendroid_lengths_gpu', float), ('tendroid_radius_gpu', float),
+    ('spawn_heights_gpu', float), ('pop_heights_gpu', float),
+    ('max_diameter_heights_gpu', float), ('max_radii_gpu', float),
+    ('limit_flags_gpu', int),
+)
+
 
 class BubbleGPUManager:
     """
@@ -61,6 +87,15 @@ class BubbleGPUManager:
         self.pop_heights_gpu = wp.zeros(max_bubbles, dtype=float, device=device)
         self.max_diameter_heights_gpu = wp.zeros(max_bubbles, dtype=float, device=device)
         self.max_radii_gpu = wp.zeros(max_bubbles, dtype=float, device=device)
+        
+        # Scratch for the concurrent limiter (1 = over limit this frame)
+        self.limit_flags_gpu = wp.zeros(max_bubbles, dtype=int, device=device)
+        self._allocate_limit_sort()
+    
+    def _allocate_limit_sort(self):
+        """Sort scratch for the limiter (radix_sort_pairs needs 2x length)."""
+        self.limit_keys_gpu = wp.zeros(2 * self.max_bubbles, dtype=float, device=self.device)
+        self.limit_order_gpu = wp.zeros(2 * self.max_bubbles, dtype=int, device=self.device)
     
     def register_bubble(
         self,
@@ -86,43 +121,163 @@ class BubbleGPUManager:
             max_diameter_y: Y position where bubble reaches max size
             max_radius: Maximum bubble radius
         """
-        if bubble_id >= self.max_bubbles:
-            return
+        self.register_bubbles(
+            [bubble_id], [tendroid_position], [tendroid_length], [tendroid_radius],
+            [spawn_y], [pop_height], [max_diameter_y], [max_radius]
+        )
+    
+    def register_bubbles(
+        self,
+        bubble_ids,
+        tendroid_positions,
+        tendroid_lengths,
+        tendroid_radii,
+        spawn_ys,
+        pop_heights,
+        max_diameter_ys,
+        max_radii
+    ) -> int:
+        """
+        Register many bubbles with one upload and one scatter launch.
         
-        # Update CPU arrays then upload
-        phases = self.phases_gpu.numpy()
-        phases[bubble_id] = 1  # rising
-        self.phases_gpu = wp.array(phases, dtype=int, device=self.device)
+        All arguments are parallel sequences (one entry per bubble).
+        Ids outside 0..max_bubbles-1 are dropped.
         
-        y_pos = self.y_positions_gpu.numpy()
-        y_pos[bubble_id] = spawn_y
-        self.y_positions_gpu = wp.array(y_pos, dtype=float, device=self.device)
+        Returns:
+            Number of bubbles registered
+        """
+        ids = np.asarray(bubble_ids, dtype=np.int32).reshape(-1)
+        keep = self._valid_ids(ids)
+        if not keep.any():
+            return 0
         
-        # Set initial radius
-        radii = self.current_radius_gpu.numpy()
-        radii[bubble_id] = tendroid_radius * 0.5
-        self.current_radius_gpu = wp.array(radii, dtype=float, device=self.device)
-        
-        # Set tendroid properties
-        self._update_array(self.tendroid_x_gpu, bubble_id, tendroid_position[0])
-        self._update_array(self.tendroid_y_gpu, bubble_id, tendroid_position[1])
-        self._update_array(self.tendroid_z_gpu, bubble_id, tendroid_position[2])
-        self._update_array(self.tendroid_lengths_gpu, bubble_id, tendroid_length)
-        self._update_array(self.tendroid_radius_gpu, bubble_id, tendroid_radius)
-        
-        # Set bubble config
-        self._update_array(self.spawn_heights_gpu, bubble_id, spawn_y)
-        self._update_array(self.pop_heights_gpu, bubble_id, pop_height)
-        self._update_array(self.max_diameter_heights_gpu, bubble_id, max_diameter_y)
-        self._update_array(self.max_radii_gpu, bubble_id, max_radius)
-        
-        self.active_count += 1
+        count = int(keep.sum())
+        wp.launch(
+            kernel=scatter_register_bubbles_kernel,
+            dim=count,
+            inputs=[
+                self._upload(ids[keep], int),
+                self._upload(np.asarray(tendroid_positions, dtype=np.float32).reshape(-1, 3)[keep], wp.vec3),
+                self._upload(np.asarray(tendroid_lengths, dtype=np.float32)[keep], float),
+                self._upload(np.asarray(tendroid_radii, dtype=np.float32)[keep], float),
+                self._upload(np.asarray(spawn_ys, dtype=np.float32)[keep], float),
+                self._upload(np.asarray(pop_heights, dtype=np.float32)[keep], float),
+                self._upload(np.asarray(max_diameter_ys, dtype=np.float32)[keep], float),
+                self._upload(np.asarray(max_radii, dtype=np.float32)[keep], float),
+                self.y_positions_gpu,
+                self.phases_gpu,
+                self.current_radius_gpu,
+                self.tendroid_x_gpu,
+                self.tendroid_y_gpu,
+                self.tendroid_z_gpu,
+                self.tendroid_lengths_gpu,
+                self.tendroid_radius_gpu,
+                self.spawn_heights_gpu,
+                self.pop_heights_gpu,
+                self.max_diameter_heights_gpu,
+                self.max_radii_gpu,
+            ],
+            device=self.device
+        )
+        
+        self.active_count += count
+        return count
     
-    def _update_array(self, gpu_array, index: int, value: float):
-        """Helper to update single element in GPU array."""
-        arr = gpu_array.numpy()
-        arr[index] = value
-        gpu_array.assign(wp.array(arr, dtype=gpu_array.dtype, device=self.device))
+    def update_bubble_params(
+        self,
+        bubble_ids,
+        spawn_ys,
+        pop_heights,
+        max_diameter_ys,
+        max_radii
+    ) -> int:
+        """
+        Patch per-bubble lifecycle config in one launch (live tuning).
+        
+        Positions, phases and timers are left alone, so bubbles in
+        flight pick the new values up where they are.
+        
+        Returns:
+            Number of bubbles updated
+        """
+        ids = np.asarray(bubble_ids, dtype=np.int32).reshape(-1)
+        keep = self._valid_ids(ids)
+        if not keep.any():
+            return 0
+        
+        count = int(keep.sum())
+        wp.launch(
+            kernel=scatter_bubble_params_kernel,
+            dim=count,
+            inputs=[
+                self._upload(ids[keep], int),
+                self._upload(np.asarray(spawn_ys, dtype=np.float32)[keep], float),
+                self._upload(np.asarray(pop_heights, dtype=np.float32)[keep], float),
+                self._upload(np.asarray(max_diameter_ys, dtype=np.float32)[keep], float),
+                self._upload(np.asarray(max_radii, dtype=np.float32)[keep], float),
+                self.spawn_heights_gpu,
+                self.pop_heights_gpu,
+                self.max_diameter_heights_gpu,
+                self.max_radii_gpu,
+            ],
+            device=self.device
+        )
+        return count
+    
+    def ensure_capacity(self, count: int) -> bool:
+        """
+        Grow every bubble array to hold at least count slots.
+        
+        Capacity doubles and existing slots are copied on device, so
+        live bubbles keep their state. New slots start idle (phase 0).
+        Growing replaces the arrays, so captured launches must be
+        re-recorded (GPUFramePipeline keys on max_bubbles).
+        
+        Returns:
+            True if the arrays were reallocated
+        """
+        if count <= self.max_bubbles:
+            return False
+        
+        capacity = max(self.max_bubbles, 1)
+        while capacity < count:
+            capacity *= 2
+        
+        for attr, dtype in _BUBBLE_ARRAYS:
+            old = getattr(self, attr)
+            new = wp.zeros(capacity, dtype=dtype, device=self.device)
+            if old is not None and self.max_bubbles > 0:
+                wp.copy(new, old, count=self.max_bubbles)
+            setattr(self, attr, new)
+        
+        self.max_bubbles = capacity
+        self._allocate_limit_sort()
+        return True
+    
+    def release_bubbles(self, bubble_ids) -> int:
+        """
+        Return bubbles to idle (phase 0) when their tendroid is removed.
+        
+        Idle slots are skipped by the physics kernel and never respawn,
+        so a released id can be re-registered for a new tendroid.
+        
+        Returns:
+            Number of bubbles released
+        """
+        ids = np.asarray(bubble_ids, dtype=np.int32).reshape(-1)
+        count = self.update_bubble_states(
+            ids, np.zeros(ids.size, dtype=np.float32), np.zeros(ids.size, dtype=np.int32)
+        )
+        self.active_count = max(0, self.active_count - count)
+        return count
+    
+    def _valid_ids(self, ids: np.ndarray) -> np.ndarray:
+        """Mask of bubble ids that address a real slot."""
+        return (ids >= 0) & (ids < self.max_bubbles)
+    
+    def _upload(self, values: np.ndarray, dtype):
+        """Copy a small host batch to the device for a scatter launch."""
+        return wp.array(values, dtype=dtype, device=self.device)
     
     def update_bubble_state(self, bubble_id: int, y_pos: float, phase: int):
         """
@@ -135,14 +290,39 @@ class BubbleGPUManager:
             y_pos: New Y position
             phase: New phase (0-4)
         """
-        if bubble_id >= self.max_bubbles:
-            return
+        self.update_bubble_states([bubble_id], [y_pos], [phase])
+    
+    def update_bubble_states(self, bubble_ids, y_positions, phases) -> int:
+        """
+        Overwrite Y position and phase for many bubbles in one launch.
         
-        self._update_array(self.y_positions_gpu, bubble_id, y_pos)
+        Args:
+            bubble_ids: Bubble indices
+            y_positions: New Y position per bubble
+            phases: New phase (0-4) per bubble
+            
+        Returns:
+            Number of bubbles updated
+        """
+        ids = np.asarray(bubble_ids, dtype=np.int32).reshape(-1)
+        keep = self._valid_ids(ids)
+        if not keep.any():
+            return 0
         
-        phases = self.phases_gpu.numpy()
-        phases[bubble_id] = phase
-        self.phases_gpu = wp.array(phases, dtype=int, device=self.device)
+        count = int(keep.sum())
+        wp.launch(
+            kernel=scatter_bubble_states_kernel,
+            dim=count,
+            inputs=[
+                self._upload(ids[keep], int),
+                self._upload(np.asarray(y_positions, dtype=np.float32)[keep], float),
+                self._upload(np.asarray(phases, dtype=np.int32)[keep], int),
+                self.y_positions_gpu,
+                self.phases_gpu,
+            ],
+            device=self.device
+        )
+        return count
     
     def spawn_bubble(self, bubble_id: int, spawn_y: float, tendroid_radius: float):
         """
@@ -153,20 +333,44 @@ class BubbleGPUManager:
             spawn_y: Starting Y position
             tendroid_radius: Base radius for initial size
         """
-        if bubble_id >= self.max_bubbles:
-            return
+        self.spawn_bubbles([bubble_id], [spawn_y], [tendroid_radius])
+    
+    def spawn_bubbles(self, bubble_ids, spawn_ys, tendroid_radii) -> int:
+        """
+        Reset many bubbles to the rising phase in one launch.
         
-        # Reset to rising phase at spawn position
-        self._update_array(self.y_positions_gpu, bubble_id, spawn_y)
-        self._update_array(self.ages_gpu, bubble_id, 0.0)
-        self._update_array(self.velocities_x_gpu, bubble_id, 0.0)
-        self._update_array(self.velocities_y_gpu, bubble_id, 0.0)
-        self._update_array(self.velocities_z_gpu, bubble_id, 0.0)
-        self._update_array(self.current_radius_gpu, bubble_id, tendroid_radius * 0.5)
+        Args:
+            bubble_ids: Bubble indices
+            spawn_ys: Starting Y position per bubble
+            tendroid_radii: Base radius per bubble (initial size is half)
+            
+        Returns:
+            Number of bubbles spawned
+        """
+        ids = np.asarray(bubble_ids, dtype=np.int32).reshape(-1)
+        keep = self._valid_ids(ids)
+        if not keep.any():
+            return 0
         
-        phases = self.phases_gpu.numpy()
-        phases[bubble_id] = 1  # rising
-        self.phases_gpu = wp.array(phases, dtype=int, device=self.device)
+        count = int(keep.sum())
+        wp.launch(
+            kernel=scatter_spawn_bubbles_kernel,
+            dim=count,
+            inputs=[
+                self._upload(ids[keep], int),
+                self._upload(np.asarray(spawn_ys, dtype=np.float32)[keep], float),
+                self._upload(np.asarray(tendroid_radii, dtype=np.float32)[keep], float),
+                self.y_positions_gpu,
+                self.ages_gpu,
+                self.velocities_x_gpu,
+                self.velocities_y_gpu,
+                self.velocities_z_gpu,
+                self.current_radius_gpu,
+                self.phases_gpu,
+            ],
+            device=self.device
+        )
+        return count
     
     def update_all(
         self,
@@ -246,47 +450,100 @@ class BubbleGPUManager:
         
         # Enforce concurrent bubble limit if specified
         if max_concurrent_active is not None and max_concurrent_active > 0:
-            self._enforce_concurrent_limit(max_concurrent_active, respawn_delay)
+            self.launch_concurrent_limit(max_concurrent_active, respawn_delay)
     
-    def _enforce_concurrent_limit(self, max_concurrent: int, respawn_delay: float):
+    def launch_update_frame(
+        self,
+        frame_params,
+        wave_params,
+        rise_speed: float,
+        released_rise_speed: float,
+        respawn_delay: float
+    ):
         """
-        Limit number of concurrent active bubbles (phases 1, 2, 3).
+        Enqueue bubble physics with dt and wave read from device buffers.
         
-        If more than max_concurrent bubbles are active, delay the youngest
-        bubbles by resetting their respawn timers.
+        Used by the GPU frame pipeline (graph capture). Arrays are
+        updated in place, so a captured launch stays valid.
         
         Args:
-            max_concurrent: Maximum number of active bubbles allowed
-            respawn_delay: Delay value to set for bubbles over limit
+            frame_params: Device float array, [0] = dt
+            wave_params: DeviceWaveState.params_gpu
+            rise_speed: Rising speed inside cylinder
+            released_rise_speed: Free-float speed
+            respawn_delay: Seconds until respawn after pop
         """
-        phases = self.phases_gpu.numpy()
-        ages = self.ages_gpu.numpy()
-        
-        # Find all active bubbles (rising=1, exiting=2, released=3)
-        active_mask = (phases == 1) | (phases == 2) | (phases == 3)
-        active_indices = np.where(active_mask)[0]
-        
-        # If under limit, nothing to do
-        if len(active_indices) <= max_concurrent:
-            return
-        
-        # Sort by age (youngest first) - we want to keep oldest bubbles active
-        sorted_indices = active_indices[np.argsort(ages[active_indices])]
+        wp.launch(
+            kernel=update_bubble_physics_frame_kernel,
+            dim=self.max_bubbles,
+            inputs=[
+                self.y_positions_gpu,
+                self.velocities_x_gpu,
+                self.velocities_y_gpu,
+                self.velocities_z_gpu,
+                self.world_x_gpu,
+                self.world_y_gpu,
+                self.world_z_gpu,
+                self.phases_gpu,
+                self.ages_gpu,
+                self.release_timers_gpu,
+                self.current_radius_gpu,
+                self.respawn_timers_gpu,
+                self.tendroid_x_gpu,
+                self.tendroid_y_gpu,
+                self.tendroid_z_gpu,
+                self.tendroid_lengths_gpu,
+                self.tendroid_radius_gpu,
+                self.spawn_heights_gpu,
+                self.pop_heights_gpu,
+                self.max_diameter_heights_gpu,
+                self.max_radii_gpu,
+                rise_speed,
+                released_rise_speed,
+                respawn_delay,
+                frame_params,
+                wave_params,
+            ],
+            device=self.device
+        )
+    
+    def launch_concurrent_limit(self, max_concurrent: int, respawn_delay: float):
+        """
+        Enqueue the concurrent-bubble limiter (phases 1, 2, 3).
         
-        # Keep the oldest max_concurrent bubbles, force rest back to popped state
-        bubbles_to_delay = sorted_indices[:len(sorted_indices) - max_concurrent]
+        If more than max_concurrent bubbles are active, the youngest are
+        sent back to popped with a fresh respawn timer. Bubbles are
+        ranked by a device radix sort on age (O(N), no host sync), so it
+        can be captured in a CUDA graph.
         
-        if len(bubbles_to_delay) > 0:
-            # Update phases and respawn timers
-            respawn_timers = self.respawn_timers_gpu.numpy()
-            
-            for idx in bubbles_to_delay:
-                phases[idx] = 4  # Set to popped
-                respawn_timers[idx] = respawn_delay  # Reset respawn timer
-            
-            # Upload changes back to GPU
-            self.phases_gpu = wp.array(phases, dtype=int, device=self.device)
-            self.respawn_timers_gpu = wp.array(respawn_timers, dtype=float, device=self.device)
+        Args:
+            max_concurrent: Maximum number of active bubbles allowed
+            respawn_delay: Delay value to set for bubbles over limit
+        """
+        n = self.max_bubbles
+        wp.launch(
+            kernel=age_sort_keys_kernel,
+            dim=n,
+            inputs=[self.phases_gpu, self.ages_gpu, self.limit_keys_gpu, self.limit_order_gpu],
+            device=self.device
+        )
+        wp.utils.radix_sort_pairs(self.limit_keys_gpu, self.limit_order_gpu, n)
+        wp.launch(
+            kernel=mark_concurrent_limit_kernel,
+            dim=n,
+            inputs=[self.limit_order_gpu, self.phases_gpu, n - max_concurrent, self.limit_flags_gpu],
+            device=self.device
+        )
+        wp.launch(
+            kernel=apply_concurrent_limit_kernel,
+            dim=self.max_bubbles,
+            inputs=[self.limit_flags_gpu, self.phases_gpu, self.respawn_timers_gpu, respawn_delay],
+            device=self.device
+        )
+    
+    def _enforce_concurrent_limit(self, max_concurrent: int, respawn_delay: float):
+        """Apply the concurrent limit now (see launch_concurrent_limit)."""
+        self.launch_concurrent_limit(max_concurrent, respawn_delay)
     
     def get_bubble_states(self) -> tuple:
         """
@@ -321,13 +578,5 @@ class BubbleGPUManager:
     def destroy(self):
         """Free GPU resources."""
         # Clear all references to allow GPU memory cleanup
-        arrays = [
-            'y_positions_gpu', 'velocities_x_gpu', 'velocities_y_gpu', 'velocities_z_gpu',
-            'world_x_gpu', 'world_y_gpu', 'world_z_gpu', 'phases_gpu', 'ages_gpu',
-            'release_timers_gpu', 'current_radius_gpu', 'respawn_timers_gpu',
-            'tendroid_x_gpu', 'tendroid_y_gpu', 'tendroid_z_gpu', 
-            'tendroid_lengths_gpu', 'tendroid_radius_gpu',
-            'spawn_heights_gpu', 'pop_heights_gpu', 'max_diameter_heights_gpu', 'max_radii_gpu'
-        ]
-        for attr in arrays:
+        for attr, _ in _BUBBLE_ARRAYS:
             setattr(self, attr, None)
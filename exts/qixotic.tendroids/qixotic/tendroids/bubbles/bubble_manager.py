@@ -30,16 +30,20 @@ class V2BubbleManager:
     Bubbles rise, exit, pop, and respawn automatically.
     """
     
-    def __init__(self, stage, config: V2BubbleConfig = None):
+    def __init__(self, stage, config: V2BubbleConfig = None, device: str = "cuda:0"):
         self.stage = stage
         self.config = config or DEFAULT_V2_BUBBLE_CONFIG
+        self.device = device
         self._bubbles = {}
         self._bubble_counter = 0
         self._bubble_parent = "/World/Bubbles"
         self._ensure_parent()
         
         # Particle system for pop effects (use resolved config)
-        self.particle_manager = PopParticleManager(stage, self.config)
+        self.particle_manager = PopParticleManager(stage, self.config, device=device)
+        
+        # One PointInstancer for all bubbles (replaces per-bubble prims)
+        self.instancer = None
     
     def _ensure_parent(self):
         if self.stage and not self.stage.GetPrimAtPath(self._bubble_parent):
@@ -54,10 +58,30 @@ class V2BubbleManager:
                 stage=self.stage,
                 parent_path=self._bubble_parent,
                 bubble_id=self._bubble_counter,
-                particle_manager=self.particle_manager
+                particle_manager=self.particle_manager,
+                create_visual=not self.config.use_point_instancer
             )
             self._bubble_counter += 1
     
+    def unregister_tendroid(self, name: str) -> bool:
+        """Destroy a tendroid's bubble state (live removal)."""
+        state = self._bubbles.pop(name, None)
+        if state is None:
+            return False
+        state.destroy()
+        return True
+    
+    def refresh_config(self) -> int:
+        """
+        Re-derive every bubble's lifecycle parameters after a config change.
+        
+        Returns:
+            Number of bubbles updated
+        """
+        for state in self._bubbles.values():
+            state.refresh_config()
+        return len(self._bubbles)
+    
     def update(self, dt: float, tendroids: list, wave_controller=None):
         for t in tendroids:
             if t.name not in self._bubbles:
@@ -65,10 +89,48 @@ class V2BubbleManager:
         for name, state in self._bubbles.items():
             state.update(dt, wave_controller)
         
+        if self.config.use_point_instancer:
+            self._ensure_instancer(len(self._bubbles), self.device)
+            self.instancer.update_from_states(list(self._bubbles.values()))
+        
         # Update particle system
         if self.particle_manager:
             self.particle_manager.update(dt)
     
+    @property
+    def uses_instancer(self) -> bool:
+        """True when bubbles render through one PointInstancer."""
+        return self.config.use_point_instancer
+    
+    def _ensure_instancer(self, count: int, device: str):
+        """Create (or resize) the bubble PointInstancer."""
+        if self.instancer and self.instancer.count == count:
+            return
+        if self.instancer:
+            self.instancer.destroy()
+        
+        from .instanced_visuals import BubbleInstancerVisual
+        
+        self.instancer = BubbleInstancerVisual(
+            stage=self.stage,
+            path=f"{self._bubble_parent}/BubbleInstancer",
+            count=count,
+            config=self.config,
+            device=device
+        )
+        self.instancer.create()
+    
+    def render_instances_gpu(self, bubble_gpu_manager, stage_id=None):
+        """
+        Draw all bubbles from GPU physics state through the instancer.
+        
+        Args:
+            bubble_gpu_manager: BubbleGPUManager (instance i = bubble slot i)
+            stage_id: USD stage ID for the Fabric path, or None for USD writes
+        """
+        self._ensure_instancer(bubble_gpu_manager.max_bubbles, bubble_gpu_manager.device)
+        self.instancer.update_from_gpu(bubble_gpu_manager, stage_id)
+    
     def get_bubble_count(self) -> int:
         return sum(1 for s in self._bubbles.values() if s.phase != "idle")
     
@@ -77,6 +139,10 @@ class V2BubbleManager:
             state.destroy()
         self._bubbles.clear()
         
+        if self.instancer:
+            self.instancer.destroy()
+            self.instancer = None
+        
         # Clear particles
         if self.particle_manager:
             self.particle_manager.clear_all()
@@ -91,13 +157,23 @@ class _BubbleState:
     Key: Wave displacement is now passed to deformation for composition.
     """
     
-    def __init__(self, tendroid, config: V2BubbleConfig, stage, parent_path: str, bubble_id: int, particle_manager):
+    def __init__(
+        self,
+        tendroid,
+        config: V2BubbleConfig,
+        stage,
+        parent_path: str,
+        bubble_id: int,
+        particle_manager,
+        create_visual: bool = True
+    ):
         self.tendroid = tendroid
         self.config = config
         self.stage = stage
         self.parent_path = parent_path
         self.bubble_id = bubble_id
         self.particle_manager = particle_manager
+        self.create_visual = create_visual  # False when drawn by the instancer
         
         self.prim_path = f"{parent_path}/bubble_{tendroid.name}_{bubble_id}"
         self.sphere_prim = None
@@ -122,11 +198,13 @@ class _BubbleState:
         self.release_timer = 0.0
         self.respawn_timer = 0.0
         self.pop_height = 0.0
+        self._pop_fraction = 0.0  # Draw within the pop height range
         
         # Growth zone - use tendroid's spawn height calculation
-        self.spawn_y = tendroid.get_spawn_height(config.spawn_height_pct)
-        self.max_diameter_y = tendroid.length * config.max_diameter_pct
-        self.max_radius = tendroid.radius * (1.0 + tendroid.deformer.max_amplitude)
+        self.spawn_y = 0.0
+        self.max_diameter_y = 0.0
+        self.max_radius = 0.0
+        self._update_growth_zone()
         
         # Physics tuning
         self.shape_transition_time = 0.3
@@ -139,6 +217,22 @@ class _BubbleState:
         
         self._spawn()
     
+    def _update_growth_zone(self):
+        """Spawn / max-size heights and max radius from config and deformer."""
+        self.spawn_y = self.tendroid.get_spawn_height(self.config.spawn_height_pct)
+        self.max_diameter_y = self.tendroid.length * self.config.max_diameter_pct
+        self.max_radius = self.tendroid.radius * (1.0 + self.tendroid.deformer.max_amplitude)
+    
+    def _pop_height(self) -> float:
+        """Pop height for the current draw within the configured range."""
+        low, high = self.config.min_pop_height, self.config.max_pop_height
+        return self.tendroid.length + low + (high - low) * self._pop_fraction
+    
+    def refresh_config(self):
+        """Apply config / deformer changes to this bubble without respawning."""
+        self._update_growth_zone()
+        self.pop_height = self._pop_height()
+    
     def _get_wave_displacement(self, wave_controller) -> tuple:
         """Get wave displacement at tendroid position."""
         if wave_controller and wave_controller.enabled:
@@ -164,11 +258,11 @@ class _BubbleState:
         tx, ty, tz = self.tendroid.position
         self.world_pos = [tx, ty + self.y, tz]
         
-        self.pop_height = self.tendroid.length + random.uniform(
-            self.config.min_pop_height, self.config.max_pop_height
-        )
+        self._pop_fraction = random.random()
+        self.pop_height = self._pop_height()
         
-        self._create_visual()
+        if self.create_visual:
+            self._create_visual()
         
         if self.config.debug_logging:
             carb.log_info(
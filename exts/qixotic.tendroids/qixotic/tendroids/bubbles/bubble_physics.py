@@ -5,15 +5,32 @@ Batch-processes bubble physics for all tendroids in parallel on GPU.
 Eliminates CPU-bound Python loops.
 
 Complete lifecycle: spawn → rise → exit → release → pop → respawn
+
+The per-bubble step lives in step_bubble() so the frame-pipeline
+kernel (dt and wave read from device buffers, CUDA-graph friendly)
+shares identical physics with the scalar-parameter kernel.
+
+The concurrent-bubble limiter and the batched register/spawn/state
+scatters also run here, so host code never round-trips bubble arrays.
 """
 
 import warp as wp
 
+from ..core.device_wave_state import (
+  WAVE_AMPLITUDE,
+  WAVE_DIR_X,
+  WAVE_DIR_Z,
+  WAVE_DISPLACEMENT,
+  WAVE_ENABLED,
+)
+
 wp.init()
 
 
-@wp.kernel
-def update_bubble_physics_kernel(
+@wp.func
+def step_bubble(
+  tid: int,
+  
   # Input state
   y_positions: wp.array(dtype=float),
   velocities_x: wp.array(dtype=float),
@@ -55,13 +72,10 @@ def update_bubble_physics_kernel(
   wave_dir_z: float,
 ):
   """
-  Update bubble physics for one bubble - COMPLETE LIFECYCLE.
+  Advance one bubble by dt - COMPLETE LIFECYCLE.
   
-  Each thread handles one tendroid's bubble.
   Phases: 0=idle, 1=rising, 2=exiting, 3=released, 4=popped
   """
-  tid = wp.tid()
-  
   phase = phases[tid]
   
   # Idle phase - waiting to spawn
@@ -209,3 +223,313 @@ def update_bubble_physics_kernel(
       velocities_y[tid] = 0.0
       velocities_z[tid] = 0.0
       current_radius[tid] = t_radius * 0.5
+
+
+@wp.kernel
+def update_bubble_physics_kernel(
+  # Input state
+  y_positions: wp.array(dtype=float),
+  velocities_x: wp.array(dtype=float),
+  velocities_y: wp.array(dtype=float),
+  velocities_z: wp.array(dtype=float),
+  world_x: wp.array(dtype=float),
+  world_y: wp.array(dtype=float),
+  world_z: wp.array(dtype=float),
+  phases: wp.array(dtype=int),  # 0=idle, 1=rising, 2=exiting, 3=released, 4=popped
+  ages: wp.array(dtype=float),
+  release_timers: wp.array(dtype=float),
+  current_radius: wp.array(dtype=float),  # Current bubble radius
+  respawn_timers: wp.array(dtype=float),  # Countdown to respawn
+  
+  # Tendroid properties
+  tendroid_x: wp.array(dtype=float),
+  tendroid_y: wp.array(dtype=float),
+  tendroid_z: wp.array(dtype=float),
+  tendroid_lengths: wp.array(dtype=float),
+  tendroid_radius: wp.array(dtype=float),
+  
+  # Bubble config (per-bubble)
+  spawn_heights: wp.array(dtype=float),
+  pop_heights: wp.array(dtype=float),
+  max_diameter_heights: wp.array(dtype=float),
+  max_radii: wp.array(dtype=float),
+  
+  # Config
+  dt: float,
+  rise_speed: float,
+  released_rise_speed: float,
+  respawn_delay: float,
+  
+  # Wave state (if enabled)
+  wave_enabled: int,
+  wave_displacement: float,
+  wave_amplitude: float,
+  wave_dir_x: float,
+  wave_dir_z: float,
+):
+  """
+  Update bubble physics for one bubble - COMPLETE LIFECYCLE.
+  
+  Each thread handles one tendroid's bubble.
+  Phases: 0=idle, 1=rising, 2=exiting, 3=released, 4=popped
+  """
+  tid = wp.tid()
+  step_bubble(
+    tid,
+    y_positions, velocities_x, velocities_y, velocities_z,
+    world_x, world_y, world_z, phases,
+    ages, release_timers, current_radius, respawn_timers,
+    tendroid_x, tendroid_y, tendroid_z, tendroid_lengths,
+    tendroid_radius, spawn_heights, pop_heights, max_diameter_heights,
+    max_radii, dt, rise_speed, released_rise_speed,
+    respawn_delay, wave_enabled, wave_displacement, wave_amplitude,
+    wave_dir_x, wave_dir_z,
+  )
+
+
+@wp.kernel
+def update_bubble_physics_frame_kernel(
+  # Input state
+  y_positions: wp.array(dtype=float),
+  velocities_x: wp.array(dtype=float),
+  velocities_y: wp.array(dtype=float),
+  velocities_z: wp.array(dtype=float),
+  world_x: wp.array(dtype=float),
+  world_y: wp.array(dtype=float),
+  world_z: wp.array(dtype=float),
+  phases: wp.array(dtype=int),  # 0=idle, 1=rising, 2=exiting, 3=released, 4=popped
+  ages: wp.array(dtype=float),
+  release_timers: wp.array(dtype=float),
+  current_radius: wp.array(dtype=float),  # Current bubble radius
+  respawn_timers: wp.array(dtype=float),  # Countdown to respawn
+  
+  # Tendroid properties
+  tendroid_x: wp.array(dtype=float),
+  tendroid_y: wp.array(dtype=float),
+  tendroid_z: wp.array(dtype=float),
+  tendroid_lengths: wp.array(dtype=float),
+  tendroid_radius: wp.array(dtype=float),
+  
+  # Bubble config (per-bubble)
+  spawn_heights: wp.array(dtype=float),
+  pop_heights: wp.array(dtype=float),
+  max_diameter_heights: wp.array(dtype=float),
+  max_radii: wp.array(dtype=float),
+  
+  # Config
+  rise_speed: float,
+  released_rise_speed: float,
+  respawn_delay: float,
+  
+  # Device-resident frame inputs
+  frame_params: wp.array(dtype=float),  # [0] = dt
+  wave_params: wp.array(dtype=float),  # DeviceWaveState layout
+):
+  """
+  Frame-pipeline variant of update_bubble_physics_kernel.
+  
+  dt and wave state are read from device buffers instead of launch
+  arguments, so a captured CUDA graph picks up new values on replay.
+  """
+  tid = wp.tid()
+  
+  wave_enabled = 0
+  if wave_params[WAVE_ENABLED] > 0.5:
+    wave_enabled = 1
+  
+  step_bubble(
+    tid,
+    y_positions, velocities_x, velocities_y, velocities_z,
+    world_x, world_y, world_z, phases,
+    ages, release_timers, current_radius, respawn_timers,
+    tendroid_x, tendroid_y, tendroid_z, tendroid_lengths,
+    tendroid_radius, spawn_heights, pop_heights, max_diameter_heights,
+    max_radii, frame_params[0], rise_speed, released_rise_speed,
+    respawn_delay, wave_enabled,
+    wave_params[WAVE_DISPLACEMENT], wave_params[WAVE_AMPLITUDE],
+    wave_params[WAVE_DIR_X], wave_params[WAVE_DIR_Z],
+  )
+
+
+@wp.kernel
+def age_sort_keys_kernel(
+  phases: wp.array(dtype=int),
+  ages: wp.array(dtype=float),
+  sort_keys: wp.array(dtype=float),  # Output: age (active) or lowest float
+  sort_values: wp.array(dtype=int),  # Output: bubble index
+):
+  """
+  Sort keys for the concurrent limiter.
+  
+  Active bubbles (phases 1-3) key on their age; inactive ones sort
+  before all of them. The radix sort is stable, so equal ages stay in
+  index order, as with the host argsort this replaces.
+  """
+  tid = wp.tid()
+  phase = phases[tid]
+  if phase >= 1 and phase <= 3:
+    sort_keys[tid] = ages[tid]
+  else:
+    sort_keys[tid] = -3.4e38
+  sort_values[tid] = tid
+
+
+@wp.kernel
+def mark_concurrent_limit_kernel(
+  sorted_values: wp.array(dtype=int),  # Bubble indices, youngest first
+  phases: wp.array(dtype=int),
+  keep_from: int,  # First kept rank (bubble count - max_concurrent)
+  over_limit: wp.array(dtype=int),  # Output: 1 = delay this bubble
+):
+  """
+  Flag active bubbles that fall outside the oldest max_concurrent.
+  
+  One thread per sorted rank; the ranks are a permutation, so every
+  bubble's flag is written exactly once.
+  """
+  rank = wp.tid()
+  b = sorted_values[rank]
+  phase = phases[b]
+  
+  if rank < keep_from and phase >= 1 and phase <= 3:
+    over_limit[b] = 1
+  else:
+    over_limit[b] = 0
+
+
+@wp.kernel
+def apply_concurrent_limit_kernel(
+  over_limit: wp.array(dtype=int),
+  phases: wp.array(dtype=int),
+  respawn_timers: wp.array(dtype=float),
+  respawn_delay: float,
+):
+  """
+  Send flagged bubbles back to popped with a fresh respawn timer.
+  
+  Separate from the marking pass so no thread reads a phase another
+  thread has already rewritten this frame.
+  """
+  tid = wp.tid()
+  if over_limit[tid] != 0:
+    phases[tid] = 4
+    respawn_timers[tid] = respawn_delay
+
+
+@wp.kernel
+def scatter_register_bubbles_kernel(
+  # Batch input (one entry per registered bubble)
+  bubble_ids: wp.array(dtype=int),
+  in_tendroid_positions: wp.array(dtype=wp.vec3),
+  in_tendroid_lengths: wp.array(dtype=float),
+  in_tendroid_radii: wp.array(dtype=float),
+  in_spawn_heights: wp.array(dtype=float),
+  in_pop_heights: wp.array(dtype=float),
+  in_max_diameter_heights: wp.array(dtype=float),
+  in_max_radii: wp.array(dtype=float),
+  
+  # Bubble state
+  y_positions: wp.array(dtype=float),
+  phases: wp.array(dtype=int),
+  current_radius: wp.array(dtype=float),
+  
+  # Tendroid properties
+  tendroid_x: wp.array(dtype=float),
+  tendroid_y: wp.array(dtype=float),
+  tendroid_z: wp.array(dtype=float),
+  tendroid_lengths: wp.array(dtype=float),
+  tendroid_radius: wp.array(dtype=float),
+  
+  # Bubble config (per-bubble)
+  spawn_heights: wp.array(dtype=float),
+  pop_heights: wp.array(dtype=float),
+  max_diameter_heights: wp.array(dtype=float),
+  max_radii: wp.array(dtype=float),
+):
+  """Write tendroid properties and a rising start state for each bubble id."""
+  i = wp.tid()
+  b = bubble_ids[i]
+  
+  pos = in_tendroid_positions[i]
+  radius = in_tendroid_radii[i]
+  spawn_y = in_spawn_heights[i]
+  
+  phases[b] = 1  # rising
+  y_positions[b] = spawn_y
+  current_radius[b] = radius * 0.5
+  
+  tendroid_x[b] = pos[0]
+  tendroid_y[b] = pos[1]
+  tendroid_z[b] = pos[2]
+  tendroid_lengths[b] = in_tendroid_lengths[i]
+  tendroid_radius[b] = radius
+  
+  spawn_heights[b] = spawn_y
+  pop_heights[b] = in_pop_heights[i]
+  max_diameter_heights[b] = in_max_diameter_heights[i]
+  max_radii[b] = in_max_radii[i]
+
+
+@wp.kernel
+def scatter_bubble_params_kernel(
+  # Batch input (one entry per bubble)
+  bubble_ids: wp.array(dtype=int),
+  in_spawn_heights: wp.array(dtype=float),
+  in_pop_heights: wp.array(dtype=float),
+  in_max_diameter_heights: wp.array(dtype=float),
+  in_max_radii: wp.array(dtype=float),
+  
+  # Bubble config (per-bubble)
+  spawn_heights: wp.array(dtype=float),
+  pop_heights: wp.array(dtype=float),
+  max_diameter_heights: wp.array(dtype=float),
+  max_radii: wp.array(dtype=float),
+):
+  """Overwrite lifecycle config for each bubble id (state untouched)."""
+  i = wp.tid()
+  b = bubble_ids[i]
+  spawn_heights[b] = in_spawn_heights[i]
+  pop_heights[b] = in_pop_heights[i]
+  max_diameter_heights[b] = in_max_diameter_heights[i]
+  max_radii[b] = in_max_radii[i]
+
+
+@wp.kernel
+def scatter_spawn_bubbles_kernel(
+  bubble_ids: wp.array(dtype=int),
+  in_spawn_y: wp.array(dtype=float),
+  in_tendroid_radii: wp.array(dtype=float),
+  y_positions: wp.array(dtype=float),
+  ages: wp.array(dtype=float),
+  velocities_x: wp.array(dtype=float),
+  velocities_y: wp.array(dtype=float),
+  velocities_z: wp.array(dtype=float),
+  current_radius: wp.array(dtype=float),
+  phases: wp.array(dtype=int),
+):
+  """Reset each listed bubble to the rising phase at its spawn height."""
+  i = wp.tid()
+  b = bubble_ids[i]
+  
+  y_positions[b] = in_spawn_y[i]
+  ages[b] = 0.0
+  velocities_x[b] = 0.0
+  velocities_y[b] = 0.0
+  velocities_z[b] = 0.0
+  current_radius[b] = in_tendroid_radii[i] * 0.5
+  phases[b] = 1  # rising
+
+
+@wp.kernel
+def scatter_bubble_states_kernel(
+  bubble_ids: wp.array(dtype=int),
+  in_y_positions: wp.array(dtype=float),
+  in_phases: wp.array(dtype=int),
+  y_positions: wp.array(dtype=float),
+  phases: wp.array(dtype=int),
+):
+  """Overwrite Y position and phase for each listed bubble."""
+  i = wp.tid()
+  b = bubble_ids[i]
+  y_positions[b] = in_y_positions[i]
+  phases[b] = in_phases[i]
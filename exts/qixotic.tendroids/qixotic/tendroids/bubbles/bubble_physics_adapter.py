@@ -4,10 +4,15 @@ GPU Bubble Physics Integration Helper
 Provides a drop-in replacement interface for CPU-based bubble physics.
 Makes it easy to switch between CPU and GPU implementations.
 
-Updated for full lifecycle support.
+Updated for full lifecycle support. Bubble ids come from a SlotTable,
+which the scene shares with the batch deformer so ids double as
+deformer slots and tendroids can be added or removed live.
 """
 
+import random
+
 from .bubble_gpu_manager import BubbleGPUManager
+from ..utils.slot_arena import SlotTable
 
 
 class BubblePhysicsAdapter:
@@ -18,22 +23,35 @@ class BubblePhysicsAdapter:
     Supports full lifecycle: spawn, rise, exit, release, pop, respawn.
     """
     
-    def __init__(self, use_gpu: bool = True, max_bubbles: int = 100):
+    def __init__(
+        self,
+        use_gpu: bool = True,
+        max_bubbles: int = 100,
+        slots: SlotTable = None,
+        device: str = "cuda:0"
+    ):
         """
         Args:
             use_gpu: Enable GPU acceleration
-            max_bubbles: Maximum concurrent bubbles (GPU only)
+            max_bubbles: Initial bubble capacity (GPU only, grows on demand)
+            slots: Shared tendroid slot table (a private one if None)
+            device: Warp device for the bubble state
         """
         self.use_gpu = use_gpu
+        self.device = device
         self.gpu_manager = None
         
         if use_gpu:
-            self.gpu_manager = BubbleGPUManager(max_bubbles=max_bubbles)
+            self.gpu_manager = BubbleGPUManager(max_bubbles=max_bubbles, device=device)
         
-        # Map tendroid names to bubble IDs
+        # Map tendroid names to bubble IDs (ids are slot table slots)
+        self.slots = slots if slots is not None else SlotTable()
         self._name_to_id = {}
         self._id_to_name = {}
-        self._next_id = 0
+        
+        # Per-tendroid draw in [0, 1] within the pop height range, kept so
+        # live range changes rescale pop heights instead of re-rolling them
+        self._pop_fractions = {}
     
     def register_tendroid(self, tendroid, config):
         """
@@ -43,41 +61,119 @@ class BubblePhysicsAdapter:
             tendroid: Tendroid instance
             config: Bubble config with lifecycle parameters
         """
+        self.register_tendroids([tendroid], config)
+    
+    def register_tendroids(self, tendroids: list, config):
+        """
+        Register tendroids in one batched GPU scatter.
+        
+        Already-registered names are skipped.
+        
+        Args:
+            tendroids: Tendroid instances
+            config: Bubble config with lifecycle parameters
+        """
         if not self.use_gpu:
             return
         
-        name = tendroid.name
-        if name in self._name_to_id:
-            return
+        ids, positions, lengths, radii = [], [], [], []
+        spawn_ys, pop_heights, max_diameter_ys, max_radii = [], [], [], []
         
-        bubble_id = self._next_id
-        self._name_to_id[name] = bubble_id
-        self._id_to_name[bubble_id] = name
-        self._next_id += 1
+        for tendroid in tendroids:
+            name = tendroid.name
+            if name in self._name_to_id:
+                continue
+            
+            bubble_id = self.slots.acquire(name)
+            self._name_to_id[name] = bubble_id
+            self._id_to_name[bubble_id] = name
+            
+            # Random pop height in configured range
+            self._pop_fractions[name] = random.random()
+            
+            # Calculate lifecycle parameters
+            spawn_y, pop_height, max_diameter_y, max_radius = self._lifecycle_params(tendroid, config)
+            ids.append(bubble_id)
+            positions.append(tendroid.position)
+            lengths.append(tendroid.length)
+            radii.append(tendroid.radius)
+            spawn_ys.append(spawn_y)
+            pop_heights.append(pop_height)
+            max_diameter_ys.append(max_diameter_y)
+            max_radii.append(max_radius)
         
-        # Calculate lifecycle parameters
-        spawn_y = tendroid.get_spawn_height(config.spawn_height_pct)
-        max_diameter_y = tendroid.length * config.max_diameter_pct
-        max_radius = tendroid.radius * (1.0 + tendroid.deformer.max_amplitude)
+        # Register with GPU manager
+        if self.gpu_manager and ids:
+            self.gpu_manager.ensure_capacity(max(ids) + 1)
+            self.gpu_manager.register_bubbles(
+                ids, positions, lengths, radii,
+                spawn_ys, pop_heights, max_diameter_ys, max_radii
+            )
+    
+    def _lifecycle_params(self, tendroid, config) -> tuple:
+        """(spawn_y, pop_height, max_diameter_y, max_radius) for one tendroid."""
+        fraction = self._pop_fractions.get(tendroid.name, 0.5)
+        pop_offset = config.min_pop_height + (config.max_pop_height - config.min_pop_height) * fraction
+        return (
+            tendroid.get_spawn_height(config.spawn_height_pct),
+            tendroid.position[1] + tendroid.length + pop_offset,
+            tendroid.length * config.max_diameter_pct,
+            tendroid.radius * (1.0 + tendroid.deformer.max_amplitude),
+        )
+    
+    def update_config(self, tendroids: list, config) -> int:
+        """
+        Re-derive lifecycle parameters after a config change, in place.
         
-        # Generate random pop height in configured range
-        import random
-        pop_height = tendroid.position[1] + tendroid.length + random.uniform(
-            config.min_pop_height, config.max_pop_height
+        Covers spawn_height_pct, max_diameter_pct, the pop height range
+        and the deformers' max_amplitude with one batched scatter.
+        Launch-scalar values (rise speeds, respawn delay) need no upload.
+        
+        Args:
+            tendroids: Registered tendroid instances
+            config: Updated bubble config
+        
+        Returns:
+            Number of bubbles updated
+        """
+        if not self.use_gpu or not self.gpu_manager:
+            return 0
+        
+        ids, params = [], []
+        for tendroid in tendroids:
+            bubble_id = self._name_to_id.get(tendroid.name)
+            if bubble_id is None:
+                continue
+            ids.append(bubble_id)
+            params.append(self._lifecycle_params(tendroid, config))
+        if not ids:
+            return 0
+        
+        spawn_ys, pop_heights, max_diameter_ys, max_radii = zip(*params)
+        return self.gpu_manager.update_bubble_params(
+            ids, spawn_ys, pop_heights, max_diameter_ys, max_radii
         )
+    
+    def unregister_tendroid(self, tendroid_name: str):
+        """
+        Drop a tendroid's bubble and idle its GPU slot.
+        
+        The slot itself stays acquired in the slot table; whoever owns
+        the table (the scene manager when shared) releases it once every
+        consumer has let go.
+        
+        Returns:
+            The freed bubble id, or None if the name was not registered
+        """
+        bubble_id = self._name_to_id.pop(tendroid_name, None)
+        if bubble_id is None:
+            return None
+        self._pop_fractions.pop(tendroid_name, None)
+        self._id_to_name.pop(bubble_id, None)
         
-        # Register with GPU manager
         if self.gpu_manager:
-            self.gpu_manager.register_bubble(
-                bubble_id=bubble_id,
-                tendroid_position=tendroid.position,
-                tendroid_length=tendroid.length,
-                tendroid_radius=tendroid.radius,
-                spawn_y=spawn_y,
-                pop_height=pop_height,
-                max_diameter_y=max_diameter_y,
-                max_radius=max_radius
-            )
+            self.gpu_manager.release_bubbles([bubble_id])
+        return bubble_id
     
     def update_gpu(self, dt: float, config, wave_state=None):
         """
@@ -202,20 +298,28 @@ class BubblePhysicsAdapter:
             self.gpu_manager = None
 
 
-def create_gpu_bubble_system(tendroids: list, config) -> BubblePhysicsAdapter:
+def create_gpu_bubble_system(
+    tendroids: list,
+    config,
+    slots: SlotTable = None,
+    device: str = "cuda:0"
+) -> BubblePhysicsAdapter:
     """
     Factory function to create GPU-accelerated bubble system.
     
     Args:
         tendroids: List of tendroids
         config: Bubble configuration with lifecycle parameters
+        slots: Optional tendroid slot table shared with the deformer
+        device: Warp device for the bubble state
         
     Returns:
         BubblePhysicsAdapter ready to use with full lifecycle support
     """
-    adapter = BubblePhysicsAdapter(use_gpu=True, max_bubbles=len(tendroids) * 2)
+    adapter = BubblePhysicsAdapter(
+        use_gpu=True, max_bubbles=max(len(tendroids) * 2, 1), slots=slots, device=device
+    )
     
-    for tendroid in tendroids:
-        adapter.register_tendroid(tendroid, config)
+    adapter.register_tendroids(tendroids, config)
     
     return adapter
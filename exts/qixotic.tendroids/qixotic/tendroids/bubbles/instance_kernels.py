@@ -0,0 +1,73 @@
+"""
+Warp GPU Kernels for Instanced Bubble and Particle Rendering
+
+Fill PointInstancer positions/scales buffers straight from the physics
+arrays, and copy them into the instancer's Fabric attributes. Hidden
+instances get a zero scale so the Fabric path never has to resize
+invisibleIds on device.
+"""
+
+import warp as wp
+
+wp.init()
+
+
+@wp.kernel
+def bubble_instance_kernel(
+    phases: wp.array(dtype=int),  # 0=idle, 1=rising, 2=exiting, 3=released, 4=popped
+    world_x: wp.array(dtype=float),
+    world_y: wp.array(dtype=float),
+    world_z: wp.array(dtype=float),
+    current_radius: wp.array(dtype=float),
+    visual_scale: float,  # Visual radius relative to physics radius
+    hide_rising: int,  # 1 = hide until clear of the mouth
+    out_positions: wp.array(dtype=wp.vec3),
+    out_scales: wp.array(dtype=wp.vec3),
+):
+    """
+    One instance per bubble slot; idle/popped (and optionally rising)
+    bubbles collapse to zero scale.
+    """
+    tid = wp.tid()
+    phase = phases[tid]
+
+    out_positions[tid] = wp.vec3(world_x[tid], world_y[tid], world_z[tid])
+
+    hidden = phase == 0 or phase == 4 or (phase == 1 and hide_rising != 0)
+    if hidden:
+        out_scales[tid] = wp.vec3(0.0, 0.0, 0.0)
+    else:
+        r = current_radius[tid] * visual_scale
+        out_scales[tid] = wp.vec3(r, r, r)
+
+
+@wp.kernel
+def particle_instance_kernel(
+    alive_flags: wp.array(dtype=int),  # 1=alive, 0=dead
+    particle_scale: float,
+    out_scales: wp.array(dtype=wp.vec3),
+):
+    """Dead particle slots collapse to zero scale."""
+    tid = wp.tid()
+    if alive_flags[tid] != 0:
+        out_scales[tid] = wp.vec3(particle_scale, particle_scale, particle_scale)
+    else:
+        out_scales[tid] = wp.vec3(0.0, 0.0, 0.0)
+
+
+@wp.kernel
+def copy_instances_to_fabric_kernel(
+    positions: wp.array(dtype=wp.vec3),
+    scales: wp.array(dtype=wp.vec3),
+    fabric_positions: wp.fabricarrayarray(dtype=wp.vec3),
+    fabric_scales: wp.fabricarrayarray(dtype=wp.vec3),
+):
+    """
+    Copy instance buffers into the selected instancer's Fabric arrays.
+
+    The selection holds exactly one tagged instancer (prim 0) whose
+    arrays were authored with one entry per instance.
+    """
+    tid = wp.tid()
+    fabric_positions[0][tid] = positions[tid]
+    fabric_scales[0][tid] = scales[tid]
@@ -0,0 +1,304 @@
+"""
+Instanced bubble and pop particle visuals
+
+Draws every bubble through one UsdGeom.PointInstancer and every pop
+particle through another, instead of authoring a translate/scale op and
+visibility on one sphere prim per bubble or particle.
+
+GPU path: a kernel fills the instance buffers from the physics arrays
+and a second kernel copies them into the instancer's Fabric attributes -
+no host transfer. Fallback: one download, then positions, scales and
+invisibleIds are each set in bulk on the USD instancer.
+"""
+
+import carb
+import numpy as np
+import warp as wp
+from pxr import Gf, Sdf, UsdGeom, Vt
+
+from .instance_kernels import (
+    bubble_instance_kernel,
+    copy_instances_to_fabric_kernel,
+    particle_instance_kernel,
+)
+from .sphere_geometry_helper import create_sphere_mesh
+
+
+class PointInstancerVisual:
+    """
+    One PointInstancer with a single prototype and a fixed instance count.
+
+    Instance i maps to physics slot i. positions_gpu/scales_gpu are the
+    device-side instance buffers; hidden instances carry a zero scale.
+    """
+
+    def __init__(self, stage, path: str, count: int, tag_attr: str, device: str = "cuda:0"):
+        """
+        Args:
+            stage: USD stage
+            path: Prim path for the PointInstancer
+            count: Number of instances (physics slots)
+            tag_attr: Fabric tag attribute unique to this instancer
+            device: Warp device of the physics arrays
+        """
+        self.stage = stage
+        self.path = path
+        self.count = count
+        self.tag_attr = tag_attr
+        self.device = device
+
+        self.instancer = None
+        self._positions_attr = None
+        self._scales_attr = None
+        self._invisible_attr = None
+        self._invisible_ids = None  # Last authored invisibleIds (skip unchanged)
+        self._fabric_tagged_stage_id = None
+
+        self.positions_gpu = wp.zeros(count, dtype=wp.vec3, device=device)
+        self.scales_gpu = wp.zeros(count, dtype=wp.vec3, device=device)
+
+    def create(self):
+        """Define the instancer, its prototype and per-instance arrays."""
+        if self.stage.GetPrimAtPath(self.path).IsValid():
+            self.stage.RemovePrim(self.path)
+
+        self.instancer = UsdGeom.PointInstancer.Define(self.stage, self.path)
+        proto_path = f"{self.path}/Prototypes/proto"
+        self._create_prototype(proto_path)
+        self.instancer.CreatePrototypesRel().SetTargets([Sdf.Path(proto_path)])
+
+        zeros = np.zeros((self.count, 3), dtype=np.float32)
+        self.instancer.CreateProtoIndicesAttr(Vt.IntArray([0] * self.count))
+        self._positions_attr = self.instancer.CreatePositionsAttr(Vt.Vec3fArray.FromNumpy(zeros))
+        self._scales_attr = self.instancer.CreateScalesAttr(Vt.Vec3fArray.FromNumpy(zeros))
+        self._invisible_attr = self.instancer.CreateInvisibleIdsAttr(Vt.Int64Array())
+        self._invisible_ids = np.zeros(0, dtype=np.int64)
+        self._fabric_tagged_stage_id = None
+
+        carb.log_info(f"[PointInstancerVisual] {self.count} instances at {self.path}")
+
+    def _create_prototype(self, proto_path: str):
+        """Author the prototype prim (override per visual)."""
+        raise NotImplementedError
+
+    def sync(self, stage_id=None, use_fabric: bool = True):
+        """
+        Push positions_gpu/scales_gpu to the renderer.
+
+        Tries the device-to-Fabric copy first, then falls back to one
+        download and bulk USD writes.
+        """
+        if not self.instancer:
+            return
+
+        if use_fabric and stage_id is not None and self._write_fabric(stage_id):
+            return
+
+        scales = self.scales_gpu.numpy()
+        self.write_usd(self.positions_gpu.numpy(), scales, np.flatnonzero(scales[:, 0] <= 0.0))
+
+    def write_usd(self, positions: np.ndarray, scales: np.ndarray, invisible_ids):
+        """
+        Bulk-author positions, scales and invisibleIds.
+
+        invisibleIds is only re-authored when the hidden set changes.
+        """
+        if not self.instancer:
+            return
+
+        self._positions_attr.Set(Vt.Vec3fArray.FromNumpy(np.ascontiguousarray(positions, dtype=np.float32)))
+        self._scales_attr.Set(Vt.Vec3fArray.FromNumpy(np.ascontiguousarray(scales, dtype=np.float32)))
+        self._set_invisible_ids(np.asarray(invisible_ids, dtype=np.int64))
+
+    def _set_invisible_ids(self, ids: np.ndarray):
+        """Author invisibleIds if they differ from the last write."""
+        if self._invisible_ids is not None and np.array_equal(ids, self._invisible_ids):
+            return
+        self._invisible_attr.Set(Vt.Int64Array.FromNumpy(ids))
+        self._invisible_ids = ids
+
+    def _write_fabric(self, stage_id) -> bool:
+        """Copy instance buffers into Fabric on device; False if unavailable."""
+        if not self.device.startswith("cuda"):
+            return False
+
+        from ..utils import FabricHelper
+
+        try:
+            usdrt_stage = FabricHelper.get_usdrt_stage(stage_id)
+            if self._fabric_tagged_stage_id != stage_id:
+                if not FabricHelper.tag_instancer(usdrt_stage, self.path, self.tag_attr):
+                    return False
+                self._fabric_tagged_stage_id = stage_id
+
+            selection = FabricHelper.select_instancer(usdrt_stage, self.tag_attr, self.device)
+            if selection is None:
+                return False
+
+            fabric_positions = wp.fabricarray(selection, "positions")
+            fabric_scales = wp.fabricarray(selection, "scales")
+        except Exception:
+            self._fabric_tagged_stage_id = None
+            return False
+
+        # Zero scale hides instances on this path - drop any USD-side hiding
+        self._set_invisible_ids(np.zeros(0, dtype=np.int64))
+
+        wp.launch(
+            kernel=copy_instances_to_fabric_kernel,
+            dim=self.count,
+            inputs=[self.positions_gpu, self.scales_gpu, fabric_positions, fabric_scales],
+            device=self.device
+        )
+        return True
+
+    def destroy(self):
+        """Remove the instancer and release instance buffers."""
+        if self.stage and self.stage.GetPrimAtPath(self.path).IsValid():
+            self.stage.RemovePrim(self.path)
+        self.instancer = None
+        self._positions_attr = None
+        self._scales_attr = None
+        self._invisible_attr = None
+        self.positions_gpu = None
+        self.scales_gpu = None
+
+
+class BubbleInstancerVisual(PointInstancerVisual):
+    """All bubbles as instances of one vertex-down sphere mesh."""
+
+    TAG_ATTR = "tendroidBubbleInstancer"
+    VISUAL_SCALE = 0.92  # Match _BubbleState._update_scale
+
+    def __init__(self, stage, path: str, count: int, config, device: str = "cuda:0"):
+        """
+        Args:
+            stage: USD stage
+            path: Prim path for the PointInstancer
+            count: Bubble slots (BubbleGPUManager.max_bubbles)
+            config: V2BubbleConfig (color, opacity, hide_until_clear)
+            device: Warp device of the bubble arrays
+        """
+        super().__init__(stage, path, count, self.TAG_ATTR, device)
+        self.config = config
+
+    def _create_prototype(self, proto_path: str):
+        """Unit-radius vertex-down sphere with the shared bubble material."""
+        from .bubble_material import apply_bubble_material, create_transparent_bubble_material
+
+        mesh = create_sphere_mesh(
+            stage=self.stage,
+            path=proto_path,
+            radius=1.0,
+            horizontal_segments=16,
+            vertical_segments=10,
+            vertex_down=True
+        )
+        material = create_transparent_bubble_material(
+            stage=self.stage,
+            material_path=f"{self.path}/Prototypes/BubbleMaterial",
+            color=self.config.color,
+            opacity=self.config.opacity,
+            metallic=0.0,
+            roughness=0.1
+        )
+        apply_bubble_material(mesh.GetPrim(), material)
+
+    def update_from_gpu(self, bubble_gpu_manager, stage_id=None, use_fabric: bool = True):
+        """
+        Fill instance buffers from BubbleGPUManager arrays and sync.
+
+        Args:
+            bubble_gpu_manager: BubbleGPUManager with this many slots
+            stage_id: USD stage ID (enables the Fabric path)
+            use_fabric: Try the device-to-Fabric copy first
+        """
+        wp.launch(
+            kernel=bubble_instance_kernel,
+            dim=self.count,
+            inputs=[
+                bubble_gpu_manager.phases_gpu,
+                bubble_gpu_manager.world_x_gpu,
+                bubble_gpu_manager.world_y_gpu,
+                bubble_gpu_manager.world_z_gpu,
+                bubble_gpu_manager.current_radius_gpu,
+                self.VISUAL_SCALE,
+                1 if self.config.hide_until_clear else 0,
+                self.positions_gpu,
+                self.scales_gpu,
+            ],
+            device=self.device
+        )
+        self.sync(stage_id, use_fabric)
+
+    def update_from_states(self, states: list):
+        """
+        Author instances from CPU bubble states (CPU physics path).
+
+        Args:
+            states: _BubbleState per instance slot, in slot order
+        """
+        positions = np.zeros((self.count, 3), dtype=np.float32)
+        scales = np.zeros((self.count, 3), dtype=np.float32)
+        invisible = []
+
+        for i, state in enumerate(states[:self.count]):
+            positions[i] = state.world_pos
+            hidden = state.phase in ("idle", "popped") or (
+                state.phase == "rising" and self.config.hide_until_clear
+            )
+            if hidden:
+                invisible.append(i)
+                continue
+            r = state.current_radius * self.VISUAL_SCALE
+            scales[i] = (r * state.horizontal_scale, r * state.vertical_stretch, r * state.horizontal_scale)
+
+        invisible.extend(range(len(states), self.count))
+        self.write_usd(positions, scales, invisible)
+
+
+class ParticleInstancerVisual(PointInstancerVisual):
+    """All pop particles as instances of one small sphere."""
+
+    TAG_ATTR = "tendroidParticleInstancer"
+
+    def __init__(self, stage, path: str, count: int, config, device: str = "cuda:0"):
+        """
+        Args:
+            stage: USD stage
+            path: Prim path for the PointInstancer
+            count: Particle slots (PopParticleGPUManager.max_particles)
+            config: V2BubbleConfig (particle_size)
+            device: Warp device of the particle arrays
+        """
+        super().__init__(stage, path, count, self.TAG_ATTR, device)
+        self.config = config
+
+    def _create_prototype(self, proto_path: str):
+        """Unit sphere with the pop particle display appearance."""
+        sphere = UsdGeom.Sphere.Define(self.stage, proto_path)
+        sphere.GetRadiusAttr().Set(1.0)
+        sphere.CreateDisplayColorAttr([Gf.Vec3f(0.7, 0.9, 1.0)])
+        sphere.CreateDisplayOpacityAttr([0.6])
+
+    def update_from_gpu(self, particle_gpu_manager, stage_id=None, use_fabric: bool = True):
+        """
+        Fill instance buffers from PopParticleGPUManager arrays and sync.
+
+        Args:
+            particle_gpu_manager: PopParticleGPUManager with this many slots
+            stage_id: USD stage ID (enables the Fabric path)
+            use_fabric: Try the device-to-Fabric copy first
+        """
+        wp.copy(self.positions_gpu, particle_gpu_manager.positions_gpu)
+        wp.launch(
+            kernel=particle_instance_kernel,
+            dim=self.count,
+            inputs=[
+                particle_gpu_manager.alive_flags_gpu,
+                float(self.config.particle_size),
+                self.scales_gpu,
+            ],
+            device=self.device
+        )
+        self.sync(stage_id, use_fabric)
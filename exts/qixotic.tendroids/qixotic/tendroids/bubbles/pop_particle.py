@@ -95,16 +95,18 @@ class PopParticleManager:
     
     Coordinates between:
     - PopParticleGPUManager: Physics on GPU
-    - PopParticleVisual: USD prim management
+    - PopParticleVisual: USD prim management, or one
+      ParticleInstancerVisual for all slots when config.use_point_instancer
     """
     
-    def __init__(self, stage, config):
+    def __init__(self, stage, config, device: str = "cuda:0"):
         """
         Initialize particle manager.
         
         Args:
             stage: USD stage
             config: BubbleConfig instance
+            device: Warp device for particle physics ("cpu" without CUDA)
         """
         self.stage = stage
         self.config = config
@@ -112,7 +114,7 @@ class PopParticleManager:
         # GPU physics manager
         self.gpu_manager = PopParticleGPUManager(
             max_particles=config.max_particles,
-            device="cuda:0"
+            device=device
         )
         
         # USD visuals indexed by slot
@@ -121,6 +123,21 @@ class PopParticleManager:
         # Parent path for organization
         self.parent_path = "/World/Bubbles/PopParticles"
         self._ensure_parent()
+        
+        # Instanced mode: one PointInstancer reads every slot directly
+        self.instancer = None
+        self._instances_dirty = False
+        if getattr(config, "use_point_instancer", False):
+            from .instanced_visuals import ParticleInstancerVisual
+            
+            self.instancer = ParticleInstancerVisual(
+                stage=stage,
+                path=f"{self.parent_path}/ParticleInstancer",
+                count=config.max_particles,
+                config=config,
+                device=self.gpu_manager.device
+            )
+            self.instancer.create()
     
     def _ensure_parent(self):
         """Create parent prim if needed."""
@@ -144,22 +161,27 @@ class PopParticleManager:
         
         num_particles = min(
             self.config.particles_per_pop,
-            len(self.gpu_manager.free_slots)
+            self.gpu_manager.get_free_count()
         )
         
         if num_particles == 0:
             return
         
-        # Spawn on GPU and get assigned slots
+        # Spawn on GPU and get assigned slots (instancer reads slots on device)
         spawned_slots = self.gpu_manager.spawn_spray(
             pop_position=pop_position,
             bubble_velocity=bubble_velocity,
             num_particles=num_particles,
             particle_speed=self.config.particle_speed,
             particle_spread=self.config.particle_spread,
-            base_lifetime=self.config.particle_lifetime
+            base_lifetime=self.config.particle_lifetime,
+            return_slots=self.instancer is None
         )
         
+        if self.instancer:
+            self._instances_dirty = True
+            return
+        
         # Create USD visuals for spawned particles
         for slot_idx in spawned_slots:
             prim_path = f"{self.parent_path}/particle_{slot_idx:04d}"
@@ -171,20 +193,66 @@ class PopParticleManager:
             )
             self.visuals[slot_idx] = visual
     
-    def update(self, dt: float):
+    def update(self, dt: float, stage_id=None):
         """
         Update all particles.
         
         1. Run GPU physics kernel
         2. Update USD transforms from GPU positions
         3. Clean up dead particles
+        
+        Args:
+            dt: Delta time
+            stage_id: USD stage ID for the instancer's Fabric path
         """
+        if self.instancer:
+            self.gpu_manager.update(dt)
+            self._sync_instancer(stage_id)
+            return
+        
         if not self.visuals:
             return
         
         # Update physics on GPU, get dead particle slots
         dead_slots = self.gpu_manager.update(dt)
+        self._sync_visuals(dead_slots)
+    
+    def sync_after_gpu_update(self, stage_id=None):
+        """
+        Sync visuals after physics already ran on GPU.
         
+        Used by the GPU frame pipeline, which launches the particle
+        kernel itself as part of the captured frame graph. Always
+        collects so dead slots return to the free list every frame.
+        
+        Args:
+            stage_id: USD stage ID for the instancer's Fabric path
+        """
+        dead_slots = self.gpu_manager.collect_dead_slots()
+        if self.instancer:
+            self._sync_instancer(stage_id)
+            return
+        
+        if not self.visuals:
+            return
+        
+        self._sync_visuals(dead_slots)
+    
+    def _sync_instancer(self, stage_id=None):
+        """
+        Redraw the particle instancer while any particle is alive.
+        
+        One extra sync after the last death hides the final slots.
+        """
+        active = self.gpu_manager.get_active_count() > 0
+        if not active and not self._instances_dirty:
+            return
+        
+        self.instancer.update_from_gpu(self.gpu_manager, stage_id)
+        self._instances_dirty = active
+    
+    def _sync_visuals(self, dead_slots: list):
+        """Drop dead particle visuals and move the rest to GPU positions."""
         # Remove dead visuals
         for slot_idx in dead_slots:
             if slot_idx in self.visuals:
@@ -207,10 +275,17 @@ class PopParticleManager:
         for visual in self.visuals.values():
             visual.destroy()
         self.visuals.clear()
+        
+        if self.instancer:
+            self._instances_dirty = True
+            self._sync_instancer()
     
     def destroy(self):
         """Full cleanup."""
         self.clear_all()
+        if self.instancer:
+            self.instancer.destroy()
+            self.instancer = None
         self.gpu_manager.destroy()
     
     @property
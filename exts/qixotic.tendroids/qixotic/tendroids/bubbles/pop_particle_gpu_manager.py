@@ -6,12 +6,17 @@ Handles spawning, physics updates, and state synchronization.
 """
 
 import math
-import random
 
 import numpy as np
 import warp as wp
 
-from .pop_particle_physics import update_pop_particles_kernel, spawn_particles_kernel
+from .pop_particle_physics import (
+    update_pop_particles_kernel,
+    update_pop_particles_frame_kernel,
+    spawn_spray_kernel,
+    release_dead_slots_kernel,
+    reset_free_list_kernel,
+)
 
 wp.init()
 
@@ -21,6 +26,8 @@ class PopParticleGPUManager:
     Manages pop particle physics on GPU using Warp kernels.
     
     All particle state lives in GPU arrays. Updates happen in parallel.
+    Slot allocation uses a device free-list stack; deaths are compacted
+    on device so each frame downloads only the indices that died.
     CPU only handles spawning decisions and USD visual updates.
     """
     
@@ -34,32 +41,48 @@ class PopParticleGPUManager:
         self.device = device
         self.gravity = -5.0
         
-        # GPU arrays - positions
-        self.pos_x_gpu = wp.zeros(max_particles, dtype=float, device=device)
-        self.pos_y_gpu = wp.zeros(max_particles, dtype=float, device=device)
-        self.pos_z_gpu = wp.zeros(max_particles, dtype=float, device=device)
-        
-        # GPU arrays - velocities
-        self.vel_x_gpu = wp.zeros(max_particles, dtype=float, device=device)
-        self.vel_y_gpu = wp.zeros(max_particles, dtype=float, device=device)
-        self.vel_z_gpu = wp.zeros(max_particles, dtype=float, device=device)
+        # GPU arrays - packed motion state
+        self.positions_gpu = wp.zeros(max_particles, dtype=wp.vec3, device=device)
+        self.velocities_gpu = wp.zeros(max_particles, dtype=wp.vec3, device=device)
         
         # GPU arrays - lifecycle
         self.ages_gpu = wp.zeros(max_particles, dtype=float, device=device)
         self.lifetimes_gpu = wp.zeros(max_particles, dtype=float, device=device)
         self.alive_flags_gpu = wp.zeros(max_particles, dtype=int, device=device)
         
-        # Free slot tracking (CPU side)
-        self.free_slots = list(range(max_particles))
+        # Device free-list stack + compacted death list
+        self.free_list_gpu = wp.zeros(max_particles, dtype=int, device=device)
+        self.free_count_gpu = wp.zeros(1, dtype=int, device=device)
+        self.dead_indices_gpu = wp.zeros(max_particles, dtype=int, device=device)
+        self.dead_count_gpu = wp.zeros(1, dtype=int, device=device)
+        self.spawned_slots_gpu = wp.zeros(max_particles, dtype=int, device=device)
+        self._reset_free_list()
+        
+        # Host mirrors: exact, since slots are only freed in collect_dead_slots()
+        self._free_count = max_particles
         self.active_slots = set()
+        self._spawn_seed = 0
+    
+    def _reset_free_list(self):
+        """Mark every slot free on device."""
+        wp.launch(
+            kernel=reset_free_list_kernel,
+            dim=self.max_particles,
+            inputs=[self.free_list_gpu, self.free_count_gpu],
+            device=self.device
+        )
     
     def get_active_count(self) -> int:
         """Return number of active particles."""
-        return len(self.active_slots)
+        return self.max_particles - self._free_count
+    
+    def get_free_count(self) -> int:
+        """Return number of free slots (no device sync)."""
+        return self._free_count
     
     def has_capacity(self, count: int) -> bool:
         """Check if we can spawn count more particles."""
-        return len(self.free_slots) >= count
+        return self._free_count >= count
     
     def spawn_spray(
         self,
@@ -68,11 +91,15 @@ class PopParticleGPUManager:
         num_particles: int,
         particle_speed: float,
         particle_spread: float,
-        base_lifetime: float
+        base_lifetime: float,
+        return_slots: bool = True
     ) -> list:
         """
         Spawn a spray of particles at pop location.
         
+        Slots are claimed atomically from the device free list and the
+        spray is randomized on device - one launch, no uploads.
+        
         Args:
             pop_position: (x, y, z) where bubble popped
             bubble_velocity: [vx, vy, vz] bubble's velocity at pop
@@ -80,72 +107,44 @@ class PopParticleGPUManager:
             particle_speed: Base spray speed
             particle_spread: Spread angle in degrees
             base_lifetime: Base lifetime (will be randomized +/- 30%)
+            return_slots: Download the claimed slots (small sync). Pass
+                False when visuals read positions_gpu directly.
             
         Returns:
-            List of slot indices that were spawned (for USD creation)
+            List of slot indices that were spawned (for USD creation),
+            empty when return_slots is False
         """
-        actual_count = min(num_particles, len(self.free_slots))
+        actual_count = min(num_particles, self._free_count)
         if actual_count == 0:
             return []
         
-        # Claim slots
-        spawned_indices = []
-        for _ in range(actual_count):
-            idx = self.free_slots.pop()
-            self.active_slots.add(idx)
-            spawned_indices.append(idx)
-        
-        # Build spawn data arrays
-        spawn_pos_x = np.full(actual_count, pop_position[0], dtype=np.float32)
-        spawn_pos_y = np.full(actual_count, pop_position[1], dtype=np.float32)
-        spawn_pos_z = np.full(actual_count, pop_position[2], dtype=np.float32)
-        
-        spawn_vel_x = np.zeros(actual_count, dtype=np.float32)
-        spawn_vel_y = np.zeros(actual_count, dtype=np.float32)
-        spawn_vel_z = np.zeros(actual_count, dtype=np.float32)
-        spawn_lifetimes = np.zeros(actual_count, dtype=np.float32)
-        
-        # Generate random velocities for each particle
-        for i in range(actual_count):
-            angle = random.uniform(0, 2 * math.pi)
-            elevation = random.uniform(-particle_spread / 2, particle_spread)
-            
-            spray_vx = particle_speed * math.cos(angle) * math.cos(math.radians(elevation))
-            spray_vy = particle_speed * math.sin(math.radians(elevation))
-            spray_vz = particle_speed * math.sin(angle) * math.cos(math.radians(elevation))
-            
-            spawn_vel_x[i] = bubble_velocity[0] + spray_vx
-            spawn_vel_y[i] = bubble_velocity[1] + spray_vy
-            spawn_vel_z[i] = bubble_velocity[2] + spray_vz
-            
-            spawn_lifetimes[i] = base_lifetime * random.uniform(0.7, 1.3)
-        
-        # Upload spawn data to GPU
-        indices_gpu = wp.array(spawned_indices, dtype=int, device=self.device)
-        spawn_px = wp.array(spawn_pos_x, dtype=float, device=self.device)
-        spawn_py = wp.array(spawn_pos_y, dtype=float, device=self.device)
-        spawn_pz = wp.array(spawn_pos_z, dtype=float, device=self.device)
-        spawn_vx = wp.array(spawn_vel_x, dtype=float, device=self.device)
-        spawn_vy = wp.array(spawn_vel_y, dtype=float, device=self.device)
-        spawn_vz = wp.array(spawn_vel_z, dtype=float, device=self.device)
-        spawn_lt = wp.array(spawn_lifetimes, dtype=float, device=self.device)
-        
-        # Launch spawn kernel
+        self._spawn_seed += 1
         wp.launch(
-            kernel=spawn_particles_kernel,
+            kernel=spawn_spray_kernel,
             dim=actual_count,
             inputs=[
-                self.pos_x_gpu, self.pos_y_gpu, self.pos_z_gpu,
-                self.vel_x_gpu, self.vel_y_gpu, self.vel_z_gpu,
+                self.positions_gpu, self.velocities_gpu,
                 self.ages_gpu, self.lifetimes_gpu, self.alive_flags_gpu,
-                indices_gpu,
-                spawn_px, spawn_py, spawn_pz,
-                spawn_vx, spawn_vy, spawn_vz,
-                spawn_lt,
+                self.free_list_gpu, self.free_count_gpu,
+                wp.vec3(pop_position[0], pop_position[1], pop_position[2]),
+                wp.vec3(bubble_velocity[0], bubble_velocity[1], bubble_velocity[2]),
+                particle_speed,
+                math.radians(particle_spread),
+                base_lifetime,
+                self._spawn_seed,
+                self.spawned_slots_gpu,
             ],
             device=self.device
         )
+        self._free_count -= actual_count
+        
+        if not return_slots:
+            return []
         
+        spawned_indices = [
+            int(i) for i in self.spawned_slots_gpu[:actual_count].numpy() if i >= 0
+        ]
+        self.active_slots.update(spawned_indices)
         return spawned_indices
     
     def update(self, dt: float) -> list:
@@ -158,45 +157,88 @@ class PopParticleGPUManager:
         Returns:
             List of slot indices that died this frame (for USD cleanup)
         """
-        if not self.active_slots:
+        if self._free_count == self.max_particles:
             return []
         
         # Launch physics kernel for ALL slots (dead ones skip internally)
+        self.dead_count_gpu.zero_()
         wp.launch(
             kernel=update_pop_particles_kernel,
             dim=self.max_particles,
             inputs=[
-                self.pos_x_gpu, self.pos_y_gpu, self.pos_z_gpu,
-                self.vel_x_gpu, self.vel_y_gpu, self.vel_z_gpu,
+                self.positions_gpu, self.velocities_gpu,
                 self.ages_gpu, self.lifetimes_gpu, self.alive_flags_gpu,
+                self.dead_indices_gpu, self.dead_count_gpu,
                 dt, self.gravity,
             ],
             device=self.device
         )
         
-        # Check for newly dead particles
-        alive_flags = self.alive_flags_gpu.numpy()
-        dead_slots = []
+        return self.collect_dead_slots()
+    
+    def launch_update_frame(self, frame_params):
+        """
+        Enqueue the physics kernel with dt read from a device buffer.
+        
+        Used by the GPU frame pipeline (graph capture). Always launches
+        over all slots; call collect_dead_slots() after every frame so
+        the dead list is consumed before the next launch resets it.
+        
+        Args:
+            frame_params: Device float array, [0] = dt
+        """
+        self.dead_count_gpu.zero_()
+        wp.launch(
+            kernel=update_pop_particles_frame_kernel,
+            dim=self.max_particles,
+            inputs=[
+                self.positions_gpu, self.velocities_gpu,
+                self.ages_gpu, self.lifetimes_gpu, self.alive_flags_gpu,
+                self.dead_indices_gpu, self.dead_count_gpu,
+                self.gravity, frame_params,
+            ],
+            device=self.device
+        )
+    
+    def collect_dead_slots(self) -> list:
+        """
+        Release slots whose particles died and return them.
+        
+        Downloads one counter plus only the indices that died, then
+        returns those slots to the device free list.
         
-        for idx in list(self.active_slots):
-            if alive_flags[idx] == 0:
-                dead_slots.append(idx)
-                self.active_slots.remove(idx)
-                self.free_slots.append(idx)
+        Returns:
+            List of slot indices that died since the last launch
+        """
+        if self._free_count == self.max_particles:
+            return []
+        
+        dead_count = int(self.dead_count_gpu.numpy()[0])
+        if dead_count == 0:
+            return []
+        
+        dead_slots = self.dead_indices_gpu[:dead_count].numpy().tolist()
+        self.dead_count_gpu.zero_()
+        
+        wp.launch(
+            kernel=release_dead_slots_kernel,
+            dim=dead_count,
+            inputs=[self.dead_indices_gpu, self.free_list_gpu, self.free_count_gpu],
+            device=self.device
+        )
+        self._free_count += dead_count
+        self.active_slots.difference_update(dead_slots)
         
         return dead_slots
     
     def get_positions(self) -> np.ndarray:
         """
-        Download all particle positions from GPU.
+        Download all particle positions from GPU (single copy).
         
         Returns:
             [max_particles, 3] float array of positions
         """
-        px = self.pos_x_gpu.numpy()
-        py = self.pos_y_gpu.numpy()
-        pz = self.pos_z_gpu.numpy()
-        return np.stack([px, py, pz], axis=-1)
+        return self.positions_gpu.numpy()
     
     def get_active_positions(self) -> dict:
         """
@@ -224,12 +266,13 @@ class PopParticleGPUManager:
         """
         dead_slots = list(self.active_slots)
         
-        # Reset alive flags on GPU
-        alive_flags = np.zeros(self.max_particles, dtype=np.int32)
-        self.alive_flags_gpu = wp.array(alive_flags, dtype=int, device=self.device)
+        # Reset on GPU (in place - keeps captured graphs valid)
+        self.alive_flags_gpu.zero_()
+        self.dead_count_gpu.zero_()
+        self._reset_free_list()
         
         # Reset tracking
-        self.free_slots = list(range(self.max_particles))
+        self._free_count = self.max_particles
         self.active_slots = set()
         
         return dead_slots
@@ -237,9 +280,10 @@ class PopParticleGPUManager:
     def destroy(self):
         """Free GPU resources."""
         arrays = [
-            'pos_x_gpu', 'pos_y_gpu', 'pos_z_gpu',
-            'vel_x_gpu', 'vel_y_gpu', 'vel_z_gpu',
-            'ages_gpu', 'lifetimes_gpu', 'alive_flags_gpu'
+            'positions_gpu', 'velocities_gpu',
+            'ages_gpu', 'lifetimes_gpu', 'alive_flags_gpu',
+            'free_list_gpu', 'free_count_gpu',
+            'dead_indices_gpu', 'dead_count_gpu', 'spawned_slots_gpu',
         ]
         for attr in arrays:
             setattr(self, attr, None)
@@ -3,6 +3,11 @@ Warp GPU Kernel for Pop Particle Physics
 
 Batch-processes all pop particles in parallel on GPU.
 Simple physics: gravity + velocity integration + lifetime tracking.
+
+Slot lifecycle stays on device:
+- spawn_spray_kernel pops slots from a device free-list stack
+- the update kernels append particles that die to a compact dead list
+- release_dead_slots_kernel pushes collected dead slots back on the stack
 """
 
 import warp as wp
@@ -10,97 +15,196 @@ import warp as wp
 wp.init()
 
 
-@wp.kernel
-def update_pop_particles_kernel(
-    # Positions (read/write)
-    pos_x: wp.array(dtype=float),
-    pos_y: wp.array(dtype=float),
-    pos_z: wp.array(dtype=float),
-    
-    # Velocities (read/write)
-    vel_x: wp.array(dtype=float),
-    vel_y: wp.array(dtype=float),
-    vel_z: wp.array(dtype=float),
-    
-    # Lifecycle (read/write)
+@wp.func
+def step_particle(
+    tid: int,
+    positions: wp.array(dtype=wp.vec3),
+    velocities: wp.array(dtype=wp.vec3),
     ages: wp.array(dtype=float),
     lifetimes: wp.array(dtype=float),
-    alive_flags: wp.array(dtype=int),  # 1=alive, 0=dead
-    
-    # Config
+    alive_flags: wp.array(dtype=int),
+    dead_indices: wp.array(dtype=int),
+    dead_count: wp.array(dtype=int),
     dt: float,
     gravity: float,
 ):
     """
-    Update single particle physics.
-    
-    Each thread handles one particle.
-    Dead particles (alive_flags=0) skip processing.
+    Advance one particle by dt.
+
+    Dead particles (alive_flags=0) skip processing. A particle that
+    expires this step is appended to dead_indices.
     """
-    tid = wp.tid()
-    
     # Skip dead particles
     if alive_flags[tid] == 0:
         return
-    
+
     # Update age
     new_age = ages[tid] + dt
     ages[tid] = new_age
-    
-    # Check lifetime - mark dead if expired
+
+    # Check lifetime - mark dead if expired and record for the host
     if new_age >= lifetimes[tid]:
         alive_flags[tid] = 0
+        slot = wp.atomic_add(dead_count, 0, 1)
+        dead_indices[slot] = tid
         return
-    
+
     # Apply gravity to Y velocity
-    vel_y[tid] = vel_y[tid] + gravity * dt
-    
+    vel = velocities[tid]
+    vel = wp.vec3(vel[0], vel[1] + gravity * dt, vel[2])
+    velocities[tid] = vel
+
     # Integrate position
-    pos_x[tid] = pos_x[tid] + vel_x[tid] * dt
-    pos_y[tid] = pos_y[tid] + vel_y[tid] * dt
-    pos_z[tid] = pos_z[tid] + vel_z[tid] * dt
+    positions[tid] = positions[tid] + vel * dt
 
 
 @wp.kernel
-def spawn_particles_kernel(
+def update_pop_particles_kernel(
+    # Motion (read/write)
+    positions: wp.array(dtype=wp.vec3),
+    velocities: wp.array(dtype=wp.vec3),
+
+    # Lifecycle (read/write)
+    ages: wp.array(dtype=float),
+    lifetimes: wp.array(dtype=float),
+    alive_flags: wp.array(dtype=int),  # 1=alive, 0=dead
+
+    # Compacted deaths this frame (dead_count zeroed before launch)
+    dead_indices: wp.array(dtype=int),
+    dead_count: wp.array(dtype=int),
+
+    # Config
+    dt: float,
+    gravity: float,
+):
+    """
+    Update single particle physics.
+
+    Each thread handles one particle.
+    Dead particles (alive_flags=0) skip processing.
+    """
+    tid = wp.tid()
+    step_particle(
+        tid,
+        positions, velocities,
+        ages, lifetimes, alive_flags,
+        dead_indices, dead_count,
+        dt, gravity,
+    )
+
+
+@wp.kernel
+def update_pop_particles_frame_kernel(
+    positions: wp.array(dtype=wp.vec3),
+    velocities: wp.array(dtype=wp.vec3),
+    ages: wp.array(dtype=float),
+    lifetimes: wp.array(dtype=float),
+    alive_flags: wp.array(dtype=int),
+    dead_indices: wp.array(dtype=int),
+    dead_count: wp.array(dtype=int),
+    gravity: float,
+    frame_params: wp.array(dtype=float),  # [0] = dt
+):
+    """
+    Frame-pipeline variant: dt read from a device buffer (graph replay safe).
+    """
+    tid = wp.tid()
+    step_particle(
+        tid,
+        positions, velocities,
+        ages, lifetimes, alive_flags,
+        dead_indices, dead_count,
+        frame_params[0], gravity,
+    )
+
+
+@wp.kernel
+def spawn_spray_kernel(
     # Target arrays
-    pos_x: wp.array(dtype=float),
-    pos_y: wp.array(dtype=float),
-    pos_z: wp.array(dtype=float),
-    vel_x: wp.array(dtype=float),
-    vel_y: wp.array(dtype=float),
-    vel_z: wp.array(dtype=float),
+    positions: wp.array(dtype=wp.vec3),
+    velocities: wp.array(dtype=wp.vec3),
     ages: wp.array(dtype=float),
     lifetimes: wp.array(dtype=float),
     alive_flags: wp.array(dtype=int),
-    
-    # Spawn data (one entry per particle to spawn)
-    spawn_indices: wp.array(dtype=int),
-    spawn_pos_x: wp.array(dtype=float),
-    spawn_pos_y: wp.array(dtype=float),
-    spawn_pos_z: wp.array(dtype=float),
-    spawn_vel_x: wp.array(dtype=float),
-    spawn_vel_y: wp.array(dtype=float),
-    spawn_vel_z: wp.array(dtype=float),
-    spawn_lifetimes: wp.array(dtype=float),
+
+    # Device free-list stack
+    free_list: wp.array(dtype=int),
+    free_count: wp.array(dtype=int),
+
+    # Spray parameters (shared by every particle in this spray)
+    pop_position: wp.vec3,
+    bubble_velocity: wp.vec3,
+    particle_speed: float,
+    spread_radians: float,
+    base_lifetime: float,
+    seed: int,
+
+    # Output: slot claimed by each thread (-1 if the stack ran dry)
+    spawned_slots: wp.array(dtype=int),
 ):
     """
-    Spawn new particles at specified indices.
-    
-    Each thread initializes one particle slot.
+    Claim a free slot and initialize one spray particle.
+
+    Slots are popped with an atomic decrement of free_count. Launch
+    with dim <= free slots; a thread that still finds the stack empty
+    restores the count and reports -1. Spray direction and lifetime
+    (+/- 30%) are randomized on device.
     """
     tid = wp.tid()
-    
-    idx = spawn_indices[tid]
-    
-    pos_x[idx] = spawn_pos_x[tid]
-    pos_y[idx] = spawn_pos_y[tid]
-    pos_z[idx] = spawn_pos_z[tid]
-    
-    vel_x[idx] = spawn_vel_x[tid]
-    vel_y[idx] = spawn_vel_y[tid]
-    vel_z[idx] = spawn_vel_z[tid]
-    
+
+    top = wp.atomic_sub(free_count, 0, 1)
+    if top <= 0:
+        wp.atomic_add(free_count, 0, 1)
+        spawned_slots[tid] = -1
+        return
+
+    idx = free_list[top - 1]
+
+    state = wp.rand_init(seed, tid)
+    angle = wp.randf(state, 0.0, 2.0 * wp.pi)
+    elevation = wp.randf(state, -0.5 * spread_radians, spread_radians)
+    lifetime_scale = wp.randf(state, 0.7, 1.3)
+
+    cos_elev = wp.cos(elevation)
+    spray = wp.vec3(
+        particle_speed * wp.cos(angle) * cos_elev,
+        particle_speed * wp.sin(elevation),
+        particle_speed * wp.sin(angle) * cos_elev,
+    )
+
+    positions[idx] = pop_position
+    velocities[idx] = bubble_velocity + spray
     ages[idx] = 0.0
-    lifetimes[idx] = spawn_lifetimes[tid]
+    lifetimes[idx] = base_lifetime * lifetime_scale
     alive_flags[idx] = 1
+
+    spawned_slots[tid] = idx
+
+
+@wp.kernel
+def release_dead_slots_kernel(
+    dead_indices: wp.array(dtype=int),
+    free_list: wp.array(dtype=int),
+    free_count: wp.array(dtype=int),
+):
+    """
+    Push collected dead slots back onto the free-list stack.
+
+    Runs after the host has consumed the dead list, so a slot is never
+    reused while its visual still exists.
+    """
+    tid = wp.tid()
+    top = wp.atomic_add(free_count, 0, 1)
+    free_list[top] = dead_indices[tid]
+
+
+@wp.kernel
+def reset_free_list_kernel(
+    free_list: wp.array(dtype=int),
+    free_count: wp.array(dtype=int),
+):
+    """Refill the stack with every slot (0..n-1, top = n-1)."""
+    tid = wp.tid()
+    free_list[tid] = tid
+    if tid == 0:
+        free_count[0] = free_list.shape[0]
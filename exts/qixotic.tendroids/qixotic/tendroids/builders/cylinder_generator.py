@@ -2,11 +2,15 @@
 Cylinder mesh generator with flared base support for V2 tendroids
 
 Creates cylinder geometry with configurable flare at the base
-for realistic sea floor attachment.
+for realistic sea floor attachment. Geometry is generated with NumPy
+in bulk so large forests build without per-vertex Python loops.
 """
 
 import math
-from pxr import Gf, UsdGeom, Sdf
+from functools import lru_cache
+
+import numpy as np
+from pxr import UsdGeom, Sdf, Vt
 
 
 class CylinderGenerator:
@@ -17,6 +21,67 @@ class CylinderGenerator:
     giving tendroids a more organic, rooted appearance.
     """
     
+    @staticmethod
+    def create_cylinder_arrays(
+        radius: float,
+        length: float,
+        radial_segments: int = 24,
+        height_segments: int = 48,
+        flare_height_percent: float = 15.0,
+        flare_radius_multiplier: float = 2.0
+    ) -> tuple:
+        """
+        Generate cylinder vertices with flared base as NumPy arrays.
+        
+        Vectorized over all rings - no per-vertex Python work. Vertex
+        order is ring-major (ring h, segment r -> h * radial_segments + r).
+        
+        Args:
+            radius: Base cylinder radius (at non-flared sections)
+            length: Total cylinder height
+            radial_segments: Vertices around circumference
+            height_segments: Vertical divisions
+            flare_height_percent: Height of flare as % of total length
+            flare_radius_multiplier: Max radius at base (multiplier of radius)
+        
+        Returns:
+            Tuple of (points, normals, heights, deform_start_height)
+            - points: [N, 3] float32
+            - normals: [N, 3] float32
+            - heights: [N] float32 Y values per vertex
+            - deform_start_height: Y where flare ends (deformation can begin)
+        """
+        flare_height = length * (flare_height_percent / 100.0)
+        max_flare_radius = radius * flare_radius_multiplier
+        
+        ring_y = (np.arange(height_segments + 1, dtype=np.float64) / height_segments) * length
+        
+        # Smooth flare using cosine interpolation below flare_height
+        ring_radius = np.full(ring_y.shape, radius, dtype=np.float64)
+        if flare_height > 0.0:
+            in_flare = ring_y < flare_height
+            t = ring_y[in_flare] / flare_height
+            flare_factor = 0.5 * (1.0 - np.cos(t * math.pi))
+            ring_radius[in_flare] = max_flare_radius + (radius - max_flare_radius) * flare_factor
+        
+        angles = (np.arange(radial_segments, dtype=np.float64) / radial_segments) * 2.0 * math.pi
+        cos_a = np.cos(angles)
+        sin_a = np.sin(angles)
+        
+        n = (height_segments + 1) * radial_segments
+        points = np.empty((n, 3), dtype=np.float32)
+        points[:, 0] = np.outer(ring_radius, cos_a).reshape(-1)
+        points[:, 1] = np.repeat(ring_y, radial_segments)
+        points[:, 2] = np.outer(ring_radius, sin_a).reshape(-1)
+        
+        normals = np.zeros((n, 3), dtype=np.float32)
+        normals[:, 0] = np.tile(cos_a, height_segments + 1)
+        normals[:, 2] = np.tile(sin_a, height_segments + 1)
+        
+        heights = points[:, 1].copy()
+        
+        return points, normals, heights, flare_height
+    
     @staticmethod
     def create_cylinder_points(
         radius: float,
@@ -39,45 +104,37 @@ class CylinderGenerator:
         
         Returns:
             Tuple of (points, normals, heights, deform_start_height)
-            - points: List of Gf.Vec3f vertices
-            - normals: List of Gf.Vec3f normals
+            - points: Vt.Vec3fArray of vertices
+            - normals: Vt.Vec3fArray of normals
             - heights: List of Y values per vertex
             - deform_start_height: Y where flare ends (deformation can begin)
         """
-        points = []
-        normals = []
-        heights = []
+        points, normals, heights, deform_start = CylinderGenerator.create_cylinder_arrays(
+            radius, length, radial_segments, height_segments,
+            flare_height_percent, flare_radius_multiplier
+        )
+        return (
+            Vt.Vec3fArray.FromNumpy(points),
+            Vt.Vec3fArray.FromNumpy(normals),
+            heights.tolist(),
+            deform_start,
+        )
+    
+    @staticmethod
+    def create_face_arrays(
+        radial_segments: int,
+        height_segments: int
+    ) -> tuple:
+        """
+        Generate cylinder face counts and indices as NumPy arrays.
         
-        flare_height = length * (flare_height_percent / 100.0)
-        max_flare_radius = radius * flare_radius_multiplier
+        Topology depends only on the segment counts, so results are
+        cached and shared by every tendroid; treat them as read-only.
         
-        for h in range(height_segments + 1):
-            y = (h / height_segments) * length
-            
-            # Calculate radius at this height (flared at base)
-            if y < flare_height:
-                # Smooth flare using cosine interpolation
-                t = y / flare_height
-                flare_factor = 0.5 * (1.0 - math.cos(t * math.pi))
-                current_radius = max_flare_radius + (radius - max_flare_radius) * flare_factor
-            else:
-                current_radius = radius
-            
-            for r in range(radial_segments):
-                angle = (r / radial_segments) * 2.0 * math.pi
-                cos_a = math.cos(angle)
-                sin_a = math.sin(angle)
-                
-                x = current_radius * cos_a
-                z = current_radius * sin_a
-                
-                points.append(Gf.Vec3f(x, y, z))
-                normals.append(Gf.Vec3f(cos_a, 0.0, sin_a))
-                heights.append(y)
-        
-        deform_start_height = flare_height
-        
-        return points, normals, heights, deform_start_height
+        Returns:
+            Tuple of (face_vertex_counts, face_vertex_indices) int32 arrays
+        """
+        return _cylinder_faces(radial_segments, height_segments)
     
     @staticmethod
     def create_face_indices(
@@ -94,21 +151,8 @@ class CylinderGenerator:
         Returns:
             Tuple of (face_vertex_counts, face_vertex_indices)
         """
-        face_vertex_counts = []
-        face_vertex_indices = []
-        
-        for h in range(height_segments):
-            for r in range(radial_segments):
-                v0 = h * radial_segments + r
-                v1 = h * radial_segments + ((r + 1) % radial_segments)
-                v2 = (h + 1) * radial_segments + ((r + 1) % radial_segments)
-                v3 = (h + 1) * radial_segments + r
-                
-                # Two triangles per quad
-                face_vertex_counts.extend([3, 3])
-                face_vertex_indices.extend([v0, v2, v1, v0, v3, v2])
-        
-        return face_vertex_counts, face_vertex_indices
+        counts, indices = _cylinder_faces(radial_segments, height_segments)
+        return counts.tolist(), indices.tolist()
     
     @staticmethod
     def create_mesh(
@@ -136,9 +180,10 @@ class CylinderGenerator:
         
         Returns:
             Tuple of (mesh_prim, points, deform_start_height)
+            points is the [N, 3] float32 vertex array
         """
         # Generate geometry
-        points, normals, heights, deform_start = CylinderGenerator.create_cylinder_points(
+        points, normals, heights, deform_start = CylinderGenerator.create_cylinder_arrays(
             radius=radius,
             length=length,
             radial_segments=radial_segments,
@@ -147,24 +192,48 @@ class CylinderGenerator:
             flare_radius_multiplier=flare_radius_multiplier
         )
         
-        face_counts, face_indices = CylinderGenerator.create_face_indices(
+        face_counts, face_indices = CylinderGenerator.create_face_arrays(
             radial_segments=radial_segments,
             height_segments=height_segments
         )
         
-        # Create USD mesh
+        mesh_prim = CylinderGenerator.define_mesh(
+            stage, path, points, normals, face_counts, face_indices
+        )
+        return mesh_prim, points, deform_start
+    
+    @staticmethod
+    def define_mesh(stage, path: str, points, normals, face_counts, face_indices):
+        """
+        Define a deformable USD mesh from prebuilt arrays.
+        
+        Shared by create_mesh and the scene cache load path.
+        
+        Args:
+            stage: USD stage
+            path: Prim path for mesh
+            points: [N, 3] float32 vertices
+            normals: [N, 3] float32 vertex normals
+            face_counts: int32 vertex count per face
+            face_indices: int32 face vertex indices
+        
+        Returns:
+            UsdGeom.Mesh
+        """
+        # Create USD mesh (bulk array conversion, no per-vertex Gf objects)
         mesh_prim = UsdGeom.Mesh.Define(stage, path)
-        mesh_prim.CreatePointsAttr(points)
-        mesh_prim.CreateNormalsAttr(normals)
+        mesh_prim.CreatePointsAttr(Vt.Vec3fArray.FromNumpy(points))
+        mesh_prim.CreateNormalsAttr(Vt.Vec3fArray.FromNumpy(normals))
         mesh_prim.SetNormalsInterpolation(UsdGeom.Tokens.vertex)
-        mesh_prim.CreateFaceVertexCountsAttr(face_counts)
-        mesh_prim.CreateFaceVertexIndicesAttr(face_indices)
+        mesh_prim.CreateFaceVertexCountsAttr(Vt.IntArray.FromNumpy(face_counts))
+        mesh_prim.CreateFaceVertexIndicesAttr(Vt.IntArray.FromNumpy(face_indices))
         mesh_prim.CreateSubdivisionSchemeAttr("none")
         mesh_prim.CreateDoubleSidedAttr(True)
         
-        # Compute and set extent
-        extent = UsdGeom.PointBased(mesh_prim).ComputeExtent(points)
-        mesh_prim.CreateExtentAttr(extent)
+        # Extent straight from the array bounds
+        mesh_prim.CreateExtentAttr(Vt.Vec3fArray.FromNumpy(
+            np.stack([points.min(axis=0), points.max(axis=0)])
+        ))
         
         # Add "Deformable" tag for Fabric GPU rendering
         # This tells OmniHydra to render points directly from Fabric
@@ -173,4 +242,23 @@ class CylinderGenerator:
         if not prim.HasAttribute("Deformable"):
             prim.CreateAttribute("Deformable", Sdf.ValueTypeNames.Token, True)
         
-        return mesh_prim, points, deform_start
+        return mesh_prim
+
+
+@lru_cache(maxsize=8)
+def _cylinder_faces(radial_segments: int, height_segments: int) -> tuple:
+    """Two triangles per quad, same winding as the original ring loop."""
+    h = np.arange(height_segments, dtype=np.int32)[:, None]
+    r = np.arange(radial_segments, dtype=np.int32)[None, :]
+    r_next = (r + 1) % radial_segments
+    
+    v0 = h * radial_segments + r
+    v1 = h * radial_segments + r_next
+    v2 = (h + 1) * radial_segments + r_next
+    v3 = (h + 1) * radial_segments + r
+    
+    indices = np.stack([v0, v2, v1, v0, v3, v2], axis=-1).reshape(-1).astype(np.int32)
+    counts = np.full(indices.size // 3, 3, dtype=np.int32)
+    indices.setflags(write=False)
+    counts.setflags(write=False)
+    return counts, indices
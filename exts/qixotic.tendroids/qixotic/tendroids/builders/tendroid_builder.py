@@ -5,13 +5,19 @@ Handles USD geometry creation, terrain conforming, and Warp deformer initializat
 """
 
 import carb
-from pxr import Gf, UsdGeom
+import numpy as np
+from pxr import Gf, UsdGeom, Vt
 
 from .cylinder_generator import CylinderGenerator
 from .terrain_conform import conform_base_to_terrain
 from ..config import get_config_value
 from ..utils import apply_material
 
+# LOD variant resolution: segments halve per level, down to these floors
+LOD_SEGMENT_SCALE = 0.5
+MIN_LOD_RADIAL_SEGMENTS = 6
+MIN_LOD_HEIGHT_SEGMENTS = 4
+
 
 class V2TendroidBuilder:
   """
@@ -35,7 +41,8 @@ class V2TendroidBuilder:
     max_amplitude: float = 0.8,
     bulge_width: float = 0.9,
     parent_path: str = "/World/Tendroids",
-    get_height_fn=None
+    get_height_fn=None,
+    get_heights_fn=None
   ) -> dict | None:
     """
     Create a complete V2 tendroid with all features.
@@ -54,6 +61,8 @@ class V2TendroidBuilder:
         bulge_width: Deformation bulge width
         parent_path: USD parent path
         get_height_fn: Terrain height query function
+        get_heights_fn: Batched terrain query (xs, zs) -> heights;
+          used instead of get_height_fn when given
 
     Returns:
         Dict with tendroid data:
@@ -65,9 +74,11 @@ class V2TendroidBuilder:
             'mesh_prim': UsdGeom.Mesh,
             'mesh_path': str,
             'base_path': str,
-            'base_points': list,
+            'base_points': np.ndarray [N, 3] float32,
             'deform_start_height': float,
             'flare_height': float,
+            'flare_height_percent': float,
+            'flare_radius_multiplier': float,
             'radial_segments': int,
             'height_segments': int,
         }
@@ -85,7 +96,10 @@ class V2TendroidBuilder:
         )
 
       # Adjust Y position to terrain if height function provided
-      if get_height_fn:
+      if get_heights_fn:
+        floor_height = float(get_heights_fn([position[0]], [position[2]])[0])
+        position = (position[0], floor_height, position[2])
+      elif get_height_fn:
         floor_height = get_height_fn(position[0], position[2])
         position = (position[0], floor_height, position[2])
 
@@ -112,16 +126,17 @@ class V2TendroidBuilder:
       flare_height = length * (flare_height_percent / 100.0)
 
       # Conform base to terrain if height function provided
-      if get_height_fn:
+      if get_heights_fn or get_height_fn:
         conformed_points = conform_base_to_terrain(
           vertices=points,
           base_position=position,
           flare_height=flare_height,
           radial_segments=radial_segments,
           height_segments=height_segments,
-          get_height_fn=get_height_fn
+          get_height_fn=get_height_fn,
+          get_heights_fn=get_heights_fn
         )
-        mesh_prim.GetPointsAttr().Set(conformed_points)
+        mesh_prim.GetPointsAttr().Set(Vt.Vec3fArray.FromNumpy(conformed_points))
         points = conformed_points
 
       # Apply material
@@ -143,6 +158,8 @@ class V2TendroidBuilder:
         'base_points': points,
         'deform_start_height': deform_start,
         'flare_height': flare_height,
+        'flare_height_percent': flare_height_percent,
+        'flare_radius_multiplier': flare_radius_multiplier,
         'radial_segments': radial_segments,
         'height_segments': height_segments,
         'max_amplitude': max_amplitude,
@@ -155,6 +172,150 @@ class V2TendroidBuilder:
       traceback.print_exc()
       return None
 
+  @staticmethod
+  def lod_segments(radial_segments: int, height_segments: int, level: int) -> tuple:
+    """(radial, height) segments of LOD level (0 = full resolution)."""
+    scale = LOD_SEGMENT_SCALE ** level
+    return (
+      max(int(radial_segments * scale), min(MIN_LOD_RADIAL_SEGMENTS, radial_segments)),
+      max(int(height_segments * scale), min(MIN_LOD_HEIGHT_SEGMENTS, height_segments)),
+    )
+
+  @staticmethod
+  def create_lod_variant(
+    stage,
+    data: dict,
+    level: int,
+    get_height_fn=None,
+    get_heights_fn=None
+  ) -> dict | None:
+    """
+    Create a reduced-segment mesh of a built tendroid for LOD level.
+
+    The mesh is a sibling of the tendroid's mesh under its base Xform
+    (removed with it), conformed to the same terrain and created
+    invisible; BatchWarpDeformer.add_lod_variant shows it when its
+    level is culled in.
+
+    Args:
+        stage: USD stage
+        data: create_tendroid() result of the full-resolution tendroid
+        level: LOD level (1 = first reduced level)
+        get_height_fn: Terrain height query function
+        get_heights_fn: Batched terrain query (xs, zs) -> heights
+
+    Returns:
+        Same dict as create_tendroid() for the variant (name
+        '<name>_lod<level>', plus 'lod_of' and 'lod_level'), or None
+        if creation failed
+    """
+    name = f"{data['name']}_lod{level}"
+    try:
+      radial_segments, height_segments = V2TendroidBuilder.lod_segments(
+        data['radial_segments'], data['height_segments'], level
+      )
+      mesh_path = f"{data['base_path']}/lod{level}"
+      mesh_prim, points, deform_start = CylinderGenerator.create_mesh(
+        stage=stage,
+        path=mesh_path,
+        radius=data['radius'],
+        length=data['length'],
+        radial_segments=radial_segments,
+        height_segments=height_segments,
+        flare_height_percent=data['flare_height_percent'],
+        flare_radius_multiplier=data['flare_radius_multiplier']
+      )
+
+      if get_heights_fn or get_height_fn:
+        points = conform_base_to_terrain(
+          vertices=points,
+          base_position=data['position'],
+          flare_height=data['flare_height'],
+          radial_segments=radial_segments,
+          height_segments=height_segments,
+          get_height_fn=get_height_fn,
+          get_heights_fn=get_heights_fn
+        )
+        mesh_prim.GetPointsAttr().Set(Vt.Vec3fArray.FromNumpy(points))
+
+      apply_material(stage, mesh_prim)
+      UsdGeom.Imageable(mesh_prim).MakeInvisible()
+
+      variant = dict(data)
+      variant.update({
+        'name': name,
+        'mesh_prim': mesh_prim,
+        'mesh_path': mesh_path,
+        'base_points': points,
+        'deform_start_height': deform_start,
+        'radial_segments': radial_segments,
+        'height_segments': height_segments,
+        'lod_of': data['name'],
+        'lod_level': level,
+      })
+      variant.pop('height_factors', None)
+      return variant
+
+    except Exception as e:
+      carb.log_error(f"[V2TendroidBuilder] Failed to create LOD variant '{name}': {e}")
+      return None
+
+  @staticmethod
+  def create_tendroid_from_arrays(
+    stage,
+    params: dict,
+    points,
+    normals,
+    face_indices,
+    parent_path: str = "/World/Tendroids"
+  ) -> dict | None:
+    """
+    Recreate a tendroid from cached geometry (see SceneCache).
+
+    Skips cylinder generation and terrain conforming; points are the
+    already-conformed rest pose.
+
+    Args:
+        stage: USD stage
+        params: Scalar fields of a create_tendroid() result (name,
+          position, radius, length, segments, flare, amplitude, ...)
+        points: [N, 3] float32 rest vertices
+        normals: [N, 3] float32 vertex normals
+        face_indices: int32 triangle vertex indices
+        parent_path: USD parent path
+
+    Returns:
+        Same dict as create_tendroid(), or None if creation failed
+    """
+    name = params['name']
+    try:
+      position = tuple(params['position'])
+      base_path = f"{parent_path}/{name}"
+      base_xform = UsdGeom.Xform.Define(stage, base_path)
+      base_xform.ClearXformOpOrder()
+      base_xform.AddTranslateOp().Set(Gf.Vec3d(*position))
+
+      mesh_path = f"{base_path}/mesh"
+      face_counts = np.full(len(face_indices) // 3, 3, dtype=np.int32)
+      mesh_prim = CylinderGenerator.define_mesh(
+        stage, mesh_path, points, normals, face_counts, face_indices
+      )
+      apply_material(stage, mesh_prim)
+
+      data = dict(params)
+      data.update({
+        'position': position,
+        'mesh_prim': mesh_prim,
+        'mesh_path': mesh_path,
+        'base_path': base_path,
+        'base_points': points,
+      })
+      return data
+
+    except Exception as e:
+      carb.log_error(f"[V2TendroidBuilder] Failed to restore '{name}': {e}")
+      return None
+
   @staticmethod
   def destroy_tendroid(stage, base_path: str):
     """
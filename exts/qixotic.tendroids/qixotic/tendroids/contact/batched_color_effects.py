@@ -0,0 +1,332 @@
+"""
+Batched Color Effects - Shock / recovery colors for many meshes at once
+
+Batched alternative to ColorEffectController. Every mesh shares one
+material that shades by the displayColor primvar, so no per-instance
+material or shader write is needed. One update_color_effects_kernel
+launch advances all instances, and the colors reach the meshes through
+a single Fabric write (USD primvar writes only as a fallback).
+
+State codes and fade math mirror color_effect_helpers and
+color_fade_helpers, which remain the reference.
+"""
+
+import carb
+import numpy as np
+import warp as wp
+
+from .color_effect_helpers import ColorConfig, ColorEffectStatus
+from .color_fade_helpers import FadeConfig, FadeMode
+from .color_effect_kernel import (
+    EASING_CODES,
+    FADE_MODE_CODES,
+    STATE_CODES,
+    STATE_FROM_CODE,
+    update_color_effects_kernel,
+    write_display_color_kernel,
+)
+
+wp.init()
+
+
+class BatchedColorEffects:
+    """
+    Per-instance shock colors driven by one kernel.
+
+    Usage:
+        effects = BatchedColorEffects(count=len(tendroids))
+        effects.bind_meshes(stage, [t.mesh_prim for t in tendroids])
+
+        effects.trigger_shock([3, 7])     # on contact
+        effects.update(dt, distances)     # each frame
+        effects.write_to_fabric(stage_id) # or write_to_usd()
+    """
+
+    def __init__(
+        self,
+        count: int,
+        config: ColorConfig = None,
+        fade_config: FadeConfig = None,
+        easing: str = "linear",
+        device: str = "cuda:0",
+    ):
+        """
+        Initialize batched color effects.
+
+        Args:
+            count: Number of instances
+            config: Color configuration shared by all instances
+            fade_config: Fade behavior shared by all instances
+            easing: apply_easing() name applied to the fade progress
+            device: Warp device
+        """
+        self.count = int(count)
+        self.device = device
+        self._config = config or ColorConfig()
+        self._fade_config = fade_config or FadeConfig()
+        self._easing = EASING_CODES.get(easing, EASING_CODES["linear"])
+
+        n = max(self.count, 1)
+        self._states = wp.zeros(n, dtype=int, device=device)
+        self._progress = wp.zeros(n, dtype=float, device=device)
+        self._recovery_time = wp.zeros(n, dtype=float, device=device)
+        self._shock_counts = wp.zeros(n, dtype=int, device=device)
+        self._colors = wp.full(n, wp.vec3(*self._config.normal_color), dtype=wp.vec3, device=device)
+
+        # Shock requests are gathered on the host and uploaded with the next update
+        self._shock_requests = wp.zeros(n, dtype=int, device=device)
+        self._pending_host = np.zeros(n, dtype=np.int32)
+        self._has_pending = False
+
+        # Placeholders for modes that don't read distances / speeds
+        self._zeros = wp.zeros(n, dtype=float, device=device)
+
+        # Mesh targets
+        self._mesh_paths = []
+        self._mesh_prims = []
+        self._fabric_tagged_stage_id = None
+        self._usd_colors = None
+
+    @property
+    def fade_mode(self) -> FadeMode:
+        """Get current fade mode."""
+        return self._fade_config.mode
+
+    def set_fade_mode(self, mode: FadeMode) -> None:
+        """Set fade mode for all instances."""
+        self._fade_config.mode = mode
+
+    def set_easing(self, easing: str) -> None:
+        """Set the easing applied to fade progress."""
+        self._easing = EASING_CODES.get(easing, EASING_CODES["linear"])
+
+    @property
+    def colors_gpu(self):
+        """Per-instance color (device)."""
+        return self._colors
+
+    @property
+    def states_gpu(self):
+        """Per-instance ColorEffectState code (device; 0 = NORMAL, 1 = SHOCKED, 2 = RECOVERING)."""
+        return self._states
+
+    def bind_meshes(self, stage, mesh_prims: list) -> int:
+        """
+        Bind the shared displayColor material and author each mesh's primvar.
+
+        Args:
+            stage: USD stage
+            mesh_prims: Mesh prims by instance index (None entries skipped)
+
+        Returns:
+            Number of meshes bound
+        """
+        from pxr import Gf, UsdGeom
+        from ..utils import apply_display_color_material
+
+        normal = Gf.Vec3f(*self._config.normal_color)
+        self._mesh_prims = list(mesh_prims[:self.count])
+        self._mesh_paths = []
+        bound = 0
+        for prim in self._mesh_prims:
+            if prim is None or not prim.IsValid():
+                self._mesh_paths.append(None)
+                continue
+
+            apply_display_color_material(stage, prim)
+            primvar = UsdGeom.Mesh(prim).CreateDisplayColorPrimvar(UsdGeom.Tokens.constant)
+            primvar.Set([normal])
+            self._mesh_paths.append(str(prim.GetPath()))
+            bound += 1
+
+        self._fabric_tagged_stage_id = None
+        self._usd_colors = None
+        carb.log_info(f"[BatchedColorEffects] Bound {bound} meshes")
+        return bound
+
+    def trigger_shock(self, indices) -> None:
+        """
+        Flag instances for a shock on the next update (on_contact).
+
+        Args:
+            indices: Instance indices that made contact
+        """
+        indices = np.asarray(indices, dtype=np.int64).reshape(-1)
+        indices = indices[(indices >= 0) & (indices < self.count)]
+        if indices.size == 0:
+            return
+        self._pending_host[indices] = 1
+        self._has_pending = True
+
+    def _device_array(self, values):
+        if values is None:
+            return self._zeros
+        if isinstance(values, wp.array):
+            return values
+        return wp.array(np.asarray(values, dtype=np.float32), dtype=float, device=self.device)
+
+    def update(self, dt: float, distances=None, speeds=None) -> None:
+        """
+        Advance every instance one frame.
+
+        Args:
+            dt: Frame time (drives the TIME fade mode)
+            distances: Per-instance distance to the creature (host
+                sequence or device wp.array); needed for shock exit
+                and the DISTANCE mode
+            speeds: Per-instance repel speed for the SPEED mode
+        """
+        if self.count == 0:
+            return
+
+        if self._has_pending:
+            self._shock_requests.assign(self._pending_host)
+            self._pending_host[:] = 0
+            self._has_pending = False
+
+        config = self._config
+        fade = self._fade_config
+        wp.launch(
+            kernel=update_color_effects_kernel,
+            dim=self.count,
+            inputs=[
+                self._shock_requests,
+                self._device_array(distances),
+                self._device_array(speeds),
+                float(dt),
+                FADE_MODE_CODES.get(fade.mode, FADE_MODE_CODES[FadeMode.DISTANCE]),
+                self._easing,
+                config.approach_minimum,
+                fade.fade_start_distance,
+                fade.fade_end_distance,
+                fade.max_speed,
+                fade.min_speed,
+                fade.fade_duration,
+                wp.vec3(*config.normal_color),
+                wp.vec3(*config.shock_color),
+                self._states,
+                self._progress,
+                self._recovery_time,
+                self._shock_counts,
+                self._colors,
+            ],
+            device=self.device
+        )
+
+    def reset(self) -> None:
+        """Reset every instance to normal color immediately."""
+        normal = np.array(self._config.normal_color, dtype=np.float32)
+        self._states.zero_()
+        self._progress.fill_(1.0)
+        self._recovery_time.zero_()
+        self._shock_requests.zero_()
+        self._colors.assign(np.tile(normal, (max(self.count, 1), 1)))
+        self._pending_host[:] = 0
+        self._has_pending = False
+
+    def status(self, index: int) -> ColorEffectStatus:
+        """
+        Download one instance's status (debugging / tests).
+
+        Args:
+            index: Instance index
+        """
+        return ColorEffectStatus(
+            state=STATE_FROM_CODE[int(self._states.numpy()[index])],
+            current_color=tuple(float(c) for c in self._colors.numpy()[index]),
+            shock_count=int(self._shock_counts.numpy()[index]),
+            recovery_progress=float(self._progress.numpy()[index]),
+        )
+
+    def count_in_state(self, state) -> int:
+        """Number of instances in a ColorEffectState."""
+        return int(np.count_nonzero(self._states.numpy()[:self.count] == STATE_CODES[state]))
+
+    # =========================================================================
+    # Output
+    # =========================================================================
+
+    def write_to_fabric(self, stage_id) -> bool:
+        """
+        Copy colors into the tagged meshes' Fabric displayColor.
+
+        Args:
+            stage_id: USD stage ID for the USDRT attachment
+
+        Returns:
+            True if written, False if Fabric is unavailable (use write_to_usd)
+        """
+        if self.count == 0:
+            return True
+
+        from ..utils import FabricHelper
+
+        try:
+            usdrt_stage = FabricHelper.get_usdrt_stage(stage_id)
+            if self._fabric_tagged_stage_id != stage_id:
+                for i, path in enumerate(self._mesh_paths):
+                    if path:
+                        FabricHelper.tag_color_index(usdrt_stage, path, i)
+                self._fabric_tagged_stage_id = stage_id
+
+            # Buffers can move between frames - re-select every time
+            selection = FabricHelper.select_color_meshes(usdrt_stage, self.device)
+            if selection is None:
+                return False
+
+            fabric_colors = wp.fabricarrayarray(selection, "primvars:displayColor", dtype=wp.vec3)
+            fabric_index = wp.fabricarray(selection, FabricHelper.COLOR_INDEX_ATTR)
+        except Exception as e:
+            carb.log_warn(f"[BatchedColorEffects] Fabric write unavailable: {e}")
+            self._fabric_tagged_stage_id = None
+            return False
+
+        wp.launch(
+            kernel=write_display_color_kernel,
+            dim=fabric_index.size,
+            inputs=[fabric_index, self._colors, fabric_colors],
+            device=self.device
+        )
+        return True
+
+    def write_to_usd(self) -> int:
+        """
+        Fallback: author displayColor for instances whose color changed.
+
+        Returns:
+            Number of primvars written
+        """
+        if not self._mesh_prims:
+            return 0
+
+        from pxr import Gf, UsdGeom
+
+        colors = self._colors.numpy()[:len(self._mesh_prims)]
+        if self._usd_colors is None:
+            changed = np.ones(len(colors), dtype=bool)
+        else:
+            changed = np.any(colors != self._usd_colors, axis=1)
+        self._usd_colors = colors.copy()
+
+        written = 0
+        for i in np.flatnonzero(changed):
+            prim = self._mesh_prims[i]
+            if prim is None or not prim.IsValid():
+                continue
+            r, g, b = colors[i]
+            UsdGeom.Mesh(prim).GetDisplayColorPrimvar().Set([Gf.Vec3f(float(r), float(g), float(b))])
+            written += 1
+        return written
+
+    def destroy(self) -> None:
+        """Release device resources and mesh references."""
+        self._mesh_prims = []
+        self._mesh_paths = []
+        self._states = None
+        self._progress = None
+        self._recovery_time = None
+        self._shock_counts = None
+        self._colors = None
+        self._shock_requests = None
+        self._zeros = None
+        self.count = 0
@@ -0,0 +1,194 @@
+"""
+Color Effect Kernels - Batched shock / recovery colors on GPU
+
+Warp port of the color_effect_helpers state machine and the
+color_fade_helpers fade modes, run for every instance in one launch.
+The Python helpers stay the reference implementation for unit tests.
+
+Per-instance state lives in flat arrays (state, progress, recovery
+time, shock count, color); the color array is copied into each mesh's
+constant displayColor primvar through Fabric.
+"""
+
+import warp as wp
+
+from .color_effect_helpers import ColorEffectState
+from .color_fade_helpers import FadeMode
+
+wp.init()
+
+# ColorEffectState codes
+STATE_NORMAL = wp.constant(0)
+STATE_SHOCKED = wp.constant(1)
+STATE_RECOVERING = wp.constant(2)
+
+# FadeMode codes
+FADE_DISTANCE = wp.constant(0)
+FADE_SPEED = wp.constant(1)
+FADE_TIME = wp.constant(2)
+
+# apply_easing() names
+EASE_LINEAR = wp.constant(0)
+EASE_IN = wp.constant(1)
+EASE_OUT = wp.constant(2)
+EASE_IN_OUT = wp.constant(3)
+
+STATE_CODES = {
+    ColorEffectState.NORMAL: 0,
+    ColorEffectState.SHOCKED: 1,
+    ColorEffectState.RECOVERING: 2,
+}
+STATE_FROM_CODE = {code: state for state, code in STATE_CODES.items()}
+
+FADE_MODE_CODES = {
+    FadeMode.DISTANCE: 0,
+    FadeMode.SPEED: 1,
+    FadeMode.TIME: 2,
+}
+
+EASING_CODES = {
+    "linear": 0,
+    "ease_in": 1,
+    "ease_out": 2,
+    "ease_in_out": 3,
+}
+
+
+@wp.func
+def distance_fade(distance: float, start: float, end: float):
+    """calculate_distance_fade()"""
+    if distance <= start:
+        return 0.0
+    if distance >= end:
+        return 1.0
+    return (distance - start) / (end - start)
+
+
+@wp.func
+def speed_fade(speed: float, max_speed: float, min_speed: float):
+    """calculate_speed_fade()"""
+    if speed >= max_speed:
+        return 0.0
+    if speed <= min_speed:
+        return 1.0
+    return 1.0 - (speed - min_speed) / (max_speed - min_speed)
+
+
+@wp.func
+def time_fade(elapsed: float, duration: float):
+    """calculate_time_fade()"""
+    if elapsed <= 0.0:
+        return 0.0
+    if elapsed >= duration:
+        return 1.0
+    return elapsed / duration
+
+
+@wp.func
+def apply_easing_wp(progress: float, easing: int):
+    """apply_easing() with the easing name as an EASE_* code."""
+    p = wp.clamp(progress, 0.0, 1.0)
+    if easing == EASE_IN:
+        return p * p
+    if easing == EASE_OUT:
+        return 1.0 - (1.0 - p) * (1.0 - p)
+    if easing == EASE_IN_OUT:
+        if p < 0.5:
+            return 2.0 * p * p
+        return 1.0 - 2.0 * (1.0 - p) * (1.0 - p)
+    return p
+
+
+@wp.kernel
+def update_color_effects_kernel(
+    # Per-instance inputs
+    shock_requests: wp.array(dtype=int),
+    distances: wp.array(dtype=float),
+    speeds: wp.array(dtype=float),
+    dt: float,
+
+    # ColorConfig / FadeConfig
+    fade_mode: int,
+    easing: int,
+    approach_minimum: float,
+    fade_start_distance: float,
+    fade_end_distance: float,
+    max_speed: float,
+    min_speed: float,
+    fade_duration: float,
+    normal_color: wp.vec3,
+    shock_color: wp.vec3,
+
+    # Per-instance state (read / write)
+    states: wp.array(dtype=int),
+    progress: wp.array(dtype=float),
+    recovery_time: wp.array(dtype=float),
+    shock_counts: wp.array(dtype=int),
+    colors: wp.array(dtype=wp.vec3),
+):
+    """
+    trigger_shock / check_shock_exit / update_recovery for each instance.
+
+    Equivalent to ColorEffectController.on_contact() (when a shock is
+    requested) followed by update(distance, speed, recovery_time).
+    Time fade measures recovery_time, advanced by dt per launch once
+    recovery has started.
+    """
+    i = wp.tid()
+
+    state = states[i]
+    if shock_requests[i] != 0:
+        shock_requests[i] = 0
+        state = STATE_SHOCKED
+        shock_counts[i] = shock_counts[i] + 1
+        progress[i] = 0.0
+        colors[i] = shock_color
+
+    if state == STATE_NORMAL:
+        return
+
+    distance = distances[i]
+    elapsed = recovery_time[i] + dt
+    if state == STATE_SHOCKED:
+        if distance >= approach_minimum:
+            state = STATE_RECOVERING
+            progress[i] = 0.0
+            elapsed = 0.0
+        else:
+            states[i] = state
+            return
+
+    fade = float(1.0)
+    if fade_mode == FADE_DISTANCE:
+        fade = distance_fade(distance, fade_start_distance, fade_end_distance)
+    elif fade_mode == FADE_SPEED:
+        fade = speed_fade(speeds[i], max_speed, min_speed)
+    elif fade_mode == FADE_TIME:
+        fade = time_fade(elapsed, fade_duration)
+    fade = apply_easing_wp(fade, easing)
+
+    recovery_time[i] = elapsed
+    if fade >= 1.0:
+        states[i] = STATE_NORMAL
+        progress[i] = 1.0
+        colors[i] = normal_color
+        return
+
+    states[i] = STATE_RECOVERING
+    progress[i] = fade
+    colors[i] = shock_color + (normal_color - shock_color) * fade
+
+
+@wp.kernel
+def write_display_color_kernel(
+    fabric_color_index: wp.fabricarray(dtype=int),
+    colors: wp.array(dtype=wp.vec3),
+    fabric_display_color: wp.fabricarrayarray(dtype=wp.vec3),
+):
+    """Copy each selected mesh's color into its constant displayColor."""
+    i = wp.tid()
+
+    t = fabric_color_index[i]
+    if t < 0 or t >= colors.shape[0]:
+        return
+    fabric_display_color[i][0] = colors[t]
@@ -7,6 +7,10 @@ filtered creature-tendroid contact events to registered listeners.
 Implements TEND-24: Subscribe to PhysX contact events.
 Implements TEND-91: Create contact_handler.py controller module.
 Implements TEND-92: Implement PhysX contact subscription setup.
+
+Dense contact: register colliders with a ContactIdTable and reports are
+classified by integer ID per header and reduced to one event per
+touching (creature, tendroid) pair (see contact_id_table).
 """
 
 from dataclasses import dataclass
@@ -39,6 +43,7 @@ class ContactEvent:
     surface_normal: Tuple[float, float, float]  # Points away from tendroid
     impulse: float
     separation: float
+    contact_count: int = 1  # Contact points merged into this event
     
     @classmethod
     def from_contact_info(cls, info: ContactInfo) -> 'ContactEvent':
@@ -92,6 +97,8 @@ class ContactHandler:
         self._subscription = None
         self._state = ContactHandlerState.UNINITIALIZED
         self._contact_count = 0
+        self._id_table = None
+        self._last_records = None
     
     @property
     def state(self) -> ContactHandlerState:
@@ -108,6 +115,27 @@ class ContactHandler:
         """Total creature-tendroid contacts processed."""
         return self._contact_count
     
+    @property
+    def id_table(self):
+        """Registered ContactIdTable (None: path-pattern filtering)."""
+        return self._id_table
+    
+    @property
+    def last_records(self):
+        """ContactRecords of the most recent ID-table report (bulk consumers)."""
+        return self._last_records
+    
+    def set_id_table(self, id_table) -> None:
+        """
+        Classify contacts by integer collider ID instead of path patterns.
+        
+        Args:
+            id_table: ContactIdTable with creature and tendroid colliders
+                registered (None restores path-pattern filtering)
+        """
+        self._id_table = id_table
+        self._last_records = None
+    
     def add_listener(self, listener: ContactListener) -> None:
         """
         Register a callback for contact events.
@@ -179,6 +207,10 @@ class ContactHandler:
             contact_headers: PhysX contact headers array
             contact_data: PhysX contact data array
         """
+        if self._id_table is not None and len(self._id_table):
+            self._process_id_report(contact_headers, contact_data)
+            return
+        
         for header in contact_headers:
             actor0_path = str(header.actor0)
             actor1_path = str(header.actor1)
@@ -217,6 +249,52 @@ class ContactHandler:
                 if info is not None:
                     self._dispatch_contact(info)
     
+    def _process_id_report(self, contact_headers, contact_data) -> None:
+        """
+        Reduce a report through the ID table and dispatch per pair.
+        
+        Args:
+            contact_headers: PhysX contact headers array
+            contact_data: PhysX contact data array
+        """
+        from .contact_id_table import KIND_CREATURE, KIND_TENDROID, reduce_contact_report
+        
+        records = reduce_contact_report(contact_headers, contact_data, self._id_table)
+        self._last_records = records
+        
+        table = self._id_table
+        for i in range(len(records)):
+            count = int(records.contact_count[i])
+            event = ContactEvent(
+                creature_path=table.path_of(KIND_CREATURE, records.creature_index[i]),
+                tendroid_path=table.path_of(KIND_TENDROID, records.tendroid_index[i]),
+                contact_point=tuple(float(v) for v in records.contact_point[i]),
+                surface_normal=tuple(float(v) for v in records.surface_normal[i]),
+                impulse=float(records.impulse[i]),
+                separation=float(records.separation[i]),
+                contact_count=count,
+            )
+            self._emit(event, count)
+    
+    def process_full_report(self) -> int:
+        """
+        Poll the current step's full contact report instead of subscribing.
+        
+        Returns:
+            Creature-tendroid contact points processed
+        """
+        try:
+            from omni.physx import get_physx_simulation_interface
+            report = get_physx_simulation_interface().get_full_contact_report()
+        except Exception as e:
+            import carb
+            carb.log_error(f"[ContactHandler] Full contact report failed: {e}")
+            return 0
+        
+        before = self._contact_count
+        self._on_contact_report(report[0], report[1])
+        return self._contact_count - before
+    
     def _dispatch_contact(self, info: ContactInfo) -> None:
         """
         Dispatch contact event to all listeners.
@@ -224,8 +302,17 @@ class ContactHandler:
         Args:
             info: Filtered contact information
         """
-        self._contact_count += 1
-        event = ContactEvent.from_contact_info(info)
+        self._emit(ContactEvent.from_contact_info(info))
+    
+    def _emit(self, event: ContactEvent, contacts: int = 1) -> None:
+        """
+        Count contacts and deliver an event to all listeners.
+        
+        Args:
+            event: Contact event
+            contacts: Contact points the event represents
+        """
+        self._contact_count += contacts
         
         for listener in self._listeners:
             try:
@@ -273,3 +360,4 @@ class ContactHandler:
         self.unsubscribe()
         self._listeners.clear()
         self._contact_count = 0
+        self._last_records = None
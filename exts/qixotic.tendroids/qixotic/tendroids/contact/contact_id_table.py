@@ -0,0 +1,249 @@
+"""
+Contact ID Table - Integer-ID classification and bulk reduction of contacts
+
+Fast path for ContactHandler under dense contact. Collider prims are
+mapped once, at registration, from their encoded SdfPath ints (the form
+PhysX contact headers carry) to integer (kind, index) IDs. A contact
+report is then processed as:
+
+    headers:  one dict lookup per actor -> keep creature/tendroid pairs
+    contacts: one gather of the kept pairs' contact rows into arrays
+    reduce:   vectorized sums / minima per (creature, tendroid) pair
+
+No path strings are built or matched per contact, and one record per
+touching pair comes out instead of one event per contact point.
+"""
+
+from dataclasses import dataclass
+from typing import Callable, Tuple
+
+import numpy as np
+
+# Collider kinds
+KIND_NONE = 0
+KIND_CREATURE = 1
+KIND_TENDROID = 2
+
+_UNKNOWN = (KIND_NONE, -1)
+
+
+def _default_encoder() -> Callable:
+    """SdfPath string -> PhysX encoded int (PhysicsSchemaTools.sdfPathToInt)."""
+    from pxr import PhysicsSchemaTools
+    return PhysicsSchemaTools.sdfPathToInt
+
+
+@dataclass
+class ContactRecords:
+    """
+    Reduced contacts, one row per touching (creature, tendroid) pair.
+
+    Attributes:
+        creature_index: (M,) registered creature index
+        tendroid_index: (M,) registered tendroid index
+        contact_count: (M,) contact points merged into the row
+        contact_point: (M, 3) mean contact position
+        surface_normal: (M, 3) mean normal, pointing away from the tendroid
+        impulse: (M,) summed impulse magnitude
+        separation: (M,) deepest (minimum) separation
+    """
+    creature_index: np.ndarray
+    tendroid_index: np.ndarray
+    contact_count: np.ndarray
+    contact_point: np.ndarray
+    surface_normal: np.ndarray
+    impulse: np.ndarray
+    separation: np.ndarray
+
+    def __len__(self) -> int:
+        return len(self.creature_index)
+
+    @classmethod
+    def empty(cls) -> 'ContactRecords':
+        """No contacts."""
+        return cls(
+            creature_index=np.zeros(0, dtype=np.int64),
+            tendroid_index=np.zeros(0, dtype=np.int64),
+            contact_count=np.zeros(0, dtype=np.int64),
+            contact_point=np.zeros((0, 3), dtype=np.float32),
+            surface_normal=np.zeros((0, 3), dtype=np.float32),
+            impulse=np.zeros(0, dtype=np.float32),
+            separation=np.zeros(0, dtype=np.float32),
+        )
+
+
+class ContactIdTable:
+    """
+    Encoded collider path -> (kind, index), built once at registration.
+
+    Usage:
+        table = ContactIdTable()
+        table.register_prim_tree(stage, '/World/Creature', KIND_CREATURE, 0)
+        for i, tendroid in enumerate(tendroids):
+            table.register(tendroid.mesh_path, KIND_TENDROID, i)
+
+        records = reduce_contact_report(headers, contact_data, table)
+    """
+
+    def __init__(self, encode_path: Callable = None):
+        """
+        Args:
+            encode_path: Path string -> the key contact headers carry
+                (defaults to PhysicsSchemaTools.sdfPathToInt)
+        """
+        self._encode = encode_path or _default_encoder()
+        self._ids = {}  # encoded path -> (kind, index)
+        self._paths = {KIND_CREATURE: {}, KIND_TENDROID: {}}  # kind -> index -> path
+
+    def __len__(self) -> int:
+        return len(self._ids)
+
+    def register(self, path: str, kind: int, index: int) -> None:
+        """
+        Map one collider (or rigid body) prim to a (kind, index) ID.
+
+        Several prims may share an ID (e.g. every collider of one
+        creature); the first path registered names the ID in events.
+        """
+        self._ids[self._encode(str(path))] = (int(kind), int(index))
+        self._paths[kind].setdefault(int(index), str(path))
+
+    def register_prim_tree(self, stage, root_path: str, kind: int, index: int) -> int:
+        """
+        Register a prim and every descendant under one ID.
+
+        Matches the prefix semantics of the path-pattern filter without
+        touching strings per contact.
+
+        Returns:
+            Number of prims registered
+        """
+        from pxr import Usd
+
+        root = stage.GetPrimAtPath(root_path)
+        if not root or not root.IsValid():
+            return 0
+        count = 0
+        for prim in Usd.PrimRange(root):
+            self.register(str(prim.GetPath()), kind, index)
+            count += 1
+        return count
+
+    def unregister(self, kind: int, index: int) -> None:
+        """Drop every prim mapped to (kind, index)."""
+        key = (int(kind), int(index))
+        self._ids = {encoded: ids for encoded, ids in self._ids.items() if ids != key}
+        self._paths[kind].pop(int(index), None)
+
+    def clear(self) -> None:
+        """Forget every registration."""
+        self._ids.clear()
+        for paths in self._paths.values():
+            paths.clear()
+
+    def lookup(self, encoded) -> Tuple[int, int]:
+        """(kind, index) for an encoded path, (KIND_NONE, -1) if unknown."""
+        return self._ids.get(encoded, _UNKNOWN)
+
+    def lookup_actor(self, header, side: int) -> Tuple[int, int]:
+        """(kind, index) of one side of a contact header (collider, then actor)."""
+        ids = self.lookup(getattr(header, f'collider{side}', None))
+        if ids[0] == KIND_NONE:
+            ids = self.lookup(getattr(header, f'actor{side}'))
+        return ids
+
+    def path_of(self, kind: int, index: int) -> str:
+        """Registered path naming (kind, index), or ''."""
+        return self._paths[kind].get(int(index), '')
+
+
+def contact_arrays(contact_data, indices: np.ndarray) -> tuple:
+    """
+    Gather contact rows into (positions, normals, impulses, separations).
+
+    Accepts a NumPy structured array (fields position / normal / impulse
+    / separation: one fancy-index) or PhysX's list of ContactData
+    structs (one pass over the kept rows only). Vector impulses are
+    reduced to their magnitude.
+    """
+    if isinstance(contact_data, np.ndarray) and contact_data.dtype.names:
+        rows = contact_data[indices]
+        names = contact_data.dtype.names
+        positions = rows['position'].astype(np.float32)
+        normals = rows['normal'].astype(np.float32)
+        impulses = rows['impulse'] if 'impulse' in names else np.zeros(len(rows), dtype=np.float32)
+        separations = rows['separation'] if 'separation' in names else np.zeros(len(rows), dtype=np.float32)
+    else:
+        rows = [contact_data[i] for i in indices.tolist()]
+        positions = np.array([tuple(c.position) for c in rows], dtype=np.float32).reshape(-1, 3)
+        normals = np.array([tuple(c.normal) for c in rows], dtype=np.float32).reshape(-1, 3)
+        impulses = [getattr(c, 'impulse', 0.0) for c in rows]
+        impulses = np.array([tuple(i) if hasattr(i, '__len__') else i for i in impulses], dtype=np.float32)
+        separations = np.array([getattr(c, 'separation', 0.0) for c in rows], dtype=np.float32)
+
+    impulses = np.asarray(impulses, dtype=np.float32)
+    if impulses.ndim == 2:
+        impulses = np.linalg.norm(impulses, axis=1)
+    return positions, normals, impulses, np.asarray(separations, dtype=np.float32)
+
+
+def reduce_contact_report(contact_headers, contact_data, id_table: ContactIdTable) -> ContactRecords:
+    """
+    Filter a PhysX contact report to creature-tendroid contacts and
+    reduce them per (creature, tendroid) pair.
+
+    Args:
+        contact_headers: PhysX contact headers (actor0/1, collider0/1,
+            num_contact_data, contact_data_offset)
+        contact_data: PhysX contact rows (list or structured array)
+        id_table: Registered colliders
+
+    Returns:
+        ContactRecords; normals point away from the tendroid
+    """
+    pairs = []
+    for header in contact_headers:
+        count = header.num_contact_data
+        if count <= 0:
+            continue
+        kind0, index0 = id_table.lookup_actor(header, 0)
+        kind1, index1 = id_table.lookup_actor(header, 1)
+        if kind0 == KIND_CREATURE and kind1 == KIND_TENDROID:
+            pairs.append((index0, index1, 1.0, header.contact_data_offset, count))
+        elif kind1 == KIND_CREATURE and kind0 == KIND_TENDROID:
+            # PhysX normal points 0 -> 1; flip to point away from the tendroid
+            pairs.append((index1, index0, -1.0, header.contact_data_offset, count))
+    if not pairs:
+        return ContactRecords.empty()
+
+    creature, tendroid, sign, offsets, counts = (np.array(column) for column in zip(*pairs))
+
+    # Contact row of every kept contact: header offset + position within header
+    starts = np.cumsum(counts) - counts
+    indices = np.repeat(offsets - starts, counts) + np.arange(int(counts.sum()))
+    positions, normals, impulses, separations = contact_arrays(contact_data, indices)
+    normals = normals * np.repeat(sign, counts)[:, None].astype(np.float32)
+
+    # One row per (creature, tendroid)
+    stride = int(tendroid.max()) + 1
+    keys, inverse = np.unique(np.repeat(creature * stride + tendroid, counts), return_inverse=True)
+    rows = len(keys)
+    contact_count = np.bincount(inverse, minlength=rows)
+
+    point_sum = np.zeros((rows, 3), dtype=np.float64)
+    np.add.at(point_sum, inverse, positions)
+    normal_sum = np.zeros((rows, 3), dtype=np.float64)
+    np.add.at(normal_sum, inverse, normals)
+    lengths = np.linalg.norm(normal_sum, axis=1)
+    separation = np.full(rows, np.inf, dtype=np.float64)
+    np.minimum.at(separation, inverse, separations)
+
+    return ContactRecords(
+        creature_index=keys // stride,
+        tendroid_index=keys % stride,
+        contact_count=contact_count,
+        contact_point=(point_sum / contact_count[:, None]).astype(np.float32),
+        surface_normal=(normal_sum / np.where(lengths > 0.0, lengths, 1.0)[:, None]).astype(np.float32),
+        impulse=np.bincount(inverse, weights=impulses, minlength=rows).astype(np.float32),
+        separation=separation.astype(np.float32),
+    )
@@ -75,6 +75,9 @@ class CreatureController:
         # Input lock state (LTEND-28)
         self._input_lock_status = InputLockStatus()
         
+        # Optional GPU hash grid pass (CreatureInteractionGrid)
+        self.interaction_grid = None
+        
         # Create mesh and get transform ops
         result = create_creature_mesh(
             self.stage, self.creature_radius, self.creature_length
@@ -108,6 +111,15 @@ class CreatureController:
             state_msg = "LOCKED - repel active" if self._input_lock_status.is_locked else "UNLOCKED"
             carb.log_info(f"[CreatureController] Input {state_msg}")
     
+    def set_interaction_grid(self, interaction_grid):
+        """Use a CreatureInteractionGrid instead of the per-object scans."""
+        self.interaction_grid = interaction_grid
+    
+    @property
+    def uses_gpu_bubble_collisions(self) -> bool:
+        """True if bubble hits come from GPU state (bubble dicts not needed)."""
+        return self.interaction_grid is not None and self.interaction_grid.has_bubbles
+    
     def apply_repulsion_force(self, force_vector: tuple) -> None:
         """Apply external repulsion force (bypasses keyboard lock)."""
         fx, fy, fz = force_vector
@@ -199,10 +211,17 @@ class CreatureController:
             self.current_rotation = calculate_rotation(self.intended_velocity, self.current_rotation)
             self.rotate_op.Set(self.current_rotation)
         
-        # Check collisions
-        self.velocity, popped = check_bubble_collisions(
-            self.position, self.creature_radius, bubble_positions, bubble_radii, self.velocity)
-        self.velocity, interactions = check_tendroid_interactions(
-            self.position, self.velocity, self.creature_radius, tendroids)
+        # Check collisions (grid: bubbles + registered tendroids in one launch)
+        popped = []
+        if not self.uses_gpu_bubble_collisions:
+            self.velocity, popped = check_bubble_collisions(
+                self.position, self.creature_radius, bubble_positions, bubble_radii, self.velocity)
+        if self.interaction_grid is not None:
+            self.velocity, grid_popped, interactions = self.interaction_grid.check(
+                self.position, self.velocity, self.creature_radius)
+            popped.extend(grid_popped)
+        else:
+            self.velocity, interactions = check_tendroid_interactions(
+                self.position, self.velocity, self.creature_radius, tendroids)
         
         return popped, interactions
@@ -0,0 +1,330 @@
+"""
+Creature Interaction Grid - Hash-grid bubble and tendroid interactions on GPU
+
+Replaces the per-frame scene scans of check_bubble_collisions and
+check_tendroid_interactions (creature_update_helpers) with one
+creature_interaction_kernel launch. Tendroids sit in a static
+ProximityHashGrid (rebuilt only when the set changes); bubbles are
+gathered straight from BubbleGPUManager's device arrays into a second
+grid each frame, so no bubble state is downloaded for collisions.
+
+The host reads back one fixed-size hit list (a few hundred entries at
+most) and the creature's new velocity, and turns them into the same
+(velocity, popped, interactions) results as the Python helpers.
+"""
+
+import carb
+import numpy as np
+import warp as wp
+from pxr import Gf
+
+from .creature_interaction_kernel import (
+    HIT_AVOIDANCE,
+    HIT_BUBBLE,
+    HIT_SHOCK,
+    creature_interaction_kernel,
+    pack_bubbles_kernel,
+)
+from ..proximity import GridConfig, ProximityHashGrid
+
+wp.init()
+
+DEFAULT_MAX_HITS = 256
+
+# Constants of the Python reference (check_*_interactions)
+AVOIDANCE_EPSILON = 30.0
+SHOCK_IMPULSE = 25.0
+BUBBLE_IMPULSE = 5.0
+
+# Bubbles are creature-sized; cells a bit larger than one keep queries to ~8 cells
+BUBBLE_CELL_SIZE = 16.0
+
+
+class CreatureInteractionGrid:
+    """
+    GPU creature vs. tendroid / bubble interaction pass.
+
+    Usage:
+        grid = CreatureInteractionGrid()
+        grid.set_tendroids(tendroids)
+        grid.bind_bubbles(gpu_manager, adapter._id_to_name)
+
+        # Each frame (after bubble physics):
+        velocity, popped, interactions = grid.check(position, velocity, radius)
+    """
+
+    def __init__(
+        self,
+        device: str = "cuda:0",
+        max_hits: int = DEFAULT_MAX_HITS,
+        avoidance_epsilon: float = AVOIDANCE_EPSILON,
+        shock_impulse: float = SHOCK_IMPULSE,
+        bubble_impulse: float = BUBBLE_IMPULSE,
+    ):
+        """
+        Args:
+            device: Warp device
+            max_hits: Hit list capacity per launch (extra hits are dropped)
+            avoidance_epsilon: Tendroid avoidance range
+            shock_impulse: Velocity added per tendroid contact
+            bubble_impulse: Velocity added per bubble hit
+        """
+        self.device = device
+        self.max_hits = int(max_hits)
+        self.avoidance_epsilon = avoidance_epsilon
+        self.shock_impulse = shock_impulse
+        self.bubble_impulse = bubble_impulse
+
+        # Tendroids: static grid, names by grid index
+        self._tendroid_grid = None
+        self._tendroid_radii = None
+        self._tendroid_names = []
+
+        # Bubbles: packed from the bound BubbleGPUManager each check
+        self._bubble_manager = None
+        self._bubble_names = {}
+        self._bubble_grid = wp.HashGrid(128, 128, 128, device=device)
+        self._bubble_positions = None
+        self._bubble_radii = None
+        self._bubble_max_radius = wp.zeros(1, dtype=float, device=device)
+
+        # One creature (CreatureController); staged through pinned memory
+        pinned = device.startswith("cuda")
+        self._creature_host = wp.zeros(2, dtype=wp.vec3, device="cpu", pinned=pinned)
+        self._creature_gpu = wp.zeros(2, dtype=wp.vec3, device=device)
+        self._creature_velocity_gpu = self._creature_gpu[1:2]
+        self._out_velocity = wp.zeros(1, dtype=wp.vec3, device=device)
+
+        # Compact hit list
+        self._hit_count = wp.zeros(1, dtype=int, device=device)
+        self._hit_creature = wp.zeros(self.max_hits, dtype=int, device=device)
+        self._hit_kind = wp.zeros(self.max_hits, dtype=int, device=device)
+        self._hit_index = wp.zeros(self.max_hits, dtype=int, device=device)
+        self._hit_scalars = wp.zeros(self.max_hits, dtype=wp.vec3, device=device)
+        self._hit_direction = wp.zeros(self.max_hits, dtype=wp.vec3, device=device)
+        self._host = {
+            name: wp.zeros(array.shape, dtype=array.dtype, device="cpu", pinned=pinned)
+            for name, array in self._download_arrays().items()
+        }
+
+    @property
+    def has_tendroids(self) -> bool:
+        return bool(self._tendroid_names)
+
+    @property
+    def has_bubbles(self) -> bool:
+        return self._bubble_manager is not None
+
+    def _download_arrays(self) -> dict:
+        return {
+            'count': self._hit_count,
+            'kind': self._hit_kind,
+            'index': self._hit_index,
+            'scalars': self._hit_scalars,
+            'direction': self._hit_direction,
+            'velocity': self._out_velocity,
+        }
+
+    def set_tendroids(self, tendroids: list) -> bool:
+        """
+        (Re)register tendroid positions and radii in the static grid.
+
+        Call again whenever tendroids are added or removed.
+
+        Returns:
+            True if the grid holds at least one tendroid
+        """
+        self._tendroid_names = []
+        self._tendroid_radii = None
+        if not tendroids:
+            return False
+
+        if self._tendroid_grid is None:
+            self._tendroid_grid = ProximityHashGrid(
+                GridConfig(cell_size=self.avoidance_epsilon, device=self.device),
+                static_tendroids=True,
+            )
+            if not self._tendroid_grid.initialize():
+                self._tendroid_grid = None
+                return False
+
+        positions = [tuple(float(v) for v in t.position) for t in tendroids]
+        if not self._tendroid_grid.register_tendroids(positions):
+            return False
+        self._tendroid_grid.bind_creature_positions(self._creature_gpu, count=1)
+        self._tendroid_grid.rebuild(self.avoidance_epsilon)
+
+        self._tendroid_radii = wp.array(
+            np.array([t.radius for t in tendroids], dtype=np.float32), dtype=float, device=self.device
+        )
+        self._tendroid_names = [t.name for t in tendroids]
+        return True
+
+    def bind_bubbles(self, bubble_gpu_manager, id_to_name: dict):
+        """
+        Read bubbles from a BubbleGPUManager's device state.
+
+        Args:
+            bubble_gpu_manager: Source of phases / world positions / radii
+            id_to_name: Bubble id -> tendroid name (referenced, stays live)
+        """
+        self._bubble_manager = bubble_gpu_manager
+        self._bubble_names = id_to_name
+
+    def unbind_bubbles(self):
+        """Stop bubble collisions (tendroid interactions continue)."""
+        self._bubble_manager = None
+        self._bubble_names = {}
+
+    def _pack_bubbles(self) -> bool:
+        """Gather live bubbles into the bubble grid. Returns False if none."""
+        manager = self._bubble_manager
+        count = manager.max_bubbles
+        if count == 0 or manager.active_count == 0:
+            return False
+
+        if self._bubble_positions is None or self._bubble_positions.shape[0] != count:
+            self._bubble_positions = wp.zeros(count, dtype=wp.vec3, device=self.device)
+            self._bubble_radii = wp.zeros(count, dtype=float, device=self.device)
+
+        self._bubble_max_radius.zero_()
+        wp.launch(
+            kernel=pack_bubbles_kernel,
+            dim=count,
+            inputs=[
+                manager.phases_gpu,
+                manager.world_x_gpu, manager.world_y_gpu, manager.world_z_gpu,
+                manager.current_radius_gpu,
+                self._bubble_positions, self._bubble_radii, self._bubble_max_radius,
+            ],
+            device=self.device
+        )
+        self._bubble_grid.build(points=self._bubble_positions, radius=BUBBLE_CELL_SIZE)
+        return True
+
+    def check(self, position, velocity, creature_radius: float) -> tuple:
+        """
+        Bubble pops and tendroid avoidance / shock for one creature.
+
+        Args:
+            position: Creature position (Gf.Vec3f or xyz)
+            velocity: Creature velocity
+            creature_radius: Collision radius
+
+        Returns:
+            (new_velocity, popped, interactions) as returned by
+            check_bubble_collisions + check_tendroid_interactions
+        """
+        if not self.launch(position, velocity, creature_radius):
+            return Gf.Vec3f(velocity[0], velocity[1], velocity[2]), [], {}
+        return self.read_results()
+
+    def launch(self, position, velocity, creature_radius: float) -> bool:
+        """
+        Queue the interaction pass without waiting for it.
+
+        Split from check() so several grids (one per device partition)
+        can run concurrently before any of them is read back.
+
+        Returns:
+            True if a launch was queued (read it with read_results())
+        """
+        use_bubbles = self.has_bubbles and self._pack_bubbles()
+        use_tendroids = self.has_tendroids
+        if not use_bubbles and not use_tendroids:
+            return False
+
+        staging = self._creature_host.numpy()
+        staging[0] = (position[0], position[1], position[2])
+        staging[1] = (velocity[0], velocity[1], velocity[2])
+        wp.copy(self._creature_gpu, self._creature_host)
+
+        tendroid_grid = self._tendroid_grid if use_tendroids else None
+        self._hit_count.zero_()
+        wp.launch(
+            kernel=creature_interaction_kernel,
+            dim=1,
+            inputs=[
+                tendroid_grid.get_grid_id() if tendroid_grid else wp.uint64(0),
+                tendroid_grid.get_tendroid_positions_gpu() if tendroid_grid else self._creature_gpu,
+                self._tendroid_radii if tendroid_grid else self._bubble_max_radius,
+                int(use_tendroids),
+                self._bubble_grid.id if use_bubbles else wp.uint64(0),
+                self._bubble_positions if use_bubbles else self._creature_gpu,
+                self._bubble_radii if use_bubbles else self._bubble_max_radius,
+                self._bubble_max_radius,
+                int(use_bubbles),
+                self._creature_gpu,
+                self._creature_velocity_gpu,
+                float(creature_radius),
+                self.avoidance_epsilon,
+                self.shock_impulse,
+                self.bubble_impulse,
+                self._out_velocity,
+                self.max_hits,
+                self._hit_count,
+                self._hit_creature,
+                self._hit_kind,
+                self._hit_index,
+                self._hit_scalars,
+                self._hit_direction,
+            ],
+            device=self.device
+        )
+        for name, array in self._download_arrays().items():
+            wp.copy(self._host[name], array)
+        return True
+
+    def read_results(self) -> tuple:
+        """Wait for the last launch(), then build host-side result dicts."""
+        wp.synchronize_device(self.device)
+
+        total = int(self._host['count'].numpy()[0])
+        count = min(total, self.max_hits)
+        if total > self.max_hits:
+            carb.log_warn(f"[CreatureInteractionGrid] {total} hits, kept {self.max_hits}")
+
+        kinds = self._host['kind'].numpy()[:count]
+        indices = self._host['index'].numpy()[:count]
+        scalars = self._host['scalars'].numpy()[:count]
+        directions = self._host['direction'].numpy()[:count]
+
+        popped, interactions = [], {}
+        for kind, index, (distance, approach, factor), direction in zip(kinds, indices, scalars, directions):
+            direction = Gf.Vec3f(float(direction[0]), float(direction[1]), float(direction[2]))
+            if kind == HIT_BUBBLE:
+                name = self._bubble_names.get(int(index))
+                if name is not None:
+                    popped.append((name, direction))
+                continue
+
+            name = self._tendroid_names[int(index)]
+            if kind == HIT_AVOIDANCE:
+                interactions[name] = {
+                    'type': 'avoidance',
+                    'distance': float(distance),
+                    'approach_velocity': float(approach),
+                    'avoidance_factor': float(factor),
+                    'avoidance_direction': tuple(direction),
+                }
+            elif kind == HIT_SHOCK:
+                interactions[name] = {
+                    'type': 'shock',
+                    'distance': float(distance),
+                    'shock_direction': tuple(direction),
+                }
+
+        v = self._host['velocity'].numpy()[0]
+        return Gf.Vec3f(float(v[0]), float(v[1]), float(v[2])), popped, interactions
+
+    def destroy(self):
+        """Release device resources."""
+        if self._tendroid_grid:
+            self._tendroid_grid.destroy()
+        self._tendroid_grid = None
+        self._tendroid_radii = None
+        self._tendroid_names = []
+        self.unbind_bubbles()
+        self._bubble_grid = None
+        self._bubble_positions = None
+        self._bubble_radii = None
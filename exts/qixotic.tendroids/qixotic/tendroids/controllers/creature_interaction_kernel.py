@@ -0,0 +1,180 @@
+"""
+Creature Interaction Kernels - Hash grid bubble hits and tendroid avoidance/shock
+
+Device version of check_bubble_collisions + check_tendroid_interactions
+(creature_update_helpers). Each creature queries a tendroid hash grid
+and a bubble hash grid instead of looping over the whole scene, and
+appends its hits to a compact list (atomic counter) so the host reads
+back only what actually happened.
+
+Semantics match the Python reference: bubble impulses are applied
+first, avoidance uses the velocity after bubble hits, and shock
+impulses are summed on top.
+"""
+
+import warp as wp
+
+wp.init()
+
+# Hit kinds in the compact list
+HIT_BUBBLE = wp.constant(0)
+HIT_AVOIDANCE = wp.constant(1)
+HIT_SHOCK = wp.constant(2)
+
+# Below this distance the direction falls back to +Y (as in the reference)
+MIN_DIRECTION_DISTANCE = wp.constant(0.01)
+
+# Approach speed that turns proximity into avoidance / shock
+MIN_APPROACH_VELOCITY = wp.constant(0.1)
+
+
+@wp.kernel
+def pack_bubbles_kernel(
+    phases: wp.array(dtype=int),
+    world_x: wp.array(dtype=float),
+    world_y: wp.array(dtype=float),
+    world_z: wp.array(dtype=float),
+    current_radius: wp.array(dtype=float),
+    # Outputs: grid points, collision radius (0 = inactive), largest radius
+    bubble_positions: wp.array(dtype=wp.vec3),
+    bubble_radii: wp.array(dtype=float),
+    max_radius: wp.array(dtype=float),
+):
+    """Gather BubbleGPUManager SoA state into hash grid points."""
+    b = wp.tid()
+    bubble_positions[b] = wp.vec3(world_x[b], world_y[b], world_z[b])
+
+    radius = float(0.0)
+    if phases[b] > 0:
+        radius = wp.max(current_radius[b], 0.0)
+    bubble_radii[b] = radius
+    wp.atomic_max(max_radius, 0, radius)
+
+
+@wp.func
+def append_hit(
+    creature: int,
+    kind: int,
+    index: int,
+    scalars: wp.vec3,
+    direction: wp.vec3,
+    max_hits: int,
+    hit_count: wp.array(dtype=int),
+    hit_creature: wp.array(dtype=int),
+    hit_kind: wp.array(dtype=int),
+    hit_index: wp.array(dtype=int),
+    hit_scalars: wp.array(dtype=wp.vec3),
+    hit_direction: wp.array(dtype=wp.vec3),
+):
+    """Append one hit; counted but dropped once the list is full."""
+    slot = wp.atomic_add(hit_count, 0, 1)
+    if slot < max_hits:
+        hit_creature[slot] = creature
+        hit_kind[slot] = kind
+        hit_index[slot] = index
+        hit_scalars[slot] = scalars
+        hit_direction[slot] = direction
+
+
+@wp.kernel
+def creature_interaction_kernel(
+    # Tendroids (static grid; grid index = tendroid index)
+    tendroid_grid: wp.uint64,
+    tendroid_positions: wp.array(dtype=wp.vec3),
+    tendroid_radii: wp.array(dtype=float),
+    use_tendroids: int,
+
+    # Bubbles (rebuilt each frame by pack_bubbles_kernel)
+    bubble_grid: wp.uint64,
+    bubble_positions: wp.array(dtype=wp.vec3),
+    bubble_radii: wp.array(dtype=float),
+    bubble_max_radius: wp.array(dtype=float),
+    use_bubbles: int,
+
+    # Creatures
+    creature_positions: wp.array(dtype=wp.vec3),
+    creature_velocities: wp.array(dtype=wp.vec3),
+    creature_radius: float,
+
+    # Tuning (creature_update_helpers constants)
+    avoidance_epsilon: float,
+    shock_impulse: float,
+    bubble_impulse: float,
+
+    # Outputs
+    out_velocities: wp.array(dtype=wp.vec3),
+    max_hits: int,
+    hit_count: wp.array(dtype=int),
+    hit_creature: wp.array(dtype=int),
+    hit_kind: wp.array(dtype=int),
+    hit_index: wp.array(dtype=int),
+    hit_scalars: wp.array(dtype=wp.vec3),
+    hit_direction: wp.array(dtype=wp.vec3),
+):
+    """
+    One creature per thread: bubble pops, then tendroid avoidance / shock.
+
+    Hit scalars are (distance, approach_velocity, avoidance_factor);
+    fields that do not apply to a kind are 0.
+    """
+    c = wp.tid()
+    position = creature_positions[c]
+    velocity = creature_velocities[c]
+    up = wp.vec3(0.0, 1.0, 0.0)
+
+    # Bubble collisions (query covers the largest live bubble)
+    if use_bubbles != 0:
+        query_radius = (creature_radius + bubble_max_radius[0]) * 0.9
+        query = wp.hash_grid_query(bubble_grid, position, query_radius)
+        for b in query:
+            radius = bubble_radii[b]
+            if radius <= 0.0:
+                continue
+            offset = position - bubble_positions[b]
+            distance = wp.length(offset)
+            if distance < (creature_radius + radius) * 0.9:
+                direction = up
+                if distance > MIN_DIRECTION_DISTANCE:
+                    direction = offset / distance
+                velocity = velocity + direction * bubble_impulse
+                append_hit(
+                    c, HIT_BUBBLE, b, wp.vec3(distance, 0.0, 0.0), direction, max_hits,
+                    hit_count, hit_creature, hit_kind, hit_index, hit_scalars, hit_direction,
+                )
+
+    # Tendroid avoidance / shock against the post-bubble velocity
+    result = velocity
+    if use_tendroids != 0:
+        query = wp.hash_grid_query(tendroid_grid, position, avoidance_epsilon)
+        for t in query:
+            offset = position - tendroid_positions[t]
+            distance = wp.length(offset)
+            if distance > avoidance_epsilon:
+                continue
+
+            approach_velocity = float(0.0)
+            if distance > MIN_DIRECTION_DISTANCE:
+                approach_velocity = wp.dot(velocity, -offset / distance)
+            if approach_velocity <= MIN_APPROACH_VELOCITY:
+                continue
+
+            contact_distance = creature_radius + tendroid_radii[t]
+            if distance > contact_distance:
+                factor = 1.0 - (distance - contact_distance) / (avoidance_epsilon - contact_distance)
+                append_hit(
+                    c, HIT_AVOIDANCE, t,
+                    wp.vec3(distance, approach_velocity, wp.clamp(factor, 0.0, 1.0)),
+                    offset / distance, max_hits,
+                    hit_count, hit_creature, hit_kind, hit_index, hit_scalars, hit_direction,
+                )
+            else:
+                direction = up
+                if distance > MIN_DIRECTION_DISTANCE:
+                    direction = offset / distance
+                result = result + direction * shock_impulse
+                append_hit(
+                    c, HIT_SHOCK, t, wp.vec3(distance, approach_velocity, 0.0), direction, max_hits,
+                    hit_count, hit_creature, hit_kind, hit_index, hit_scalars, hit_direction,
+                )
+
+    out_velocities[c] = result
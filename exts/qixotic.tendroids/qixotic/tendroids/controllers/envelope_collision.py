@@ -210,6 +210,116 @@ def sphere_capsule_collision(
   return point_capsule_collision(sphere_center, capsule, effective_offset)
 
 
+def closest_points_between_segments(
+  p1: Vec3, q1: Vec3, p2: Vec3, q2: Vec3
+) -> Tuple[Vec3, Vec3, float, float]:
+  """
+  Closest points between segments p1-q1 and p2-q2.
+
+  Args:
+      p1, q1: First segment
+      p2, q2: Second segment
+
+  Returns:
+      Tuple of (point_on_first, point_on_second, s, t) with s, t in [0,1]
+  """
+  d1 = q1 - p1
+  d2 = q2 - p2
+  r = p1 - p2
+  a = d1.length_squared()
+  e = d2.length_squared()
+  f = d2.dot(r)
+
+  if a < 1e-10 and e < 1e-10:
+    return p1, p2, 0.0, 0.0
+
+  if a < 1e-10:
+    s = 0.0
+    t = max(0.0, min(1.0, f / e))
+  else:
+    c = d1.dot(r)
+    if e < 1e-10:
+      t = 0.0
+      s = max(0.0, min(1.0, -c / a))
+    else:
+      b = d1.dot(d2)
+      denom = a * e - b * b
+      # Parallel segments: any s works, start from p1
+      s = max(0.0, min(1.0, (b * f - c * e) / denom)) if denom > 1e-10 else 0.0
+      t = (b * s + f) / e
+      if t < 0.0:
+        t = 0.0
+        s = max(0.0, min(1.0, -c / a))
+      elif t > 1.0:
+        t = 1.0
+        s = max(0.0, min(1.0, (b - c) / a))
+
+  return p1 + d1 * s, p2 + d2 * t, s, t
+
+
+def capsule_capsule_collision(
+  capsule: Capsule,
+  other: Capsule,
+  contact_offset: float = 0.0
+) -> CollisionResult:
+  """
+  Test collision between two capsules (e.g. creature envelope vs tendroid).
+
+  Contact point, normal and type are reported on `other`, as in
+  point_capsule_collision with `capsule`'s axis standing in for the point.
+
+  Args:
+      capsule: Moving capsule (creature envelope)
+      other: Capsule tested against (tendroid)
+      contact_offset: Additional offset for early contact detection
+
+  Returns:
+      CollisionResult with hit status and contact info
+  """
+  effective_radius = other.radius + contact_offset
+
+  on_capsule, on_other, _, t = closest_points_between_segments(
+    capsule.point_a, capsule.point_b, other.point_a, other.point_b
+  )
+
+  to_capsule = on_capsule - on_other
+  distance_between_axes = to_capsule.length()
+  distance_to_surface = distance_between_axes - effective_radius - capsule.radius
+
+  if t <= 0.0:
+    contact_type = "cap_a"
+  elif t >= 1.0:
+    contact_type = "cap_b"
+  else:
+    contact_type = "cylinder"
+
+  if distance_between_axes > 1e-8:
+    contact_normal = to_capsule.normalized()
+  else:
+    contact_normal = Vec3(1, 0, 0)
+    if abs(other.axis.x) > 0.9:
+      contact_normal = Vec3(0, 1, 0)
+
+  return CollisionResult(
+    hit=(distance_to_surface <= 0),
+    distance=distance_to_surface,
+    contact_point=on_other + contact_normal * effective_radius,
+    contact_normal=contact_normal,
+    contact_type=contact_type
+  )
+
+
+def tendroid_capsule(position: Tuple[float, float, float], length: float, radius: float) -> Capsule:
+  """Upright capsule around a tendroid standing at `position` (base)."""
+  half_height = length * 0.5
+  return Capsule(
+    center=Vec3(position[0], position[1] + half_height, position[2]),
+    axis=Vec3(0, 1, 0),
+    half_height=half_height,
+    radius=radius
+  )
+
+
 def calculate_approach_velocity(
   object_pos: Vec3,
   object_vel: Vec3,
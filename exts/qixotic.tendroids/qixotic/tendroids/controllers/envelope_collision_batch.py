@@ -0,0 +1,253 @@
+"""
+Envelope Collision Batch - Many creature envelopes vs. nearby tendroid capsules
+
+Vectorized backend for envelope_collision.py. Tendroids are registered
+once as upright capsules (tendroid_capsule) in a static ProximityHashGrid;
+each collide() call is one envelope_collision_kernel launch over all
+creatures, so cost grows with creatures x neighbors instead of
+creatures x tendroids.
+
+The pure-Python functions remain the reference implementation.
+"""
+
+from dataclasses import dataclass
+
+import carb
+import numpy as np
+import warp as wp
+
+from .envelope_collision_kernel import CONTACT_TYPE_NAMES, envelope_collision_kernel
+from ..proximity import GridConfig, ProximityHashGrid
+
+wp.init()
+
+DEFAULT_MAX_CONTACTS = 1024
+
+
+@dataclass
+class EnvelopeContacts:
+  """
+  Result of one batch query (host arrays).
+
+  Attributes:
+      nearest_distance: [creatures] closest tendroid surface distance
+          (negative = overlapping, 1e30 = no candidate)
+      nearest_tendroid: [creatures] tendroid index, -1 if none
+      pairs: [n, 2] (creature, tendroid) with distance <= report_distance
+      distance: [n] surface distance per pair
+      contact_point: [n, 3] point on the tendroid surface
+      contact_normal: [n, 3] outward tendroid normal toward the creature
+      contact_type: [n] index into CONTACT_TYPE_NAMES
+      dropped: Pairs beyond the contact list capacity
+  """
+  nearest_distance: np.ndarray
+  nearest_tendroid: np.ndarray
+  pairs: np.ndarray
+  distance: np.ndarray
+  contact_point: np.ndarray
+  contact_normal: np.ndarray
+  contact_type: np.ndarray
+  dropped: int = 0
+
+  def contact_type_name(self, i: int) -> str:
+    return CONTACT_TYPE_NAMES[int(self.contact_type[i])]
+
+
+class EnvelopeCollisionBatch:
+  """
+  GPU capsule-vs-capsule tests for creature envelopes.
+
+  Usage:
+      batch = EnvelopeCollisionBatch()
+      batch.set_tendroids(tendroids)
+
+      contacts = batch.collide(centers, axes, half_heights, radii,
+                               contact_offset=CONTACT_OFFSET)
+  """
+
+  def __init__(self, device: str = "cuda:0", max_contacts: int = DEFAULT_MAX_CONTACTS, cell_size: float = 32.0):
+    """
+    Args:
+        device: Warp device
+        max_contacts: Contact list capacity per query
+        cell_size: Hash grid cell size (about one envelope reach)
+    """
+    self.device = device
+    self.max_contacts = int(max_contacts)
+    self.cell_size = cell_size
+
+    self._grid = None
+    self._tendroid_a = None
+    self._tendroid_b = None
+    self._tendroid_radii = None
+    self._max_tendroid_radius = 0.0
+    self.tendroid_count = 0
+
+    self._creature_capacity = 0
+    self._nearest_distance = None
+    self._nearest_tendroid = None
+
+    self._contact_count = wp.zeros(1, dtype=int, device=device)
+    self._contact_pairs = wp.zeros(self.max_contacts, dtype=wp.vec2i, device=device)
+    self._contact_distance = wp.zeros(self.max_contacts, dtype=float, device=device)
+    self._contact_point = wp.zeros(self.max_contacts, dtype=wp.vec3, device=device)
+    self._contact_normal = wp.zeros(self.max_contacts, dtype=wp.vec3, device=device)
+    self._contact_type = wp.zeros(self.max_contacts, dtype=int, device=device)
+
+  def set_tendroids(self, tendroids: list) -> bool:
+    """
+    Register tendroid capsules (position = base, length, radius).
+
+    Call again when tendroids are added or removed.
+
+    Returns:
+        True if at least one tendroid is registered
+    """
+    self.tendroid_count = 0
+    if not tendroids:
+      return False
+
+    base = np.array([t.position for t in tendroids], dtype=np.float32).reshape(-1, 3)
+    lengths = np.array([t.length for t in tendroids], dtype=np.float32)
+    radii = np.array([t.radius for t in tendroids], dtype=np.float32)
+
+    # Segment ends of tendroid_capsule(): base .. base + length along +Y
+    top = base.copy()
+    top[:, 1] += lengths
+    projected = base.copy()
+    projected[:, 1] = 0.0
+
+    if self._grid is None:
+      self._grid = ProximityHashGrid(
+        GridConfig(cell_size=self.cell_size, device=self.device),
+        static_tendroids=True,
+      )
+      if not self._grid.initialize():
+        self._grid = None
+        return False
+
+    if not self._grid.register_tendroids([tuple(p) for p in projected]):
+      return False
+    self._grid.rebuild(self.cell_size)
+
+    self._tendroid_a = wp.array(base, dtype=wp.vec3, device=self.device)
+    self._tendroid_b = wp.array(top, dtype=wp.vec3, device=self.device)
+    self._tendroid_radii = wp.array(radii, dtype=float, device=self.device)
+    self._max_tendroid_radius = float(radii.max())
+    self.tendroid_count = len(tendroids)
+    return True
+
+  def _ensure_creature_capacity(self, count: int):
+    if count <= self._creature_capacity:
+      return
+    self._creature_capacity = max(count, 2 * self._creature_capacity)
+    self._nearest_distance = wp.zeros(self._creature_capacity, dtype=float, device=self.device)
+    self._nearest_tendroid = wp.zeros(self._creature_capacity, dtype=int, device=self.device)
+
+  def _device_array(self, values, dtype):
+    if isinstance(values, wp.array):
+      return values
+    return wp.array(np.asarray(values, dtype=np.float32), dtype=dtype, device=self.device)
+
+  def collide(
+    self,
+    centers,
+    axes,
+    half_heights,
+    radii,
+    contact_offset: float = 0.0,
+    report_distance: float = 0.0,
+    download: bool = True,
+  ):
+    """
+    Test every creature envelope against its nearby tendroid capsules.
+
+    Inputs are per-creature sequences, numpy arrays or device wp.arrays
+    (read in place).
+
+    Args:
+        centers: Envelope centers (vec3)
+        axes: Unit envelope axes (vec3)
+        half_heights: Cylinder half heights
+        radii: Envelope radii
+        contact_offset: Added to the tendroid radius (as in the reference)
+        report_distance: List pairs up to this surface distance
+            (0 = touching only; > 0 includes near misses)
+        download: Return EnvelopeContacts; False leaves results on device
+
+    Returns:
+        EnvelopeContacts, or None if download is False or there is
+        nothing to test
+    """
+    centers = self._device_array(centers, wp.vec3)
+    count = centers.shape[0]
+    if count == 0 or self.tendroid_count == 0:
+      return None
+
+    self._ensure_creature_capacity(count)
+    self._contact_count.zero_()
+    wp.launch(
+      kernel=envelope_collision_kernel,
+      dim=count,
+      inputs=[
+        self._grid.get_grid_id(),
+        self._tendroid_a, self._tendroid_b, self._tendroid_radii,
+        self._max_tendroid_radius,
+        centers,
+        self._device_array(axes, wp.vec3),
+        self._device_array(half_heights, float),
+        self._device_array(radii, float),
+        float(contact_offset),
+        float(report_distance),
+        self._nearest_distance,
+        self._nearest_tendroid,
+        self.max_contacts,
+        self._contact_count,
+        self._contact_pairs,
+        self._contact_distance,
+        self._contact_point,
+        self._contact_normal,
+        self._contact_type,
+      ],
+      device=self.device
+    )
+    if not download:
+      return None
+    return self._download(count)
+
+  def _download(self, count: int) -> EnvelopeContacts:
+    total = int(self._contact_count.numpy()[0])
+    n = min(total, self.max_contacts)
+    if total > n:
+      carb.log_warn(f"[EnvelopeCollisionBatch] {total} contacts, kept {n}")
+
+    return EnvelopeContacts(
+      nearest_distance=self._nearest_distance.numpy()[:count],
+      nearest_tendroid=self._nearest_tendroid.numpy()[:count],
+      pairs=self._contact_pairs.numpy()[:n],
+      distance=self._contact_distance.numpy()[:n],
+      contact_point=self._contact_point.numpy()[:n],
+      contact_normal=self._contact_normal.numpy()[:n],
+      contact_type=self._contact_type.numpy()[:n],
+      dropped=total - n,
+    )
+
+  @property
+  def nearest_distance_gpu(self):
+    """Per-creature nearest surface distance of the last collide() (device)."""
+    return self._nearest_distance
+
+  @property
+  def nearest_tendroid_gpu(self):
+    """Per-creature nearest tendroid index of the last collide() (device)."""
+    return self._nearest_tendroid
+
+  def destroy(self):
+    """Release device resources."""
+    if self._grid:
+      self._grid.destroy()
+    self._grid = None
+    self._tendroid_a = None
+    self._tendroid_b = None
+    self._tendroid_radii = None
+    self.tendroid_count = 0
@@ -0,0 +1,206 @@
+"""
+Envelope Collision Kernels - Warp versions of the capsule tests
+
+wp.func ports of closest_point_on_segment, closest_points_between_segments
+and capsule_capsule_collision (envelope_collision.py, which stays the
+reference for unit tests), plus a batch kernel that tests every creature
+envelope against the tendroid capsules a hash grid returns for it.
+
+The tendroid grid holds bases projected to y = 0, so a tall tendroid is
+found from any height; the exact capsule test does the vertical part.
+"""
+
+import warp as wp
+
+wp.init()
+
+# Contact types (CollisionResult.contact_type)
+CONTACT_NONE = wp.constant(0)
+CONTACT_CYLINDER = wp.constant(1)
+CONTACT_CAP_A = wp.constant(2)
+CONTACT_CAP_B = wp.constant(3)
+
+CONTACT_TYPE_NAMES = ("none", "cylinder", "cap_a", "cap_b")
+
+SEGMENT_EPSILON = wp.constant(1.0e-10)
+AXIS_EPSILON = wp.constant(1.0e-8)
+
+
+@wp.func
+def closest_point_on_segment_wp(point: wp.vec3, seg_a: wp.vec3, seg_b: wp.vec3):
+  """Closest point on seg_a-seg_b to point; returns vec4(point, t)."""
+  ab = seg_b - seg_a
+  ab_length_sq = wp.dot(ab, ab)
+  if ab_length_sq < SEGMENT_EPSILON:
+    return wp.vec4(seg_a[0], seg_a[1], seg_a[2], 0.0)
+
+  t = wp.clamp(wp.dot(point - seg_a, ab) / ab_length_sq, 0.0, 1.0)
+  closest = seg_a + ab * t
+  return wp.vec4(closest[0], closest[1], closest[2], t)
+
+
+@wp.func
+def segment_segment_params(p1: wp.vec3, q1: wp.vec3, p2: wp.vec3, q2: wp.vec3):
+  """(s, t) of the closest points between p1-q1 and p2-q2."""
+  d1 = q1 - p1
+  d2 = q2 - p2
+  r = p1 - p2
+  a = wp.dot(d1, d1)
+  e = wp.dot(d2, d2)
+  f = wp.dot(d2, r)
+
+  s = float(0.0)
+  t = float(0.0)
+  if a < SEGMENT_EPSILON and e < SEGMENT_EPSILON:
+    return wp.vec2(s, t)
+
+  if a < SEGMENT_EPSILON:
+    t = wp.clamp(f / e, 0.0, 1.0)
+  else:
+    c = wp.dot(d1, r)
+    if e < SEGMENT_EPSILON:
+      s = wp.clamp(-c / a, 0.0, 1.0)
+    else:
+      b = wp.dot(d1, d2)
+      denom = a * e - b * b
+      if denom > SEGMENT_EPSILON:
+        s = wp.clamp((b * f - c * e) / denom, 0.0, 1.0)
+      t = (b * s + f) / e
+      if t < 0.0:
+        t = 0.0
+        s = wp.clamp(-c / a, 0.0, 1.0)
+      elif t > 1.0:
+        t = 1.0
+        s = wp.clamp((b - c) / a, 0.0, 1.0)
+
+  return wp.vec2(s, t)
+
+
+@wp.func
+def contact_type_from_t(t: float):
+  if t <= 0.0:
+    return CONTACT_CAP_A
+  if t >= 1.0:
+    return CONTACT_CAP_B
+  return CONTACT_CYLINDER
+
+
+@wp.func
+def fallback_normal(axis: wp.vec3):
+  """Perpendicular used when the query lies on the axis (reference rule)."""
+  if wp.abs(axis[0]) > 0.9:
+    return wp.vec3(0.0, 1.0, 0.0)
+  return wp.vec3(1.0, 0.0, 0.0)
+
+
+@wp.kernel
+def envelope_collision_kernel(
+  # Tendroid capsules (grid index = tendroid index)
+  grid: wp.uint64,
+  tendroid_a: wp.array(dtype=wp.vec3),
+  tendroid_b: wp.array(dtype=wp.vec3),
+  tendroid_radii: wp.array(dtype=float),
+  max_tendroid_radius: float,
+
+  # Creature envelopes
+  centers: wp.array(dtype=wp.vec3),
+  axes: wp.array(dtype=wp.vec3),
+  half_heights: wp.array(dtype=float),
+  radii: wp.array(dtype=float),
+
+  contact_offset: float,
+  report_distance: float,
+
+  # Per creature: closest tendroid surface
+  nearest_distance: wp.array(dtype=float),
+  nearest_tendroid: wp.array(dtype=int),
+
+  # Compact list of pairs with distance <= report_distance
+  max_contacts: int,
+  contact_count: wp.array(dtype=int),
+  contact_pairs: wp.array(dtype=wp.vec2i),
+  contact_distance: wp.array(dtype=float),
+  contact_point: wp.array(dtype=wp.vec3),
+  contact_normal: wp.array(dtype=wp.vec3),
+  contact_type: wp.array(dtype=int),
+):
+  """capsule_capsule_collision for each creature vs. its grid candidates."""
+  c = wp.tid()
+  center = centers[c]
+  axis = axes[c]
+  half_height = half_heights[c]
+  radius = radii[c]
+  p1 = center - axis * half_height
+  q1 = center + axis * half_height
+
+  # Horizontal reach of the envelope plus the widest tendroid
+  axis_xz = wp.sqrt(axis[0] * axis[0] + axis[2] * axis[2])
+  reach = half_height * axis_xz + radius + max_tendroid_radius + contact_offset
+  reach = reach + wp.max(report_distance, 0.0)
+
+  best = float(1.0e30)
+  best_index = int(-1)
+
+  query = wp.hash_grid_query(grid, wp.vec3(center[0], 0.0, center[2]), reach)
+  for t_idx in query:
+    p2 = tendroid_a[t_idx]
+    q2 = tendroid_b[t_idx]
+    effective_radius = tendroid_radii[t_idx] + contact_offset
+
+    st = segment_segment_params(p1, q1, p2, q2)
+    on_creature = p1 + (q1 - p1) * st[0]
+    on_tendroid = p2 + (q2 - p2) * st[1]
+    offset = on_creature - on_tendroid
+    axis_distance = wp.length(offset)
+    distance = axis_distance - effective_radius - radius
+
+    if distance < best:
+      best = distance
+      best_index = t_idx
+
+    if distance <= report_distance:
+      normal = fallback_normal(wp.normalize(q2 - p2))
+      if axis_distance > AXIS_EPSILON:
+        normal = offset / axis_distance
+
+      slot = wp.atomic_add(contact_count, 0, 1)
+      if slot < max_contacts:
+        contact_pairs[slot] = wp.vec2i(c, t_idx)
+        contact_distance[slot] = distance
+        contact_point[slot] = on_tendroid + normal * effective_radius
+        contact_normal[slot] = normal
+        contact_type[slot] = contact_type_from_t(st[1])
+
+  nearest_distance[c] = best
+  nearest_tendroid[c] = best_index
+
+
+@wp.kernel
+def point_capsule_kernel(
+  points: wp.array(dtype=wp.vec3),
+  capsule_a: wp.vec3,
+  capsule_b: wp.vec3,
+  capsule_axis: wp.vec3,
+  effective_radius: float,
+  # Outputs (point_capsule_collision fields)
+  distances: wp.array(dtype=float),
+  contact_points: wp.array(dtype=wp.vec3),
+  contact_normals: wp.array(dtype=wp.vec3),
+  contact_types: wp.array(dtype=int),
+):
+  """point_capsule_collision for many points against one capsule."""
+  i = wp.tid()
+  point = points[i]
+  closest = closest_point_on_segment_wp(point, capsule_a, capsule_b)
+  on_axis = wp.vec3(closest[0], closest[1], closest[2])
+
+  to_point = point - on_axis
+  distance_to_axis = wp.length(to_point)
+  normal = fallback_normal(capsule_axis)
+  if distance_to_axis > AXIS_EPSILON:
+    normal = to_point / distance_to_axis
+
+  distances[i] = distance_to_axis - effective_radius
+  contact_points[i] = on_axis + normal * effective_radius
+  contact_normals[i] = normal
+  contact_types[i] = contact_type_from_t(closest[3])
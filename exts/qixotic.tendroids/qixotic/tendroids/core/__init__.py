@@ -8,6 +8,7 @@ from .warp_tendroid import V2WarpTendroid
 from .deformer import V2Deformer
 from .warp_deformer import V2WarpDeformer
 from .batch_warp_deformer import BatchWarpDeformer
+from .frustum_culler import FrustumCuller
 
 __all__ = [
     "V2Tendroid",
@@ -16,4 +17,5 @@ __all__ = [
     "V2Deformer",
     "V2WarpDeformer",
     "BatchWarpDeformer",
+    "FrustumCuller",
 ]
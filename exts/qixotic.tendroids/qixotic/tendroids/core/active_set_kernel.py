@@ -0,0 +1,414 @@
+"""
+Active-Set Batch Deform Kernels
+
+Most tendroids are at rest most of the time: no bubble in phase 1/2,
+no deflection bend and a constant (or disabled) wave. Their output
+would be identical to last frame, so recomputing and re-uploading them
+is wasted work.
+
+mark_active_tendroids_kernel compares each tendroid's deform inputs to
+the ones it was last deformed with. Changed tendroids append their
+vertex range, split into ACTIVE_CHUNK-vertex work items, to a compacted
+list (atomic counter). The active_* kernels then run only those chunks;
+threads past the live chunk count exit after one read.
+
+A FrustumCuller may veto tendroids for the frame (off screen or on a
+reduced LOD rate) through skip_flags. Their applied inputs are left
+alone, so they come back dirty when they next run.
+
+With analytic normals the stored kernels write normals for the same
+chunks; clean tendroids keep last frame's normals along with their
+points.
+
+Launch sizes stay fixed for a given layout (chunk count if every
+tendroid were active), so the sequence can be captured in a CUDA graph.
+"""
+
+import warp as wp
+
+from .batch_deform_kernel import deform_normal, deform_vertex
+from .procedural_deform_kernel import procedural_deform_vertex
+
+wp.init()
+
+# Vertices per work item in the compacted list
+ACTIVE_CHUNK = wp.constant(64)
+
+
+@wp.kernel
+def mark_active_tendroids_kernel(
+    # Per-tendroid layout (0 vertices = free slot)
+    vertex_counts: wp.array(dtype=int),
+
+    # 1 = deform regardless of inputs (new slot, output target changed)
+    force_dirty: wp.array(dtype=int),
+
+    # 1 = not this frame (FrustumCuller); state is kept so it runs later
+    skip_flags: wp.array(dtype=int),
+
+    # Current deform inputs
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
+
+    # Inputs of the last deform (updated for active tendroids)
+    applied_inputs: wp.array(dtype=wp.vec4),
+    applied_bend: wp.array(dtype=wp.vec4),
+
+    # Outputs: per-tendroid flag + compacted chunk list
+    dirty_flags: wp.array(dtype=int),
+    active_chunk_count: wp.array(dtype=int),
+    chunk_slots: wp.array(dtype=int),
+    chunk_starts: wp.array(dtype=int),
+):
+    """Flag tendroids whose inputs changed and enqueue their vertex chunks."""
+    t = wp.tid()
+
+    count = vertex_counts[t]
+    if count == 0 or skip_flags[t] != 0:
+        dirty_flags[t] = 0
+        return
+
+    inputs = wp.vec4(bubble_y[t], bubble_radius[t], wave_dx[t], wave_dz[t])
+    axis = bend_axes[t]
+    bend = wp.vec4(bend_angles[t], axis[0], axis[1], axis[2])
+
+    changed = force_dirty[t] != 0
+    if wp.length_sq(inputs - applied_inputs[t]) > 0.0:
+        changed = True
+    if wp.length_sq(bend - applied_bend[t]) > 0.0:
+        changed = True
+
+    if not changed:
+        dirty_flags[t] = 0
+        return
+
+    dirty_flags[t] = 1
+    force_dirty[t] = 0
+    applied_inputs[t] = inputs
+    applied_bend[t] = bend
+
+    chunks = (count + ACTIVE_CHUNK - 1) // ACTIVE_CHUNK
+    base = wp.atomic_add(active_chunk_count, 0, chunks)
+    for i in range(chunks):
+        chunk_slots[base + i] = t
+        chunk_starts[base + i] = i * ACTIVE_CHUNK
+
+
+@wp.func
+def active_vertex(
+    tid: int,
+    active_chunk_count: wp.array(dtype=int),
+    chunk_slots: wp.array(dtype=int),
+    chunk_starts: wp.array(dtype=int),
+    vertex_counts: wp.array(dtype=int),
+):
+    """(slot, local vertex) for this thread, or slot -1 if it has no work."""
+    c = tid // ACTIVE_CHUNK
+    if c >= active_chunk_count[0]:
+        return wp.vec2i(-1, 0)
+
+    t = chunk_slots[c]
+    local = chunk_starts[c] + tid - c * ACTIVE_CHUNK
+    if local >= vertex_counts[t]:
+        return wp.vec2i(-1, 0)
+    return wp.vec2i(t, local)
+
+
+@wp.kernel
+def active_deform_kernel(
+    # Compacted work list
+    active_chunk_count: wp.array(dtype=int),
+    chunk_slots: wp.array(dtype=int),
+    chunk_starts: wp.array(dtype=int),
+    vertex_offsets: wp.array(dtype=int),
+    vertex_counts: wp.array(dtype=int),
+
+    # Stored rest pose
+    base_points: wp.array(dtype=wp.vec3),
+    height_factors: wp.array(dtype=float),
+    out_points: wp.array(dtype=wp.vec3),
+
+    # Per-tendroid deform state
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
+    cylinder_radius: wp.array(dtype=float),
+    max_amplitude: wp.array(dtype=float),
+    bulge_width: wp.array(dtype=float),
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
+):
+    """batch_deform_kernel over active chunks only."""
+    work = active_vertex(wp.tid(), active_chunk_count, chunk_slots, chunk_starts, vertex_counts)
+    t = work[0]
+    if t < 0:
+        return
+
+    v = vertex_offsets[t] + work[1]
+    out_points[v] = deform_vertex(
+        base_points[v], height_factors[v],
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+
+
+@wp.kernel
+def active_deform_fabric_kernel(
+    active_chunk_count: wp.array(dtype=int),
+    chunk_slots: wp.array(dtype=int),
+    chunk_starts: wp.array(dtype=int),
+    vertex_offsets: wp.array(dtype=int),
+    vertex_counts: wp.array(dtype=int),
+    base_points: wp.array(dtype=wp.vec3),
+    height_factors: wp.array(dtype=float),
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
+    cylinder_radius: wp.array(dtype=float),
+    max_amplitude: wp.array(dtype=float),
+    bulge_width: wp.array(dtype=float),
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
+
+    # Tendroid -> Fabric prim (-1 = not selected)
+    tendroid_to_fabric: wp.array(dtype=int),
+    fabric_points: wp.fabricarrayarray(dtype=wp.vec3),
+):
+    """batch_deform_fabric_kernel over active chunks; clean meshes are not written."""
+    work = active_vertex(wp.tid(), active_chunk_count, chunk_slots, chunk_starts, vertex_counts)
+    t = work[0]
+    if t < 0:
+        return
+    prim = tendroid_to_fabric[t]
+    if prim < 0:
+        return
+
+    v = vertex_offsets[t] + work[1]
+    fabric_points[prim][work[1]] = deform_vertex(
+        base_points[v], height_factors[v],
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+
+
+@wp.kernel
+def active_deform_normals_kernel(
+    active_chunk_count: wp.array(dtype=int),
+    chunk_slots: wp.array(dtype=int),
+    chunk_starts: wp.array(dtype=int),
+    vertex_offsets: wp.array(dtype=int),
+    vertex_counts: wp.array(dtype=int),
+    base_points: wp.array(dtype=wp.vec3),
+    height_factors: wp.array(dtype=float),
+    out_points: wp.array(dtype=wp.vec3),
+    out_normals: wp.array(dtype=wp.vec3),
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
+    cylinder_radius: wp.array(dtype=float),
+    cylinder_length: wp.array(dtype=float),
+    max_amplitude: wp.array(dtype=float),
+    bulge_width: wp.array(dtype=float),
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
+):
+    """batch_deform_normals_kernel over active chunks only."""
+    work = active_vertex(wp.tid(), active_chunk_count, chunk_slots, chunk_starts, vertex_counts)
+    t = work[0]
+    if t < 0:
+        return
+
+    v = vertex_offsets[t] + work[1]
+    pos = base_points[v]
+    h_factor = height_factors[v]
+    out_points[v] = deform_vertex(
+        pos, h_factor,
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+    out_normals[v] = deform_normal(
+        pos, h_factor,
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], cylinder_length[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+
+
+@wp.kernel
+def active_deform_fabric_normals_kernel(
+    active_chunk_count: wp.array(dtype=int),
+    chunk_slots: wp.array(dtype=int),
+    chunk_starts: wp.array(dtype=int),
+    vertex_offsets: wp.array(dtype=int),
+    vertex_counts: wp.array(dtype=int),
+    base_points: wp.array(dtype=wp.vec3),
+    height_factors: wp.array(dtype=float),
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
+    cylinder_radius: wp.array(dtype=float),
+    cylinder_length: wp.array(dtype=float),
+    max_amplitude: wp.array(dtype=float),
+    bulge_width: wp.array(dtype=float),
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
+    tendroid_to_fabric: wp.array(dtype=int),
+    fabric_points: wp.fabricarrayarray(dtype=wp.vec3),
+    fabric_normals: wp.fabricarrayarray(dtype=wp.vec3),
+):
+    """batch_deform_fabric_normals_kernel over active chunks only."""
+    work = active_vertex(wp.tid(), active_chunk_count, chunk_slots, chunk_starts, vertex_counts)
+    t = work[0]
+    if t < 0:
+        return
+    prim = tendroid_to_fabric[t]
+    if prim < 0:
+        return
+
+    v = vertex_offsets[t] + work[1]
+    pos = base_points[v]
+    h_factor = height_factors[v]
+    fabric_points[prim][work[1]] = deform_vertex(
+        pos, h_factor,
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+    fabric_normals[prim][work[1]] = deform_normal(
+        pos, h_factor,
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], cylinder_length[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+
+
+@wp.kernel
+def active_procedural_deform_kernel(
+    active_chunk_count: wp.array(dtype=int),
+    chunk_slots: wp.array(dtype=int),
+    chunk_starts: wp.array(dtype=int),
+    vertex_offsets: wp.array(dtype=int),
+    vertex_counts: wp.array(dtype=int),
+    out_points: wp.array(dtype=wp.vec3),
+
+    # Procedural rest pose + deform state (see procedural_deform_kernel)
+    radial_segments: wp.array(dtype=int),
+    height_segments: wp.array(dtype=int),
+    cylinder_radius: wp.array(dtype=float),
+    cylinder_length: wp.array(dtype=float),
+    flare_height: wp.array(dtype=float),
+    flare_radius: wp.array(dtype=float),
+    terrain_offsets: wp.array(dtype=float),
+    terrain_start: wp.array(dtype=int),
+    terrain_rings: wp.array(dtype=int),
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
+    max_amplitude: wp.array(dtype=float),
+    bulge_width: wp.array(dtype=float),
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
+):
+    """procedural_deform_kernel over active chunks only."""
+    work = active_vertex(wp.tid(), active_chunk_count, chunk_slots, chunk_starts, vertex_counts)
+    t = work[0]
+    if t < 0:
+        return
+
+    out_points[vertex_offsets[t] + work[1]] = procedural_deform_vertex(
+        t, work[1],
+        radial_segments, height_segments,
+        cylinder_radius, cylinder_length,
+        flare_height, flare_radius,
+        terrain_offsets, terrain_start, terrain_rings,
+        bubble_y, bubble_radius, wave_dx, wave_dz,
+        max_amplitude, bulge_width, bend_angles, bend_axes,
+    )
+
+
+@wp.kernel
+def active_procedural_deform_fabric_kernel(
+    active_chunk_count: wp.array(dtype=int),
+    chunk_slots: wp.array(dtype=int),
+    chunk_starts: wp.array(dtype=int),
+    vertex_offsets: wp.array(dtype=int),
+    vertex_counts: wp.array(dtype=int),
+    radial_segments: wp.array(dtype=int),
+    height_segments: wp.array(dtype=int),
+    cylinder_radius: wp.array(dtype=float),
+    cylinder_length: wp.array(dtype=float),
+    flare_height: wp.array(dtype=float),
+    flare_radius: wp.array(dtype=float),
+    terrain_offsets: wp.array(dtype=float),
+    terrain_start: wp.array(dtype=int),
+    terrain_rings: wp.array(dtype=int),
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
+    max_amplitude: wp.array(dtype=float),
+    bulge_width: wp.array(dtype=float),
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
+    tendroid_to_fabric: wp.array(dtype=int),
+    fabric_points: wp.fabricarrayarray(dtype=wp.vec3),
+):
+    """procedural_deform_fabric_kernel over active chunks only."""
+    work = active_vertex(wp.tid(), active_chunk_count, chunk_slots, chunk_starts, vertex_counts)
+    t = work[0]
+    if t < 0:
+        return
+    prim = tendroid_to_fabric[t]
+    if prim < 0:
+        return
+
+    fabric_points[prim][work[1]] = procedural_deform_vertex(
+        t, work[1],
+        radial_segments, height_segments,
+        cylinder_radius, cylinder_length,
+        flare_height, flare_radius,
+        terrain_offsets, terrain_start, terrain_rings,
+        bubble_y, bubble_radius, wave_dx, wave_dz,
+        max_amplitude, bulge_width, bend_angles, bend_axes,
+    )
+
+
+@wp.kernel
+def active_scatter_points_to_fabric_kernel(
+    active_chunk_count: wp.array(dtype=int),
+    chunk_slots: wp.array(dtype=int),
+    chunk_starts: wp.array(dtype=int),
+    vertex_offsets: wp.array(dtype=int),
+    vertex_counts: wp.array(dtype=int),
+    points: wp.array(dtype=wp.vec3),
+    tendroid_to_fabric: wp.array(dtype=int),
+    fabric_points: wp.fabricarrayarray(dtype=wp.vec3),
+):
+    """scatter_points_to_fabric_kernel for the meshes deformed this frame."""
+    work = active_vertex(wp.tid(), active_chunk_count, chunk_slots, chunk_starts, vertex_counts)
+    t = work[0]
+    if t < 0:
+        return
+    prim = tendroid_to_fabric[t]
+    if prim < 0:
+        return
+
+    fabric_points[prim][work[1]] = points[vertex_offsets[t] + work[1]]
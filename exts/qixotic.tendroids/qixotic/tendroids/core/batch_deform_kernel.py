@@ -3,13 +3,285 @@ Batch Warp GPU Kernel for Multi-Tendroid Deformation
 
 Processes ALL vertices from ALL tendroids in a SINGLE kernel launch.
 Eliminates per-tendroid kernel overhead for massive performance gains.
+
+Deformation per vertex: Gaussian bubble bulge, height-weighted
+deflection bend about the tendroid base, then wave sway.
+
+Two output variants share the same deformation math:
+- batch_deform_kernel: writes into one contiguous out_points array
+- batch_deform_fabric_kernel: scatters straight into each mesh's
+  Fabric points buffer (device-to-device, no host round-trip)
+
+The *_normals_kernel variants also write analytic vertex normals
+(deform_normal) next to the points, so shading follows the bulge,
+bend and sway without a renderer-side normal recompute.
+
+update_tendroid_states_kernel derives the per-tendroid bubble and
+wave inputs on device from BubbleGPUManager state;
+interpolate_tendroid_states_kernel blends two such states for
+fixed-rate simulation rendered at display rate.
 """
 
 import warp as wp
 
+from .device_wave_state import tendroid_wave_offset
+
 wp.init()
 
 
+@wp.kernel
+def update_tendroid_states_kernel(
+    # Tendroid -> bubble slot (-1 = no bubble)
+    tendroid_bubble_ids: wp.array(dtype=int),
+    
+    # BubbleGPUManager state (read only)
+    bubble_phases: wp.array(dtype=int),
+    bubble_world_y: wp.array(dtype=float),
+    bubble_current_radius: wp.array(dtype=float),
+    
+    # Per-tendroid placement and geometry
+    tendroid_x: wp.array(dtype=float),
+    tendroid_base_y: wp.array(dtype=float),
+    tendroid_z: wp.array(dtype=float),
+    cylinder_radius: wp.array(dtype=float),
+    
+    # Global parameters
+    diameter_multiplier: float,
+    wave_params: wp.array(dtype=float),
+    
+    # Outputs (preallocated, per-tendroid)
+    out_bubble_y: wp.array(dtype=float),
+    out_bubble_radius: wp.array(dtype=float),
+    out_wave_dx: wp.array(dtype=float),
+    out_wave_dz: wp.array(dtype=float),
+):
+    """
+    Compute deform inputs for one tendroid from its bubble slot.
+    
+    Rising (1) and exiting (2) bubbles drive the bulge; every other
+    phase leaves the tendroid at rest radius. Wave offset uses the
+    same spatial variation as the bubble physics kernel.
+    """
+    t = wp.tid()
+    
+    rest_radius = cylinder_radius[t]
+    local_y = 0.0
+    radius = rest_radius
+    
+    b = tendroid_bubble_ids[t]
+    if b >= 0:
+        phase = bubble_phases[b]
+        if phase == 1 or phase == 2:
+            local_y = bubble_world_y[b] - tendroid_base_y[t]
+            radius = bubble_current_radius[b] * diameter_multiplier
+    
+    out_bubble_y[t] = local_y
+    out_bubble_radius[t] = radius
+    
+    offset = tendroid_wave_offset(wave_params, tendroid_x[t], tendroid_z[t])
+    out_wave_dx[t] = offset[0]
+    out_wave_dz[t] = offset[1]
+
+
+@wp.kernel
+def interpolate_tendroid_states_kernel(
+    # Previous sim step
+    prev_bubble_y: wp.array(dtype=float),
+    prev_bubble_radius: wp.array(dtype=float),
+    prev_wave_dx: wp.array(dtype=float),
+    prev_wave_dz: wp.array(dtype=float),
+    prev_bend_angle: wp.array(dtype=float),
+    prev_bend_axis: wp.array(dtype=wp.vec3),
+    
+    # Latest sim step
+    curr_bubble_y: wp.array(dtype=float),
+    curr_bubble_radius: wp.array(dtype=float),
+    curr_wave_dx: wp.array(dtype=float),
+    curr_wave_dz: wp.array(dtype=float),
+    curr_bend_angle: wp.array(dtype=float),
+    curr_bend_axis: wp.array(dtype=wp.vec3),
+    
+    alpha: float,
+    
+    # Outputs (deform inputs for this render frame)
+    out_bubble_y: wp.array(dtype=float),
+    out_bubble_radius: wp.array(dtype=float),
+    out_wave_dx: wp.array(dtype=float),
+    out_wave_dz: wp.array(dtype=float),
+    out_bend_angle: wp.array(dtype=float),
+    out_bend_axis: wp.array(dtype=wp.vec3),
+):
+    """
+    Blend one tendroid's deform inputs between two sim steps.
+    
+    Bubbles only rise, so a bubble that appeared (previous y at the
+    base) or dropped (pop / respawn) snaps to the latest state instead
+    of sweeping the bulge along the tendroid.
+    """
+    t = wp.tid()
+    
+    y0 = prev_bubble_y[t]
+    y1 = curr_bubble_y[t]
+    if y0 <= 0.0 or y1 < y0:
+        out_bubble_y[t] = y1
+        out_bubble_radius[t] = curr_bubble_radius[t]
+    else:
+        out_bubble_y[t] = wp.lerp(y0, y1, alpha)
+        out_bubble_radius[t] = wp.lerp(prev_bubble_radius[t], curr_bubble_radius[t], alpha)
+    
+    out_wave_dx[t] = wp.lerp(prev_wave_dx[t], curr_wave_dx[t], alpha)
+    out_wave_dz[t] = wp.lerp(prev_wave_dz[t], curr_wave_dz[t], alpha)
+    
+    out_bend_angle[t] = wp.lerp(prev_bend_angle[t], curr_bend_angle[t], alpha)
+    axis = wp.lerp(prev_bend_axis[t], curr_bend_axis[t], alpha)
+    axis_length = wp.length(axis)
+    if axis_length > 1.0e-6:
+        out_bend_axis[t] = axis / axis_length
+    else:
+        out_bend_axis[t] = curr_bend_axis[t]
+
+
+@wp.func
+def deform_vertex(
+    pos: wp.vec3,
+    h_factor: float,
+    t_bubble_y: float,
+    t_bubble_radius: float,
+    t_wave_dx: float,
+    t_wave_dz: float,
+    t_cyl_radius: float,
+    t_max_amp: float,
+    t_bulge_width: float,
+    t_bend_angle: float,
+    t_bend_axis: wp.vec3,
+):
+    """
+    Deform one rest-pose vertex: Gaussian bulge, bend, then wave sway.
+    
+    The bend rotates the scaled vertex about the tendroid base by
+    t_bend_angle * h_factor, so the base stays planted and the tip
+    takes the full angle. Wave displacement is added AFTER radial
+    scaling so the centerline does not move when the bubble passes.
+    """
+    vertex_y = pos[1]
+    
+    # Calculate bubble deformation
+    max_radius = t_cyl_radius * (1.0 + t_max_amp)
+    radius_range = max_radius - t_cyl_radius
+    
+    growth_factor = 0.0
+    if radius_range > 0.0:
+        growth_factor = (t_bubble_radius - t_cyl_radius) / radius_range
+        growth_factor = wp.clamp(growth_factor, 0.0, 1.0)
+    
+    current_amplitude = t_max_amp * growth_factor
+    
+    sigma = t_bubble_radius * t_bulge_width
+    dist = vertex_y - t_bubble_y
+    
+    gaussian = 0.0
+    if sigma > 0.0:
+        gaussian = wp.exp(-(dist * dist) / (2.0 * sigma * sigma))
+    
+    displacement = current_amplitude * gaussian
+    scale = 1.0 + displacement
+    
+    # Apply radial scaling
+    scaled = wp.vec3(pos[0] * scale, vertex_y, pos[2] * scale)
+    
+    # Deflection bend (axis lies in the XZ plane through the base)
+    if t_bend_angle != 0.0:
+        q = wp.quat_from_axis_angle(t_bend_axis, t_bend_angle * h_factor)
+        scaled = wp.quat_rotate(q, scaled)
+    
+    # Add wave displacement
+    return wp.vec3(
+        scaled[0] + t_wave_dx * h_factor,
+        scaled[1],
+        scaled[2] + t_wave_dz * h_factor,
+    )
+
+
+@wp.func
+def height_factor_slope(y: float, cyl_length: float):
+    """d/dy of the smooth cubic sway weight (compute_height_factors)."""
+    if cyl_length <= 0.0:
+        return 0.0
+    ratio = y / cyl_length
+    if ratio <= 0.0 or ratio >= 1.0:
+        return 0.0
+    return 6.0 * ratio * (1.0 - ratio) / cyl_length
+
+
+@wp.func
+def deform_normal(
+    pos: wp.vec3,
+    h_factor: float,
+    t_bubble_y: float,
+    t_bubble_radius: float,
+    t_wave_dx: float,
+    t_wave_dz: float,
+    t_cyl_radius: float,
+    t_cyl_length: float,
+    t_max_amp: float,
+    t_bulge_width: float,
+    t_bend_angle: float,
+    t_bend_axis: wp.vec3,
+):
+    """
+    Analytic normal of deform_vertex() at one rest-pose vertex.
+    
+    Pushes the two surface tangents (around the ring and up the
+    height) through the deformation: the bulge tilts the height
+    tangent by the Gaussian slope, the bend rotates both tangents
+    and adds the rotation rate, and the sway adds its height slope.
+    The rest normal is radial, matching CylinderGenerator.
+    """
+    vertex_y = pos[1]
+    
+    # Bulge terms (same as deform_vertex)
+    max_radius = t_cyl_radius * (1.0 + t_max_amp)
+    radius_range = max_radius - t_cyl_radius
+    
+    growth_factor = 0.0
+    if radius_range > 0.0:
+        growth_factor = (t_bubble_radius - t_cyl_radius) / radius_range
+        growth_factor = wp.clamp(growth_factor, 0.0, 1.0)
+    
+    current_amplitude = t_max_amp * growth_factor
+    
+    sigma = t_bubble_radius * t_bulge_width
+    dist = vertex_y - t_bubble_y
+    
+    gaussian = 0.0
+    scale_slope = 0.0
+    if sigma > 0.0:
+        gaussian = wp.exp(-(dist * dist) / (2.0 * sigma * sigma))
+        scale_slope = -current_amplitude * gaussian * dist / (sigma * sigma)
+    
+    scale = 1.0 + current_amplitude * gaussian
+    
+    # Rest tangents: around the ring, and up the scaled profile
+    radial = wp.vec3(1.0, 0.0, 0.0)
+    ring = wp.sqrt(pos[0] * pos[0] + pos[2] * pos[2])
+    if ring > 1.0e-8:
+        radial = wp.vec3(pos[0] / ring, 0.0, pos[2] / ring)
+    around = wp.vec3(-radial[2], 0.0, radial[0])
+    along = wp.vec3(pos[0] * scale_slope, 1.0, pos[2] * scale_slope)
+    
+    h_slope = height_factor_slope(vertex_y, t_cyl_length)
+    
+    if t_bend_angle != 0.0:
+        q = wp.quat_from_axis_angle(t_bend_axis, t_bend_angle * h_factor)
+        scaled = wp.quat_rotate(q, wp.vec3(pos[0] * scale, vertex_y, pos[2] * scale))
+        around = wp.quat_rotate(q, around)
+        along = wp.quat_rotate(q, along) + wp.cross(t_bend_axis, scaled) * (t_bend_angle * h_slope)
+    
+    along = along + wp.vec3(t_wave_dx, 0.0, t_wave_dz) * h_slope
+    
+    return wp.normalize(wp.cross(along, around))
+
+
 @wp.kernel
 def batch_deform_kernel(
     # Vertex data (all tendroids concatenated)
@@ -33,61 +305,257 @@ def batch_deform_kernel(
     cylinder_length: wp.array(dtype=float),
     max_amplitude: wp.array(dtype=float),
     bulge_width: wp.array(dtype=float),
+    
+    # Per-tendroid deflection bend (BatchDeflectionManager device output)
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
 ):
     """
     Batch deform all vertices from all tendroids.
     
     Each thread processes one vertex:
-    1. Look up which tendroid this vertex belongs to
+    1. Look up which tendroid this vertex belongs to (-1 = free arena slot)
     2. Fetch that tendroid's bubble state
-    3. Apply deformation + wave
+    3. Apply deformation + bend + wave
     """
     tid = wp.tid()
     
     # Which tendroid does this vertex belong to?
-    tendroid_id = vertex_tendroid_ids[tid]
-    
-    # Fetch tendroid-specific parameters
-    t_bubble_y = bubble_y[tendroid_id]
-    t_bubble_radius = bubble_radius[tendroid_id]
-    t_wave_dx = wave_dx[tendroid_id]
-    t_wave_dz = wave_dz[tendroid_id]
-    t_cyl_radius = cylinder_radius[tendroid_id]
-    t_max_amp = max_amplitude[tendroid_id]
-    t_bulge_width = bulge_width[tendroid_id]
-    
-    # Fetch vertex data
+    t = vertex_tendroid_ids[tid]
+    if t < 0:
+        return
+    
+    out_points[tid] = deform_vertex(
+        base_points[tid], height_factors[tid],
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+
+
+@wp.kernel
+def batch_deform_fabric_kernel(
+    # Vertex data (all tendroids concatenated)
+    base_points: wp.array(dtype=wp.vec3),
+    height_factors: wp.array(dtype=float),
+    
+    # Per-vertex tendroid mapping
+    vertex_tendroid_ids: wp.array(dtype=int),
+    
+    # Per-tendroid bubble state
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
+    
+    # Per-tendroid wave displacement
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
+    
+    # Per-tendroid geometry
+    cylinder_radius: wp.array(dtype=float),
+    max_amplitude: wp.array(dtype=float),
+    bulge_width: wp.array(dtype=float),
+    
+    # Per-tendroid deflection bend
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
+    
+    # Scatter table: tendroid -> first batch vertex, tendroid -> Fabric prim
+    vertex_offsets: wp.array(dtype=int),
+    tendroid_to_fabric: wp.array(dtype=int),
+    
+    # Output: one points buffer per selected Fabric mesh
+    fabric_points: wp.fabricarrayarray(dtype=wp.vec3),
+):
+    """
+    Batch deform all vertices and write directly into Fabric.
+    
+    Each thread processes one vertex and scatters the result into
+    its mesh's Fabric points buffer via the per-tendroid table.
+    Tendroids missing from the Fabric selection (index -1) and free
+    arena vertices (tendroid id -1) are skipped.
+    """
+    tid = wp.tid()
+    
+    t = vertex_tendroid_ids[tid]
+    if t < 0:
+        return
+    prim = tendroid_to_fabric[t]
+    if prim < 0:
+        return
+    
+    local = tid - vertex_offsets[t]
+    
+    fabric_points[prim][local] = deform_vertex(
+        base_points[tid], height_factors[tid],
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+
+
+@wp.kernel
+def batch_deform_normals_kernel(
+    # Vertex data (all tendroids concatenated)
+    base_points: wp.array(dtype=wp.vec3),
+    out_points: wp.array(dtype=wp.vec3),
+    out_normals: wp.array(dtype=wp.vec3),
+    height_factors: wp.array(dtype=float),
+    
+    # Per-vertex tendroid mapping
+    vertex_tendroid_ids: wp.array(dtype=int),
+    
+    # Per-tendroid bubble state
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
+    
+    # Per-tendroid wave displacement
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
+    
+    # Per-tendroid geometry
+    cylinder_radius: wp.array(dtype=float),
+    cylinder_length: wp.array(dtype=float),
+    max_amplitude: wp.array(dtype=float),
+    bulge_width: wp.array(dtype=float),
+    
+    # Per-tendroid deflection bend
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
+):
+    """batch_deform_kernel plus analytic normals into out_normals."""
+    tid = wp.tid()
+    
+    t = vertex_tendroid_ids[tid]
+    if t < 0:
+        return
+    
     pos = base_points[tid]
     h_factor = height_factors[tid]
-    vertex_y = pos[1]
+    out_points[tid] = deform_vertex(
+        pos, h_factor,
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+    out_normals[tid] = deform_normal(
+        pos, h_factor,
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], cylinder_length[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+
+
+@wp.kernel
+def batch_deform_fabric_normals_kernel(
+    # Vertex data (all tendroids concatenated)
+    base_points: wp.array(dtype=wp.vec3),
+    height_factors: wp.array(dtype=float),
     
-    # Calculate bubble deformation
-    max_radius = t_cyl_radius * (1.0 + t_max_amp)
-    radius_range = max_radius - t_cyl_radius
+    # Per-vertex tendroid mapping
+    vertex_tendroid_ids: wp.array(dtype=int),
     
-    growth_factor = 0.0
-    if radius_range > 0.0:
-        growth_factor = (t_bubble_radius - t_cyl_radius) / radius_range
-        growth_factor = wp.clamp(growth_factor, 0.0, 1.0)
+    # Per-tendroid bubble state
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
     
-    current_amplitude = t_max_amp * growth_factor
+    # Per-tendroid wave displacement
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
     
-    sigma = t_bubble_radius * t_bulge_width
-    dist = vertex_y - t_bubble_y
+    # Per-tendroid geometry
+    cylinder_radius: wp.array(dtype=float),
+    cylinder_length: wp.array(dtype=float),
+    max_amplitude: wp.array(dtype=float),
+    bulge_width: wp.array(dtype=float),
     
-    gaussian = 0.0
-    if sigma > 0.0:
-        gaussian = wp.exp(-(dist * dist) / (2.0 * sigma * sigma))
+    # Per-tendroid deflection bend
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
     
-    displacement = current_amplitude * gaussian
-    scale = 1.0 + displacement
+    # Scatter table: tendroid -> first batch vertex, tendroid -> Fabric prim
+    vertex_offsets: wp.array(dtype=int),
+    tendroid_to_fabric: wp.array(dtype=int),
     
-    # Apply radial scaling
-    scaled_x = pos[0] * scale
-    scaled_z = pos[2] * scale
+    # Output: points and normals buffers per selected Fabric mesh
+    fabric_points: wp.fabricarrayarray(dtype=wp.vec3),
+    fabric_normals: wp.fabricarrayarray(dtype=wp.vec3),
+):
+    """batch_deform_fabric_kernel plus analytic normals into Fabric."""
+    tid = wp.tid()
     
-    # Add wave displacement
-    final_x = scaled_x + t_wave_dx * h_factor
-    final_z = scaled_z + t_wave_dz * h_factor
+    t = vertex_tendroid_ids[tid]
+    if t < 0:
+        return
+    prim = tendroid_to_fabric[t]
+    if prim < 0:
+        return
+    
+    local = tid - vertex_offsets[t]
+    pos = base_points[tid]
+    h_factor = height_factors[tid]
+    
+    fabric_points[prim][local] = deform_vertex(
+        pos, h_factor,
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+    fabric_normals[prim][local] = deform_normal(
+        pos, h_factor,
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], cylinder_length[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+
+
+@wp.kernel
+def scatter_points_to_fabric_kernel(
+    points: wp.array(dtype=wp.vec3),
+    vertex_tendroid_ids: wp.array(dtype=int),
+    vertex_offsets: wp.array(dtype=int),
+    tendroid_to_fabric: wp.array(dtype=int),
+    fabric_points: wp.fabricarrayarray(dtype=wp.vec3),
+):
+    """
+    Copy already-deformed batch output into Fabric points buffers.
+    
+    Device-to-device handoff for paths that deform into out_points
+    first (e.g. a captured frame graph).
+    """
+    tid = wp.tid()
+    
+    t = vertex_tendroid_ids[tid]
+    if t < 0:
+        return
+    prim = tendroid_to_fabric[t]
+    if prim < 0:
+        return
+    
+    fabric_points[prim][tid - vertex_offsets[t]] = points[tid]
+
+
+@wp.kernel
+def map_fabric_prims_kernel(
+    fabric_batch_index: wp.fabricarray(dtype=int),
+    index_base: int,
+    tendroid_to_fabric: wp.array(dtype=int),
+):
+    """
+    Invert the Fabric selection order into a tendroid -> prim table.
+    
+    Each thread handles one selected prim and records its position
+    in the selection under the batch index tagged on the mesh. Tags
+    outside [index_base, index_base + table size) belong to another
+    deformer (device partition) and are skipped.
+    """
+    i = wp.tid()
     
-    out_points[tid] = wp.vec3(final_x, vertex_y, final_z)
+    t = fabric_batch_index[i] - index_base
+    if t >= 0 and t < tendroid_to_fabric.shape[0]:
+        tendroid_to_fabric[t] = i
@@ -3,15 +3,113 @@ Batch Warp Deformer Manager
 
 Manages GPU arrays for batch processing ALL tendroid vertices
 in a single kernel launch. Eliminates per-tendroid kernel overhead.
+
+Two rest-pose modes:
+- stored (default): per-vertex base points, height factors and
+  tendroid ids on device
+- procedural: rest vertices rebuilt in-kernel from per-tendroid
+  cylinder parameters plus a flare terrain offset table
+
+Tendroids can be added and removed after build(). Per-tendroid arrays
+are indexed by SlotTable slot and vertices live in a RangeAllocator
+arena, so a change uploads only that tendroid's data; free vertices
+are skipped by the kernels (tendroid id / range owner -1).
+
+With active_set=True each deform first flags the tendroids whose
+inputs changed and launches only over their vertex chunks; resting
+tendroids keep last frame's output and their meshes are not rewritten.
+An attached FrustumCuller additionally holds back off-screen and
+distant tendroids (see frustum_culler.py). Reduced-resolution meshes
+added with add_lod_variant take their own slots; only the shown level
+of each tendroid is deformed.
+
+With analytic_normals=True (stored mode) the kernels also
+write deformed vertex normals to out_normals_gpu / the Fabric normals
+buffers in the same launch.
+
+The kernel for each target / rest pose / active set / normals
+combination is picked from the table in deform_modes.py.
+
+On the "cpu" device (hosts without CUDA) the stored full deform is split
+into contiguous vertex chunks launched from worker threads, and the one
+output buffer is scattered into Fabric's host buffers in a single pass.
 """
 
+import os
+from concurrent.futures import ThreadPoolExecutor
+
+import carb
 import numpy as np
 import warp as wp
 
-from .batch_deform_kernel import batch_deform_kernel
+from .batch_deform_kernel import (
+    map_fabric_prims_kernel,
+    update_tendroid_states_kernel,
+)
+from .active_set_kernel import ACTIVE_CHUNK, mark_active_tendroids_kernel
+from .deform_modes import select_mode
+from .device_wave_state import DeviceWaveState
+from .procedural_deform_kernel import extract_terrain_offsets
+from ..utils.slot_arena import RangeAllocator, SlotTable
 
 wp.init()
 
+# Smallest vertex chunk worth a CPU worker thread
+CPU_CHUNK_MIN_VERTICES = 16384
+
+# Per-tendroid device arrays: (attribute, dtype, value for a free slot)
+_TENDROID_ARRAYS = (
+    ('cylinder_radius_gpu', float, 0.0),
+    ('cylinder_length_gpu', float, 0.0),
+    ('max_amplitude_gpu', float, 0.0),
+    ('bulge_width_gpu', float, 0.0),
+    ('tendroid_x_gpu', float, 0.0),
+    ('tendroid_base_y_gpu', float, 0.0),
+    ('tendroid_z_gpu', float, 0.0),
+    ('tendroid_bubble_ids_gpu', int, -1),
+    ('vertex_offsets_gpu', int, 0),
+    ('tendroid_to_fabric_gpu', int, -1),
+    ('bubble_y_gpu', float, 0.0),
+    ('bubble_radius_gpu', float, 0.0),
+    ('wave_dx_gpu', float, 0.0),
+    ('wave_dz_gpu', float, 0.0),
+    ('_own_bend_angle_gpu', float, 0.0),
+    ('_own_bend_axis_gpu', wp.vec3, (1.0, 0.0, 0.0)),
+)
+
+_PROCEDURAL_ARRAYS = (
+    ('radial_segments_gpu', int, 1),
+    ('height_segments_gpu', int, 1),
+    ('flare_height_gpu', float, 0.0),
+    ('flare_radius_gpu', float, 0.0),
+    ('terrain_start_gpu', int, 0),
+    ('terrain_rings_gpu', int, 0),
+)
+
+_ACTIVE_SET_ARRAYS = (
+    ('vertex_counts_gpu', int, 0),
+    ('dirty_flags_gpu', int, 0),
+    ('_force_dirty_gpu', int, 0),
+    ('_applied_inputs_gpu', wp.vec4, (0.0, 0.0, 0.0, 0.0)),
+    ('_applied_bend_gpu', wp.vec4, (0.0, 0.0, 0.0, 0.0)),
+    ('skip_flags_gpu', int, 0),
+    ('lod_levels_gpu', int, 0),
+    ('bound_radius_gpu', float, 0.0),
+    ('lod_variant_gpu', int, -1),
+    ('lod_shown_gpu', int, 0),
+    ('_lod_live_gpu', int, 0),
+)
+
+# Bend allowance for culling bounds (deflection max is ~30 degrees)
+_BOUND_SWAY = 0.5
+
+
+def _host_dtype(dtype):
+    """NumPy dtype for a Warp scalar/vector dtype used above."""
+    if dtype is int:
+        return np.int32
+    return np.float32
+
 
 class BatchWarpDeformer:
     """
@@ -21,18 +119,67 @@ class BatchWarpDeformer:
     enabling single-kernel processing of entire scene.
     """
     
-    def __init__(self, device: str = "cuda:0"):
+    def __init__(
+        self,
+        device: str = "cuda:0",
+        procedural: bool = False,
+        slots: SlotTable = None,
+        active_set: bool = False,
+        analytic_normals: bool = False,
+        fabric_index_base: int = 0,
+        cpu_threads: int = 0
+    ):
+        """
+        Args:
+            device: Warp device
+            procedural: Rebuild rest vertices in-kernel instead of storing
+                them (needs builder geometry at registration; falls back
+                to stored mode if any tendroid is not a builder cylinder)
+            slots: Slot table shared with the bubble/deflection managers
+                (a private one is created if omitted)
+            active_set: Deform only tendroids whose inputs changed
+            analytic_normals: Also output deformed vertex normals
+                (stored rest points only)
+            fabric_index_base: Offset added to slots in the Fabric batch
+                tag, so deformers sharing a stage (one per device
+                partition) select only their own meshes
+            cpu_threads: Worker threads for stored-mode deforms on the
+                "cpu" device (0 = one per core, 1 = launch inline)
+        """
         self.device = device
+        self.procedural = procedural
+        self.active_set = active_set
+        self.analytic_normals = analytic_normals
+        self.fabric_index_base = int(fabric_index_base)
+        self.cpu_threads = int(cpu_threads) or (os.cpu_count() or 1)
+        self._cpu_pool = None
+        self._cpu_loaded = set()  # kernels launched once inline (module loaded)
+        self.slots = slots if slots is not None else SlotTable()
+        self._owns_slots = slots is None
+        self.vertex_arena = RangeAllocator()
+        self.terrain_arena = RangeAllocator()
+        
+        # Host tables indexed by slot (None / 0 = free slot)
         self.tendroids = []
         self.tendroid_names = []
         self.name_to_index = {}
         self.vertex_offsets = []
         self.vertex_counts = []
-        self.total_vertices = 0
+        self.total_vertices = 0  # Launch size: vertex arena extent
+        self._geometry = []
+        self._base_points = []
+        self._terrain_ranges = []
+        self._bubble_ids = []
+        self._lod_variant = []  # LOD level the slot's mesh draws (-1 = no variants)
+        self._lod_owner = []  # Tendroid a LOD slot belongs to (None = no variants)
+        self._lod_groups = {}  # Tendroid name -> slot per LOD level (None = missing)
+        self._lod_shown = {}  # Tendroid name -> shown LOD level
+        self._layout_version = 0
         
-        # GPU arrays
+        # GPU arrays (stored mode)
         self.base_points_gpu = None
         self.out_points_gpu = None
+        self.out_normals_gpu = None
         self.height_factors_gpu = None
         self.vertex_tendroid_ids_gpu = None
         self.bubble_y_gpu = None
@@ -44,6 +191,58 @@ class BatchWarpDeformer:
         self.max_amplitude_gpu = None
         self.bulge_width_gpu = None
         
+        # Procedural mode geometry (per tendroid + flare offset table)
+        self.radial_segments_gpu = None
+        self.height_segments_gpu = None
+        self.flare_height_gpu = None
+        self.flare_radius_gpu = None
+        self.terrain_offsets_gpu = None
+        self.terrain_start_gpu = None
+        self.terrain_rings_gpu = None
+        
+        # Procedural vertex -> slot lookup: sorted range starts + owners
+        self.range_starts_gpu = None
+        self.range_owners_gpu = None
+        
+        # Per-tendroid placement + bubble slot (device state update path)
+        self.tendroid_x_gpu = None
+        self.tendroid_base_y_gpu = None
+        self.tendroid_z_gpu = None
+        self.tendroid_bubble_ids_gpu = None
+        self.wave_state = None
+        
+        # Per-tendroid deflection bend; rebound to deflection manager output
+        self._own_bend_angle_gpu = None
+        self._own_bend_axis_gpu = None
+        self.bend_angle_gpu = None
+        self.bend_axis_gpu = None
+        
+        # Fabric scatter table (direct device write path)
+        self.vertex_offsets_gpu = None
+        self.tendroid_to_fabric_gpu = None
+        self._fabric_tagged_stage_id = None
+        self._fabric_full_write = True
+        self._fabric_normals = None
+        
+        # Active set: per-tendroid dirty tracking + compacted chunk list
+        self.vertex_counts_gpu = None
+        self.dirty_flags_gpu = None
+        self._force_dirty_gpu = None
+        self._applied_inputs_gpu = None
+        self._applied_bend_gpu = None
+        self.active_chunk_count_gpu = None
+        self.chunk_slots_gpu = None
+        self.chunk_starts_gpu = None
+        self._chunk_total = 0  # chunks if every tendroid were active
+        self._active_target = None  # 'points' or 'fabric'
+        self.skip_flags_gpu = None
+        self.lod_levels_gpu = None
+        self.bound_radius_gpu = None
+        self.lod_variant_gpu = None
+        self.lod_shown_gpu = None
+        self._lod_live_gpu = None
+        self.culler = None  # FrustumCuller (active set only)
+        
         # CPU staging (reused)
         self._bubble_y_cpu = None
         self._bubble_radius_cpu = None
@@ -51,64 +250,808 @@ class BatchWarpDeformer:
         self._wave_dz_cpu = None
         self._built = False
     
-    def register_tendroid(self, tendroid, base_points: list):
-        """Register a tendroid for batch processing."""
+    def register_tendroid(self, tendroid, base_points, geometry: dict = None):
+        """
+        Register a tendroid for batch processing.
+        
+        After build() this forwards to add_tendroid().
+        
+        Args:
+            tendroid: Tendroid wrapper (name, position, radius, length, deformer)
+            base_points: Rest vertices as uploaded to the mesh
+            geometry: V2TendroidBuilder data (procedural mode only)
+        """
         if self._built:
-            raise RuntimeError("Cannot register after build()")
+            self.add_tendroid(tendroid, base_points, geometry)
+            return
         name = tendroid.name
         if name in self.name_to_index:
             return
-        index = len(self.tendroids)
-        self.name_to_index[name] = index
-        self.tendroids.append(tendroid)
-        self.tendroid_names.append(name)
-        self.vertex_offsets.append(self.total_vertices)
-        self.vertex_counts.append(len(base_points))
-        self.total_vertices += len(base_points)
+        self._place(self.slots.acquire(name), tendroid, base_points, geometry)
+    
+    def _place(self, slot: int, tendroid, base_points, geometry):
+        """Record a tendroid in the host slot tables."""
+        while len(self.tendroids) <= slot:
+            self.tendroids.append(None)
+            self.tendroid_names.append(None)
+            self.vertex_offsets.append(0)
+            self.vertex_counts.append(0)
+            self._geometry.append(None)
+            self._base_points.append(None)
+            self._terrain_ranges.append((0, 0))
+            self._bubble_ids.append(-1)
+            self._lod_variant.append(-1)
+            self._lod_owner.append(None)
+        
+        self.name_to_index[tendroid.name] = slot
+        self.tendroids[slot] = tendroid
+        self.tendroid_names[slot] = tendroid.name
+        self.vertex_counts[slot] = len(base_points)
+        self._geometry[slot] = geometry
+        self._base_points[slot] = base_points if self.procedural else None
+    
+    def _clear_slot(self, slot: int):
+        """Mark a slot free in the host tables."""
+        self.tendroids[slot] = None
+        self.tendroid_names[slot] = None
+        self.vertex_offsets[slot] = 0
+        self.vertex_counts[slot] = 0
+        self._geometry[slot] = None
+        self._base_points[slot] = None
+        self._terrain_ranges[slot] = (0, 0)
+        self._bubble_ids[slot] = -1
+        self._lod_variant[slot] = -1
+        self._lod_owner[slot] = None
+    
+    def _live_slots(self):
+        """Occupied slots in slot order."""
+        return [i for i, t in enumerate(self.tendroids) if t is not None]
     
     def build(self):
         """Build GPU arrays after all tendroids registered."""
-        if self._built or not self.tendroids:
+        if self._built or not self.name_to_index:
             return
-        n_tendroids = len(self.tendroids)
         
-        all_base_points = []
-        all_height_factors = []
-        all_tendroid_ids = []
+        # Shared slots may already extend past our last tendroid
+        while len(self.tendroids) < self.slots.capacity:
+            self.tendroids.append(None)
+            self.tendroid_names.append(None)
+            self.vertex_offsets.append(0)
+            self.vertex_counts.append(0)
+            self._geometry.append(None)
+            self._base_points.append(None)
+            self._terrain_ranges.append((0, 0))
+            self._bubble_ids.append(-1)
+            self._lod_variant.append(-1)
+            self._lod_owner.append(None)
         
-        for i, tendroid in enumerate(self.tendroids):
-            deformer = tendroid.deformer
-            base_pts = deformer.base_points_gpu.numpy()
-            height_facs = deformer.height_factors_gpu.numpy()
-            for j in range(len(base_pts)):
-                all_base_points.append(tuple(base_pts[j]))
-                all_height_factors.append(float(height_facs[j]))
-                all_tendroid_ids.append(i)
+        # Slot order = vertex order on first build (no holes in the arena)
+        for slot in self._live_slots():
+            self.vertex_offsets[slot] = self.vertex_arena.allocate(self.vertex_counts[slot])
+        self.total_vertices = self.vertex_arena.extent
+        
+        if self.procedural and not self._build_procedural():
+            carb.log_warn(
+                "[BatchWarpDeformer] Procedural mode needs builder cylinders - "
+                "using stored rest points"
+            )
+            self.procedural = False
+            self.terrain_arena.clear()
+        self._base_points = [None] * len(self.tendroids)
+        
+        if not self.procedural:
+            self._build_stored()
+        
+        self.out_points_gpu = wp.zeros(self.vertex_arena.capacity, dtype=wp.vec3, device=self.device)
+        
+        if self.analytic_normals and self.procedural:
+            carb.log_warn(
+                "[BatchWarpDeformer] Analytic normals need stored rest points - "
+                "normals disabled"
+            )
+            self.analytic_normals = False
+        if self.analytic_normals:
+            self.out_normals_gpu = wp.zeros(self.vertex_arena.capacity, dtype=wp.vec3, device=self.device)
+        
+        self._allocate_tendroid_arrays(len(self.tendroids))
+        self._refresh_active_chunks()
+        self.wave_state = DeviceWaveState(device=self.device)
+        self.bend_angle_gpu = self._own_bend_angle_gpu
+        self.bend_axis_gpu = self._own_bend_axis_gpu
+        self._built = True
+    
+    def _allocate_tendroid_arrays(self, capacity: int):
+        """
+        (Re)allocate per-tendroid arrays from the host slot tables.
+        
+        Every slot below capacity is written (free slots get their
+        'free' value), so growing uploads the whole table once.
+        """
+        specs = self._tendroid_array_specs()
+        rows = [self._slot_values(slot) for slot in range(capacity)]
+        
+        for attr, dtype, _ in specs:
+            values = np.array([row[attr] for row in rows], dtype=_host_dtype(dtype))
+            setattr(self, attr, wp.array(values, dtype=dtype, device=self.device))
+        
+        self._bubble_y_cpu = np.zeros(capacity, dtype=np.float32)
+        self._bubble_radius_cpu = np.array([row['bubble_radius_gpu'] for row in rows], dtype=np.float32)
+        self._wave_dx_cpu = np.zeros(capacity, dtype=np.float32)
+        self._wave_dz_cpu = np.zeros(capacity, dtype=np.float32)
+    
+    def _tendroid_array_specs(self) -> tuple:
+        """Per-tendroid arrays allocated in the current mode."""
+        specs = _TENDROID_ARRAYS
+        if self.procedural:
+            specs += _PROCEDURAL_ARRAYS
+        if self.active_set:
+            specs += _ACTIVE_SET_ARRAYS
+        return specs
+    
+    def _slot_values(self, slot: int) -> dict:
+        """Per-tendroid array values for one slot (free defaults if empty)."""
+        specs = _TENDROID_ARRAYS + _PROCEDURAL_ARRAYS + _ACTIVE_SET_ARRAYS
+        values = {attr: free for attr, _, free in specs}
+        
+        tendroid = self.tendroids[slot] if slot < len(self.tendroids) else None
+        if tendroid is None:
+            return values
+        
+        values.update({
+            'cylinder_radius_gpu': tendroid.radius,
+            'cylinder_length_gpu': tendroid.length,
+            'max_amplitude_gpu': tendroid.deformer.max_amplitude,
+            'bulge_width_gpu': tendroid.deformer.bulge_width,
+            'tendroid_x_gpu': tendroid.position[0],
+            'tendroid_base_y_gpu': tendroid.position[1],
+            'tendroid_z_gpu': tendroid.position[2],
+            'vertex_offsets_gpu': self.vertex_offsets[slot],
+            'tendroid_bubble_ids_gpu': self._bubble_ids[slot],
+            'bubble_radius_gpu': tendroid.radius,
+            'vertex_counts_gpu': self.vertex_counts[slot],
+            '_force_dirty_gpu': 1,
+            'bound_radius_gpu': self._bound_radius(slot),
+            'lod_variant_gpu': self._lod_variant[slot],
+            'lod_shown_gpu': self._lod_shown.get(self._lod_owner[slot], 0),
+        })
+        
+        geometry = self._geometry[slot]
+        if self.procedural and geometry is not None:
+            start, size = self._terrain_ranges[slot]
+            radial = int(geometry['radial_segments'])
+            values.update({
+                'radial_segments_gpu': radial,
+                'height_segments_gpu': int(geometry['height_segments']),
+                'flare_height_gpu': geometry['flare_height'],
+                'flare_radius_gpu': geometry['radius'] * geometry['flare_radius_multiplier'],
+                'terrain_start_gpu': start,
+                'terrain_rings_gpu': size // radial if radial > 0 else 0,
+            })
+        return values
+    
+    def _bound_radius(self, slot: int) -> float:
+        """Culling capsule radius: widest of flare and max bulge, plus bend."""
+        tendroid = self.tendroids[slot]
+        geometry = self._geometry[slot] or {}
+        widest = max(
+            geometry.get('flare_radius_multiplier', 1.0),
+            1.0 + tendroid.deformer.max_amplitude
+        )
+        return tendroid.radius * widest + tendroid.length * _BOUND_SWAY
+    
+    def _build_stored(self):
+        """Upload per-vertex rest data (stored mode)."""
+        capacity = self.vertex_arena.capacity
+        all_base_points = np.zeros((capacity, 3), dtype=np.float32)
+        all_height_factors = np.zeros(capacity, dtype=np.float32)
+        all_tendroid_ids = np.full(capacity, -1, dtype=np.int32)
+        
+        # Slice copies per tendroid (offsets from the arena)
+        for slot in self._live_slots():
+            start, count = self.vertex_offsets[slot], self.vertex_counts[slot]
+            deformer = self.tendroids[slot].deformer
+            all_base_points[start:start + count] = self._host_base_points(deformer)
+            all_height_factors[start:start + count] = self._host_height_factors(deformer)
+            all_tendroid_ids[start:start + count] = slot
         
         self.base_points_gpu = wp.array(all_base_points, dtype=wp.vec3, device=self.device)
-        self.out_points_gpu = wp.zeros(self.total_vertices, dtype=wp.vec3, device=self.device)
         self.height_factors_gpu = wp.array(all_height_factors, dtype=float, device=self.device)
         self.vertex_tendroid_ids_gpu = wp.array(all_tendroid_ids, dtype=int, device=self.device)
+    
+    def _build_procedural(self) -> bool:
+        """
+        Build the flare terrain offset table (procedural mode).
         
-        cyl_radii = [t.radius for t in self.tendroids]
-        self.cylinder_radius_gpu = wp.array(cyl_radii, dtype=float, device=self.device)
-        self.cylinder_length_gpu = wp.array([t.length for t in self.tendroids], dtype=float, device=self.device)
-        self.max_amplitude_gpu = wp.array([t.deformer.max_amplitude for t in self.tendroids], dtype=float, device=self.device)
-        self.bulge_width_gpu = wp.array([t.deformer.bulge_width for t in self.tendroids], dtype=float, device=self.device)
-        
-        self.bubble_y_gpu = wp.zeros(n_tendroids, dtype=float, device=self.device)
-        self.bubble_radius_gpu = wp.array(cyl_radii, dtype=float, device=self.device)
-        self.wave_dx_gpu = wp.zeros(n_tendroids, dtype=float, device=self.device)
-        self.wave_dz_gpu = wp.zeros(n_tendroids, dtype=float, device=self.device)
-        
-        self._bubble_y_cpu = np.zeros(n_tendroids, dtype=np.float32)
-        self._bubble_radius_cpu = np.array(cyl_radii, dtype=np.float32)
-        self._wave_dx_cpu = np.zeros(n_tendroids, dtype=np.float32)
-        self._wave_dz_cpu = np.zeros(n_tendroids, dtype=np.float32)
-        self._built = True
+        Per-tendroid cylinder parameters are uploaded with the other
+        per-tendroid arrays.
+        
+        Returns:
+            False if any tendroid lacks builder geometry or its rest
+            points differ from the parametric cylinder beyond the flare
+        """
+        tables = {}
+        for slot in self._live_slots():
+            geometry, points = self._geometry[slot], self._base_points[slot]
+            if geometry is None or points is None:
+                return False
+            table = extract_terrain_offsets(points, geometry)
+            if table is None:
+                return False
+            tables[slot] = table[0]
+        
+        for slot, offsets in tables.items():
+            self._terrain_ranges[slot] = (self.terrain_arena.allocate(offsets.size), offsets.size)
+        
+        all_offsets = np.zeros(max(self.terrain_arena.capacity, 1), dtype=np.float32)
+        for slot, offsets in tables.items():
+            start = self._terrain_ranges[slot][0]
+            all_offsets[start:start + offsets.size] = offsets
+        
+        self.terrain_offsets_gpu = wp.array(all_offsets, dtype=float, device=self.device)
+        self._upload_range_table()
+        
+        carb.log_info(
+            f"[BatchWarpDeformer] Procedural rest pose: {self.total_vertices} vertices, "
+            f"{self.terrain_arena.extent} terrain offsets"
+        )
+        return True
+    
+    def _upload_range_table(self):
+        """
+        Upload sorted vertex range starts and owning slots (free = -1).
+        
+        Procedural kernels binary-search this table instead of reading
+        a per-vertex tendroid id. Its size is O(tendroids + holes).
+        """
+        entries = [
+            (self.vertex_offsets[slot], slot)
+            for slot in self._live_slots() if self.vertex_counts[slot] > 0
+        ]
+        entries += [(start, -1) for start, _ in self.vertex_arena.free_ranges()]
+        entries.sort()
+        if not entries:
+            entries = [(0, -1)]
+        
+        starts = np.array([e[0] for e in entries], dtype=np.int32)
+        owners = np.array([e[1] for e in entries], dtype=np.int32)
+        self.range_starts_gpu = wp.array(starts, dtype=int, device=self.device)
+        self.range_owners_gpu = wp.array(owners, dtype=int, device=self.device)
+    
+    def add_tendroid(self, tendroid, base_points, geometry: dict = None, bubble_id: int = -1):
+        """
+        Insert one tendroid into a built deformer.
+        
+        Reuses a freed vertex range when one fits; arrays grow (doubling)
+        only when the arena or slot table passes capacity. Otherwise only
+        this tendroid's vertices and per-tendroid values are uploaded.
+        
+        Args:
+            tendroid: Tendroid wrapper
+            base_points: Rest vertices as uploaded to the mesh
+            geometry: V2TendroidBuilder data (required in procedural mode)
+            bubble_id: BubbleGPUManager slot driving this tendroid (-1 = none)
+        
+        Returns:
+            Slot index, or None if procedural mode cannot rebuild it
+        """
+        if not self._built:
+            self.register_tendroid(tendroid, base_points, geometry)
+            return self.name_to_index.get(tendroid.name)
+        
+        name = tendroid.name
+        if name in self.name_to_index:
+            return self.name_to_index[name]
+        
+        terrain = None
+        if self.procedural:
+            terrain = extract_terrain_offsets(base_points, geometry) if geometry else None
+            if terrain is None:
+                carb.log_error(
+                    f"[BatchWarpDeformer] '{name}' is not a builder cylinder - "
+                    "cannot add to a procedural deformer"
+                )
+                return None
+        
+        slot = self.slots.acquire(name)
+        self._place(slot, tendroid, base_points, geometry)
+        self._base_points[slot] = None
+        
+        count = self.vertex_counts[slot]
+        start = self.vertex_arena.allocate(count)
+        self.vertex_offsets[slot] = start
+        self._ensure_vertex_capacity()
+        self.total_vertices = self.vertex_arena.extent
+        
+        if self.procedural:
+            offsets = terrain[0]
+            t_start = self.terrain_arena.allocate(offsets.size)
+            self._terrain_ranges[slot] = (t_start, offsets.size)
+            self._ensure_terrain_capacity()
+            if offsets.size:
+                self._copy_into(self.terrain_offsets_gpu, offsets, float, t_start)
+        elif count:
+            deformer = tendroid.deformer
+            self._copy_into(self.base_points_gpu, self._host_base_points(deformer), wp.vec3, start)
+            self._copy_into(self.height_factors_gpu, self._host_height_factors(deformer), float, start)
+            self.vertex_tendroid_ids_gpu[start:start + count].fill_(slot)
+        
+        if slot >= self.slot_capacity:
+            self._grow_tendroid_arrays(len(self.tendroids))
+        self._write_slot(slot, bubble_id)
+        
+        self._on_layout_changed()
+        return slot
+    
+    def remove_tendroid(self, name: str) -> bool:
+        """
+        Remove one tendroid; its vertex range is freed for reuse.
+        
+        Only the freed id range (stored mode) or the range table
+        (procedural mode) and the slot's per-tendroid values are written.
+        
+        Returns:
+            True if the tendroid was registered
+        """
+        slot = self.name_to_index.pop(name, None)
+        if slot is None:
+            return False
+        self._drop_lod_slot(name, slot)
+        
+        start, count = self.vertex_offsets[slot], self.vertex_counts[slot]
+        
+        if self._built:
+            self.vertex_arena.free(start, count)
+            if self.procedural:
+                self.terrain_arena.free(*self._terrain_ranges[slot])
+            elif count:
+                self.vertex_tendroid_ids_gpu[start:start + count].fill_(-1)
+        
+        self._clear_slot(slot)
+        if self._owns_slots:
+            self.slots.release(name)
+        
+        if self._built:
+            self.total_vertices = self.vertex_arena.extent
+            self._write_slot(slot, -1)
+            self._on_layout_changed()
+        return True
+    
+    def add_lod_variant(self, name: str, level: int, tendroid, base_points, geometry: dict = None):
+        """
+        Add a reduced-resolution mesh of a registered tendroid as an LOD level.
+        
+        The variant is inserted like add_tendroid (own slot, vertex range
+        and Fabric binding) and driven by the tendroid's bubble; the
+        tendroid's own mesh is level 0. Only the shown level is deformed
+        (FrustumCuller.switch_lod_meshes picks it), so the variant mesh
+        should start invisible.
+        
+        Args:
+            name: Registered tendroid the variant draws
+            level: LOD level (1 = first reduced level)
+            tendroid: Wrapper for the variant mesh (own name, same placement)
+            base_points: Variant rest vertices
+            geometry: Variant builder data (required in procedural mode)
+        
+        Returns:
+            Variant slot, or None if it could not be added
+        """
+        primary = self.name_to_index.get(name)
+        if primary is None or not self._built or not self.active_set or level < 1:
+            carb.log_warn(f"[BatchWarpDeformer] LOD variants need a built active-set deformer and '{name}'")
+            return None
+        if self._lod_owner[primary] not in (None, name):
+            carb.log_warn(f"[BatchWarpDeformer] '{name}' is itself an LOD variant")
+            return None
+        
+        group = self._lod_groups.get(name, [primary])
+        group += [None] * (level + 1 - len(group))
+        if group[level] is not None:
+            return group[level]
+        
+        slot = self.add_tendroid(tendroid, base_points, geometry, bubble_id=self._bubble_ids[primary])
+        if slot is None:
+            return None
+        
+        group[level] = slot
+        self._lod_groups[name] = group
+        self._lod_shown.setdefault(name, 0)
+        for member, member_level in ((primary, 0), (slot, level)):
+            self._lod_variant[member] = member_level
+            self._lod_owner[member] = name
+            self._write_slot(member, self._bubble_ids[primary])
+        return slot
+    
+    def switch_lod_variants(self) -> int:
+        """
+        Show the LOD level of the last cull for every tendroid with variants.
+        
+        Downloads the culled levels (syncs); a level without a variant
+        falls back to the next lower one. Changed tendroids swap mesh
+        visibility and the shown levels are uploaded in one copy.
+        
+        Returns:
+            Number of tendroids whose shown level changed
+        """
+        if not self._lod_groups or self.lod_levels_gpu is None:
+            return 0
+        
+        levels = self.lod_levels_gpu.numpy()
+        switched = 0
+        for name, group in self._lod_groups.items():
+            level = min(int(levels[group[0]]), len(group) - 1)
+            while level > 0 and group[level] is None:
+                level -= 1
+            shown = self._lod_shown[name]
+            if level == shown:
+                continue
+            self._set_mesh_visible(self.tendroids[group[shown]], False)
+            self._set_mesh_visible(self.tendroids[group[level]], True)
+            self._lod_shown[name] = level
+            switched += 1
+        
+        if switched:
+            self._upload_columns(['lod_shown_gpu'])
+        return switched
+    
+    def _drop_lod_slot(self, name: str, slot: int):
+        """Unlink a removed slot from its LOD group (a tendroid takes its variants along)."""
+        owner = self._lod_owner[slot]
+        group = self._lod_groups.get(owner) if owner is not None else None
+        if group is None:
+            return
+        
+        if owner == name:
+            del self._lod_groups[owner]
+            del self._lod_shown[owner]
+            for variant in group[1:]:
+                if variant is not None:
+                    self.remove_tendroid(self.tendroid_names[variant])
+            return
+        
+        # A removed variant: fall back to level 0, drop the group once empty
+        level = self._lod_variant[slot]
+        group[level] = None
+        if self._lod_shown[owner] == level:
+            self._lod_shown[owner] = 0
+            self._set_mesh_visible(self.tendroids[group[0]], True)
+        if all(member is None for member in group[1:]):
+            del self._lod_groups[owner]
+            del self._lod_shown[owner]
+            self._lod_variant[group[0]] = -1
+            self._lod_owner[group[0]] = None
+        if self._built:
+            self._upload_columns(['lod_variant_gpu', 'lod_shown_gpu'])
+    
+    @staticmethod
+    def _set_mesh_visible(tendroid, visible: bool):
+        """Show or hide a tendroid's mesh prim (no-op without one)."""
+        prim = getattr(tendroid, 'mesh_prim', None)
+        if not prim:
+            return
+        from pxr import UsdGeom
+        
+        imageable = UsdGeom.Imageable(prim)
+        if visible:
+            imageable.MakeVisible()
+        else:
+            imageable.MakeInvisible()
+    
+    @property
+    def has_lod_variants(self) -> bool:
+        """True if any tendroid has LOD mesh variants."""
+        return bool(self._lod_groups)
+    
+    def _on_layout_changed(self):
+        """Refresh lookup tables and invalidate captured launches."""
+        if self.procedural:
+            self._upload_range_table()
+        self._refresh_active_chunks()
+        self._layout_version += 1
+        self._fabric_tagged_stage_id = None  # Re-tag: slots may be reused
+    
+    def _write_slot(self, slot: int, bubble_id: int):
+        """Upload one slot's per-tendroid values (one element per array)."""
+        if self.tendroids[slot] is not None:
+            self._bubble_ids[slot] = bubble_id
+        values = self._slot_values(slot)
+        
+        for attr, dtype, _ in self._tendroid_array_specs():
+            value = np.array([values[attr]], dtype=_host_dtype(dtype))
+            self._copy_into(getattr(self, attr), value, dtype, slot)
+        
+        self._bubble_y_cpu[slot] = 0.0
+        self._bubble_radius_cpu[slot] = values['bubble_radius_gpu']
+        self._wave_dx_cpu[slot] = 0.0
+        self._wave_dz_cpu[slot] = 0.0
+    
+    def _copy_into(self, dst, values: np.ndarray, dtype, offset: int):
+        """Copy a small host array into dst[offset:] (no reallocation)."""
+        src = wp.array(values, dtype=dtype, device="cpu")
+        wp.copy(dst, src, dest_offset=offset, count=src.shape[0])
+    
+    def _grow_tendroid_arrays(self, capacity: int):
+        """Reallocate per-tendroid arrays for more slots (keeps bend binding if it fits)."""
+        bound_angles = self.bend_angle_gpu if self.bend_angle_gpu is not self._own_bend_angle_gpu else None
+        bound_axes = self.bend_axis_gpu
+        
+        # Live device state (bubble/wave/bend) is recomputed every frame
+        self._allocate_tendroid_arrays(max(capacity, 2 * self.slot_capacity))
+        
+        n = self._own_bend_angle_gpu.shape[0]
+        if bound_angles is not None and bound_angles.shape[0] >= n and bound_axes.shape[0] >= n:
+            self.bend_angle_gpu, self.bend_axis_gpu = bound_angles, bound_axes
+        else:
+            if bound_angles is not None:
+                carb.log_warn("[BatchWarpDeformer] Deflection arrays too small after growth - bend unbound")
+            self.unbind_deflection()
+    
+    def _ensure_vertex_capacity(self):
+        """Grow per-vertex arrays to the arena capacity, keeping contents."""
+        capacity = self.vertex_arena.capacity
+        if self.out_points_gpu.shape[0] >= capacity:
+            return
+        
+        self.out_points_gpu = self._grown(self.out_points_gpu, capacity, wp.vec3)
+        if self.out_normals_gpu is not None:
+            self.out_normals_gpu = self._grown(self.out_normals_gpu, capacity, wp.vec3)
+        if not self.procedural:
+            self.base_points_gpu = self._grown(self.base_points_gpu, capacity, wp.vec3)
+            self.height_factors_gpu = self._grown(self.height_factors_gpu, capacity, float)
+            self.vertex_tendroid_ids_gpu = self._grown(self.vertex_tendroid_ids_gpu, capacity, int, fill=-1)
+    
+    def _ensure_terrain_capacity(self):
+        """Grow the terrain offset table to the terrain arena capacity."""
+        capacity = max(self.terrain_arena.capacity, 1)
+        if self.terrain_offsets_gpu.shape[0] < capacity:
+            self.terrain_offsets_gpu = self._grown(self.terrain_offsets_gpu, capacity, float)
+    
+    def _grown(self, array, capacity: int, dtype, fill=None):
+        """New array of capacity with array copied into the front."""
+        if fill is None:
+            grown = wp.zeros(capacity, dtype=dtype, device=self.device)
+        else:
+            grown = wp.full(capacity, fill, dtype=dtype, device=self.device)
+        wp.copy(grown, array, count=array.shape[0])
+        return grown
+    
+    def _refresh_active_chunks(self):
+        """Size the compacted chunk list for the current layout (active set)."""
+        if not self.active_set:
+            return
+        
+        self._chunk_total = sum(
+            (count + ACTIVE_CHUNK - 1) // ACTIVE_CHUNK for count in self.vertex_counts
+        )
+        capacity = max(self._chunk_total, 1)
+        if self.chunk_slots_gpu is None or self.chunk_slots_gpu.shape[0] < capacity:
+            self.chunk_slots_gpu = wp.zeros(capacity, dtype=int, device=self.device)
+            self.chunk_starts_gpu = wp.zeros(capacity, dtype=int, device=self.device)
+        if self.active_chunk_count_gpu is None:
+            self.active_chunk_count_gpu = wp.zeros(1, dtype=int, device=self.device)
+    
+    def _mark_active(self, target: str):
+        """
+        Build this frame's active chunk list (device only, no sync).
+        
+        Switching output target ('points' / 'fabric') forces a full
+        pass, since the skipped tendroids were only current in the other.
+        """
+        if target != self._active_target:
+            self._force_dirty_gpu.fill_(1)
+            self._active_target = target
+        
+        if self.culler is not None:
+            self.culler.launch(self)
+        
+        self.active_chunk_count_gpu.zero_()
+        wp.launch(
+            kernel=mark_active_tendroids_kernel,
+            dim=self.slot_capacity,
+            inputs=[
+                self.vertex_counts_gpu, self._force_dirty_gpu, self.skip_flags_gpu,
+                self.bubble_y_gpu, self.bubble_radius_gpu,
+                self.wave_dx_gpu, self.wave_dz_gpu,
+                self.bend_angle_gpu, self.bend_axis_gpu,
+                self._applied_inputs_gpu, self._applied_bend_gpu,
+                self.dirty_flags_gpu, self.active_chunk_count_gpu,
+                self.chunk_slots_gpu, self.chunk_starts_gpu,
+            ],
+            device=self.device
+        )
+    
+    @property
+    def _active_dim(self) -> int:
+        """Fixed launch size of the active_* kernels."""
+        return self._chunk_total * ACTIVE_CHUNK
+    
+    def attach_culler(self, culler) -> bool:
+        """
+        Run a FrustumCuller before every active-set mark (None detaches).
+        
+        Returns:
+            True if attached; culling needs active_set
+        """
+        if culler is not None and not self.active_set:
+            carb.log_warn("[BatchWarpDeformer] Frustum culling needs active_set - not attached")
+            return False
+        self.culler = culler
+        if culler is None and self.skip_flags_gpu is not None:
+            self.skip_flags_gpu.zero_()
+        self._layout_version += 1
+        return culler is not None
+    
+    def get_lod_levels(self):
+        """Per-slot LOD level from the last cull (downloads), or None."""
+        if self.culler is None or self.lod_levels_gpu is None:
+            return None
+        return self.lod_levels_gpu.numpy()
+    
+    def get_dirty_flags(self):
+        """
+        Per-slot 1/0 flags from the last deform (downloads; syncs).
+        
+        Returns:
+            numpy int array, or None when active_set is off
+        """
+        if not self.active_set or self.dirty_flags_gpu is None:
+            return None
+        return self.dirty_flags_gpu.numpy()
+    
+    def capture_key(self) -> tuple:
+        """Layout identity baked into a captured deform launch."""
+        return (
+            self.total_vertices, len(self.tendroids), self._layout_version,
+            self.procedural, self.active_set, self._chunk_total,
+        ) + (self.culler.capture_key() if self.culler is not None else ())
+    
+    @staticmethod
+    def _host_base_points(deformer) -> np.ndarray:
+        """Deformer base points as [N, 3]; host copy if kept, else one download."""
+        points = getattr(deformer, 'base_points_np', None)
+        if points is None:
+            points = deformer.base_points_gpu.numpy()
+        return np.asarray(points).reshape(-1, 3)
+    
+    @staticmethod
+    def _host_height_factors(deformer) -> np.ndarray:
+        """Deformer height factors; host copy if kept, else one download."""
+        factors = getattr(deformer, 'height_factors_np', None)
+        if factors is None:
+            factors = deformer.height_factors_gpu.numpy()
+        return np.asarray(factors).reshape(-1)
+    
+    def bind_bubble_slots(self, name_to_id: dict):
+        """
+        Map each tendroid to its BubbleGPUManager slot (one upload).
+        
+        Args:
+            name_to_id: Tendroid name -> bubble id, e.g. the GPU
+                adapter's _name_to_id. Unmapped tendroids get -1.
+        """
+        if not self._built:
+            return
+        ids = np.full(self.slot_capacity, -1, dtype=np.int32)
+        for i, name in enumerate(self.tendroid_names):
+            if name is not None:
+                # LOD variants follow their tendroid's bubble
+                self._bubble_ids[i] = name_to_id.get(self._lod_owner[i] or name, -1)
+                ids[i] = self._bubble_ids[i]
+        self.tendroid_bubble_ids_gpu.assign(ids)
+    
+    def bind_deflection(self, angles_gpu, axes_gpu) -> bool:
+        """
+        Read bend angle/axis straight from device arrays (zero copy).
+        
+        Typically BatchDeflectionManager.angles_gpu / axes_gpu, indexed by
+        the same slots as this deformer (may be longer than slot_capacity).
+        
+        Returns:
+            True if bound; False on size/device mismatch (bend stays off)
+        """
+        if not self._built or angles_gpu is None or axes_gpu is None:
+            return False
+        n = self.slot_capacity
+        if angles_gpu.shape[0] < n or axes_gpu.shape[0] < n:
+            return False
+        if str(angles_gpu.device) != str(self.bend_angle_gpu.device):
+            return False
+        self.bend_angle_gpu = angles_gpu
+        self.bend_axis_gpu = axes_gpu
+        return True
+    
+    def unbind_deflection(self):
+        """Revert to the deformer's own (zero) bend arrays."""
+        self.bend_angle_gpu = self._own_bend_angle_gpu
+        self.bend_axis_gpu = self._own_bend_axis_gpu
+    
+    def update_deform_params(self, max_amplitude: float = None, bulge_width: float = None) -> int:
+        """
+        Patch bulge parameters of every tendroid in place (live tuning).
+        
+        Each tendroid's deformer keeps the host value; the device columns
+        are rewritten with one upload each, so the layout, captured
+        graphs and Fabric bindings stay valid (no rebuild).
+        
+        Args:
+            max_amplitude: Maximum radial expansion fraction (None = keep)
+            bulge_width: Gaussian width multiplier (None = keep)
+        
+        Returns:
+            Number of tendroids updated
+        """
+        if not self._built or (max_amplitude is None and bulge_width is None):
+            return 0
+        
+        updated = 0
+        for tendroid in self.tendroids:
+            if tendroid is None:
+                continue
+            if max_amplitude is not None:
+                tendroid.deformer.max_amplitude = float(max_amplitude)
+            if bulge_width is not None:
+                tendroid.deformer.bulge_width = float(bulge_width)
+            updated += 1
+        
+        attrs = ['max_amplitude_gpu', 'bulge_width_gpu']
+        if self.active_set:
+            attrs.append('bound_radius_gpu')  # Widest bulge sets the cull bounds
+        self._upload_columns(attrs)
+        
+        # Resting tendroids must redeform with the new shape
+        if self.active_set:
+            self._force_dirty_gpu.fill_(1)
+        return updated
+    
+    def _upload_columns(self, attrs: list):
+        """Rewrite whole per-tendroid arrays from the host slot tables."""
+        dtypes = {attr: dtype for attr, dtype, _ in self._tendroid_array_specs()}
+        rows = [self._slot_values(slot) for slot in range(self.slot_capacity)]
+        for attr in attrs:
+            values = np.array([row[attr] for row in rows], dtype=_host_dtype(dtypes[attr]))
+            getattr(self, attr).assign(values)
+    
+    def update_states_gpu(self, bubble_gpu_manager, wave_state: dict, default_config):
+        """
+        Update tendroid states entirely on device.
+        
+        Reads phases/world_y/current_radius straight from the bubble
+        manager and writes the preallocated per-tendroid buffers.
+        Call bind_bubble_slots() once before the first update.
+        
+        Args:
+            bubble_gpu_manager: BubbleGPUManager owning the bubble state
+            wave_state: Dict from WaveController.get_wave_state()
+            default_config: Bubble config (diameter_multiplier)
+        """
+        if not self._built:
+            return
+        
+        self.wave_state.upload(wave_state)
+        self.launch_state_update(bubble_gpu_manager, default_config.diameter_multiplier)
+    
+    def launch_state_update(self, bubble_gpu_manager, diameter_multiplier: float):
+        """Launch the per-tendroid state kernel (wave params already on device)."""
+        wp.launch(
+            kernel=update_tendroid_states_kernel,
+            dim=self.slot_capacity,
+            inputs=[
+                self.tendroid_bubble_ids_gpu,
+                bubble_gpu_manager.phases_gpu,
+                bubble_gpu_manager.world_y_gpu,
+                bubble_gpu_manager.current_radius_gpu,
+                self.tendroid_x_gpu, self.tendroid_base_y_gpu, self.tendroid_z_gpu,
+                self.cylinder_radius_gpu,
+                diameter_multiplier,
+                self.wave_state.params_gpu,
+                self.bubble_y_gpu, self.bubble_radius_gpu,
+                self.wave_dx_gpu, self.wave_dz_gpu,
+            ],
+            device=self.device
+        )
     
     def update_states(self, bubble_data: dict, wave_state: dict, default_config):
-        """Update tendroid states from bubble data."""
+        """Update tendroid states from host-side bubble data."""
         if not self._built:
             return
         
@@ -119,7 +1062,9 @@ class BatchWarpDeformer:
         wave_dz = wave_state.get('dir_z', 0.0)
         
         for i, tendroid in enumerate(self.tendroids):
-            name = tendroid.name
+            if tendroid is None:
+                continue
+            name = self._lod_owner[i] or tendroid.name
             bubble_y = 0.0
             bubble_radius = tendroid.radius
             
@@ -142,38 +1087,274 @@ class BatchWarpDeformer:
                 self._wave_dx_cpu[i] = 0.0
                 self._wave_dz_cpu[i] = 0.0
         
-        # Direct array assignment (Warp handles this efficiently)
-        self.bubble_y_gpu = wp.array(self._bubble_y_cpu, dtype=float, device=self.device)
-        self.bubble_radius_gpu = wp.array(self._bubble_radius_cpu, dtype=float, device=self.device)
-        self.wave_dx_gpu = wp.array(self._wave_dx_cpu, dtype=float, device=self.device)
-        self.wave_dz_gpu = wp.array(self._wave_dz_cpu, dtype=float, device=self.device)
+        # Copy into the preallocated buffers (no per-frame allocation)
+        self.bubble_y_gpu.assign(self._bubble_y_cpu)
+        self.bubble_radius_gpu.assign(self._bubble_radius_cpu)
+        self.wave_dx_gpu.assign(self._wave_dx_cpu)
+        self.wave_dz_gpu.assign(self._wave_dz_cpu)
     
-    def deform_all(self):
-        """Launch single kernel to deform ALL vertices."""
+    def deform_all(self, download: bool = True):
+        """
+        Launch single kernel to deform ALL vertices.
+        
+        Args:
+            download: Return a host copy of the output (forces a sync).
+                When False, returns the device array out_points_gpu.
+        """
         if not self._built:
             return None
+        if self.active_set:
+            self._mark_active('points')
+        outputs = [self.out_points_gpu]
+        if self.analytic_normals:
+            outputs.append(self.out_normals_gpu)
+        self._launch_mode('points', outputs, normals=self.analytic_normals)
+        if not download:
+            return self.out_points_gpu
+        return self.out_points_gpu.numpy()
+    
+    @property
+    def uses_cpu_threads(self) -> bool:
+        """True if full stored deforms are split over CPU worker threads."""
+        return (self.device == "cpu" and self.cpu_threads > 1
+                and not self.procedural and not self.active_set)
+    
+    def _launch_mode(self, target: str, outputs: list, active: bool = None, normals: bool = False):
+        """
+        Launch the DEFORM_MODES kernel for target (see deform_modes.py).
+        
+        Args:
+            target: 'points', 'fabric' or 'scatter'
+            outputs: Target buffers (points [, normals] / source, dest)
+            active: Use the active set's chunk list (default active_set)
+            normals: Also write analytic normals
+        """
+        mode = select_mode(
+            target, self.procedural, self.active_set if active is None else active, normals
+        )
+        inputs = mode.inputs(self, outputs)
+        if mode.active:
+            wp.launch(kernel=mode.kernel, dim=self._active_dim, inputs=inputs, device=self.device)
+        elif mode.vertex_arrays:
+            self._launch_vertices(mode.kernel, inputs[:mode.vertex_arrays], inputs[mode.vertex_arrays:])
+        else:
+            wp.launch(kernel=mode.kernel, dim=self.total_vertices, inputs=inputs, device=self.device)
+    
+    def _launch_vertices(self, kernel, vertex_inputs: list, tendroid_inputs: list):
+        """
+        Launch a stored-mode kernel over every vertex.
+        
+        With uses_cpu_threads the vertex range is cut into contiguous
+        chunks: per-vertex arrays are sliced (views, no copies) and the
+        per-tendroid tables shared, so each chunk is an independent
+        launch. Warp CPU launches release the GIL, so the chunks run in
+        parallel on the worker pool.
+        
+        Args:
+            kernel: Kernel whose leading inputs are per-vertex arrays
+            vertex_inputs: Those per-vertex arrays, in kernel order
+            tendroid_inputs: Remaining (per-tendroid) inputs
+        """
+        n = self.total_vertices
+        chunks = min(self.cpu_threads, n // CPU_CHUNK_MIN_VERTICES) if self.uses_cpu_threads else 1
+        
+        # First launch inline: loads the kernel's module outside the pool
+        if chunks <= 1 or kernel.key not in self._cpu_loaded:
+            wp.launch(kernel=kernel, dim=n, inputs=vertex_inputs + tendroid_inputs, device=self.device)
+            if self.device == "cpu":
+                self._cpu_loaded.add(kernel.key)
+            return
+        
+        if self._cpu_pool is None:
+            self._cpu_pool = ThreadPoolExecutor(
+                max_workers=self.cpu_threads, thread_name_prefix="BatchWarpDeformer"
+            )
+        bounds = np.linspace(0, n, chunks + 1).astype(int).tolist()
+        futures = [
+            self._cpu_pool.submit(
+                wp.launch, kernel=kernel, dim=end - start,
+                inputs=[a[start:end] for a in vertex_inputs] + tendroid_inputs,
+                device=self.device
+            )
+            for start, end in zip(bounds[:-1], bounds[1:])
+        ]
+        for future in futures:
+            future.result()
+    
+    def deform_to_fabric(self, stage_id) -> bool:
+        """
+        Deform ALL vertices straight into Fabric points buffers - GPU PATH.
+        
+        Selects every batch-tagged mesh in Fabric on this device and
+        scatters kernel output into each mesh's points buffer through a
+        per-tendroid table. No device sync and no host copies.
+        
+        Falls back (returns False) when the selection is unavailable,
+        e.g. on a CPU device or before meshes are populated in Fabric.
+        
+        Args:
+            stage_id: USD stage ID from omni.usd.get_context().get_stage_id()
+        
+        Returns:
+            True if the direct write was launched
+        """
+        fabric_points = self._prepare_fabric_targets(stage_id)
+        if fabric_points is None:
+            return False
+        
+        # CPU: threaded deform into out_points, then one scatter pass
+        # (the direct-write kernels index Fabric by absolute vertex and
+        # cannot be split into chunks)
+        if self.uses_cpu_threads:
+            self.deform_all(download=False)
+            self._scatter_all_to_fabric(self.out_points_gpu, fabric_points)
+            if self._fabric_normals is not None:
+                self._scatter_all_to_fabric(self.out_normals_gpu, self._fabric_normals)
+            return True
+        
+        if self.active_set:
+            if self._fabric_full_write:
+                self._force_dirty_gpu.fill_(1)
+                self._fabric_full_write = False
+            self._mark_active('fabric')
+        outputs = [fabric_points]
+        if self._fabric_normals is not None:
+            outputs.append(self._fabric_normals)
+        self._launch_mode('fabric', outputs, normals=self._fabric_normals is not None)
+        return True
+    
+    def copy_output_to_fabric(self, stage_id) -> bool:
+        """
+        Scatter out_points_gpu into Fabric points buffers on device.
+        
+        For callers that already ran deform_all(download=False) or
+        replayed a graph that wrote out_points_gpu.
+        
+        Returns:
+            True if the copy was launched
+        """
+        if not self._built or not self.device.startswith("cuda"):
+            return False
+        
+        fabric_points = self._prepare_fabric_targets(stage_id)
+        if fabric_points is None:
+            return False
+        
+        # Only meshes deformed this frame changed (full copy after re-tag)
+        if self.active_set and self._active_target == 'points' and not self._fabric_full_write:
+            self._launch_mode('scatter', [self.out_points_gpu, fabric_points])
+            if self._fabric_normals is not None:
+                self._launch_mode('scatter', [self.out_normals_gpu, self._fabric_normals])
+            return True
+        self._scatter_all_to_fabric(self.out_points_gpu, fabric_points)
+        if self._fabric_normals is not None:
+            self._scatter_all_to_fabric(self.out_normals_gpu, self._fabric_normals)
+        return True
+    
+    def scatter_points_to_fabric(self, points, stage_id) -> bool:
+        """
+        Scatter a full points buffer (same layout as out_points_gpu)
+        into every Fabric mesh on the current stream.
+        
+        Used by PipelinedDeformOutput for its snapshot buffers.
+        
+        Returns:
+            True if the scatter was launched
+        """
+        if not self._built or not self.device.startswith("cuda"):
+            return False
+        fabric_points = self._prepare_fabric_targets(stage_id)
+        if fabric_points is None:
+            return False
+        self._scatter_all_to_fabric(points, fabric_points)
+        return True
+    
+    def _scatter_all_to_fabric(self, points, fabric_points):
+        """Full (all meshes) points -> Fabric scatter."""
+        self._fabric_full_write = False
+        self._launch_mode('scatter', [points, fabric_points], active=False)
+    
+    def _prepare_fabric_targets(self, stage_id):
+        """
+        Select tagged Fabric meshes and refresh the tendroid -> prim table.
+        
+        Returns:
+            fabricarrayarray of points buffers, or None if unavailable
+        """
+        from ..utils import FabricHelper
+        
+        try:
+            usdrt_stage = FabricHelper.get_usdrt_stage(stage_id)
+            
+            # Tag meshes once per stage so the selection can be mapped back
+            if self._fabric_tagged_stage_id != stage_id:
+                self.tag_fabric_meshes(usdrt_stage)
+                self._fabric_tagged_stage_id = stage_id
+                self._fabric_full_write = True
+            
+            # Buffers can move between frames - re-select every time
+            selection = FabricHelper.select_batch_meshes(
+                usdrt_stage, self.device, with_normals=self.analytic_normals
+            )
+            if selection is None:
+                return None
+            
+            fabric_points = wp.fabricarray(selection, "points")
+            fabric_index = wp.fabricarray(selection, FabricHelper.BATCH_INDEX_ATTR)
+            self._fabric_normals = (
+                wp.fabricarray(selection, "normals") if self.analytic_normals else None
+            )
+        except Exception:
+            self._fabric_tagged_stage_id = None
+            self._fabric_normals = None
+            return None
+        
+        self.tendroid_to_fabric_gpu.fill_(-1)
         wp.launch(
-            kernel=batch_deform_kernel,
-            dim=self.total_vertices,
-            inputs=[
-                self.base_points_gpu, self.out_points_gpu, self.height_factors_gpu,
-                self.vertex_tendroid_ids_gpu,
-                self.bubble_y_gpu, self.bubble_radius_gpu,
-                self.wave_dx_gpu, self.wave_dz_gpu,
-                self.cylinder_radius_gpu, self.cylinder_length_gpu,
-                self.max_amplitude_gpu, self.bulge_width_gpu,
-            ],
+            kernel=map_fabric_prims_kernel,
+            dim=fabric_index.size,
+            inputs=[fabric_index, self.fabric_index_base, self.tendroid_to_fabric_gpu],
             device=self.device
         )
-        return self.out_points_gpu.numpy()
+        return fabric_points
+    
+    def tag_fabric_meshes(self, usdrt_stage):
+        """Write each tendroid's batch index (base + slot) onto its Fabric mesh."""
+        from ..utils import FabricHelper
+        
+        for i, tendroid in enumerate(self.tendroids):
+            mesh_path = self._get_mesh_path(tendroid) if tendroid is not None else None
+            if mesh_path:
+                FabricHelper.tag_batch_index(usdrt_stage, mesh_path, self.fabric_index_base + i)
     
-    def apply_to_meshes(self, all_points: np.ndarray):
-        """Apply deformed points to USD meshes - CPU PATH."""
+    @staticmethod
+    def _get_mesh_path(tendroid):
+        """Resolve a tendroid's mesh prim path, or None."""
+        if hasattr(tendroid, 'mesh_path'):
+            return tendroid.mesh_path
+        if hasattr(tendroid, 'mesh_prim') and tendroid.mesh_prim:
+            return str(tendroid.mesh_prim.GetPath())
+        return None
+    
+    def apply_to_meshes(self, all_points: np.ndarray, dirty: np.ndarray = None):
+        """
+        Apply deformed points to USD meshes - CPU PATH.
+        
+        Args:
+            all_points: Host copy of out_points_gpu
+            dirty: Per-slot flags matching all_points (downloaded from
+                the last deform if None)
+        """
         if all_points is None:
             return
         from pxr import Vt, UsdGeom
         
+        if dirty is None:
+            dirty = self.get_dirty_flags()
+        all_normals = self.out_normals_gpu.numpy() if self.out_normals_gpu is not None else None
         for i, tendroid in enumerate(self.tendroids):
+            if tendroid is None or (dirty is not None and not dirty[i]):
+                continue
             offset = self.vertex_offsets[i]
             count = self.vertex_counts[i]
             # numpy tolist() is C-optimized, much faster than per-element conversion
@@ -182,9 +1363,16 @@ class BatchWarpDeformer:
             if hasattr(tendroid, 'mesh_prim') and tendroid.mesh_prim:
                 mesh = UsdGeom.Mesh(tendroid.mesh_prim)
                 mesh.GetPointsAttr().Set(Vt.Vec3fArray(points_tuples))
+                if all_normals is not None:
+                    mesh.GetNormalsAttr().Set(Vt.Vec3fArray(all_normals[offset:offset + count].tolist()))
     
     def apply_to_meshes_fabric(self, stage_id):
-        """Apply deformed points via Fabric - GPU PATH (FAST)."""
+        """
+        Apply deformed points via Fabric - host-staged path.
+        
+        Downloads out_points once and sets each mesh from a CPU slice.
+        Used when deform_to_fabric() cannot select GPU buffers.
+        """
         if not self._built:
             return
         
@@ -197,18 +1385,18 @@ class BatchWarpDeformer:
         # CRITICAL: Do ONE GPU→CPU transfer for all vertices
         # Multiple numpy() calls create GPU sync points causing stuttering
         all_points_cpu = self.out_points_gpu.numpy()
+        all_normals_cpu = self.out_normals_gpu.numpy() if self.out_normals_gpu is not None else None
+        dirty = self.get_dirty_flags()
         
-        # Apply to each tendroid mesh
+        # Apply to each tendroid mesh (unchanged meshes keep last frame's points)
         for i, tendroid in enumerate(self.tendroids):
+            if tendroid is None or (dirty is not None and not dirty[i]):
+                continue
             offset = self.vertex_offsets[i]
             count = self.vertex_counts[i]
             
-            # Get mesh path
-            if hasattr(tendroid, 'mesh_path'):
-                mesh_path = tendroid.mesh_path
-            elif hasattr(tendroid, 'mesh_prim') and tendroid.mesh_prim:
-                mesh_path = str(tendroid.mesh_prim.GetPath())
-            else:
+            mesh_path = self._get_mesh_path(tendroid)
+            if not mesh_path:
                 continue
             
             # Get Fabric points attribute
@@ -224,6 +1412,13 @@ class BatchWarpDeformer:
             # Write to Fabric - VtArray constructor accepts numpy directly
             # No tolist() needed - numpy is passed as-is
             points_attr.Set(Vt.Vec3fArray(tendroid_points))
+            
+            if all_normals_cpu is not None:
+                normals_attr = FabricHelper.get_fabric_normals_attribute(
+                    usdrt_stage, mesh_path
+                )
+                if normals_attr:
+                    normals_attr.Set(Vt.Vec3fArray(all_normals_cpu[offset:offset + count]))
     
     def reset(self):
         """Reset to pre-build state."""
@@ -233,18 +1428,53 @@ class BatchWarpDeformer:
         self.name_to_index.clear()
         self.vertex_offsets.clear()
         self.vertex_counts.clear()
+        self._geometry.clear()
+        self._base_points.clear()
+        self._terrain_ranges.clear()
+        self._bubble_ids.clear()
+        self._lod_variant.clear()
+        self._lod_owner.clear()
+        self._lod_groups.clear()
+        self._lod_shown.clear()
+        self.vertex_arena.clear()
+        self.terrain_arena.clear()
+        if self._owns_slots:
+            self.slots.clear()
         self.total_vertices = 0
+        self._chunk_total = 0
+        self._active_target = None
         self._built = False
+        self._fabric_tagged_stage_id = None
+        self._fabric_full_write = True
     
     def destroy(self):
         """Free all GPU resources."""
-        for attr in ['base_points_gpu', 'out_points_gpu', 'height_factors_gpu',
+        for attr in ['base_points_gpu', 'out_points_gpu', 'out_normals_gpu', 'height_factors_gpu',
                      'vertex_tendroid_ids_gpu', 'bubble_y_gpu', 'bubble_radius_gpu',
                      'wave_dx_gpu', 'wave_dz_gpu', 'cylinder_radius_gpu',
-                     'cylinder_length_gpu', 'max_amplitude_gpu', 'bulge_width_gpu']:
+                     'cylinder_length_gpu', 'max_amplitude_gpu', 'bulge_width_gpu',
+                     'vertex_offsets_gpu', 'tendroid_to_fabric_gpu',
+                     'tendroid_x_gpu', 'tendroid_base_y_gpu', 'tendroid_z_gpu',
+                     'tendroid_bubble_ids_gpu', 'bend_angle_gpu', 'bend_axis_gpu',
+                     '_own_bend_angle_gpu', '_own_bend_axis_gpu',
+                     'radial_segments_gpu', 'height_segments_gpu',
+                     'flare_height_gpu', 'flare_radius_gpu', 'terrain_offsets_gpu',
+                     'terrain_start_gpu', 'terrain_rings_gpu',
+                     'range_starts_gpu', 'range_owners_gpu',
+                     'vertex_counts_gpu', 'dirty_flags_gpu', '_force_dirty_gpu',
+                     '_applied_inputs_gpu', '_applied_bend_gpu',
+                     'active_chunk_count_gpu', 'chunk_slots_gpu', 'chunk_starts_gpu',
+                     'skip_flags_gpu', 'lod_levels_gpu', 'bound_radius_gpu',
+                     'lod_variant_gpu', 'lod_shown_gpu', '_lod_live_gpu']:
             setattr(self, attr, None)
+        if self.wave_state:
+            self.wave_state.destroy()
+            self.wave_state = None
         self._bubble_y_cpu = self._bubble_radius_cpu = None
         self._wave_dx_cpu = self._wave_dz_cpu = None
+        if self._cpu_pool:
+            self._cpu_pool.shutdown(wait=True)
+            self._cpu_pool = None
     
     @property
     def is_built(self) -> bool:
@@ -252,4 +1482,11 @@ class BatchWarpDeformer:
     
     @property
     def tendroid_count(self) -> int:
+        return len(self.name_to_index)
+    
+    @property
+    def slot_capacity(self) -> int:
+        """Length of the per-tendroid device arrays (launch size)."""
+        if self.tendroid_to_fabric_gpu is not None:
+            return self.tendroid_to_fabric_gpu.shape[0]
         return len(self.tendroids)
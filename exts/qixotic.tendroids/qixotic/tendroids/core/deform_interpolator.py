@@ -0,0 +1,148 @@
+"""
+Deform Interpolator - render-rate blending of fixed-rate deform inputs
+
+With the simulation on a fixed step, the batch deformer's per-tendroid
+inputs (bubble y / radius, wave offset, deflection bend) only change
+once per sim step. Blending those few values per tendroid, instead of
+the deformed points, keeps the render-rate cost to one small kernel
+ahead of the usual deform launch:
+
+    sim step:  update_states* -> commit()   (prev <- curr <- live)
+    render:    with interpolated(alpha): deform + mesh write
+
+Blended values go into the deformer's own bubble / wave buffers (the
+next sim step rewrites them) and into private bend buffers bound for
+the duration of the render, so a bound deflection manager keeps its
+state.
+"""
+
+from contextlib import contextmanager
+
+import warp as wp
+
+from .batch_deform_kernel import interpolate_tendroid_states_kernel
+
+wp.init()
+
+_SCALAR_INPUTS = ('bubble_y_gpu', 'bubble_radius_gpu', 'wave_dx_gpu', 'wave_dz_gpu', 'bend_angle_gpu')
+
+
+class DeformInterpolator:
+    """
+    Two-state snapshot of BatchWarpDeformer inputs, blended per render.
+
+    Usage:
+        interpolator = DeformInterpolator(deformer)
+
+        # After each fixed sim step's update_states / update_states_gpu:
+        interpolator.commit()
+
+        # Each render frame:
+        with interpolator.interpolated(scheduler.alpha):
+            deformer.deform_to_fabric(stage_id)
+    """
+
+    def __init__(self, deformer):
+        """
+        Args:
+            deformer: Built BatchWarpDeformer
+        """
+        self.deformer = deformer
+        self.device = deformer.device
+        self._capacity = 0
+        self._states = None  # [prev, curr] dicts of input name -> array
+        self._bend_angle = None
+        self._bend_axis = None
+        self._committed = 0
+
+    @property
+    def ready(self) -> bool:
+        """True once at least one sim step has been committed."""
+        return self._committed > 0
+
+    def _ensure_buffers(self):
+        """(Re)allocate snapshots when the deformer's slot capacity changed."""
+        capacity = self.deformer.slot_capacity
+        if capacity == self._capacity and self._states is not None:
+            return
+        n = max(capacity, 1)
+        self._states = []
+        for _ in range(2):
+            state = {name: wp.zeros(n, dtype=float, device=self.device) for name in _SCALAR_INPUTS}
+            state['bend_axis_gpu'] = wp.zeros(n, dtype=wp.vec3, device=self.device)
+            self._states.append(state)
+        self._bend_angle = wp.zeros(n, dtype=float, device=self.device)
+        self._bend_axis = wp.zeros(n, dtype=wp.vec3, device=self.device)
+        self._capacity = capacity
+        self._committed = 0
+
+    def commit(self):
+        """Snapshot the deformer's current inputs as the latest sim state."""
+        deformer = self.deformer
+        if not deformer.is_built:
+            return
+        self._ensure_buffers()
+
+        # Ping-pong: the old latest state becomes the previous one
+        prev, curr = self._states[1], self._states[0]
+        n = self._capacity
+        for name, dst in curr.items():
+            wp.copy(dst, getattr(deformer, name), count=n)
+        self._states = [prev, curr]
+
+        # First step: nothing to blend from yet
+        if self._committed == 0:
+            for name, dst in prev.items():
+                wp.copy(dst, curr[name], count=n)
+        self._committed += 1
+
+    @contextmanager
+    def interpolated(self, alpha: float):
+        """
+        Load inputs blended at alpha, restore the bend binding on exit.
+
+        Args:
+            alpha: 0 = previous sim step, 1 = latest
+        """
+        deformer = self.deformer
+        if not self.ready or self._capacity != deformer.slot_capacity:
+            yield
+            return
+
+        prev, curr = self._states
+        wp.launch(
+            kernel=interpolate_tendroid_states_kernel,
+            dim=self._capacity,
+            inputs=[
+                prev['bubble_y_gpu'], prev['bubble_radius_gpu'],
+                prev['wave_dx_gpu'], prev['wave_dz_gpu'],
+                prev['bend_angle_gpu'], prev['bend_axis_gpu'],
+                curr['bubble_y_gpu'], curr['bubble_radius_gpu'],
+                curr['wave_dx_gpu'], curr['wave_dz_gpu'],
+                curr['bend_angle_gpu'], curr['bend_axis_gpu'],
+                min(max(float(alpha), 0.0), 1.0),
+                deformer.bubble_y_gpu, deformer.bubble_radius_gpu,
+                deformer.wave_dx_gpu, deformer.wave_dz_gpu,
+                self._bend_angle, self._bend_axis,
+            ],
+            device=self.device
+        )
+
+        bound = (deformer.bend_angle_gpu, deformer.bend_axis_gpu)
+        deformer.bend_angle_gpu, deformer.bend_axis_gpu = self._bend_angle, self._bend_axis
+        try:
+            yield
+        finally:
+            deformer.bend_angle_gpu, deformer.bend_axis_gpu = bound
+
+    def reset(self):
+        """Forget committed states (next commit starts without blending)."""
+        self._committed = 0
+
+    def destroy(self):
+        """Release snapshot buffers."""
+        self._states = None
+        self._bend_angle = None
+        self._bend_axis = None
+        self._capacity = 0
+        self._committed = 0
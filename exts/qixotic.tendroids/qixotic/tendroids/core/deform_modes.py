@@ -0,0 +1,220 @@
+"""
+Batch Deform Launch Modes
+
+Kernel selection for BatchWarpDeformer. A launch is fixed by:
+
+- target: 'points' (out_points_gpu / out_normals_gpu), 'fabric' (direct
+  write into the Fabric buffers) or 'scatter' (copy an existing points
+  buffer into Fabric)
+- rest pose: stored per-vertex arrays, or procedural cylinders
+- work list: every vertex, or the active set's compacted chunks
+- analytic normals (stored only)
+
+DEFORM_MODES maps each combination to a DeformMode - its kernel and
+how to assemble its inputs from the deformer - so the deformer has one
+launch path (BatchWarpDeformer._launch_mode) instead of a branch per
+combination. Adding a variant means adding a table entry.
+"""
+
+from typing import Callable, NamedTuple
+
+from .batch_deform_kernel import (
+    batch_deform_kernel,
+    batch_deform_fabric_kernel,
+    batch_deform_fabric_normals_kernel,
+    batch_deform_normals_kernel,
+    scatter_points_to_fabric_kernel,
+)
+from .active_set_kernel import (
+    active_deform_fabric_kernel,
+    active_deform_fabric_normals_kernel,
+    active_deform_kernel,
+    active_deform_normals_kernel,
+    active_procedural_deform_fabric_kernel,
+    active_procedural_deform_kernel,
+    active_scatter_points_to_fabric_kernel,
+)
+from .procedural_deform_kernel import (
+    procedural_deform_fabric_kernel,
+    procedural_deform_kernel,
+    procedural_scatter_points_to_fabric_kernel,
+)
+
+
+class DeformMode(NamedTuple):
+    """One kernel launch variant."""
+
+    kernel: object
+    # (deformer, outputs) -> kernel inputs; outputs are the target
+    # buffers: points [, normals] or, for 'scatter', (source, dest)
+    inputs: Callable
+    # Launched over the active chunks (_active_dim) instead of every vertex
+    active: bool = False
+    # Leading per-vertex inputs; > 0 lets CPU worker threads split the launch
+    vertex_arrays: int = 0
+
+
+def work_list_inputs(d) -> list:
+    """Compacted work list inputs leading every active_* kernel."""
+    return [
+        d.active_chunk_count_gpu, d.chunk_slots_gpu, d.chunk_starts_gpu,
+        d.vertex_offsets_gpu, d.vertex_counts_gpu,
+    ]
+
+
+def stored_state_inputs(d, with_length: bool = False) -> list:
+    """Per-tendroid deform state for the stored kernels."""
+    geometry = [d.cylinder_radius_gpu]
+    if with_length:
+        # The normals kernels also need the sway weight's slope
+        geometry.append(d.cylinder_length_gpu)
+    return [
+        d.bubble_y_gpu, d.bubble_radius_gpu,
+        d.wave_dx_gpu, d.wave_dz_gpu,
+    ] + geometry + [
+        d.max_amplitude_gpu, d.bulge_width_gpu,
+        d.bend_angle_gpu, d.bend_axis_gpu,
+    ]
+
+
+def procedural_inputs(d, ranges: bool = True) -> list:
+    """
+    Kernel inputs shared by the procedural variants.
+
+    Args:
+        ranges: Lead with the vertex range table (full launches; the
+            active kernels take ranges from the work list instead)
+    """
+    table = [d.range_starts_gpu, d.range_owners_gpu, d.vertex_offsets_gpu] if ranges else []
+    return table + [
+        d.radial_segments_gpu, d.height_segments_gpu,
+        d.cylinder_radius_gpu, d.cylinder_length_gpu,
+        d.flare_height_gpu, d.flare_radius_gpu,
+        d.terrain_offsets_gpu, d.terrain_start_gpu, d.terrain_rings_gpu,
+        d.bubble_y_gpu, d.bubble_radius_gpu,
+        d.wave_dx_gpu, d.wave_dz_gpu,
+        d.max_amplitude_gpu, d.bulge_width_gpu,
+        d.bend_angle_gpu, d.bend_axis_gpu,
+    ]
+
+
+def _stored_vertex_inputs(d, outputs: list) -> list:
+    # base points, outputs, then the per-vertex tables
+    return [d.base_points_gpu] + list(outputs) + [d.height_factors_gpu, d.vertex_tendroid_ids_gpu]
+
+
+# (target, procedural, active, normals) -> DeformMode
+DEFORM_MODES = {
+    # Full stored deform into out_points (CPU-threadable)
+    ('points', False, False, False): DeformMode(
+        batch_deform_kernel,
+        lambda d, out: _stored_vertex_inputs(d, out) + stored_state_inputs(d, with_length=True),
+        vertex_arrays=4,
+    ),
+    ('points', False, False, True): DeformMode(
+        batch_deform_normals_kernel,
+        lambda d, out: _stored_vertex_inputs(d, out) + stored_state_inputs(d, with_length=True),
+        vertex_arrays=5,
+    ),
+    ('points', True, False, False): DeformMode(
+        procedural_deform_kernel,
+        lambda d, out: [out[0]] + procedural_inputs(d),
+    ),
+    ('points', False, True, False): DeformMode(
+        active_deform_kernel,
+        lambda d, out: work_list_inputs(d) + [
+            d.base_points_gpu, d.height_factors_gpu, out[0],
+        ] + stored_state_inputs(d),
+        active=True,
+    ),
+    ('points', False, True, True): DeformMode(
+        active_deform_normals_kernel,
+        lambda d, out: work_list_inputs(d) + [
+            d.base_points_gpu, d.height_factors_gpu, out[0], out[1],
+        ] + stored_state_inputs(d, with_length=True),
+        active=True,
+    ),
+    ('points', True, True, False): DeformMode(
+        active_procedural_deform_kernel,
+        lambda d, out: work_list_inputs(d) + [out[0]] + procedural_inputs(d, ranges=False),
+        active=True,
+    ),
+
+    # Direct Fabric write (outputs: fabric points [, fabric normals])
+    ('fabric', False, False, False): DeformMode(
+        batch_deform_fabric_kernel,
+        lambda d, out: [
+            d.base_points_gpu, d.height_factors_gpu, d.vertex_tendroid_ids_gpu,
+        ] + stored_state_inputs(d) + [d.vertex_offsets_gpu, d.tendroid_to_fabric_gpu, out[0]],
+    ),
+    ('fabric', False, False, True): DeformMode(
+        batch_deform_fabric_normals_kernel,
+        lambda d, out: [
+            d.base_points_gpu, d.height_factors_gpu, d.vertex_tendroid_ids_gpu,
+        ] + stored_state_inputs(d, with_length=True) + [
+            d.vertex_offsets_gpu, d.tendroid_to_fabric_gpu, out[0], out[1],
+        ],
+    ),
+    ('fabric', True, False, False): DeformMode(
+        procedural_deform_fabric_kernel,
+        lambda d, out: procedural_inputs(d) + [d.tendroid_to_fabric_gpu, out[0]],
+    ),
+    ('fabric', False, True, False): DeformMode(
+        active_deform_fabric_kernel,
+        lambda d, out: work_list_inputs(d) + [
+            d.base_points_gpu, d.height_factors_gpu,
+        ] + stored_state_inputs(d) + [d.tendroid_to_fabric_gpu, out[0]],
+        active=True,
+    ),
+    ('fabric', False, True, True): DeformMode(
+        active_deform_fabric_normals_kernel,
+        lambda d, out: work_list_inputs(d) + [
+            d.base_points_gpu, d.height_factors_gpu,
+        ] + stored_state_inputs(d, with_length=True) + [d.tendroid_to_fabric_gpu, out[0], out[1]],
+        active=True,
+    ),
+    ('fabric', True, True, False): DeformMode(
+        active_procedural_deform_fabric_kernel,
+        lambda d, out: work_list_inputs(d) + procedural_inputs(d, ranges=False) + [
+            d.tendroid_to_fabric_gpu, out[0],
+        ],
+        active=True,
+    ),
+
+    # Points buffer -> Fabric (outputs: source, dest)
+    ('scatter', False, False, False): DeformMode(
+        scatter_points_to_fabric_kernel,
+        lambda d, out: [
+            out[0], d.vertex_tendroid_ids_gpu, d.vertex_offsets_gpu,
+            d.tendroid_to_fabric_gpu, out[1],
+        ],
+    ),
+    ('scatter', True, False, False): DeformMode(
+        procedural_scatter_points_to_fabric_kernel,
+        lambda d, out: [
+            out[0], d.range_starts_gpu, d.range_owners_gpu, d.vertex_offsets_gpu,
+            d.tendroid_to_fabric_gpu, out[1],
+        ],
+    ),
+}
+
+# The active scatter reads ranges from the work list: same for both rest poses
+for _procedural in (False, True):
+    DEFORM_MODES[('scatter', _procedural, True, False)] = DeformMode(
+        active_scatter_points_to_fabric_kernel,
+        lambda d, out: work_list_inputs(d) + [out[0], d.tendroid_to_fabric_gpu, out[1]],
+        active=True,
+    )
+
+
+def select_mode(target: str, procedural: bool, active: bool, normals: bool = False) -> DeformMode:
+    """
+    Look up the launch for a deform.
+
+    Args:
+        target: 'points', 'fabric' or 'scatter'
+        procedural: Procedural rest pose
+        active: Launch over the active set's chunks
+        normals: Also write analytic normals (ignored when procedural)
+    """
+    return DEFORM_MODES[(target, procedural, active, normals and not procedural)]
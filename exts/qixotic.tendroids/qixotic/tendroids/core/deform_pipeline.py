@@ -0,0 +1,186 @@
+"""
+Pipelined Deform Output - overlap next frame's compute with mesh handoff
+
+Without it, the frame that deforms out_points_gpu also blocks on
+reading it back (CPU path) or scattering it to Fabric on the same
+stream, so transfer latency lands on the update callback.
+
+Here each frame's output is snapshotted into one of two ping-pong
+buffers on the compute (device default) stream, and handed off on a
+dedicated present stream:
+
+    compute:  deform N -> copy out -> snap[i] -> record ready[i]
+    present:  wait ready[i] -> Fabric scatter / pinned download -> record done[i]
+
+Before snap[i] is overwritten two frames later, the compute stream
+waits (device side) on done[i]. The host only blocks on the CPU path,
+and then on the previous frame's download, which finished while this
+frame computed; meshes show frame N-1 while N is in flight.
+
+Dirty flags (active set) are snapshotted with the points so each
+frame's host copy is applied with its own flags.
+"""
+
+import carb
+import warp as wp
+
+wp.init()
+
+BUFFER_COUNT = 2
+
+
+class PipelinedDeformOutput:
+    """
+    Double-buffered, stream-overlapped handoff of BatchWarpDeformer output.
+
+    Usage:
+        pipeline = PipelinedDeformOutput(deformer)
+
+        # Each frame, after deform_all(download=False) or a graph replay:
+        pipeline.present(stage_id)   # or present(None) for the USD path
+    """
+
+    def __init__(self, deformer):
+        """
+        Args:
+            deformer: Built BatchWarpDeformer on a CUDA device
+        """
+        self.deformer = deformer
+        self.device = deformer.device
+        self.enabled = self.device.startswith("cuda")
+
+        self.present_stream = wp.Stream(self.device) if self.enabled else None
+        self._ready = [None] * BUFFER_COUNT
+        self._done = [None] * BUFFER_COUNT
+        self._in_flight = [False] * BUFFER_COUNT
+        self._host_pending = [False] * BUFFER_COUNT
+        self._index = 0
+
+        self._snapshots = [None] * BUFFER_COUNT
+        self._dirty_snapshots = [None] * BUFFER_COUNT
+        self._host_points = [None] * BUFFER_COUNT
+        self._host_dirty = [None] * BUFFER_COUNT
+        self._layout_key = None
+
+        if self.enabled:
+            self._ready = [wp.Event(self.device) for _ in range(BUFFER_COUNT)]
+            self._done = [wp.Event(self.device) for _ in range(BUFFER_COUNT)]
+
+    def _ensure_buffers(self):
+        """(Re)allocate snapshots when the deformer layout changed."""
+        deformer = self.deformer
+        key = (deformer.out_points_gpu.shape[0], deformer.slot_capacity, deformer._layout_version)
+        if key == self._layout_key:
+            return
+
+        # Drain in-flight handoffs; pending host frames have the old layout
+        self.flush(apply=False)
+
+        points_capacity, slot_capacity = key[0], key[1]
+        track_dirty = deformer.active_set and deformer.dirty_flags_gpu is not None
+        for i in range(BUFFER_COUNT):
+            snapshot = self._snapshots[i]
+            if snapshot is None or snapshot.shape[0] != points_capacity:
+                self._snapshots[i] = wp.zeros(points_capacity, dtype=wp.vec3, device=self.device)
+                self._host_points[i] = wp.zeros(
+                    points_capacity, dtype=wp.vec3, device="cpu", pinned=True
+                )
+            if track_dirty:
+                self._dirty_snapshots[i] = wp.zeros(slot_capacity, dtype=int, device=self.device)
+                self._host_dirty[i] = wp.zeros(slot_capacity, dtype=int, device="cpu", pinned=True)
+            else:
+                self._dirty_snapshots[i] = None
+                self._host_dirty[i] = None
+        self._layout_key = key
+
+    def present(self, stage_id=None) -> bool:
+        """
+        Snapshot this frame's output and hand it off asynchronously.
+
+        Args:
+            stage_id: Fabric stage id for the device scatter, or None to
+                download and apply to USD meshes (one frame behind)
+
+        Returns:
+            False if pipelining is unavailable (caller should present
+            synchronously)
+        """
+        deformer = self.deformer
+        if not self.enabled or not deformer.is_built:
+            return False
+
+        self._ensure_buffers()
+        i = self._index
+        count = deformer.total_vertices
+        compute = wp.get_stream(self.device)
+
+        # snap[i] may still be read by the handoff from two frames ago
+        if self._in_flight[i]:
+            compute.wait_event(self._done[i])
+
+        wp.copy(self._snapshots[i], deformer.out_points_gpu, count=count)
+        if self._dirty_snapshots[i] is not None:
+            wp.copy(self._dirty_snapshots[i], deformer.dirty_flags_gpu)
+        compute.record_event(self._ready[i])
+
+        self.present_stream.wait_event(self._ready[i])
+        with wp.ScopedStream(self.present_stream):
+            scattered = (
+                stage_id is not None
+                and deformer.scatter_points_to_fabric(self._snapshots[i], stage_id)
+            )
+            if not scattered:
+                wp.copy(self._host_points[i], self._snapshots[i], count=count)
+                if self._dirty_snapshots[i] is not None:
+                    wp.copy(self._host_dirty[i], self._dirty_snapshots[i])
+        self.present_stream.record_event(self._done[i])
+        self._in_flight[i] = True
+        self._host_pending[i] = not scattered
+
+        # Previous frame's download ran while this frame computed
+        self._apply_host(i ^ 1)
+        self._index = i ^ 1
+        return True
+
+    def _apply_host(self, i: int):
+        """Apply a finished host download to the USD meshes."""
+        if not self._host_pending[i]:
+            return
+        wp.synchronize_event(self._done[i])
+        self._host_pending[i] = False
+
+        dirty = self._host_dirty[i].numpy() if self._host_dirty[i] is not None else None
+        self.deformer.apply_to_meshes(
+            self._host_points[i].numpy()[:self.deformer.total_vertices], dirty=dirty
+        )
+
+    def flush(self, apply: bool = True):
+        """
+        Wait for all handoffs.
+
+        Args:
+            apply: Apply pending host frames in submission order (else drop)
+        """
+        if not self.enabled:
+            return
+        wp.synchronize_stream(self.present_stream)
+        # Oldest first: the slot that would be written next
+        for i in (self._index, self._index ^ 1):
+            if apply:
+                self._apply_host(i)
+            self._host_pending[i] = False
+            self._in_flight[i] = False
+
+    def destroy(self):
+        """Drain and free buffers."""
+        try:
+            self.flush(apply=False)
+        except Exception as e:
+            carb.log_warn(f"[PipelinedDeformOutput] Flush on destroy failed: {e}")
+        self._snapshots = [None] * BUFFER_COUNT
+        self._dirty_snapshots = [None] * BUFFER_COUNT
+        self._host_points = [None] * BUFFER_COUNT
+        self._host_dirty = [None] * BUFFER_COUNT
+        self._layout_key = None
+        self.present_stream = None
+        self.enabled = False
@@ -0,0 +1,92 @@
+"""
+Device-Resident Wave State
+
+Keeps the global wave parameters in a tiny persistent GPU buffer so
+kernels can read them directly. Each frame the host writes into a
+pinned staging buffer and issues one async copy - no allocation.
+
+Buffer layout (float32):
+    [0] enabled (1.0 / 0.0)
+    [1] displacement (-1 to +1)
+    [2] amplitude
+    [3] dir_x
+    [4] dir_z
+"""
+
+import warp as wp
+
+wp.init()
+
+WAVE_PARAM_COUNT = 5
+
+WAVE_ENABLED = wp.constant(0)
+WAVE_DISPLACEMENT = wp.constant(1)
+WAVE_AMPLITUDE = wp.constant(2)
+WAVE_DIR_X = wp.constant(3)
+WAVE_DIR_Z = wp.constant(4)
+
+
+@wp.func
+def tendroid_wave_offset(wave_params: wp.array(dtype=float), t_x: float, t_z: float):
+    """
+    Per-tendroid wave displacement at the tip (before height weighting).
+    
+    Matches the CPU spatial variation: 1 + sin(x*0.003 + z*0.002) * 0.15
+    Returns (dx, dz); zero when the wave is disabled.
+    """
+    if wave_params[WAVE_ENABLED] < 0.5:
+        return wp.vec2(0.0, 0.0)
+    
+    spatial = 1.0 + wp.sin(t_x * 0.003 + t_z * 0.002) * 0.15
+    d = wave_params[WAVE_DISPLACEMENT] * spatial * wave_params[WAVE_AMPLITUDE]
+    return wp.vec2(d * wave_params[WAVE_DIR_X], d * wave_params[WAVE_DIR_Z])
+
+
+class DeviceWaveState:
+    """
+    Persistent device copy of WaveController.get_wave_state().
+    
+    Usage:
+        wave = DeviceWaveState(device="cuda:0")
+        
+        # Each frame:
+        wave.upload(wave_controller.get_wave_state())
+        wp.launch(..., inputs=[wave.params_gpu, ...])
+    """
+    
+    def __init__(self, device: str = "cuda:0"):
+        self.device = device
+        is_cuda = device.startswith("cuda")
+        
+        self.params_gpu = wp.zeros(WAVE_PARAM_COUNT, dtype=float, device=device)
+        self._staging = wp.zeros(
+            WAVE_PARAM_COUNT, dtype=float, device="cpu", pinned=is_cuda
+        )
+        self._staging_np = self._staging.numpy()
+    
+    def write_staging(self, wave_state: dict):
+        """Write wave state into the pinned host buffer (no device work)."""
+        staging = self._staging_np
+        if wave_state and wave_state.get('enabled', False):
+            staging[0] = 1.0
+            staging[1] = wave_state.get('displacement', 0.0)
+            staging[2] = wave_state.get('amplitude', 0.0)
+            staging[3] = wave_state.get('dir_x', 0.0)
+            staging[4] = wave_state.get('dir_z', 0.0)
+        else:
+            staging[:] = 0.0
+    
+    def copy_to_device(self):
+        """Async copy of the staging buffer into params_gpu."""
+        wp.copy(self.params_gpu, self._staging)
+    
+    def upload(self, wave_state: dict):
+        """Stage and upload wave state in one call."""
+        self.write_staging(wave_state)
+        self.copy_to_device()
+    
+    def destroy(self):
+        """Free GPU resources."""
+        self.params_gpu = None
+        self._staging = None
+        self._staging_np = None
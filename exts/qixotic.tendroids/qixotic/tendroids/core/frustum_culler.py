@@ -0,0 +1,282 @@
+"""
+Frustum Culling and Distance LOD for Batch Deformation
+
+Runs before the active-set mark (see active_set_kernel.py). Each
+tendroid is bounded by a vertical capsule - base to tip, inflated by
+the flare / max bulge radius plus a sway margin - and tested against
+the six viewport frustum planes. The result is a per-tendroid skip
+flag for this frame:
+
+- on screen: deformed every lod_intervals[lod] frames, where lod is
+  the number of lod_distances the camera distance exceeds
+- off screen: deformed every offscreen_interval frames (0 = never)
+
+Skipped tendroids keep their last output and are picked up as dirty
+as soon as they run again. Frames are staggered by slot so reduced
+rates spread across frames instead of spiking.
+
+With LOD mesh variants (BatchWarpDeformer.add_lod_variant) each level
+has its own reduced-segment mesh in its own slot. Only the slot of the
+shown level is deformed; switch_lod_meshes moves the shown level to the
+culled one every switch_interval frames and toggles mesh visibility,
+and a level that was just shown deforms in its first frame regardless
+of its rate.
+
+Camera data is staged in a pinned host buffer and copied in-stream,
+like DeviceWaveState, so the launch can be captured in a CUDA graph.
+
+Buffer layout (float32):
+    [0..23]  six planes (nx, ny, nz, d), inside when n.p + d >= 0
+    [24..26] camera position
+    [27]     frame index
+    [28]     enabled (1.0 / 0.0)
+"""
+
+import numpy as np
+import warp as wp
+
+wp.init()
+
+CULL_PARAM_COUNT = 29
+MAX_LOD_LEVELS = 4
+
+CULL_CAMERA = wp.constant(24)
+CULL_FRAME = wp.constant(27)
+CULL_ENABLED = wp.constant(28)
+
+
+@wp.kernel
+def cull_tendroids_kernel(
+    # Per-tendroid bounding capsule (0 vertices = free slot)
+    vertex_counts: wp.array(dtype=int),
+    tendroid_x: wp.array(dtype=float),
+    tendroid_base_y: wp.array(dtype=float),
+    tendroid_z: wp.array(dtype=float),
+    cylinder_length: wp.array(dtype=float),
+    bound_radius: wp.array(dtype=float),
+
+    # Camera planes / position / frame (see module docstring)
+    cull_params: wp.array(dtype=float),
+
+    # LOD thresholds (ascending) and update interval per level
+    lod_distances: wp.array(dtype=float),
+    lod_intervals: wp.array(dtype=int),
+    offscreen_interval: int,
+    sway_margin: float,
+
+    # LOD mesh variants: level this slot draws (-1 = no variants), the
+    # level shown for its tendroid, 1 once deformed since shown
+    lod_variants: wp.array(dtype=int),
+    lod_shown: wp.array(dtype=int),
+    lod_live: wp.array(dtype=int),
+
+    # Outputs
+    skip_flags: wp.array(dtype=int),
+    lod_levels: wp.array(dtype=int),
+):
+    """Per-tendroid frustum test + LOD -> skip flag for this frame."""
+    t = wp.tid()
+
+    skip_flags[t] = 0
+    if vertex_counts[t] == 0:
+        return
+
+    # Hidden LOD meshes are never deformed
+    variant = lod_variants[t]
+    shown = variant < 0 or variant == lod_shown[t]
+    if not shown:
+        skip_flags[t] = 1
+        lod_live[t] = 0
+
+    if cull_params[CULL_ENABLED] < 0.5:
+        lod_levels[t] = 0
+        return
+
+    base = wp.vec3(tendroid_x[t], tendroid_base_y[t], tendroid_z[t])
+    tip = base + wp.vec3(0.0, cylinder_length[t], 0.0)
+    radius = bound_radius[t] + sway_margin
+
+    visible = int(1)
+    for p in range(6):
+        n = wp.vec3(cull_params[p * 4], cull_params[p * 4 + 1], cull_params[p * 4 + 2])
+        d = cull_params[p * 4 + 3]
+        if wp.max(wp.dot(n, base), wp.dot(n, tip)) + d < -radius:
+            visible = 0
+
+    # Closest point on the capsule axis to the camera
+    camera = wp.vec3(
+        cull_params[CULL_CAMERA], cull_params[CULL_CAMERA + 1], cull_params[CULL_CAMERA + 2]
+    )
+    axis_y = wp.clamp(camera[1], base[1], tip[1])
+    dist = wp.length(camera - wp.vec3(base[0], axis_y, base[2])) - radius
+
+    lod = int(0)
+    for i in range(lod_distances.shape[0]):
+        if dist > lod_distances[i]:
+            lod = i + 1
+    lod_levels[t] = lod
+    if not shown:
+        return
+
+    # Just shown: catch up this frame instead of waiting for the rate
+    if variant >= 0 and lod_live[t] == 0:
+        lod_live[t] = 1
+        return
+
+    interval = lod_intervals[lod]
+    if visible == 0:
+        interval = offscreen_interval
+
+    frame = int(cull_params[CULL_FRAME])
+    if interval <= 0 or (frame + t) % interval != 0:
+        skip_flags[t] = 1
+
+
+def frustum_planes(view_projection) -> np.ndarray:
+    """
+    Six inward-facing planes from a USD (row-vector) view-projection matrix.
+
+    Gribb-Hartmann extraction for clip = p * M with GL depth [-1, 1].
+
+    Args:
+        view_projection: 4x4 matrix (Gf.Matrix4d or array-like)
+
+    Returns:
+        [6, 4] float32 (nx, ny, nz, d), normalized; order left, right,
+        bottom, top, near, far
+    """
+    m = np.asarray(view_projection, dtype=np.float64).reshape(4, 4)
+    w = m[:, 3]
+    planes = np.stack([
+        w + m[:, 0], w - m[:, 0],
+        w + m[:, 1], w - m[:, 1],
+        w + m[:, 2], w - m[:, 2],
+    ])
+    lengths = np.linalg.norm(planes[:, :3], axis=1, keepdims=True)
+    return (planes / np.maximum(lengths, 1e-12)).astype(np.float32)
+
+
+class FrustumCuller:
+    """
+    Camera-aware skip flags for BatchWarpDeformer's active set.
+
+    Usage:
+        culler = FrustumCuller(device="cuda:0")
+        deformer.attach_culler(culler)
+
+        # Each frame, before the deform (or the graph replay):
+        culler.begin_frame(view_projection, camera_position)
+        culler.switch_lod_meshes(deformer)  # With LOD mesh variants
+    """
+
+    def __init__(
+        self,
+        device: str = "cuda:0",
+        lod_distances: tuple = (600.0, 1500.0),
+        lod_intervals: tuple = (1, 2, 4),
+        offscreen_interval: int = 8,
+        sway_margin: float = 0.0,
+        switch_interval: int = 8
+    ):
+        """
+        Args:
+            device: Warp device
+            lod_distances: Camera distances (ascending) where LOD steps up
+            lod_intervals: Deform every N frames per LOD level
+                (len(lod_distances) + 1 entries)
+            offscreen_interval: Deform every N frames off screen (0 = never)
+            sway_margin: Extra capsule radius for wave sway
+            switch_interval: Frames between LOD mesh switches (each
+                switch downloads the culled levels)
+        """
+        if len(lod_intervals) != len(lod_distances) + 1 or len(lod_intervals) > MAX_LOD_LEVELS:
+            raise ValueError("lod_intervals needs one entry per LOD level")
+
+        self.device = device
+        self.offscreen_interval = int(offscreen_interval)
+        self.sway_margin = float(sway_margin)
+        self.switch_interval = max(int(switch_interval), 1)
+        self.level_count = len(lod_intervals)
+        self.lod_distances_gpu = wp.array(
+            np.asarray(lod_distances, dtype=np.float32), dtype=float, device=device
+        )
+        self.lod_intervals_gpu = wp.array(
+            np.asarray(lod_intervals, dtype=np.int32), dtype=int, device=device
+        )
+
+        self.params_gpu = wp.zeros(CULL_PARAM_COUNT, dtype=float, device=device)
+        self._staging = wp.zeros(
+            CULL_PARAM_COUNT, dtype=float, device="cpu", pinned=device.startswith("cuda")
+        )
+        self._staging_np = self._staging.numpy()
+        self._frame = 0
+
+    def begin_frame(self, view_projection=None, camera_position=None):
+        """
+        Stage this frame's camera and frame index (host write only).
+
+        Call once per frame, including when a captured graph replays
+        the launch. Without a view, culling is off and every tendroid
+        deforms every frame.
+        """
+        staging = self._staging_np
+        staging[CULL_FRAME] = float(self._frame)
+        self._frame = (self._frame + 1) % (1 << 20)
+
+        if view_projection is None or camera_position is None:
+            staging[CULL_ENABLED] = 0.0
+            return
+        staging[0:24] = frustum_planes(view_projection).reshape(-1)
+        staging[24:27] = camera_position
+        staging[CULL_ENABLED] = 1.0
+
+    def launch(self, deformer):
+        """
+        Enqueue the staging copy and cull kernel for deformer's slots.
+
+        Writes deformer.skip_flags_gpu / lod_levels_gpu; consumed by the
+        active-set mark that follows. Device work only (graph safe).
+        """
+        wp.copy(self.params_gpu, self._staging)
+        wp.launch(
+            kernel=cull_tendroids_kernel,
+            dim=deformer.slot_capacity,
+            inputs=[
+                deformer.vertex_counts_gpu,
+                deformer.tendroid_x_gpu, deformer.tendroid_base_y_gpu, deformer.tendroid_z_gpu,
+                deformer.cylinder_length_gpu, deformer.bound_radius_gpu,
+                self.params_gpu,
+                self.lod_distances_gpu, self.lod_intervals_gpu,
+                self.offscreen_interval, self.sway_margin,
+                deformer.lod_variant_gpu, deformer.lod_shown_gpu, deformer._lod_live_gpu,
+                deformer.skip_flags_gpu, deformer.lod_levels_gpu,
+            ],
+            device=self.device
+        )
+
+    def switch_lod_meshes(self, deformer) -> int:
+        """
+        Show each tendroid's culled LOD mesh (every switch_interval frames).
+
+        Call after begin_frame, outside a captured graph: reads the
+        levels of the last cull (downloads) and only writes device
+        arrays and mesh visibility, so a captured launch stays valid.
+
+        Returns:
+            Number of tendroids whose shown mesh changed
+        """
+        if not deformer.has_lod_variants or self._frame % self.switch_interval != 0:
+            return 0
+        return deformer.switch_lod_variants()
+
+    def capture_key(self) -> tuple:
+        """Launch scalars baked into a captured graph."""
+        return (self.offscreen_interval, self.sway_margin, self.params_gpu.ptr)
+
+    def destroy(self):
+        """Free GPU resources."""
+        self.params_gpu = None
+        self.lod_distances_gpu = None
+        self.lod_intervals_gpu = None
+        self._staging = None
+        self._staging_np = None
@@ -0,0 +1,151 @@
+"""
+Peer Points Delivery - hand a remote device's deformed points to Fabric
+
+A BatchWarpDeformer on a non-rendering device (one partition of a
+multi-GPU field) cannot scatter into Fabric: the Fabric points buffers
+live on the render device. Each frame its out_points_gpu is peer-copied
+into a staging buffer on the render device and scattered there, with
+copies of the deformer's vertex -> tendroid tables:
+
+    remote stream:  deform_all(download=False)
+    render stream:  wait remote -> peer copy -> scatter into Fabric
+    remote stream:  wait render (next deform may overwrite out_points)
+
+All ordering is device-side; the host never blocks.
+"""
+
+import carb
+import warp as wp
+
+from .batch_deform_kernel import map_fabric_prims_kernel, scatter_points_to_fabric_kernel
+
+wp.init()
+
+
+class PeerPointsDelivery:
+    """
+    Render-device scatter table and staging for one remote deformer.
+
+    Usage:
+        delivery = PeerPointsDelivery(deformer, render_device="cuda:0")
+
+        # Each frame:
+        deformer.deform_all(download=False)
+        delivery.deliver(stage_id)
+    """
+
+    def __init__(self, deformer, render_device: str = "cuda:0"):
+        """
+        Args:
+            deformer: Built BatchWarpDeformer in stored mode (the scatter
+                needs its per-vertex tendroid ids)
+            render_device: Device the Fabric points buffers live on
+        """
+        self.deformer = deformer
+        self.device = render_device
+        self.peer_access = False
+
+        self._layout_version = None
+        self._points = None
+        self._vertex_tendroid_ids = None
+        self._vertex_offsets = None
+        self._tendroid_to_fabric = None
+        self._tagged_stage_id = None
+
+        source = deformer.device
+        if wp.is_peer_access_supported(source, render_device):
+            # Render-device copies read the remote allocations directly
+            wp.set_peer_access_enabled(source, render_device, True)
+            self.peer_access = True
+        else:
+            carb.log_warn(
+                f"[PeerPointsDelivery] No peer access {source} -> {render_device}, "
+                f"copies stage through the host"
+            )
+
+    def _ensure_tables(self) -> bool:
+        """Mirror the deformer's scatter tables after any layout change."""
+        deformer = self.deformer
+        if deformer.vertex_tendroid_ids_gpu is None:
+            return False
+        if self._layout_version == deformer._layout_version and self._points is not None:
+            return True
+
+        self._points = wp.zeros(max(deformer.total_vertices, 1), dtype=wp.vec3, device=self.device)
+        self._vertex_tendroid_ids = wp.clone(deformer.vertex_tendroid_ids_gpu, device=self.device)
+        self._vertex_offsets = wp.clone(deformer.vertex_offsets_gpu, device=self.device)
+        self._tendroid_to_fabric = wp.zeros(deformer.slot_capacity, dtype=int, device=self.device)
+        self._layout_version = deformer._layout_version
+        return True
+
+    def _select_targets(self, stage_id):
+        """Render-device Fabric selection mapped to this deformer's slots."""
+        from ..utils import FabricHelper
+
+        try:
+            usdrt_stage = FabricHelper.get_usdrt_stage(stage_id)
+            if self._tagged_stage_id != stage_id:
+                self.deformer.tag_fabric_meshes(usdrt_stage)
+                self._tagged_stage_id = stage_id
+
+            selection = FabricHelper.select_batch_meshes(usdrt_stage, self.device)
+            if selection is None:
+                return None
+            fabric_points = wp.fabricarray(selection, "points")
+            fabric_index = wp.fabricarray(selection, FabricHelper.BATCH_INDEX_ATTR)
+        except Exception:
+            self._tagged_stage_id = None
+            return None
+
+        self._tendroid_to_fabric.fill_(-1)
+        wp.launch(
+            kernel=map_fabric_prims_kernel,
+            dim=fabric_index.size,
+            inputs=[fabric_index, self.deformer.fabric_index_base, self._tendroid_to_fabric],
+            device=self.device
+        )
+        return fabric_points
+
+    def deliver(self, stage_id) -> bool:
+        """
+        Peer-copy out_points_gpu and scatter it into Fabric.
+
+        Returns:
+            True if the copy and scatter were queued (False: caller falls
+            back to apply_to_meshes on a host copy)
+        """
+        deformer = self.deformer
+        if not deformer.is_built or stage_id is None or not self._ensure_tables():
+            return False
+        fabric_points = self._select_targets(stage_id)
+        if fabric_points is None:
+            return False
+
+        n = deformer.total_vertices
+        source_stream = wp.get_stream(deformer.device)
+        render_stream = wp.get_stream(self.device)
+
+        render_stream.wait_stream(source_stream)
+        wp.copy(self._points, deformer.out_points_gpu, count=n, stream=render_stream)
+        wp.launch(
+            kernel=scatter_points_to_fabric_kernel,
+            dim=n,
+            inputs=[
+                self._points, self._vertex_tendroid_ids,
+                self._vertex_offsets, self._tendroid_to_fabric,
+                fabric_points,
+            ],
+            device=self.device,
+            stream=render_stream
+        )
+        source_stream.wait_stream(render_stream)
+        return True
+
+    def destroy(self):
+        """Release render-device copies."""
+        self._points = None
+        self._vertex_tendroid_ids = None
+        self._vertex_offsets = None
+        self._tendroid_to_fabric = None
+        self._layout_version = None
+        self._tagged_stage_id = None
@@ -0,0 +1,304 @@
+"""
+Procedural Batch Deform Kernels
+
+Variant of batch_deform_kernel.py that stores no per-vertex rest data.
+Each thread rebuilds its rest vertex from the tendroid's parametric
+cylinder (CylinderGenerator) and a small terrain offset table covering
+the conformed flare rings, then applies the shared deform_vertex().
+
+Per-vertex device traffic drops from base point + height factor +
+tendroid id (20 bytes read) to the output write alone; the owning
+tendroid is found by binary search over the sorted vertex range table
+(range_starts / range_owners, owner -1 = free arena range).
+
+Vertex order matches CylinderGenerator: ring-major, so local vertex
+i is ring i // radial_segments, segment i % radial_segments.
+"""
+
+import numpy as np
+import warp as wp
+
+from .batch_deform_kernel import deform_vertex
+
+wp.init()
+
+
+@wp.func
+def find_tendroid(
+    range_starts: wp.array(dtype=int),
+    range_owners: wp.array(dtype=int),
+    tid: int,
+):
+    """Owner slot of the last range starting at or before tid (-1 = free)."""
+    lo = int(0)
+    hi = int(range_starts.shape[0] - 1)
+    while lo < hi:
+        mid = (lo + hi + 1) // 2
+        if range_starts[mid] <= tid:
+            lo = mid
+        else:
+            hi = mid - 1
+    return range_owners[lo]
+
+
+@wp.func
+def procedural_rest_vertex(
+    local: int,
+    radial_segments: int,
+    height_segments: int,
+    cyl_radius: float,
+    cyl_length: float,
+    flare_height: float,
+    flare_radius: float,
+    terrain_offsets: wp.array(dtype=float),
+    terrain_start: int,
+    terrain_rings: int,
+):
+    """
+    Rebuild one rest-pose vertex of a flared cylinder.
+
+    Same math as CylinderGenerator.create_cylinder_arrays: cosine flare
+    from flare_radius at the base to cyl_radius at flare_height. Rings
+    below terrain_rings add their conformed Y offset from the table.
+    """
+    ring = local // radial_segments
+    segment = local - ring * radial_segments
+
+    y = (float(ring) / float(height_segments)) * cyl_length
+
+    radius = cyl_radius
+    if flare_height > 0.0 and y < flare_height:
+        flare_factor = 0.5 * (1.0 - wp.cos((y / flare_height) * wp.pi))
+        radius = flare_radius + (cyl_radius - flare_radius) * flare_factor
+
+    angle = (float(segment) / float(radial_segments)) * 2.0 * wp.pi
+
+    if ring < terrain_rings:
+        y = y + terrain_offsets[terrain_start + local]
+
+    return wp.vec3(radius * wp.cos(angle), y, radius * wp.sin(angle))
+
+
+@wp.func
+def procedural_height_factor(y: float, cyl_length: float):
+    """Smooth cubic sway weight, same as compute_height_factors()."""
+    if cyl_length <= 0.0:
+        return 0.0
+    ratio = wp.clamp(y / cyl_length, 0.0, 1.0)
+    return ratio * ratio * (3.0 - 2.0 * ratio)
+
+
+@wp.func
+def procedural_deform_vertex(
+    t: int,
+    local: int,
+    radial_segments: wp.array(dtype=int),
+    height_segments: wp.array(dtype=int),
+    cylinder_radius: wp.array(dtype=float),
+    cylinder_length: wp.array(dtype=float),
+    flare_height: wp.array(dtype=float),
+    flare_radius: wp.array(dtype=float),
+    terrain_offsets: wp.array(dtype=float),
+    terrain_start: wp.array(dtype=int),
+    terrain_rings: wp.array(dtype=int),
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
+    max_amplitude: wp.array(dtype=float),
+    bulge_width: wp.array(dtype=float),
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
+):
+    """Rebuild and deform local vertex `local` of tendroid t."""
+    pos = procedural_rest_vertex(
+        local,
+        radial_segments[t], height_segments[t],
+        cylinder_radius[t], cylinder_length[t],
+        flare_height[t], flare_radius[t],
+        terrain_offsets, terrain_start[t], terrain_rings[t],
+    )
+    h_factor = procedural_height_factor(pos[1], cylinder_length[t])
+
+    return deform_vertex(
+        pos, h_factor,
+        bubble_y[t], bubble_radius[t],
+        wave_dx[t], wave_dz[t],
+        cylinder_radius[t], max_amplitude[t], bulge_width[t],
+        bend_angles[t], bend_axes[t],
+    )
+
+
+@wp.kernel
+def procedural_deform_kernel(
+    out_points: wp.array(dtype=wp.vec3),
+
+    # Vertex range table (sorted starts, owning slot) + slot -> first vertex
+    range_starts: wp.array(dtype=int),
+    range_owners: wp.array(dtype=int),
+    vertex_offsets: wp.array(dtype=int),
+
+    # Per-tendroid parametric geometry
+    radial_segments: wp.array(dtype=int),
+    height_segments: wp.array(dtype=int),
+    cylinder_radius: wp.array(dtype=float),
+    cylinder_length: wp.array(dtype=float),
+    flare_height: wp.array(dtype=float),
+    flare_radius: wp.array(dtype=float),
+
+    # Conformed flare Y offsets (all tendroids concatenated)
+    terrain_offsets: wp.array(dtype=float),
+    terrain_start: wp.array(dtype=int),
+    terrain_rings: wp.array(dtype=int),
+
+    # Per-tendroid deform state
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
+    max_amplitude: wp.array(dtype=float),
+    bulge_width: wp.array(dtype=float),
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
+):
+    """Procedural batch_deform_kernel: one thread per output vertex."""
+    tid = wp.tid()
+
+    t = find_tendroid(range_starts, range_owners, tid)
+    if t < 0:
+        return
+
+    out_points[tid] = procedural_deform_vertex(
+        t, tid - vertex_offsets[t],
+        radial_segments, height_segments,
+        cylinder_radius, cylinder_length,
+        flare_height, flare_radius,
+        terrain_offsets, terrain_start, terrain_rings,
+        bubble_y, bubble_radius, wave_dx, wave_dz,
+        max_amplitude, bulge_width, bend_angles, bend_axes,
+    )
+
+
+@wp.kernel
+def procedural_deform_fabric_kernel(
+    range_starts: wp.array(dtype=int),
+    range_owners: wp.array(dtype=int),
+    vertex_offsets: wp.array(dtype=int),
+    radial_segments: wp.array(dtype=int),
+    height_segments: wp.array(dtype=int),
+    cylinder_radius: wp.array(dtype=float),
+    cylinder_length: wp.array(dtype=float),
+    flare_height: wp.array(dtype=float),
+    flare_radius: wp.array(dtype=float),
+    terrain_offsets: wp.array(dtype=float),
+    terrain_start: wp.array(dtype=int),
+    terrain_rings: wp.array(dtype=int),
+    bubble_y: wp.array(dtype=float),
+    bubble_radius: wp.array(dtype=float),
+    wave_dx: wp.array(dtype=float),
+    wave_dz: wp.array(dtype=float),
+    max_amplitude: wp.array(dtype=float),
+    bulge_width: wp.array(dtype=float),
+    bend_angles: wp.array(dtype=float),
+    bend_axes: wp.array(dtype=wp.vec3),
+
+    # Tendroid -> Fabric prim (-1 = not selected)
+    tendroid_to_fabric: wp.array(dtype=int),
+    fabric_points: wp.fabricarrayarray(dtype=wp.vec3),
+):
+    """Procedural batch_deform_fabric_kernel: deform straight into Fabric."""
+    tid = wp.tid()
+
+    t = find_tendroid(range_starts, range_owners, tid)
+    if t < 0:
+        return
+    prim = tendroid_to_fabric[t]
+    if prim < 0:
+        return
+
+    local = tid - vertex_offsets[t]
+
+    fabric_points[prim][local] = procedural_deform_vertex(
+        t, local,
+        radial_segments, height_segments,
+        cylinder_radius, cylinder_length,
+        flare_height, flare_radius,
+        terrain_offsets, terrain_start, terrain_rings,
+        bubble_y, bubble_radius, wave_dx, wave_dz,
+        max_amplitude, bulge_width, bend_angles, bend_axes,
+    )
+
+
+@wp.kernel
+def procedural_scatter_points_to_fabric_kernel(
+    points: wp.array(dtype=wp.vec3),
+    range_starts: wp.array(dtype=int),
+    range_owners: wp.array(dtype=int),
+    vertex_offsets: wp.array(dtype=int),
+    tendroid_to_fabric: wp.array(dtype=int),
+    fabric_points: wp.fabricarrayarray(dtype=wp.vec3),
+):
+    """scatter_points_to_fabric_kernel without the per-vertex id array."""
+    tid = wp.tid()
+
+    t = find_tendroid(range_starts, range_owners, tid)
+    if t < 0:
+        return
+    prim = tendroid_to_fabric[t]
+    if prim < 0:
+        return
+
+    fabric_points[prim][tid - vertex_offsets[t]] = points[tid]
+
+
+def extract_terrain_offsets(base_points, geometry: dict, tolerance: float = 1e-4):
+    """
+    Recover the conformed flare Y offsets of a builder-made tendroid.
+
+    Regenerates the unconformed cylinder and diffs it against the
+    actual rest points. Terrain conforming only moves Y in the flare
+    rings, so everything else must match the parametric cylinder.
+
+    Args:
+        base_points: [N, 3] rest vertices actually on the mesh
+        geometry: Builder data with radius, length, radial_segments,
+            height_segments, flare_height_percent, flare_radius_multiplier
+        tolerance: Allowed X/Z mismatch relative to the cylinder size
+
+    Returns:
+        (offsets, rings): float32 Y offsets for the first `rings` rings
+        in vertex order, or None if the points are not that cylinder
+    """
+    from ..builders.cylinder_generator import CylinderGenerator
+
+    try:
+        radial = int(geometry['radial_segments'])
+        height = int(geometry['height_segments'])
+        rest, _, _, _ = CylinderGenerator.create_cylinder_arrays(
+            radius=geometry['radius'],
+            length=geometry['length'],
+            radial_segments=radial,
+            height_segments=height,
+            flare_height_percent=geometry['flare_height_percent'],
+            flare_radius_multiplier=geometry['flare_radius_multiplier']
+        )
+    except (KeyError, TypeError, ValueError, ZeroDivisionError):
+        return None
+
+    points = np.asarray(base_points, dtype=np.float32).reshape(-1, 3)
+    if points.shape != rest.shape:
+        return None
+
+    scale = max(
+        abs(geometry['radius']) * max(geometry['flare_radius_multiplier'], 1.0),
+        abs(geometry['length']),
+        1.0
+    )
+    if np.abs(points[:, [0, 2]] - rest[:, [0, 2]]).max() > tolerance * scale:
+        return None
+
+    dy = points[:, 1] - rest[:, 1]
+    moved = np.flatnonzero(np.abs(dy).reshape(height + 1, radial).max(axis=1) > 0.0)
+    rings = int(moved[-1]) + 1 if moved.size else 0
+
+    return np.ascontiguousarray(dy[:rings * radial], dtype=np.float32), rings
@@ -8,11 +8,29 @@ Now includes wave displacement composition - wave and deformation
 are applied together in a single GPU pass.
 """
 
+import numpy as np
 import warp as wp
 
 wp.init()
 
 
+def compute_height_factors(points: np.ndarray, cylinder_length: float) -> np.ndarray:
+    """
+    Per-vertex wave sway weights (cubic interpolation for smooth sway).
+    
+    Args:
+        points: [N, 3] vertex array
+        cylinder_length: Cylinder height
+    
+    Returns:
+        [N] float32 factors, smooth cubic t^2 * (3 - 2t) of Y / length
+    """
+    if cylinder_length <= 0:
+        return np.zeros(points.shape[0], dtype=np.float32)
+    ratio = np.clip(points[:, 1] / cylinder_length, 0.0, 1.0)
+    return (ratio * ratio * (3.0 - 2.0 * ratio)).astype(np.float32)
+
+
 @wp.kernel
 def deform_cylinder_kernel(
     base_points: wp.array(dtype=wp.vec3),
@@ -157,7 +175,8 @@ class V2WarpDeformer:
         cylinder_length: float = 100.0,
         max_amplitude: float = 0.8,
         bulge_width: float = 0.9,
-        device: str = "cuda:0"
+        device: str = "cuda:0",
+        height_factors=None
     ):
         """
         Args:
@@ -167,6 +186,8 @@ class V2WarpDeformer:
             max_amplitude: Maximum radial expansion fraction
             bulge_width: Gaussian width multiplier
             device: Warp device ("cuda:0" for GPU)
+            height_factors: Precomputed per-vertex factors (scene cache);
+                computed from the points if None
         """
         self.cylinder_radius = cylinder_radius
         self.cylinder_length = cylinder_length
@@ -175,23 +196,18 @@ class V2WarpDeformer:
         self.device = device
         self.num_points = len(base_points_list)
         
-        # Convert points to tuples
-        points_data = [(p[0], p[1], p[2]) for p in base_points_list]
-        
-        # Pre-compute height factors (cubic interpolation for smooth sway)
-        height_factors = []
-        for p in base_points_list:
-            if cylinder_length > 0:
-                ratio = max(0.0, min(1.0, p[1] / cylinder_length))
-                # Smooth cubic: t^2 * (3 - 2t)
-                factor = ratio * ratio * (3.0 - 2.0 * ratio)
-            else:
-                factor = 0.0
-            height_factors.append(factor)
+        # Host copies kept so batch builds can concatenate without downloads
+        self.base_points_np = np.ascontiguousarray(
+            np.asarray(base_points_list, dtype=np.float32).reshape(-1, 3)
+        )
+        if height_factors is not None:
+            self.height_factors_np = np.asarray(height_factors, dtype=np.float32)
+        else:
+            self.height_factors_np = compute_height_factors(self.base_points_np, cylinder_length)
         
         # Upload to GPU
-        self.base_points_gpu = wp.array(points_data, dtype=wp.vec3, device=device)
-        self.height_factors_gpu = wp.array(height_factors, dtype=float, device=device)
+        self.base_points_gpu = wp.array(self.base_points_np, dtype=wp.vec3, device=device)
+        self.height_factors_gpu = wp.array(self.height_factors_np, dtype=float, device=device)
         self.out_points_gpu = wp.zeros(self.num_points, dtype=wp.vec3, device=device)
     
     def deform(
@@ -4,6 +4,14 @@ Batch Deflection Manager - GPU-accelerated batch deflection processing
 TEND-88: Create Warp GPU kernel for batch deflection calculation
 
 Provides batch processing of multiple tendroid deflections using Warp GPU.
+Geometry and deflection state live in persistent device arrays; creature
+positions arrive through a pinned staging buffer so any number of
+creatures is processed per launch and the result stays on the device
+for the batch deformer.
+
+Tendroids can be added or removed after registration. Indices follow
+the scene's shared slot table, so a removed index is parked (negative
+height, never in range) until a new tendroid reuses it.
 """
 
 import math
@@ -13,11 +21,22 @@ from typing import Dict, List, Optional, Tuple
 try:
   import warp as wp
 
+  from .warp_deflection_kernel import (
+    multi_creature_target_kernel,
+    smooth_deflection_kernel,
+    smooth_deflection_frame_kernel,
+  )
+
   WARP_AVAILABLE = True
 except ImportError:
   wp = None
   WARP_AVAILABLE = False
 
+DEFAULT_CREATURE_CAPACITY = 8
+
+# Height of a free index - fails the in-height test for every creature
+FREE_SLOT_HEIGHT = -1.0
+
 
 @dataclass
 class BatchDeflectionState:
@@ -47,22 +66,40 @@ class BatchDeflectionManager:
       manager = BatchDeflectionManager()
       manager.register_tendroids(tendroid_list)
 
-      # Each frame:
-      manager.set_creature_state(pos, vel)
-      angles, axes = manager.compute_deflections(dt)
+      # Each frame, single creature (downloads angles/axes):
+      angles, axes = manager.compute_deflections(pos, vel, dt)
+
+      # Each frame, N creatures, result left on device:
+      manager.compute_deflections_multi(positions, velocities, dt, download=False)
+      deformer.consume(manager.angles_gpu, manager.axes_gpu)
   """
 
-  def __init__(self, device: str = "cuda:0"):
+  def __init__(
+    self,
+    device: str = "cuda:0",
+    creature_capacity: int = DEFAULT_CREATURE_CAPACITY
+  ):
     """
     Initialize batch deflection manager.
 
     Args:
         device: Warp device string ("cuda:0" or "cpu")
+        creature_capacity: Initial creature slots (grows on demand)
     """
     self.device = device if WARP_AVAILABLE else "cpu"
     self._tendroid_count = 0
+    self._capacity = 0  # allocated GPU length (>= _tendroid_count)
     self._built = False
 
+    # Creature input buffers (GPU + pinned staging)
+    self._creature_capacity = max(1, creature_capacity)
+    self._creature_positions: Optional[object] = None
+    self._creature_count: Optional[object] = None
+    self._positions_staging: Optional[object] = None
+    self._positions_staging_np = None
+    self._count_staging: Optional[object] = None
+    self._count_staging_np = None
+
     # Tendroid geometry arrays (GPU)
     self._center_x: Optional[object] = None
     self._center_z: Optional[object] = None
@@ -90,9 +127,24 @@ class BatchDeflectionManager:
 
   @property
   def tendroid_count(self) -> int:
-    """Get number of registered tendroids."""
+    """Get number of tendroid indices (including removed, parked ones)."""
     return self._tendroid_count
 
+  @property
+  def uses_gpu(self) -> bool:
+    """True when state lives in Warp device arrays."""
+    return WARP_AVAILABLE and self.device != "cpu"
+
+  @property
+  def angles_gpu(self):
+    """Current bend angle per tendroid (wp.array(float)), or None on CPU."""
+    return self._current_angles if self.uses_gpu else None
+
+  @property
+  def axes_gpu(self):
+    """Bend axis per tendroid (wp.array(vec3)), or None on CPU."""
+    return self._deflection_axes if self.uses_gpu else None
+
   def configure(
     self,
     detection_range: float = 0.5,
@@ -140,7 +192,7 @@ class BatchDeflectionManager:
     height = [t.length for t in tendroids]
     radius = [t.radius for t in tendroids]
 
-    if WARP_AVAILABLE:
+    if self.uses_gpu:
       self._build_gpu_arrays(center_x, center_z, base_y, height, radius)
     else:
       self._build_cpu_arrays(center_x, center_z, base_y, height, radius)
@@ -157,6 +209,7 @@ class BatchDeflectionManager:
   ) -> None:
     """Build GPU arrays for batch processing."""
     n = self._tendroid_count
+    self._capacity = n
 
     self._center_x = wp.array(center_x, dtype=float, device=self.device)
     self._center_z = wp.array(center_z, dtype=float, device=self.device)
@@ -167,7 +220,144 @@ class BatchDeflectionManager:
     # State arrays (initialized to zero)
     self._current_angles = wp.zeros(n, dtype=float, device=self.device)
     self._target_angles = wp.zeros(n, dtype=float, device=self.device)
-    self._deflection_axes = wp.zeros(n, dtype=wp.vec3, device=self.device)
+    self._deflection_axes = wp.full(
+      n, wp.vec3(1.0, 0.0, 0.0), dtype=wp.vec3, device=self.device
+    )
+
+    if self._creature_positions is None:
+      self._allocate_creature_buffers(self._creature_capacity)
+
+  def add_tendroid(self, tendroid, index: Optional[int] = None) -> int:
+    """
+    Add one tendroid without rebuilding the others.
+
+    Only that index is uploaded. Growing past the allocated length
+    doubles the GPU arrays, which changes angles_gpu / axes_gpu -
+    consumers re-bind (GPUFramePipeline does this from capture_key).
+
+    Args:
+        tendroid: Wrapper with position, length, radius
+        index: Slot to write (shared slot table); appends if None
+
+    Returns:
+        The index the tendroid was written to
+    """
+    if index is None:
+      index = self._tendroid_count
+
+    if index >= self._tendroid_count:
+      self._grow(index + 1)
+
+    self._write_index(
+      index, tendroid.position[0], tendroid.position[2],
+      tendroid.position[1], tendroid.length, tendroid.radius
+    )
+    self._built = True
+    return index
+
+  def remove_tendroid(self, index: int) -> bool:
+    """
+    Park a tendroid index: no deflection and angle reset to rest.
+
+    Returns:
+      True if the index was in range
+    """
+    if index < 0 or index >= self._tendroid_count:
+      return False
+    self._write_index(index, 0.0, 0.0, 0.0, FREE_SLOT_HEIGHT, 0.0)
+    return True
+
+  def _grow(self, count: int) -> None:
+    """Extend every per-tendroid array to count entries (new ones parked)."""
+    old = self._tendroid_count
+    self._tendroid_count = count
+
+    if not self.uses_gpu:
+      extra = count - old
+      if self._center_x is None:
+        self._center_x, self._center_z, self._base_y = [], [], []
+        self._height, self._radius = [], []
+        self._current_angles, self._target_angles, self._deflection_axes = [], [], []
+      self._center_x += [0.0] * extra
+      self._center_z += [0.0] * extra
+      self._base_y += [0.0] * extra
+      self._height += [FREE_SLOT_HEIGHT] * extra
+      self._radius += [0.0] * extra
+      self._current_angles += [0.0] * extra
+      self._target_angles += [0.0] * extra
+      self._deflection_axes += [(1.0, 0.0, 0.0)] * extra
+      return
+
+    if self._creature_positions is None:
+      self._allocate_creature_buffers(self._creature_capacity)
+
+    if count <= self._capacity:
+      return
+
+    capacity = max(self._capacity, 1)
+    while capacity < count:
+      capacity *= 2
+
+    def grown(array, dtype, fill):
+      new = wp.full(capacity, fill, dtype=dtype, device=self.device)
+      if array is not None and old > 0:
+        wp.copy(new, array, count=old)
+      return new
+
+    self._center_x = grown(self._center_x, float, 0.0)
+    self._center_z = grown(self._center_z, float, 0.0)
+    self._base_y = grown(self._base_y, float, 0.0)
+    self._height = grown(self._height, float, FREE_SLOT_HEIGHT)
+    self._radius = grown(self._radius, float, 0.0)
+    self._current_angles = grown(self._current_angles, float, 0.0)
+    self._target_angles = grown(self._target_angles, float, 0.0)
+    self._deflection_axes = grown(self._deflection_axes, wp.vec3, wp.vec3(1.0, 0.0, 0.0))
+    self._capacity = capacity
+
+  def _write_index(
+    self,
+    i: int,
+    center_x: float,
+    center_z: float,
+    base_y: float,
+    height: float,
+    radius: float
+  ) -> None:
+    """Overwrite geometry at index i and reset its deflection state."""
+    if not self.uses_gpu:
+      self._center_x[i] = center_x
+      self._center_z[i] = center_z
+      self._base_y[i] = base_y
+      self._height[i] = height
+      self._radius[i] = radius
+      self._current_angles[i] = 0.0
+      self._target_angles[i] = 0.0
+      self._deflection_axes[i] = (1.0, 0.0, 0.0)
+      return
+
+    for array, value in (
+      (self._center_x, center_x), (self._center_z, center_z),
+      (self._base_y, base_y), (self._height, height),
+      (self._radius, radius), (self._current_angles, 0.0),
+      (self._target_angles, 0.0),
+    ):
+      array[i:i + 1].fill_(value)
+    self._deflection_axes[i:i + 1].fill_(wp.vec3(1.0, 0.0, 0.0))
+
+  def _allocate_creature_buffers(self, capacity: int) -> None:
+    """Allocate device creature buffers and their pinned staging copies."""
+    pinned = self.device.startswith("cuda")
+    self._creature_capacity = capacity
+
+    self._creature_positions = wp.zeros(capacity, dtype=wp.vec3, device=self.device)
+    self._creature_count = wp.zeros(1, dtype=int, device=self.device)
+
+    self._positions_staging = wp.zeros(
+      capacity, dtype=wp.vec3, device="cpu", pinned=pinned
+    )
+    self._positions_staging_np = self._positions_staging.numpy()
+    self._count_staging = wp.zeros(1, dtype=int, device="cpu", pinned=pinned)
+    self._count_staging_np = self._count_staging.numpy()
 
   def _build_cpu_arrays(
     self,
@@ -209,11 +399,149 @@ class BatchDeflectionManager:
     if not self._built:
       return [], []
 
-    if WARP_AVAILABLE and self.device != "cpu":
+    if self.uses_gpu:
       return self._compute_gpu(creature_pos, creature_vel, dt)
     else:
       return self._compute_cpu(creature_pos, creature_vel, dt)
 
+  def compute_deflections_multi(
+    self,
+    creature_positions: List[Tuple[float, float, float]],
+    creature_velocities: Optional[List[Tuple[float, float, float]]],
+    dt: float,
+    download: bool = True
+  ) -> Optional[Tuple[List[float], List[Tuple[float, float, float]]]]:
+    """
+    Compute deflections against any number of creatures.
+
+    Each tendroid takes the strongest deflection over all creatures.
+
+    Args:
+        creature_positions: (x, y, z) per creature
+        creature_velocities: (vx, vy, vz) per creature (reserved for
+            approach typing; not used by the falloff)
+        dt: Delta time
+        download: Return host lists; False leaves results on device
+            (read angles_gpu / axes_gpu)
+
+    Returns:
+        Tuple of (angles, axes) lists, or None when download is False
+    """
+    if not self._built:
+      return ([], []) if download else None
+
+    if not self.uses_gpu:
+      return self._compute_cpu_multi(creature_positions, dt)
+
+    self.set_creatures(creature_positions, creature_velocities)
+    self._launch(dt, None)
+
+    if not download:
+      return None
+    return self.download()
+
+  def set_creatures(
+    self,
+    creature_positions: List[Tuple[float, float, float]],
+    creature_velocities: Optional[List[Tuple[float, float, float]]] = None
+  ) -> None:
+    """
+    Stage creature positions for the next launch (host write only).
+
+    The device copy happens inside the launch, so a captured frame graph
+    picks up new positions on replay. Growing past capacity reallocates
+    the device buffers - callers holding a captured graph must re-capture
+    (see capture_key).
+    """
+    if not self.uses_gpu:
+      return
+
+    n = len(creature_positions)
+    if n > self._creature_capacity:
+      new_capacity = self._creature_capacity
+      while new_capacity < n:
+        new_capacity *= 2
+      self._allocate_creature_buffers(new_capacity)
+
+    if n:
+      self._positions_staging_np[:n] = creature_positions
+    self._count_staging_np[0] = n
+
+  def launch_frame(self, frame_params) -> None:
+    """
+    Enqueue deflection for the staged creatures with dt from frame_params[0].
+
+    Only issues async copies and kernel launches, so it can be passed to
+    GPUFramePipeline.set_deflection_stage and captured in the frame graph.
+    """
+    if self._built and self.uses_gpu:
+      self._launch(None, frame_params)
+
+  def capture_key(self) -> tuple:
+    """Identity of the device buffers baked into a captured launch."""
+    if not self.uses_gpu or not self._built:
+      return ()
+    return (
+      self._current_angles.ptr, self._deflection_axes.ptr,
+      self._creature_positions.ptr, self._tendroid_count,
+      self._detection_range, self._approach_buffer,
+      self._min_deflection, self._max_deflection,
+      self._deflection_rate, self._recovery_rate,
+    )
+
+  def download(self) -> Tuple[List[float], List[Tuple[float, float, float]]]:
+    """Copy current angles and axes back to host lists."""
+    if not self._built:
+      return [], []
+    if not self.uses_gpu:
+      return self._current_angles[:], self._deflection_axes[:]
+
+    angles = self._current_angles.numpy().tolist()
+    axes = [tuple(a) for a in self._deflection_axes.numpy().tolist()]
+    return angles, axes
+
+  def _launch(self, dt: Optional[float], frame_params) -> None:
+    """Enqueue staging copies, target evaluation and smoothing."""
+    n = self._tendroid_count
+
+    wp.copy(self._creature_positions, self._positions_staging)
+    wp.copy(self._creature_count, self._count_staging)
+
+    wp.launch(
+      multi_creature_target_kernel,
+      dim=n,
+      inputs=[
+        self._center_x, self._center_z, self._base_y,
+        self._height, self._radius,
+        self._creature_positions, self._creature_count,
+        self._detection_range, self._approach_buffer,
+        self._min_deflection, self._max_deflection,
+        self._target_angles, self._deflection_axes,
+      ],
+      device=self.device
+    )
+
+    if frame_params is not None:
+      wp.launch(
+        smooth_deflection_frame_kernel,
+        dim=n,
+        inputs=[
+          self._current_angles, self._target_angles, frame_params,
+          self._deflection_rate, self._recovery_rate, self._current_angles,
+        ],
+        device=self.device
+      )
+    else:
+      wp.launch(
+        smooth_deflection_kernel,
+        dim=n,
+        inputs=[
+          self._current_angles, self._target_angles, dt,
+          self._deflection_rate, self._recovery_rate, self._current_angles,
+        ],
+        device=self.device
+      )
+
   def _compute_cpu(
     self,
     creature_pos: Tuple[float, float, float],
@@ -221,52 +549,18 @@ class BatchDeflectionManager:
     dt: float
   ) -> Tuple[List[float], List[Tuple[float, float, float]]]:
     """CPU fallback computation."""
-    cx, cy, cz = creature_pos
+    return self._compute_cpu_multi([creature_pos], dt)
 
+  def _compute_cpu_multi(
+    self,
+    creature_positions: List[Tuple[float, float, float]],
+    dt: float
+  ) -> Tuple[List[float], List[Tuple[float, float, float]]]:
+    """CPU reference: strongest deflection over all creatures per tendroid."""
     for i in range(self._tendroid_count):
-      # Get tendroid geometry
-      tx = self._center_x[i]
-      tz = self._center_z[i]
-      by = self._base_y[i]
-      h = self._height[i]
-      r = self._radius[i]
-
-      # Calculate horizontal distance
-      dx = cx - tx
-      dz = cz - tz
-      dist_xz = math.sqrt(dx * dx + dz * dz)
-
-      # Detection threshold
-      detect_dist = r + self._approach_buffer + self._detection_range
-
-      # Check if creature is in range
-      if dist_xz > detect_dist:
-        # Recover toward zero
-        self._target_angles[i] = 0.0
-      elif cy >= by and cy <= by + h:
-        # Within tendroid height range - calculate deflection
-        height_ratio = (cy - by) / h if h > 0 else 0.0
-
-        # Distance factor (closer = more deflection)
-        dist_ratio = 1.0 - (dist_xz / detect_dist)
-        dist_ratio = max(0.0, min(1.0, dist_ratio))
-
-        # Height-proportional deflection
-        target = self._min_deflection + (
-          self._max_deflection - self._min_deflection
-        ) * height_ratio * dist_ratio
-
-        self._target_angles[i] = target
-
-        # Calculate deflection axis (perpendicular to approach)
-        if dist_xz > 0.001:
-          nx = dx / dist_xz
-          nz = dz / dist_xz
-          # Axis is perpendicular to normal in XZ plane
-          self._deflection_axes[i] = (-nz, 0.0, nx)
-      else:
-        # Above or below - recover
-        self._target_angles[i] = 0.0
+      self._target_angles[i] = 0.0
+      for creature_pos in creature_positions:
+        self._apply_creature_cpu(i, creature_pos)
 
       # Smooth transition
       current = self._current_angles[i]
@@ -287,27 +581,85 @@ class BatchDeflectionManager:
 
     return self._current_angles[:], self._deflection_axes[:]
 
+  def _apply_creature_cpu(
+    self,
+    i: int,
+    creature_pos: Tuple[float, float, float]
+  ) -> None:
+    """Raise tendroid i's target angle for one creature if it is closer."""
+    cx, cy, cz = creature_pos
+
+    # Get tendroid geometry
+    tx = self._center_x[i]
+    tz = self._center_z[i]
+    by = self._base_y[i]
+    h = self._height[i]
+    r = self._radius[i]
+
+    # Calculate horizontal distance
+    dx = cx - tx
+    dz = cz - tz
+    dist_xz = math.sqrt(dx * dx + dz * dz)
+
+    # Detection threshold
+    detect_dist = r + self._approach_buffer + self._detection_range
+
+    # Out of range, or above/below the tendroid - no contribution
+    if dist_xz > detect_dist or cy < by or cy > by + h:
+      return
+
+    # Within tendroid height range - calculate deflection
+    height_ratio = (cy - by) / h if h > 0 else 0.0
+
+    # Distance factor (closer = more deflection)
+    dist_ratio = 1.0 - (dist_xz / detect_dist)
+    dist_ratio = max(0.0, min(1.0, dist_ratio))
+
+    # Height-proportional deflection
+    target = self._min_deflection + (
+      self._max_deflection - self._min_deflection
+    ) * height_ratio * dist_ratio
+
+    if target <= self._target_angles[i]:
+      return
+
+    self._target_angles[i] = target
+
+    # Calculate deflection axis (perpendicular to approach)
+    if dist_xz > 0.001:
+      nx = dx / dist_xz
+      nz = dz / dist_xz
+      # Axis is perpendicular to normal in XZ plane
+      self._deflection_axes[i] = (-nz, 0.0, nx)
+
   def _compute_gpu(
     self,
     creature_pos: Tuple[float, float, float],
     creature_vel: Tuple[float, float, float],
     dt: float
   ) -> Tuple[List[float], List[Tuple[float, float, float]]]:
-    """GPU batch computation (uses CPU fallback for now)."""
-    # TODO: Implement actual GPU kernel when Warp kernel is ready
-    # For now, download arrays, compute on CPU, upload results
-    return self._compute_cpu(creature_pos, creature_vel, dt)
+    """GPU batch computation for a single creature."""
+    return self.compute_deflections_multi([creature_pos], [creature_vel], dt)
 
   def get_state(self, tendroid_id: int) -> Optional[Dict]:
-    """Get deflection state for a specific tendroid."""
+    """Get deflection state for a specific tendroid (syncs on GPU)."""
     if tendroid_id >= self._tendroid_count:
       return None
 
+    if self.uses_gpu:
+      current = float(self._current_angles.numpy()[tendroid_id])
+      target = float(self._target_angles.numpy()[tendroid_id])
+      axis = tuple(self._deflection_axes.numpy()[tendroid_id].tolist())
+    else:
+      current = self._current_angles[tendroid_id]
+      target = self._target_angles[tendroid_id]
+      axis = self._deflection_axes[tendroid_id]
+
     return {
-      'current_angle': self._current_angles[tendroid_id],
-      'target_angle': self._target_angles[tendroid_id],
-      'deflection_axis': self._deflection_axes[tendroid_id],
-      'is_deflecting': abs(self._current_angles[tendroid_id]) > 0.001
+      'current_angle': current,
+      'target_angle': target,
+      'deflection_axis': axis,
+      'is_deflecting': abs(current) > 0.001
     }
 
   def destroy(self) -> None:
@@ -320,4 +672,11 @@ class BatchDeflectionManager:
     self._current_angles = None
     self._target_angles = None
     self._deflection_axes = None
+    self._capacity = 0
+    self._creature_positions = None
+    self._creature_count = None
+    self._positions_staging = None
+    self._positions_staging_np = None
+    self._count_staging = None
+    self._count_staging_np = None
     self._built = False
@@ -211,6 +211,41 @@ class TestBatchDeflectionManager:
     # Should have recovered significantly
     assert angles_recovered[0] < max_defl * 0.5
 
+  def test_multi_creature_deflects_each_tendroid(self, mock_tendroids):
+    """Test that each creature deflects the tendroid it is near."""
+    from qixotic.tendroids.deflection import BatchDeflectionManager
+
+    manager = BatchDeflectionManager(device="cpu")
+    manager.register_tendroids(mock_tendroids)
+
+    positions = [
+      (mock_tendroids[0].position[0] + 0.08, 0.5, mock_tendroids[0].position[2]),
+      (mock_tendroids[-1].position[0] + 0.08, 0.5, mock_tendroids[-1].position[2]),
+    ]
+
+    angles, axes = [], []
+    for _ in range(30):
+      angles, axes = manager.compute_deflections_multi(positions, None, 0.016)
+
+    assert angles[0] > 0.01
+    assert angles[-1] > 0.01
+    assert len(axes) == 4
+
+  def test_multi_creature_matches_single(self, mock_tendroids):
+    """Test that one creature via the multi API matches the single API."""
+    from qixotic.tendroids.deflection import BatchDeflectionManager
+
+    single = BatchDeflectionManager(device="cpu")
+    single.register_tendroids(mock_tendroids)
+    multi = BatchDeflectionManager(device="cpu")
+    multi.register_tendroids(mock_tendroids)
+
+    for _ in range(10):
+      a_single, _ = single.compute_deflections((0.08, 0.5, 0.0), (0.0, 0.0, 0.0), 0.016)
+      a_multi, _ = multi.compute_deflections_multi([(0.08, 0.5, 0.0)], None, 0.016)
+
+    assert a_single == pytest.approx(a_multi)
+
 
 # === Wrapper Deflection Tests ===
 
@@ -131,6 +131,33 @@ def batch_deflection_kernel(
   out_approach_types[tid] = approach_type
 
 
+@wp.func
+def smooth_angle(
+  current: float,
+  target: float,
+  dt: float,
+  deflection_rate: float,
+  recovery_rate: float,
+):
+  """Step current toward target at the deflect/recover rate."""
+  # Choose rate based on direction
+  if target > current:
+    rate = deflection_rate
+  else:
+    rate = recovery_rate
+
+  # Calculate max change for this frame
+  max_change = rate * dt
+
+  # Apply change
+  diff = target - current
+  if wp.abs(diff) <= max_change:
+    return target
+  elif diff > 0.0:
+    return current + max_change
+  return current - max_change
+
+
 @wp.kernel
 def smooth_deflection_kernel(
   current_angles: wp.array(dtype=float),
@@ -144,26 +171,96 @@ def smooth_deflection_kernel(
   GPU kernel to smooth deflection transitions.
 
   Applies different rates for deflecting vs recovering.
+  out_angles may alias current_angles for an in-place update.
   """
   tid = wp.tid()
+  out_angles[tid] = smooth_angle(
+    current_angles[tid], target_angles[tid], dt, deflection_rate, recovery_rate
+  )
 
-  current = current_angles[tid]
-  target = target_angles[tid]
 
-  # Choose rate based on direction
-  if target > current:
-    rate = deflection_rate
-  else:
-    rate = recovery_rate
+@wp.kernel
+def smooth_deflection_frame_kernel(
+  current_angles: wp.array(dtype=float),
+  target_angles: wp.array(dtype=float),
+  frame_params: wp.array(dtype=float),
+  deflection_rate: float,
+  recovery_rate: float,
+  out_angles: wp.array(dtype=float),
+):
+  """
+  smooth_deflection_kernel with dt read from frame_params[0].
 
-  # Calculate max change for this frame
-  max_change = rate * dt
+  Lets the launch be captured once in a CUDA graph and replayed with
+  a new dt each frame.
+  """
+  tid = wp.tid()
+  out_angles[tid] = smooth_angle(
+    current_angles[tid], target_angles[tid], frame_params[0],
+    deflection_rate, recovery_rate
+  )
 
-  # Apply change
-  diff = target - current
-  if wp.abs(diff) <= max_change:
-    out_angles[tid] = target
-  elif diff > 0.0:
-    out_angles[tid] = current + max_change
-  else:
-    out_angles[tid] = current - max_change
+
+@wp.kernel
+def multi_creature_target_kernel(
+  # Tendroid geometry (per-tendroid)
+  tendroid_centers_x: wp.array(dtype=float),
+  tendroid_centers_z: wp.array(dtype=float),
+  tendroid_base_y: wp.array(dtype=float),
+  tendroid_heights: wp.array(dtype=float),
+  tendroid_radii: wp.array(dtype=float),
+  # Creature state (first creature_count[0] entries are live)
+  creature_positions: wp.array(dtype=wp.vec3),
+  creature_count: wp.array(dtype=int),
+  # Detection zones
+  detection_range: float,
+  approach_buffer: float,
+  # Deflection limits
+  min_deflection: float,
+  max_deflection: float,
+  # Outputs (axes keep their last value when nothing is in range)
+  out_target_angles: wp.array(dtype=float),
+  out_deflection_axes: wp.array(dtype=wp.vec3),
+):
+  """
+  Per-tendroid target deflection against every live creature.
+
+  Same falloff as BatchDeflectionManager._compute_cpu: the strongest
+  creature wins and sets the bend axis (perpendicular to its approach
+  in the XZ plane).
+  """
+  tid = wp.tid()
+
+  center_x = tendroid_centers_x[tid]
+  center_z = tendroid_centers_z[tid]
+  base_y = tendroid_base_y[tid]
+  height = tendroid_heights[tid]
+  detect_dist = tendroid_radii[tid] + approach_buffer + detection_range
+
+  best_target = float(0.0)
+  best_axis = out_deflection_axes[tid]
+
+  for c in range(creature_count[0]):
+    pos = creature_positions[c]
+    dx = pos[0] - center_x
+    dz = pos[2] - center_z
+    dist_xz = wp.sqrt(dx * dx + dz * dz)
+
+    # Out of range, or above/below the tendroid
+    if dist_xz > detect_dist or pos[1] < base_y or pos[1] > base_y + height:
+      continue
+
+    height_ratio = float(0.0)
+    if height > 0.0:
+      height_ratio = (pos[1] - base_y) / height
+
+    dist_ratio = wp.clamp(1.0 - dist_xz / detect_dist, 0.0, 1.0)
+    target = min_deflection + (max_deflection - min_deflection) * height_ratio * dist_ratio
+
+    if target > best_target:
+      best_target = target
+      if dist_xz > 0.001:
+        best_axis = wp.vec3(-dz / dist_xz, 0.0, dx / dist_xz)
+
+  out_target_angles[tid] = best_target
+  out_deflection_axes[tid] = best_axis
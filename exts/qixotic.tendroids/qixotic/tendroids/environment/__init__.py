@@ -4,7 +4,7 @@ V2 Environment - Sea floor, sky, and lighting setup
 
 from .sea_floor_config import SeaFloorConfig
 from .sea_floor_controller import SeaFloorController
-from .sea_floor_helper import initialize_height_map, get_height_at
+from .sea_floor_helper import initialize_height_map, get_height_at, get_heights_at
 from .environment_config import (
     EnvironmentConfig,
     SkyConfig,
@@ -19,6 +19,7 @@ __all__ = [
     "SeaFloorController",
     "initialize_height_map",
     "get_height_at",
+    "get_heights_at",
     # Environment
     "EnvironmentConfig",
     "SkyConfig",
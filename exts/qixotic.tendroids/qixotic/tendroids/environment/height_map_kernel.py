@@ -0,0 +1,138 @@
+"""
+Warp kernels for sea floor height maps
+
+fbm_height_map_kernel fills the (resolution_y + 1) x (resolution_x + 1)
+grid in one launch - one thread per cell, octaves summed in-thread -
+instead of a per-cell, per-octave Python loop. sample_heights_kernel is
+the batched form of get_height_at (same bilinear rule, 0.0 outside the
+floor).
+
+perlin2 is perlin_noise.pnoise2 (the noise package's improved Perlin)
+on the device: pass perlin_noise.PERM / GRAD2 as perm / grads and the
+terrain matches the host map to float32 rounding.
+"""
+
+import warp as wp
+
+wp.init()
+
+
+@wp.func
+def _fade(t: float):
+  return t * t * t * (t * (t * 6.0 - 15.0) + 10.0)
+
+
+@wp.func
+def _grad2(grads: wp.array(dtype=wp.vec2), hash_: int, x: float, y: float):
+  g = grads[hash_ & 15]
+  return x * g[0] + y * g[1]
+
+
+@wp.func
+def perlin2(
+  perm: wp.array(dtype=int),
+  grads: wp.array(dtype=wp.vec2),
+  x: float,
+  y: float,
+  repeat: float,
+  base: int,
+):
+  """noise.pnoise2(x, y, octaves=1, repeatx=repeat, repeaty=repeat, base=base)."""
+  i = int(wp.floor(wp.mod(x, repeat)))
+  j = int(wp.floor(wp.mod(y, repeat)))
+  ii = int(wp.mod(float(i + 1), repeat))
+  jj = int(wp.mod(float(j + 1), repeat))
+  i = (i & 255) + base
+  j = (j & 255) + base
+  ii = (ii & 255) + base
+  jj = (jj & 255) + base
+
+  x = x - wp.floor(x)
+  y = y - wp.floor(y)
+  fx = _fade(x)
+  fy = _fade(y)
+
+  mask = perm.shape[0] - 1
+  a = perm[i & mask]
+  aa = perm[(a + j) & mask]
+  ab = perm[(a + jj) & mask]
+  b = perm[ii & mask]
+  ba = perm[(b + j) & mask]
+  bb = perm[(b + jj) & mask]
+
+  n0 = wp.lerp(_grad2(grads, perm[aa], x, y), _grad2(grads, perm[ba], x - 1.0, y), fx)
+  n1 = wp.lerp(_grad2(grads, perm[ab], x, y - 1.0), _grad2(grads, perm[bb], x - 1.0, y - 1.0), fx)
+  return wp.lerp(n0, n1, fy)
+
+
+@wp.kernel
+def fbm_height_map_kernel(
+  perm: wp.array(dtype=int),
+  grads: wp.array(dtype=wp.vec2),
+  seed: int,
+  half_width: float,
+  half_depth: float,
+  spacing_x: float,
+  spacing_y: float,
+  amplitude: float,
+  frequency: float,
+  octaves: int,
+  heights: wp.array2d(dtype=float),
+):
+  """Normalized fBm height per grid cell (row = z index, col = x index)."""
+  y_idx, x_idx = wp.tid()
+
+  x = -half_width + float(x_idx) * spacing_x
+  z = -half_depth + float(y_idx) * spacing_y
+
+  height = float(0.0)
+  octave_amp = amplitude
+  octave_freq = frequency
+  total_amp = float(0.0)
+
+  for _ in range(octaves):
+    height += perlin2(perm, grads, x * octave_freq, z * octave_freq, 1024.0, seed) * octave_amp
+    total_amp += octave_amp
+    octave_amp *= 0.5
+    octave_freq *= 2.0
+
+  if total_amp > 0.0:
+    height = height / total_amp * amplitude
+  heights[y_idx, x_idx] = height
+
+
+@wp.kernel
+def sample_heights_kernel(
+  heights: wp.array2d(dtype=float),
+  half_width: float,
+  half_depth: float,
+  spacing_x: float,
+  spacing_y: float,
+  xs: wp.array(dtype=float),
+  zs: wp.array(dtype=float),
+  out: wp.array(dtype=float),
+):
+  """Bilinear height at (xs[i], zs[i]); 0.0 outside the floor."""
+  i = wp.tid()
+  x = xs[i]
+  z = zs[i]
+
+  if x < -half_width or x > half_width or z < -half_depth or z > half_depth:
+    out[i] = 0.0
+    return
+
+  res_y = heights.shape[0] - 1
+  res_x = heights.shape[1] - 1
+
+  grid_x = (x + half_width) / spacing_x
+  grid_y = (z + half_depth) / spacing_y
+  x0 = wp.min(int(wp.floor(grid_x)), res_x)
+  y0 = wp.min(int(wp.floor(grid_y)), res_y)
+  x1 = wp.min(x0 + 1, res_x)
+  y1 = wp.min(y0 + 1, res_y)
+  fx = grid_x - float(x0)
+  fy = grid_y - float(y0)
+
+  h0 = heights[y0, x0] * (1.0 - fx) + heights[y0, x1] * fx
+  h1 = heights[y1, x0] * (1.0 - fx) + heights[y1, x1] * fx
+  out[i] = h0 * (1.0 - fy) + h1 * fy
@@ -0,0 +1,133 @@
+"""
+Improved Perlin noise matching noise.pnoise2 (single octave)
+
+NumPy port of the `noise` package's 2D noise: Ken Perlin's permutation
+(doubled to 512 entries), the package's 16-entry gradient table, the
+quintic fade and its `base` offset into the permutation. fbm_heights
+sums octaves exactly like the original per-cell pnoise2 loop, vectorized
+over the whole grid; height_map_kernel.py evaluates the same function
+on the device from PERM / GRAD2.
+
+Coordinates are float32 as in the C implementation. With base > 0 the
+C code can index past its 512-entry table; those lookups wrap here.
+"""
+
+import numpy as np
+
+# Ken Perlin's reference permutation
+_PERMUTATION = [
+  151, 160, 137, 91, 90, 15, 131, 13, 201, 95, 96, 53, 194, 233, 7, 225,
+  140, 36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23, 190, 6, 148,
+  247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32,
+  57, 177, 33, 88, 237, 149, 56, 87, 174, 20, 125, 136, 171, 168, 68, 175,
+  74, 165, 71, 134, 139, 48, 27, 166, 77, 146, 158, 231, 83, 111, 229, 122,
+  60, 211, 133, 230, 220, 105, 92, 41, 55, 46, 245, 40, 244, 102, 143, 54,
+  65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169,
+  200, 196, 135, 130, 116, 188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64,
+  52, 217, 226, 250, 124, 123, 5, 202, 38, 147, 118, 126, 255, 82, 85, 212,
+  207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42, 223, 183, 170, 213,
+  119, 248, 152, 2, 44, 154, 163, 70, 221, 153, 101, 155, 167, 43, 172, 9,
+  129, 22, 39, 253, 19, 98, 108, 110, 79, 113, 224, 232, 178, 185, 112, 104,
+  218, 246, 97, 228, 251, 34, 242, 193, 238, 210, 144, 12, 191, 179, 162, 241,
+  81, 51, 145, 235, 249, 14, 239, 107, 49, 192, 214, 31, 181, 199, 106, 157,
+  184, 84, 204, 176, 115, 121, 50, 45, 127, 4, 150, 254, 138, 236, 205, 93,
+  222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156, 180,
+]
+
+PERM = np.array(_PERMUTATION * 2, dtype=np.int32)
+
+# (x, y) of the package's GRAD3 table (z dropped for 2D)
+GRAD2 = np.array([
+  (1, 1), (-1, 1), (1, -1), (-1, -1),
+  (1, 0), (-1, 0), (1, 0), (-1, 0),
+  (0, 1), (0, -1), (0, 1), (0, -1),
+  (1, 0), (-1, 0), (0, -1), (0, 1),
+], dtype=np.float32)
+
+
+def _grad(hash_, x, y):
+  """Dot of gradient hash_ with (x, y)."""
+  g = GRAD2[hash_ & 15]
+  return x * g[..., 0] + y * g[..., 1]
+
+
+def _lerp(t, a, b):
+  return a + t * (b - a)
+
+
+def pnoise2(x, y, repeatx: float = 1024.0, repeaty: float = 1024.0, base: int = 0) -> np.ndarray:
+  """
+  Vectorized noise.pnoise2(x, y, octaves=1, ...).
+
+  Args:
+      x, y: Sample coordinates (array-like, broadcast together)
+      repeatx, repeaty: Tiling period
+      base: Permutation offset (the package's seed)
+
+  Returns:
+      float32 noise values in about [-1, 1]
+  """
+  x = np.asarray(x, dtype=np.float32)
+  y = np.asarray(y, dtype=np.float32)
+  rx, ry = np.float32(repeatx), np.float32(repeaty)
+
+  i = np.floor(np.fmod(x, rx)).astype(np.int64)
+  j = np.floor(np.fmod(y, ry)).astype(np.int64)
+  ii = np.fmod((i + 1).astype(np.float32), rx).astype(np.int64)
+  jj = np.fmod((j + 1).astype(np.float32), ry).astype(np.int64)
+  i = (i & 255) + base
+  j = (j & 255) + base
+  ii = (ii & 255) + base
+  jj = (jj & 255) + base
+
+  x = x - np.floor(x)
+  y = y - np.floor(y)
+  fx = x * x * x * (x * (x * np.float32(6) - np.float32(15)) + np.float32(10))
+  fy = y * y * y * (y * (y * np.float32(6) - np.float32(15)) + np.float32(10))
+
+  mask = PERM.shape[0] - 1
+  a = PERM[i & mask]
+  aa = PERM[(a + j) & mask]
+  ab = PERM[(a + jj) & mask]
+  b = PERM[ii & mask]
+  ba = PERM[(b + j) & mask]
+  bb = PERM[(b + jj) & mask]
+
+  one = np.float32(1)
+  return _lerp(
+    fy,
+    _lerp(fx, _grad(PERM[aa], x, y), _grad(PERM[ba], x - one, y)),
+    _lerp(fx, _grad(PERM[ab], x, y - one), _grad(PERM[bb], x - one, y - one)),
+  )
+
+
+def fbm_heights(config) -> np.ndarray:
+  """
+  Normalized fBm height map of a SeaFloorConfig (row = z, col = x).
+
+  Octave i samples pnoise2 at frequency * 2^i with amplitude * 0.5^i and
+  base = seed; the sum is rescaled to the full amplitude.
+
+  Returns:
+      [resolution_y + 1, resolution_x + 1] float64 heights
+  """
+  # Grid coordinates and octave frequencies in float64 like the Python
+  # loop; pnoise2 rounds the scaled sample to float32 as the C call does
+  xs = -config.width / 2.0 + np.arange(config.resolution_x + 1) * config.grid_spacing_x
+  zs = -config.depth / 2.0 + np.arange(config.resolution_y + 1) * config.grid_spacing_y
+  x, z = np.meshgrid(xs, zs)
+
+  height = np.zeros(x.shape, dtype=np.float64)
+  amplitude = config.amplitude
+  frequency = config.frequency
+  max_amplitude = 0.0
+  for _ in range(config.octaves):
+    noise = pnoise2(x * frequency, z * frequency, base=int(config.seed))
+    height += noise.astype(np.float64) * amplitude
+    max_amplitude += amplitude
+    amplitude *= 0.5
+    frequency *= 2.0
+
+  if max_amplitude > 0.0:
+    height = height / max_amplitude * config.amplitude
+  return height
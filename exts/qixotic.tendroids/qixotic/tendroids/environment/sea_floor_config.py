@@ -19,6 +19,11 @@ class SeaFloorConfig:
   amplitude: float = 32.0  # Increased from 24.0 for dramatic terrain (±16 units)
   frequency: float = 0.01  # Reduced for fewer, larger undulations
   octaves: int = 3
+  seed: int = 42
+  
+  # Build the height map with the Warp fBm kernel (same pnoise2 surface
+  # as the host path; False forces the vectorized host build)
+  gpu_generation: bool = True
   
   # Mesh resolution (number of subdivisions)
   resolution_x: int = 60
@@ -5,10 +5,11 @@ Handles USD mesh creation for contoured sea floor terrain.
 """
 
 import carb
-from pxr import Gf, Sdf, UsdGeom, UsdShade
+import numpy as np
+from pxr import Sdf, UsdGeom, UsdShade, Vt
 
 from .sea_floor_config import SeaFloorConfig
-from .sea_floor_helper import initialize_height_map
+from .sea_floor_helper import initialize_height_map, set_height_map
 from .environment_config import EnvironmentConfig
 from .environment_setup import EnvironmentSetup
 
@@ -17,13 +18,14 @@ class SeaFloorController:
   """Controller for creating sea floor USD geometry."""
   
   @staticmethod
-  def create_sea_floor(stage, config: SeaFloorConfig = None) -> bool:
+  def create_sea_floor(stage, config: SeaFloorConfig = None, height_map=None) -> bool:
     """
     Create contoured sea floor mesh in USD stage.
     
     Args:
         stage: USD stage
         config: Configuration for terrain generation (uses JSON if None)
+        height_map: Precomputed height map (scene cache); generated if None
     
     Returns:
         True if successful, False otherwise
@@ -32,8 +34,11 @@ class SeaFloorController:
       if config is None:
         config = SeaFloorConfig.from_json()
       
-      # Generate height map
-      initialize_height_map(config)
+      # Generate height map (or reuse the cached one)
+      if height_map is not None:
+        set_height_map(config, height_map)
+      else:
+        initialize_height_map(config)
       
       # Import height map after it's been initialized
       from .sea_floor_helper import _height_map
@@ -101,64 +106,54 @@ class SeaFloorController:
       return False
   
   @staticmethod
-  def _build_vertices(config: SeaFloorConfig, height_map) -> list:
-    """Build vertex positions with height map."""
+  def _build_vertices(config: SeaFloorConfig, height_map) -> Vt.Vec3fArray:
+    """Build vertex positions with height map (row-major, z then x)."""
     if height_map is None:
       raise ValueError("Height map cannot be None")
     
-    vertices = []
-    half_width = config.width / 2.0
-    half_depth = config.depth / 2.0
+    xs = -config.width / 2.0 + np.arange(config.resolution_x + 1) * config.grid_spacing_x
+    zs = -config.depth / 2.0 + np.arange(config.resolution_y + 1) * config.grid_spacing_y
+    grid_x, grid_z = np.meshgrid(xs, zs)
     
-    for y_idx in range(config.resolution_y + 1):
-      for x_idx in range(config.resolution_x + 1):
-        x = -half_width + (x_idx * config.grid_spacing_x)
-        z = -half_depth + (y_idx * config.grid_spacing_y)
-        y = height_map[y_idx, x_idx]
-        
-        vertices.append(Gf.Vec3f(x, y, z))
-    
-    return vertices
+    points = np.stack([grid_x, np.asarray(height_map), grid_z], axis=-1)
+    return Vt.Vec3fArray.FromNumpy(points.reshape(-1, 3).astype(np.float32))
   
   @staticmethod
   def _build_faces(config: SeaFloorConfig) -> tuple:
     """Build face topology (quads)."""
-    face_counts = []
-    face_indices = []
-    
     cols = config.resolution_x + 1
     
-    for y_idx in range(config.resolution_y):
-      for x_idx in range(config.resolution_x):
-        # Quad corners (counter-clockwise)
-        i0 = y_idx * cols + x_idx
-        i1 = i0 + 1
-        i2 = i0 + cols + 1
-        i3 = i0 + cols
-        
-        face_counts.append(4)
-        face_indices.extend([i0, i1, i2, i3])
+    # Quad corners (counter-clockwise)
+    rows, columns = np.meshgrid(
+      np.arange(config.resolution_y), np.arange(config.resolution_x), indexing="ij"
+    )
+    i0 = (rows * cols + columns).reshape(-1)
+    face_indices = np.stack([i0, i0 + 1, i0 + cols + 1, i0 + cols], axis=-1)
+    face_counts = np.full(i0.shape[0], 4, dtype=np.int32)
     
-    return face_counts, face_indices
+    return (
+      Vt.IntArray.FromNumpy(face_counts),
+      Vt.IntArray.FromNumpy(face_indices.reshape(-1).astype(np.int32)),
+    )
   
   @staticmethod
-  def _build_normals(config: SeaFloorConfig, vertices: list) -> list:
+  def _build_normals(config: SeaFloorConfig, vertices) -> Vt.Vec3fArray:
     """Build vertex normals (simple upward for now)."""
     # For simplicity, use upward normals
     # Could be enhanced to compute actual surface normals
-    return [Gf.Vec3f(0, 1, 0) for _ in vertices]
+    normals = np.zeros((len(vertices), 3), dtype=np.float32)
+    normals[:, 1] = 1.0
+    return Vt.Vec3fArray.FromNumpy(normals)
   
   @staticmethod
-  def _build_uvs(config: SeaFloorConfig) -> list:
+  def _build_uvs(config: SeaFloorConfig) -> Vt.Vec2fArray:
     """Build UV coordinates."""
-    uvs = []
     scale_x = 8.0
     scale_y = 8.0
     
-    for y_idx in range(config.resolution_y + 1):
-      v = (y_idx / config.resolution_y) * scale_y
-      for x_idx in range(config.resolution_x + 1):
-        u = (x_idx / config.resolution_x) * scale_x
-        uvs.append(Gf.Vec2f(u, v))
+    u = np.arange(config.resolution_x + 1) / config.resolution_x * scale_x
+    v = np.arange(config.resolution_y + 1) / config.resolution_y * scale_y
+    grid_u, grid_v = np.meshgrid(u, v)
     
-    return uvs
+    uvs = np.stack([grid_u, grid_v], axis=-1).reshape(-1, 2)
+    return Vt.Vec2fArray.FromNumpy(uvs.astype(np.float32))
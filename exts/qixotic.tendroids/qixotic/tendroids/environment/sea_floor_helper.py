@@ -2,37 +2,25 @@
 Sea floor helper functions for height calculations
 
 Handles Perlin noise generation and height queries with bilinear interpolation.
+The height map is built on the device with Warp when available (see
+height_map_kernel.py), otherwise vectorized on the host (perlin_noise.py);
+both evaluate the same pnoise2 fBm. The map is kept resident on the
+device for batched queries; the host copy serves mesh building and
+scalar get_height_at.
 """
 
 import carb
 import numpy as np
+from .perlin_noise import GRAD2, PERM, fbm_heights
 from .sea_floor_config import SeaFloorConfig
 
 # Module-level cached height map
 _height_map = None
+_height_map_gpu = None
 _config = None
-_noise_module = None
-
-
-def _get_noise_module():
-  """Lazy import of noise module."""
-  global _noise_module
-  if _noise_module is None:
-    try:
-      import noise
-      _noise_module = noise
-    except ImportError:
-      carb.log_error("[SeaFloorHelper] Noise module not installed. Installing...")
-      try:
-        import omni.kit.pipapi
-        omni.kit.pipapi.install("noise>=1.2.2", module="noise")
-        import noise
-        _noise_module = noise
-        carb.log_info("[SeaFloorHelper] Noise module installed successfully")
-      except Exception as e:
-        carb.log_error(f"[SeaFloorHelper] Failed to install noise module: {e}")
-        raise
-  return _noise_module
+
+# Batches smaller than this are sampled on the host (launch + sync cost)
+GPU_SAMPLE_THRESHOLD = 4096
 
 
 def initialize_height_map(config: SeaFloorConfig = None):
@@ -42,70 +30,116 @@ def initialize_height_map(config: SeaFloorConfig = None):
   Args:
       config: Configuration for terrain generation
   """
-  global _height_map, _config
+  global _height_map, _height_map_gpu, _config
   
   if config is None:
     config = SeaFloorConfig()
   
   _config = config
+  _height_map_gpu = None
+  
+  if config.gpu_generation and _generate_height_map_gpu(config):
+    _log_height_map(config)
+    return
+  
+  _height_map = fbm_heights(config)
+  _upload_height_map()
+  
+  _log_height_map(config)
+
+
+def _generate_height_map_gpu(config: SeaFloorConfig) -> bool:
+  """
+  Build the height map with fbm_height_map_kernel.
   
-  # Get noise module
-  noise = _get_noise_module()
-  
-  # Generate height map using Perlin noise
-  _height_map = np.zeros((config.resolution_y + 1, config.resolution_x + 1))
-  
-  half_width = config.width / 2.0
-  half_depth = config.depth / 2.0
-  
-  min_height = float('inf')
-  max_height = float('-inf')
-  
-  for y_idx in range(config.resolution_y + 1):
-    for x_idx in range(config.resolution_x + 1):
-      # Convert grid indices to world coordinates
-      x = -half_width + (x_idx * config.grid_spacing_x)
-      z = -half_depth + (y_idx * config.grid_spacing_y)
-      
-      # Generate Perlin noise with proper octave accumulation
-      height = 0.0
-      amplitude = config.amplitude
-      frequency = config.frequency
-      max_amplitude = 0.0
-      
-      for octave in range(config.octaves):
-        noise_val = noise.pnoise2(
-          x * frequency,
-          z * frequency,
-          octaves=1,
-          persistence=0.5,
-          lacunarity=2.0,
-          repeatx=1024,
-          repeaty=1024,
-          base=42
-        )
-        height += noise_val * amplitude
-        max_amplitude += amplitude
-        
-        amplitude *= 0.5
-        frequency *= 2.0
-      
-      # Normalize to use full amplitude range
-      height = (height / max_amplitude) * config.amplitude
-      
-      _height_map[y_idx, x_idx] = height
-      
-      # Track min/max for debugging
-      min_height = min(min_height, height)
-      max_height = max(max_height, height)
+  Returns:
+      False if Warp is unavailable (caller falls back to the host fBm)
+  """
+  global _height_map, _height_map_gpu
+  
+  try:
+    import warp as wp
+    from .height_map_kernel import fbm_height_map_kernel
+  except Exception as e:
+    carb.log_warn(f"[SeaFloorHelper] Warp unavailable, using CPU noise: {e}")
+    return False
+  
+  device = "cuda:0" if wp.is_cuda_available() else "cpu"
+  heights = wp.zeros(
+    (config.resolution_y + 1, config.resolution_x + 1), dtype=float, device=device
+  )
+  wp.launch(
+    kernel=fbm_height_map_kernel,
+    dim=heights.shape,
+    inputs=[
+      wp.array(PERM, dtype=int, device=device),
+      wp.array(GRAD2, dtype=wp.vec2, device=device),
+      int(config.seed),
+      config.width / 2.0, config.depth / 2.0,
+      config.grid_spacing_x, config.grid_spacing_y,
+      config.amplitude, config.frequency, int(config.octaves),
+      heights,
+    ],
+    device=device
+  )
   
+  _height_map_gpu = heights
+  _height_map = heights.numpy().astype(np.float64)
+  return True
+
+
+def _upload_height_map():
+  """Mirror the host height map on the device for batched sampling."""
+  global _height_map_gpu
+  
+  _height_map_gpu = None
+  try:
+    import warp as wp
+    device = "cuda:0" if wp.is_cuda_available() else "cpu"
+    _height_map_gpu = wp.array(_height_map.astype(np.float32), dtype=float, device=device)
+  except Exception:
+    pass  # Host sampling only
+
+
+def _log_height_map(config: SeaFloorConfig):
+  """Log grid size and height range."""
   carb.log_info(
     f"[SeaFloorHelper] Generated height map: "
     f"{config.resolution_x + 1}x{config.resolution_y + 1} grid, "
-    f"height range: [{min_height:.2f}, {max_height:.2f}]"
+    f"height range: [{_height_map.min():.2f}, {_height_map.max():.2f}]"
   )
 
 
+def get_height_map_gpu():
+  """Device-resident height map (wp.array2d) or None."""
+  return _height_map_gpu
+
+
+def get_height_map():
+  """Host height map ([resolution_y + 1, resolution_x + 1]) or None."""
+  return _height_map
+
+
+def set_height_map(config: SeaFloorConfig, heights):
+  """
+  Install a precomputed height map (scene cache) instead of generating.
+  
+  Args:
+      config: Configuration the map was generated with
+      heights: [resolution_y + 1, resolution_x + 1] array
+  """
+  global _height_map, _config
+  
+  expected = (config.resolution_y + 1, config.resolution_x + 1)
+  heights = np.asarray(heights, dtype=np.float64)
+  if heights.shape != expected:
+    raise ValueError(f"Height map shape {heights.shape} != {expected}")
+  
+  _config = config
+  _height_map = heights
+  _upload_height_map()
+
+
 def get_height_at(x: float, y: float) -> float:
   """
   Get floor height at world position using bilinear interpolation.
@@ -155,3 +189,83 @@ def get_height_at(x: float, y: float) -> float:
   h1 = h01 * (1 - fx) + h11 * fx
   
   return h0 * (1 - fy) + h1 * fy
+
+
+def get_heights_at(xs, zs):
+  """
+  Batched get_height_at.
+  
+  Large host batches and Warp arrays are sampled on the device with
+  sample_heights_kernel; small host batches use the same bilinear rule
+  in NumPy.
+  
+  Args:
+      xs: World X coordinates (array-like or wp.array)
+      zs: World Z coordinates, same length
+  
+  Returns:
+      float64 NumPy array for host input; wp.array (on the height
+      map's device) for wp.array input
+  """
+  is_warp = hasattr(xs, "ptr")
+  
+  if _height_map is None or _config is None:
+    if is_warp:
+      import warp as wp
+      return wp.zeros(xs.shape[0], dtype=float, device=xs.device)
+    return np.zeros(np.shape(xs), dtype=np.float64)
+  
+  if _height_map_gpu is not None and (is_warp or np.size(xs) >= GPU_SAMPLE_THRESHOLD):
+    return _sample_heights_gpu(xs, zs, is_warp)
+  
+  if is_warp:
+    xs, zs = xs.numpy(), zs.numpy()
+  return _sample_heights_host(
+    np.asarray(xs, dtype=np.float64), np.asarray(zs, dtype=np.float64)
+  )
+
+
+def _sample_heights_host(xs: np.ndarray, zs: np.ndarray) -> np.ndarray:
+  """Vectorized bilinear lookup on the host height map."""
+  half_width = _config.width / 2.0
+  half_depth = _config.depth / 2.0
+  
+  inside = (xs >= -half_width) & (xs <= half_width) & (zs >= -half_depth) & (zs <= half_depth)
+  grid_x = (np.clip(xs, -half_width, half_width) + half_width) / _config.grid_spacing_x
+  grid_y = (np.clip(zs, -half_depth, half_depth) + half_depth) / _config.grid_spacing_y
+  
+  x0 = np.minimum(np.floor(grid_x).astype(np.int64), _config.resolution_x)
+  y0 = np.minimum(np.floor(grid_y).astype(np.int64), _config.resolution_y)
+  x1 = np.minimum(x0 + 1, _config.resolution_x)
+  y1 = np.minimum(y0 + 1, _config.resolution_y)
+  fx = grid_x - x0
+  fy = grid_y - y0
+  
+  h0 = _height_map[y0, x0] * (1 - fx) + _height_map[y0, x1] * fx
+  h1 = _height_map[y1, x0] * (1 - fx) + _height_map[y1, x1] * fx
+  return np.where(inside, h0 * (1 - fy) + h1 * fy, 0.0)
+
+
+def _sample_heights_gpu(xs, zs, is_warp: bool):
+  """sample_heights_kernel on the device height map."""
+  import warp as wp
+  from .height_map_kernel import sample_heights_kernel
+  
+  device = _height_map_gpu.device
+  if not is_warp:
+    xs = wp.array(np.asarray(xs, dtype=np.float32).reshape(-1), dtype=float, device=device)
+    zs = wp.array(np.asarray(zs, dtype=np.float32).reshape(-1), dtype=float, device=device)
+  
+  out = wp.zeros(xs.shape[0], dtype=float, device=device)
+  wp.launch(
+    kernel=sample_heights_kernel,
+    dim=xs.shape[0],
+    inputs=[
+      _height_map_gpu,
+      _config.width / 2.0, _config.depth / 2.0,
+      _config.grid_spacing_x, _config.grid_spacing_y,
+      xs, zs, out,
+    ],
+    device=device
+  )
+  return out if is_warp else out.numpy().astype(np.float64)
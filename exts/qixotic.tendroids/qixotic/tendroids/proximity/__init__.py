@@ -69,17 +69,31 @@ from .proximity_state import (
 )
 
 from .state_transitions import (
+    MOVEMENT_THRESHOLD,
     determine_next_state,
     get_transition_description,
 )
 
 from .state_manager import (
+    StateCallbackRegistry,
     ProximityStateManager,
     StateChangeEvent,
     TrackedEntity,
     StateCallback,
 )
 
+# Batched multi-creature state machine (device-side transitions)
+from .batch_proximity_helper import (
+    batch_proximity_state_kernel,
+    state_from_code,
+    state_to_code,
+    decode_pair_indices,
+)
+
+from .batch_proximity import (
+    BatchProximityStateManager,
+)
+
 __all__ = [
     # Grid Configuration
     "GridConfig",
@@ -130,12 +144,21 @@ __all__ = [
     "get_state_priority",
     
     # TEND-18: State Transitions
+    "MOVEMENT_THRESHOLD",
     "determine_next_state",
     "get_transition_description",
     
     # TEND-18: State Manager
+    "StateCallbackRegistry",
     "ProximityStateManager",
     "StateChangeEvent",
     "TrackedEntity",
     "StateCallback",
+    
+    # Batched multi-creature state machine
+    "batch_proximity_state_kernel",
+    "state_from_code",
+    "state_to_code",
+    "decode_pair_indices",
+    "BatchProximityStateManager",
 ]
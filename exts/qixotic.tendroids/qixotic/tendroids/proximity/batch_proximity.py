@@ -0,0 +1,352 @@
+"""
+Batch Proximity State Manager
+
+Device-resident proximity state for many creatures against all tendroids.
+One 2D kernel launch per frame classifies zones and applies the
+state_transitions.py rules for every (creature, tendroid) pair; only the
+compacted list of transitions is downloaded and turned into events,
+fired in (creature, tendroid) order.
+
+TEND-18: Create proximity state manager (batched multi-creature mode)
+"""
+
+from typing import List, Optional, Tuple
+
+import carb
+import numpy as np
+import warp as wp
+
+from .batch_proximity_helper import (
+  batch_proximity_state_kernel,
+  decode_pair_indices,
+  state_from_code,
+)
+from .proximity_config import ApproachParameters, DEFAULT_APPROACH_PARAMS
+from .proximity_state import ProximityState
+from .state_manager import StateCallbackRegistry, StateChangeEvent
+from .state_transitions import MOVEMENT_THRESHOLD
+
+
+class BatchProximityStateManager(StateCallbackRegistry):
+  """
+  Batched equivalent of ProximityStateManager.
+
+  Usage:
+      manager = BatchProximityStateManager()
+      manager.configure_tendroids(tendroid_positions, tendroid_radii)
+      manager.on_contact_enter(my_callback)
+
+      # Each frame (any number of creatures):
+      events = manager.update(creature_positions)
+  """
+
+  def __init__(
+    self,
+    params: Optional[ApproachParameters] = None,
+    device: str = "cuda:0",
+    creature_capacity: int = 16
+  ):
+    """
+    Initialize batch state manager.
+
+    Args:
+        params: Approach parameters defining zone thresholds
+        device: Warp device
+        creature_capacity: Initial creature slots (grows on demand)
+    """
+    super().__init__()
+    self._params = params or DEFAULT_APPROACH_PARAMS
+    self._device = device
+    self._creature_capacity = max(1, creature_capacity)
+    self._creature_count = 0
+    self._tendroid_count = 0
+
+    # Tendroid geometry
+    self._tendroid_positions_gpu: Optional[wp.array] = None
+    self._tendroid_radii_gpu: Optional[wp.array] = None
+
+    # Creature input (device + pinned staging)
+    self._creature_positions_gpu: Optional[wp.array] = None
+    self._positions_staging: Optional[wp.array] = None
+    self._positions_staging_np = None
+
+    # Per-pair state
+    self._states_gpu: Optional[wp.array] = None
+    self._prev_distances_gpu: Optional[wp.array] = None
+    self._has_prev_gpu: Optional[wp.array] = None
+    self._frames_in_state_gpu: Optional[wp.array] = None
+    self._contact_frames_gpu: Optional[wp.array] = None
+    self._zones_gpu: Optional[wp.array] = None
+
+    # Compacted events
+    self._event_count_gpu: Optional[wp.array] = None
+    self._event_pairs_gpu: Optional[wp.array] = None
+    self._event_prev_gpu: Optional[wp.array] = None
+    self._event_new_gpu: Optional[wp.array] = None
+    self._event_dist_gpu: Optional[wp.array] = None
+
+    self._configured = False
+
+  @property
+  def is_configured(self) -> bool:
+    """Check if tendroids have been configured."""
+    return self._configured
+
+  @property
+  def creature_count(self) -> int:
+    """Creatures processed in the last update."""
+    return self._creature_count
+
+  @property
+  def tendroid_count(self) -> int:
+    """Number of configured tendroids."""
+    return self._tendroid_count
+
+  @property
+  def zones_gpu(self) -> Optional[wp.array]:
+    """Per-pair zone index (creature-major), left on device."""
+    return self._zones_gpu
+
+  @property
+  def states_gpu(self) -> Optional[wp.array]:
+    """Per-pair state code (creature-major), left on device."""
+    return self._states_gpu
+
+  def configure_tendroids(
+    self,
+    positions: List[Tuple[float, float, float]],
+    radii: List[float]
+  ) -> bool:
+    """
+    Upload static tendroid geometry and reset all pair state.
+
+    Args:
+        positions: (x, y, z) tendroid centers
+        radii: Cylinder radius per tendroid
+
+    Returns:
+        True if configured
+    """
+    if not positions or len(positions) != len(radii):
+      carb.log_warn("[BatchProximityStateManager] Invalid tendroid geometry")
+      self._configured = False
+      return False
+
+    self._tendroid_count = len(positions)
+    self._tendroid_positions_gpu = wp.array(positions, dtype=wp.vec3, device=self._device)
+    self._tendroid_radii_gpu = wp.array(radii, dtype=float, device=self._device)
+
+    self._creature_positions_gpu = None
+    self._allocate(self._creature_capacity, preserve=False)
+    self._configured = True
+
+    carb.log_info(
+      f"[BatchProximityStateManager] Configured {self._tendroid_count} tendroids, "
+      f"{self._creature_capacity} creature slots"
+    )
+    return True
+
+  def _allocate(self, capacity: int, preserve: bool):
+    """
+    (Re)allocate creature-sized buffers.
+
+    Pair arrays are creature-major, so growing keeps existing pairs
+    by copying the old buffers into the front of the new ones.
+    """
+    pinned = self._device.startswith("cuda")
+    pairs = capacity * self._tendroid_count
+    old = None
+    if preserve and self._states_gpu is not None:
+      old = (
+        self._states_gpu, self._prev_distances_gpu, self._has_prev_gpu,
+        self._frames_in_state_gpu, self._contact_frames_gpu, self._zones_gpu,
+      )
+
+    self._creature_capacity = capacity
+    self._creature_positions_gpu = wp.zeros(capacity, dtype=wp.vec3, device=self._device)
+    self._positions_staging = wp.zeros(capacity, dtype=wp.vec3, device="cpu", pinned=pinned)
+    self._positions_staging_np = self._positions_staging.numpy()
+
+    self._states_gpu = wp.zeros(pairs, dtype=int, device=self._device)
+    self._prev_distances_gpu = wp.zeros(pairs, dtype=float, device=self._device)
+    self._has_prev_gpu = wp.zeros(pairs, dtype=int, device=self._device)
+    self._frames_in_state_gpu = wp.zeros(pairs, dtype=int, device=self._device)
+    self._contact_frames_gpu = wp.zeros(pairs, dtype=int, device=self._device)
+    self._zones_gpu = wp.full(pairs, 4, dtype=int, device=self._device)
+
+    # Each pair transitions at most once per frame - events never overflow
+    self._event_count_gpu = wp.zeros(1, dtype=int, device=self._device)
+    self._event_pairs_gpu = wp.zeros(pairs, dtype=int, device=self._device)
+    self._event_prev_gpu = wp.zeros(pairs, dtype=int, device=self._device)
+    self._event_new_gpu = wp.zeros(pairs, dtype=int, device=self._device)
+    self._event_dist_gpu = wp.zeros(pairs, dtype=float, device=self._device)
+
+    if old:
+      new = (
+        self._states_gpu, self._prev_distances_gpu, self._has_prev_gpu,
+        self._frames_in_state_gpu, self._contact_frames_gpu, self._zones_gpu,
+      )
+      for dst, src in zip(new, old):
+        wp.copy(dst, src, count=src.shape[0])
+
+  def update(
+    self,
+    creature_positions: List[Tuple[float, float, float]],
+    timestamp: float = 0.0
+  ) -> List[StateChangeEvent]:
+    """
+    Advance every creature-tendroid pair one frame.
+
+    Args:
+        creature_positions: (x, y, z) per creature; index is creature_idx
+        timestamp: Optional timestamp for events
+
+    Returns:
+        StateChangeEvents for pairs that transitioned (callbacks fired)
+    """
+    if not self._configured:
+      raise RuntimeError("Tendroids not configured - call configure_tendroids() first")
+
+    count = len(creature_positions)
+    self._ensure_capacity(count)
+    if count == 0:
+      self._creature_count = 0
+      return []
+
+    self._positions_staging_np[:count] = creature_positions
+    wp.copy(self._creature_positions_gpu, self._positions_staging, count=count)
+    return self._run(self._creature_positions_gpu, count, timestamp)
+
+  def update_from_device(
+    self,
+    creature_positions_gpu: wp.array,
+    count: Optional[int] = None,
+    timestamp: float = 0.0
+  ) -> List[StateChangeEvent]:
+    """
+    Advance pairs using creature positions already on the device.
+
+    Args:
+        creature_positions_gpu: wp.array(dtype=vec3) on this device
+        count: Creatures to process (defaults to the array length)
+        timestamp: Optional timestamp for events
+    """
+    if not self._configured:
+      raise RuntimeError("Tendroids not configured - call configure_tendroids() first")
+
+    count = creature_positions_gpu.shape[0] if count is None else count
+    self._ensure_capacity(count)
+    if count == 0:
+      self._creature_count = 0
+      return []
+    return self._run(creature_positions_gpu, count, timestamp)
+
+  def _ensure_capacity(self, count: int):
+    """Grow creature slots (doubling) while keeping existing pair state."""
+    if count <= self._creature_capacity:
+      return
+    capacity = self._creature_capacity
+    while capacity < count:
+      capacity *= 2
+    self._allocate(capacity, preserve=True)
+
+  def _run(self, positions_gpu: wp.array, count: int, timestamp: float) -> List[StateChangeEvent]:
+    """Launch the pair kernel and download only the compacted events."""
+    self._creature_count = count
+    p = self._params
+
+    self._event_count_gpu.zero_()
+    wp.launch(
+      kernel=batch_proximity_state_kernel,
+      dim=(count, self._tendroid_count),
+      inputs=[
+        positions_gpu,
+        self._tendroid_positions_gpu,
+        self._tendroid_radii_gpu,
+        p.approach_epsilon,
+        p.approach_minimum,
+        p.warning_distance,
+        p.detection_radius,
+        MOVEMENT_THRESHOLD,
+        self._states_gpu,
+        self._prev_distances_gpu,
+        self._has_prev_gpu,
+        self._frames_in_state_gpu,
+        self._contact_frames_gpu,
+        self._zones_gpu,
+        self._event_count_gpu,
+        self._event_pairs_gpu,
+        self._event_prev_gpu,
+        self._event_new_gpu,
+        self._event_dist_gpu,
+      ],
+      device=self._device
+    )
+
+    # One scalar sync, then only the populated event slots
+    n_events = int(self._event_count_gpu.numpy()[0])
+    if n_events == 0:
+      return []
+
+    pairs = self._event_pairs_gpu[:n_events].numpy()
+    prev_states = self._event_prev_gpu[:n_events].numpy()
+    new_states = self._event_new_gpu[:n_events].numpy()
+    distances = self._event_dist_gpu[:n_events].numpy()
+
+    # Atomic slot order varies run to run - fire in pair order
+    order = np.argsort(pairs, kind="stable")
+    pairs, prev_states = pairs[order], prev_states[order]
+    new_states, distances = new_states[order], distances[order]
+
+    events = []
+    indices = decode_pair_indices(pairs, self._tendroid_count)
+    for i, (creature_idx, tendroid_idx) in enumerate(indices):
+      event = StateChangeEvent(
+        creature_idx=creature_idx,
+        tendroid_idx=tendroid_idx,
+        previous_state=state_from_code(prev_states[i]),
+        new_state=state_from_code(new_states[i]),
+        surface_distance=float(distances[i]),
+        timestamp=timestamp,
+      )
+      self._fire_callbacks(event)
+      events.append(event)
+    return events
+
+  def get_state(self, creature_idx: int, tendroid_idx: int) -> ProximityState:
+    """Get current state for a pair (syncs - debugging/UI only)."""
+    if not self._configured or creature_idx >= self._creature_capacity:
+      return ProximityState.IDLE
+    pair = creature_idx * self._tendroid_count + tendroid_idx
+    return state_from_code(self._states_gpu[pair:pair + 1].numpy()[0])
+
+  def reset(self) -> None:
+    """Reset all pairs to IDLE."""
+    if not self._configured:
+      return
+    self._states_gpu.zero_()
+    self._prev_distances_gpu.zero_()
+    self._has_prev_gpu.zero_()
+    self._frames_in_state_gpu.zero_()
+    self._contact_frames_gpu.zero_()
+    self._zones_gpu.fill_(4)
+
+  def destroy(self):
+    """Release GPU resources."""
+    self._tendroid_positions_gpu = None
+    self._tendroid_radii_gpu = None
+    self._creature_positions_gpu = None
+    self._positions_staging = None
+    self._positions_staging_np = None
+    self._states_gpu = None
+    self._prev_distances_gpu = None
+    self._has_prev_gpu = None
+    self._frames_in_state_gpu = None
+    self._contact_frames_gpu = None
+    self._zones_gpu = None
+    self._event_count_gpu = None
+    self._event_pairs_gpu = None
+    self._event_prev_gpu = None
+    self._event_new_gpu = None
+    self._event_dist_gpu = None
+    self._configured = False
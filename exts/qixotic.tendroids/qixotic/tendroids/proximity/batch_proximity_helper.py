@@ -0,0 +1,186 @@
+"""
+Batch Proximity Helper Functions
+
+Warp kernels and host-side decoding for the batched multi-creature
+proximity state machine. Each (creature, tendroid) pair is one thread;
+zone classification and the state_transitions.py rules run on device
+and only a compacted list of transitions is written out.
+
+Device state codes are ProximityState values minus one:
+  0 = IDLE, 1 = APPROACHING, 2 = CONTACT, 3 = RETREATING, 4 = RECOVERED
+"""
+
+from typing import List
+
+import warp as wp
+
+from .proximity_state import ProximityState
+
+# Initialize Warp (safe to call multiple times)
+wp.init()
+
+STATE_IDLE = wp.constant(0)
+STATE_APPROACHING = wp.constant(1)
+STATE_CONTACT = wp.constant(2)
+STATE_RETREATING = wp.constant(3)
+STATE_RECOVERED = wp.constant(4)
+
+# Zone indices (same as compute_zone_based_force_kernel)
+ZONE_NAMES = ["contact", "recovering", "approaching", "detected", "idle"]
+
+
+def state_from_code(code: int) -> ProximityState:
+  """Map a device state code back to ProximityState."""
+  return ProximityState(int(code) + 1)
+
+
+def state_to_code(state: ProximityState) -> int:
+  """Map ProximityState to its device state code."""
+  return state.value - 1
+
+
+def decode_pair_indices(pairs: List[int], tendroid_count: int) -> List[tuple]:
+  """Split flattened pair indices into (creature_idx, tendroid_idx)."""
+  return [(int(p) // tendroid_count, int(p) % tendroid_count) for p in pairs]
+
+
+@wp.func
+def classify_zone(
+  dist: float,
+  epsilon: float,
+  minimum: float,
+  warning: float,
+  detection: float,
+):
+  """Zone index for a surface distance (0 = contact ... 4 = idle)."""
+  if dist <= epsilon:
+    return 0
+  if dist <= minimum:
+    return 1
+  if dist <= warning:
+    return 2
+  if dist <= detection:
+    return 3
+  return 4
+
+
+@wp.func
+def next_proximity_state(
+  current: int,
+  distance: float,
+  approaching: int,
+  retreating: int,
+  epsilon: float,
+  minimum: float,
+  warning: float,
+  detection: float,
+):
+  """Device port of state_transitions._compute_next_state."""
+  # Contact zone - always transition to CONTACT
+  if distance <= epsilon:
+    return STATE_CONTACT
+
+  # Outside detection - always IDLE
+  if distance > detection:
+    return STATE_IDLE
+
+  if current == STATE_IDLE:
+    return STATE_APPROACHING
+
+  if current == STATE_APPROACHING:
+    if retreating != 0 and distance > minimum:
+      return STATE_RECOVERED
+    return STATE_APPROACHING
+
+  if current == STATE_CONTACT:
+    return STATE_RETREATING
+
+  if current == STATE_RETREATING:
+    if distance > minimum:
+      return STATE_RECOVERED
+    return STATE_RETREATING
+
+  if current == STATE_RECOVERED:
+    if approaching != 0 and distance <= warning:
+      return STATE_APPROACHING
+    return STATE_RECOVERED
+
+  return current
+
+
+@wp.kernel
+def batch_proximity_state_kernel(
+  # Inputs
+  creature_positions: wp.array(dtype=wp.vec3),
+  tendroid_positions: wp.array(dtype=wp.vec3),
+  tendroid_radii: wp.array(dtype=float),
+  # Approach parameters
+  epsilon: float,
+  minimum: float,
+  warning: float,
+  detection: float,
+  movement_threshold: float,
+  # Persistent per-pair state (creature-major: c * tendroid_count + t)
+  states: wp.array(dtype=int),
+  prev_distances: wp.array(dtype=float),
+  has_prev: wp.array(dtype=int),
+  frames_in_state: wp.array(dtype=int),
+  contact_frames: wp.array(dtype=int),
+  zones: wp.array(dtype=int),
+  # Compacted transition events
+  event_count: wp.array(dtype=int),
+  event_pairs: wp.array(dtype=int),
+  event_prev_states: wp.array(dtype=int),
+  event_new_states: wp.array(dtype=int),
+  event_distances: wp.array(dtype=float),
+):
+  """
+  Update one creature-tendroid pair and append an event on transition.
+
+  Distance is horizontal (XZ) to the tendroid surface, as in
+  horizontal_distance_kernel. event_count must be zeroed before launch.
+  """
+  c, t = wp.tid()
+  pair = c * tendroid_positions.shape[0] + t
+
+  creature_pos = creature_positions[c]
+  tendroid_pos = tendroid_positions[t]
+  dx = creature_pos[0] - tendroid_pos[0]
+  dz = creature_pos[2] - tendroid_pos[2]
+  dist = wp.sqrt(dx * dx + dz * dz) - tendroid_radii[t]
+
+  zones[pair] = classify_zone(dist, epsilon, minimum, warning, detection)
+
+  # Movement direction with hysteresis
+  approaching = int(0)
+  retreating = int(0)
+  if has_prev[pair] != 0:
+    delta = prev_distances[pair] - dist
+    if delta > movement_threshold:
+      approaching = 1
+    elif delta < -movement_threshold:
+      retreating = 1
+
+  current = states[pair]
+  next_state = next_proximity_state(
+    current, dist, approaching, retreating,
+    epsilon, minimum, warning, detection
+  )
+
+  prev_distances[pair] = dist
+  has_prev[pair] = 1
+
+  if next_state != current:
+    states[pair] = next_state
+    frames_in_state[pair] = 0
+
+    slot = wp.atomic_add(event_count, 0, 1)
+    if slot < event_pairs.shape[0]:
+      event_pairs[slot] = pair
+      event_prev_states[slot] = current
+      event_new_states[slot] = next_state
+      event_distances[slot] = dist
+  else:
+    frames_in_state[pair] = frames_in_state[pair] + 1
+    if current == STATE_CONTACT:
+      contact_frames[pair] = contact_frames[pair] + 1
@@ -7,6 +7,11 @@ Manages grid lifecycle, position updates, and neighbor searches.
 TEND-15: Set up Warp Hash Grid infrastructure
 TEND-64: Initialize Warp HashGrid with scene dimensions
 TEND-65: Create Warp arrays for position data
+
+Static mode keeps only tendroid points in the grid and rebuilds it only
+when that set changes; moving creatures are read in place (e.g. from a
+creature controller's device array) and query the grid without ever
+being inserted.
 """
 
 import carb
@@ -28,10 +33,16 @@ class PointSet:
     count: int
     
     def update_positions(self, positions: List[Tuple[float, float, float]]):
-        """Update positions from CPU list."""
+        """Update positions from CPU list (in place, no reallocation)."""
         if len(positions) != self.count:
             raise ValueError(f"Position count mismatch: {len(positions)} != {self.count}")
-        self.positions_gpu = wp.array(positions, dtype=wp.vec3, device=self.positions_gpu.device)
+        self.positions_gpu.assign(positions)
+    
+    def update_positions_from_device(self, positions_gpu: wp.array):
+        """Copy positions from another device array (no host round-trip)."""
+        if positions_gpu.shape[0] < self.count:
+            raise ValueError(f"Position count mismatch: {positions_gpu.shape[0]} < {self.count}")
+        wp.copy(self.positions_gpu, positions_gpu, count=self.count)
 
 
 class ProximityHashGrid:
@@ -55,19 +66,38 @@ class ProximityHashGrid:
         
         # Query neighbors
         neighbors = grid.query_neighbors(query_point, radius)
+    
+    Static mode (tendroids fixed, few movers):
+        grid = ProximityHashGrid(static_tendroids=True)
+        grid.initialize()
+        grid.register_tendroids(tendroid_positions)
+        grid.bind_creature_positions(controller_positions_gpu)
+        
+        # Each frame - no-op unless tendroids changed
+        grid.rebuild()
+        # Query kernels read grid.get_creature_positions_gpu() directly
     """
     
-    def __init__(self, config: Optional[GridConfig] = None):
+    def __init__(self, config: Optional[GridConfig] = None, static_tendroids: bool = False):
         """
         Initialize hash grid controller.
         
         Args:
             config: Grid configuration (uses defaults if None)
+            static_tendroids: Grid holds tendroids only and is rebuilt
+                only when they change; creatures are query points
         """
         self.config = config or DEFAULT_GRID_CONFIG
+        self.static_tendroids = static_tendroids
         self._grid: Optional[wp.HashGrid] = None
         self._initialized = False
         
+        # Static mode: externally owned creature positions + rebuild tracking
+        self._bound_creatures_gpu: Optional[wp.array] = None
+        self._bound_creature_count = 0
+        self._grid_dirty = True
+        self._built_radius: Optional[float] = None
+        
         # Point sets
         self._creatures: Optional[PointSet] = None
         self._tendroids: Optional[PointSet] = None
@@ -75,6 +105,7 @@ class ProximityHashGrid:
         # Combined positions for grid building
         self._all_positions_gpu: Optional[wp.array] = None
         self._total_points = 0
+        self._combined_dirty = False
         
         # Index offsets for identifying point types
         self._creature_start = 0
@@ -135,7 +166,9 @@ class ProximityHashGrid:
                 positions_gpu=positions_gpu,
                 count=len(positions)
             )
-            self._rebuild_combined_array()
+            self._bound_creatures_gpu = None
+            if not self.static_tendroids:
+                self._rebuild_combined_array()
             carb.log_info(f"[ProximityHashGrid] Registered {len(positions)} creatures")
             return True
         except Exception as e:
@@ -164,6 +197,7 @@ class ProximityHashGrid:
                 count=len(positions)
             )
             self._rebuild_combined_array()
+            self._grid_dirty = True
             carb.log_info(f"[ProximityHashGrid] Registered {len(positions)} tendroids")
             return True
         except Exception as e:
@@ -190,14 +224,40 @@ class ProximityHashGrid:
             return self.register_creatures(positions)
         
         try:
-            self._creatures.positions_gpu = wp.array(
-                positions, dtype=wp.vec3, device=self.config.device
-            )
+            self._creatures.update_positions(positions)
+            if not self.static_tendroids:
+                self._combined_dirty = True
             return True
         except Exception as e:
             carb.log_error(f"[ProximityHashGrid] Creature update failed: {e}")
             return False
     
+    def bind_creature_positions(self, positions_gpu: wp.array, count: Optional[int] = None) -> bool:
+        """
+        Read creature positions straight from an existing device array.
+        
+        Static mode only. The array is referenced, not copied, so every
+        frame's query sees whatever its owner last wrote to it.
+        
+        Args:
+            positions_gpu: wp.array(dtype=vec3) on the grid's device
+            count: Live creatures at the front of the array (default: all)
+            
+        Returns:
+            True if bound
+        """
+        if not self.static_tendroids:
+            carb.log_warn("[ProximityHashGrid] bind_creature_positions requires static_tendroids mode")
+            return False
+        if positions_gpu is None:
+            self._bound_creatures_gpu = None
+            self._bound_creature_count = 0
+            return False
+        
+        self._bound_creatures_gpu = positions_gpu
+        self._bound_creature_count = positions_gpu.shape[0] if count is None else count
+        return True
+    
     def update_tendroids(self, positions: List[Tuple[float, float, float]]) -> bool:
         """
         Update tendroid positions (called when tendroids move).
@@ -215,26 +275,42 @@ class ProximityHashGrid:
             return self.register_tendroids(positions)
         
         try:
-            self._tendroids.positions_gpu = wp.array(
-                positions, dtype=wp.vec3, device=self.config.device
-            )
+            self._tendroids.update_positions(positions)
+            self._combined_dirty = True
+            self._grid_dirty = True
             return True
         except Exception as e:
             carb.log_error(f"[ProximityHashGrid] Tendroid update failed: {e}")
             return False
     
     def _rebuild_combined_array(self):
-        """Rebuild combined position array from creatures and tendroids."""
+        """
+        Rebuild combined position array from creatures and tendroids.
+        
+        Reuses the existing combined buffer when the total is unchanged.
+        In static mode the grid points are the tendroid array itself.
+        """
         from .hash_grid_helper import combine_position_arrays
         
-        creatures_gpu = self._creatures.positions_gpu if self._creatures else None
+        self._combined_dirty = False
         tendroids_gpu = self._tendroids.positions_gpu if self._tendroids else None
+        tendroid_count = self._tendroids.count if self._tendroids else 0
         
-        self._all_positions_gpu, self._creature_start, self._tendroid_start = \
-            combine_position_arrays(creatures_gpu, tendroids_gpu, self.config.device)
+        if self.static_tendroids:
+            self._all_positions_gpu = tendroids_gpu
+            self._creature_start = 0
+            self._tendroid_start = 0
+            self._total_points = tendroid_count
+            return
         
+        creatures_gpu = self._creatures.positions_gpu if self._creatures else None
         creature_count = self._creatures.count if self._creatures else 0
-        tendroid_count = self._tendroids.count if self._tendroids else 0
+        
+        self._all_positions_gpu, self._creature_start, self._tendroid_start = \
+            combine_position_arrays(
+                creatures_gpu, tendroids_gpu, self.config.device,
+                out=self._all_positions_gpu
+            )
         self._total_points = creature_count + tendroid_count
     
     def rebuild(self, search_radius: float = 1.0) -> bool:
@@ -256,18 +332,24 @@ class ProximityHashGrid:
             carb.log_error("[ProximityHashGrid] Grid not initialized")
             return False
         
-        if self._all_positions_gpu is None or self._total_points == 0:
+        if self._all_positions_gpu is None or self._total_points == 0 or self._combined_dirty:
             self._rebuild_combined_array()
         
         if self._all_positions_gpu is None:
             carb.log_warn("[ProximityHashGrid] No positions to build grid")
             return False
         
+        # Static grid only changes with the tendroid set (or query radius)
+        if self.static_tendroids and not self._grid_dirty and self._built_radius == search_radius:
+            return True
+        
         try:
             self._grid.build(
                 points=self._all_positions_gpu,
                 radius=search_radius
             )
+            self._grid_dirty = False
+            self._built_radius = search_radius
             return True
         except Exception as e:
             carb.log_error(f"[ProximityHashGrid] Grid rebuild failed: {e}")
@@ -279,8 +361,25 @@ class ProximityHashGrid:
             return None
         return self._grid.id
     
+    @property
+    def needs_rebuild(self) -> bool:
+        """True if the next rebuild() will actually rebuild the grid."""
+        return not self.static_tendroids or self._grid_dirty
+    
+    def get_creature_positions_gpu(self) -> Optional[wp.array]:
+        """Creature query positions on device (bound array or registered set)."""
+        if self._bound_creatures_gpu is not None:
+            return self._bound_creatures_gpu
+        return self._creatures.positions_gpu if self._creatures else None
+    
+    def get_tendroid_positions_gpu(self) -> Optional[wp.array]:
+        """Tendroid positions on device (the grid points in static mode)."""
+        return self._tendroids.positions_gpu if self._tendroids else None
+    
     def get_creature_count(self) -> int:
         """Get number of registered creatures."""
+        if self._bound_creatures_gpu is not None:
+            return self._bound_creature_count
         return self._creatures.count if self._creatures else 0
     
     def get_tendroid_count(self) -> int:
@@ -288,7 +387,9 @@ class ProximityHashGrid:
         return self._tendroids.count if self._tendroids else 0
     
     def is_creature_index(self, idx: int) -> bool:
-        """Check if index refers to a creature."""
+        """Check if grid index refers to a creature (never in static mode)."""
+        if self.static_tendroids:
+            return False
         creature_end = self._creature_start + self.get_creature_count()
         return self._creature_start <= idx < creature_end
     
@@ -303,6 +404,10 @@ class ProximityHashGrid:
         self._creatures = None
         self._tendroids = None
         self._all_positions_gpu = None
+        self._bound_creatures_gpu = None
+        self._bound_creature_count = 0
+        self._grid_dirty = True
+        self._built_radius = None
         self._initialized = False
         self._total_points = 0
         carb.log_info("[ProximityHashGrid] Destroyed")
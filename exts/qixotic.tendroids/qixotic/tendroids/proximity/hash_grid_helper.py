@@ -132,7 +132,8 @@ def compute_closest_distances_kernel(
 def combine_position_arrays(
   creatures_gpu: Optional[wp.array],
   tendroids_gpu: Optional[wp.array],
-  device: str = "cuda:0"
+  device: str = "cuda:0",
+  out: Optional[wp.array] = None
 ) -> Tuple[Optional[wp.array], int, int]:
   """
   Combine creature and tendroid positions into single array.
@@ -141,6 +142,7 @@ def combine_position_arrays(
       creatures_gpu: Creature position array on GPU
       tendroids_gpu: Tendroid position array on GPU
       device: Target device
+      out: Existing combined array to reuse when its size matches
 
   Returns:
       Tuple of (combined_array, creature_start_idx, tendroid_start_idx)
@@ -152,7 +154,10 @@ def combine_position_arrays(
   if total == 0:
     return None, 0, 0
 
-  combined = wp.zeros(total, dtype=wp.vec3, device=device)
+  if out is not None and out.shape[0] == total:
+    combined = out
+  else:
+    combined = wp.zeros(total, dtype=wp.vec3, device=device)
 
   creature_start = 0
   tendroid_start = creature_count
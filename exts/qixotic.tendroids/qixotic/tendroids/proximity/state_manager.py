@@ -80,7 +80,88 @@ class TrackedEntity:
   total_contact_frames: int = 0
 
 
-class ProximityStateManager:
+class StateCallbackRegistry:
+  """
+  Callback registration and dispatch for StateChangeEvents.
+
+  Shared by the host (dict-based) and batched (device) state managers.
+  """
+
+  def __init__(self):
+    """Initialize empty callback lists."""
+    self._on_any_change: List[StateCallback] = []
+    self._on_contact_enter: List[StateCallback] = []
+    self._on_contact_exit: List[StateCallback] = []
+    self._on_detection_enter: List[StateCallback] = []
+    self._on_detection_exit: List[StateCallback] = []
+    self._on_recovered: List[StateCallback] = []
+
+  def _fire_callbacks(self, event: StateChangeEvent) -> None:
+    """Fire appropriate callbacks for a state change event."""
+    # Always fire on_any_change
+    for cb in self._on_any_change:
+      cb(event)
+
+    # Fire specific callbacks
+    if event.is_contact_enter:
+      for cb in self._on_contact_enter:
+        cb(event)
+
+    if event.is_contact_exit:
+      for cb in self._on_contact_exit:
+        cb(event)
+
+    if event.is_detection_enter:
+      for cb in self._on_detection_enter:
+        cb(event)
+
+    if event.is_detection_exit:
+      for cb in self._on_detection_exit:
+        cb(event)
+
+    if event.new_state == ProximityState.RECOVERED:
+      for cb in self._on_recovered:
+        cb(event)
+
+  # =========================================================================
+  # Callback Registration Methods
+  # =========================================================================
+
+  def on_any_change(self, callback: StateCallback) -> None:
+    """Register callback for any state change."""
+    self._on_any_change.append(callback)
+
+  def on_contact_enter(self, callback: StateCallback) -> None:
+    """Register callback for entering contact state."""
+    self._on_contact_enter.append(callback)
+
+  def on_contact_exit(self, callback: StateCallback) -> None:
+    """Register callback for exiting contact state."""
+    self._on_contact_exit.append(callback)
+
+  def on_detection_enter(self, callback: StateCallback) -> None:
+    """Register callback for entering detection range."""
+    self._on_detection_enter.append(callback)
+
+  def on_detection_exit(self, callback: StateCallback) -> None:
+    """Register callback for leaving detection range."""
+    self._on_detection_exit.append(callback)
+
+  def on_recovered(self, callback: StateCallback) -> None:
+    """Register callback for recovery (past approach_minimum)."""
+    self._on_recovered.append(callback)
+
+  def clear_callbacks(self) -> None:
+    """Remove all registered callbacks."""
+    self._on_any_change.clear()
+    self._on_contact_enter.clear()
+    self._on_contact_exit.clear()
+    self._on_detection_enter.clear()
+    self._on_detection_exit.clear()
+    self._on_recovered.clear()
+
+
+class ProximityStateManager(StateCallbackRegistry):
   """
   Manages proximity state for multiple creature-tendroid pairs.
 
@@ -96,17 +177,10 @@ class ProximityStateManager:
 
   def __init__(self, params: ApproachParameters = None):
     """Initialize state manager."""
+    super().__init__()
     self._params = params or DEFAULT_APPROACH_PARAMS
     self._entities: Dict[Tuple[int, int], TrackedEntity] = { }
 
-    # Callback registrations
-    self._on_any_change: List[StateCallback] = []
-    self._on_contact_enter: List[StateCallback] = []
-    self._on_contact_exit: List[StateCallback] = []
-    self._on_detection_enter: List[StateCallback] = []
-    self._on_detection_exit: List[StateCallback] = []
-    self._on_recovered: List[StateCallback] = []
-
   def _get_key(self, creature_idx: int, tendroid_idx: int) -> Tuple[int, int]:
     """Get dictionary key for entity pair."""
     return (creature_idx, tendroid_idx)
@@ -195,70 +269,6 @@ class ProximityStateManager:
 
     return event
 
-  def _fire_callbacks(self, event: StateChangeEvent) -> None:
-    """Fire appropriate callbacks for a state change event."""
-    # Always fire on_any_change
-    for cb in self._on_any_change:
-      cb(event)
-
-    # Fire specific callbacks
-    if event.is_contact_enter:
-      for cb in self._on_contact_enter:
-        cb(event)
-
-    if event.is_contact_exit:
-      for cb in self._on_contact_exit:
-        cb(event)
-
-    if event.is_detection_enter:
-      for cb in self._on_detection_enter:
-        cb(event)
-
-    if event.is_detection_exit:
-      for cb in self._on_detection_exit:
-        cb(event)
-
-    if event.new_state == ProximityState.RECOVERED:
-      for cb in self._on_recovered:
-        cb(event)
-
-  # =========================================================================
-  # Callback Registration Methods
-  # =========================================================================
-
-  def on_any_change(self, callback: StateCallback) -> None:
-    """Register callback for any state change."""
-    self._on_any_change.append(callback)
-
-  def on_contact_enter(self, callback: StateCallback) -> None:
-    """Register callback for entering contact state."""
-    self._on_contact_enter.append(callback)
-
-  def on_contact_exit(self, callback: StateCallback) -> None:
-    """Register callback for exiting contact state."""
-    self._on_contact_exit.append(callback)
-
-  def on_detection_enter(self, callback: StateCallback) -> None:
-    """Register callback for entering detection range."""
-    self._on_detection_enter.append(callback)
-
-  def on_detection_exit(self, callback: StateCallback) -> None:
-    """Register callback for leaving detection range."""
-    self._on_detection_exit.append(callback)
-
-  def on_recovered(self, callback: StateCallback) -> None:
-    """Register callback for recovery (past approach_minimum)."""
-    self._on_recovered.append(callback)
-
-  def clear_callbacks(self) -> None:
-    """Remove all registered callbacks."""
-    self._on_any_change.clear()
-    self._on_contact_enter.clear()
-    self._on_contact_exit.clear()
-    self._on_detection_enter.clear()
-    self._on_detection_exit.clear()
-    self._on_recovered.clear()
-
   def reset(self) -> None:
     """Reset all tracked entities to IDLE."""
     self._entities.clear()
@@ -13,6 +13,10 @@ from typing import Optional, Tuple
 from .proximity_config import ApproachParameters, DEFAULT_APPROACH_PARAMS
 from .proximity_state import ProximityState
 
+# Distance change (m) below which a creature counts as holding steady.
+# Small threshold avoids noise-triggered transitions.
+MOVEMENT_THRESHOLD = 0.001  # 1mm
+
 
 def determine_next_state(
   current_state: ProximityState,
@@ -33,9 +37,6 @@ def determine_next_state(
       Tuple of (next_state, did_transition)
   """
   # Determine movement direction with hysteresis
-  # Use small threshold to avoid noise-triggered transitions
-  MOVEMENT_THRESHOLD = 0.001  # 1mm
-
   is_approaching = False
   is_retreating = False
 
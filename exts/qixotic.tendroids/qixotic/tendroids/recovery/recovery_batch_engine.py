@@ -0,0 +1,497 @@
+"""
+Recovery Batch Engine - Structure-of-arrays contact response state
+
+Holds the approach tracker, tendroid surface point, repel velocity fade,
+input lock and recovery completion status of every (creature, tendroid)
+pair in flat NumPy arrays, and advances them all with vectorized steps.
+Each step has the same semantics as the scalar helpers it replaces:
+
+- approach_tracker_helpers: start_tracking, update_distance,
+  complete_recovery, reset_tracker
+- velocity_fade_helpers: apply_initial_velocity, update_velocity
+- repulsion_helpers: calculate_repulsion -> velocity_from_force
+- input_lock_helpers: lock_input_on_contact, sync_lock_from_color_state
+- recovery_state_controller: update_completion_status,
+  process_recovery_completion
+
+Pair index = creature * tendroid_count + tendroid (as in
+BatchProximityStateManager). Enum-valued fields are stored as codes
+equal to enum.value - 1; color states use the same codes as
+BatchedColorEffects (0 = NORMAL, 1 = SHOCKED, 2 = RECOVERING).
+
+The proximity state of RecoveryContext is not duplicated here; it is
+already batched by BatchProximityStateManager.
+"""
+
+import numpy as np
+
+from ..contact.approach_tracker_helpers import (
+    ApproachTrackerStatus,
+    RecoveryPhase,
+    TendroidSurfacePoint,
+)
+from ..contact.color_effect_helpers import ColorEffectState
+from ..contact.input_lock_helpers import InputLockReason, InputLockStatus
+from ..contact.repulsion_helpers import RepulsionConfig
+from ..contact.velocity_fade_helpers import (
+    FadeMode as VelocityFadeMode,
+    VelocityFadeConfig,
+    VelocityFadeStatus,
+)
+from ..proximity.proximity_config import DEFAULT_APPROACH_PARAMS
+from .recovery_state_controller import RecoveryCompletionStatus
+
+# Enum codes (enum.value - 1)
+PHASE_INACTIVE = RecoveryPhase.INACTIVE.value - 1
+PHASE_TRACKING = RecoveryPhase.TRACKING.value - 1
+PHASE_THRESHOLD_CROSSED = RecoveryPhase.THRESHOLD_CROSSED.value - 1
+PHASE_COMPLETE = RecoveryPhase.COMPLETE.value - 1
+
+REASON_NONE = InputLockReason.NONE.value - 1
+REASON_CONTACT = InputLockReason.CONTACT.value - 1
+REASON_REPELLING = InputLockReason.REPELLING.value - 1
+REASON_RECOVERING = InputLockReason.RECOVERING.value - 1
+
+COLOR_NORMAL = ColorEffectState.NORMAL.value - 1
+COLOR_SHOCKED = ColorEffectState.SHOCKED.value - 1
+COLOR_RECOVERING = ColorEffectState.RECOVERING.value - 1
+
+# Degenerate-geometry threshold of the scalar helpers
+AXIS_EPSILON = 1e-8
+
+
+def _norm(v: np.ndarray) -> np.ndarray:
+    """Row-wise length of [n, 3] vectors."""
+    return np.sqrt(v[:, 0] * v[:, 0] + v[:, 1] * v[:, 1] + v[:, 2] * v[:, 2])
+
+
+class RecoveryBatchEngine:
+    """
+    Contact response state machines for all (creature, tendroid) pairs.
+
+    Usage:
+        engine = RecoveryBatchEngine(creature_count, tendroid_count)
+
+        # On contact events (arrays, one row per contacting pair):
+        engine.start_tracking(pairs, contact_points, normals, creature_pos)
+        engine.apply_repulsion(pairs, creature_pos, tendroid_pos, radii)
+        engine.lock_on_contact(pairs)
+
+        # Each frame:
+        completed = engine.step(dt, creature_positions, color_states)
+    """
+
+    def __init__(
+        self,
+        creature_count: int,
+        tendroid_count: int,
+        threshold: float = DEFAULT_APPROACH_PARAMS.approach_minimum,
+        velocity_config: VelocityFadeConfig = None,
+        repulsion_config: RepulsionConfig = None,
+        rest_tolerance: float = 0.01,
+    ):
+        """
+        Args:
+            creature_count: Number of creatures
+            tendroid_count: Number of tendroids
+            threshold: approach_minimum for the approach trackers
+            velocity_config: Velocity fade configuration for all pairs
+            repulsion_config: Repulsion force configuration for all pairs
+            rest_tolerance: Tendroid at-rest tolerance for completion
+        """
+        self.creature_count = int(creature_count)
+        self.tendroid_count = int(tendroid_count)
+        self.threshold = float(threshold)
+        self.velocity_config = velocity_config or VelocityFadeConfig()
+        self.repulsion_config = repulsion_config or RepulsionConfig()
+        self.rest_tolerance = float(rest_tolerance)
+
+        n = self.pair_count
+
+        # Approach tracker (ApproachTrackerStatus)
+        self.phase = np.full(n, PHASE_INACTIVE, dtype=np.int8)
+        self.current_distance = np.full(n, np.inf)
+        self.threshold_distance = np.full(n, self.threshold)
+        self.min_distance = np.full(n, np.inf)
+        self.max_distance = np.zeros(n)
+        self.update_count = np.zeros(n, dtype=np.int64)
+        self.recovery_count = np.zeros(n, dtype=np.int64)
+
+        # Tendroid surface point (TendroidSurfacePoint)
+        self.surface_current = np.zeros((n, 3))
+        self.surface_rest = np.zeros((n, 3))
+        self.surface_normal = np.tile([1.0, 0.0, 0.0], (n, 1))
+
+        # Velocity fade (VelocityFadeStatus)
+        self.velocity = np.zeros((n, 3))
+        self.initial_velocity = np.zeros((n, 3))
+        self.elapsed_time = np.zeros(n)
+        self.distance_traveled = np.zeros(n)
+        self.velocity_active = np.zeros(n, dtype=bool)
+        self.velocity_stopped = np.ones(n, dtype=bool)
+
+        # Input lock (InputLockStatus)
+        self.locked = np.zeros(n, dtype=bool)
+        self.lock_reason = np.full(n, REASON_NONE, dtype=np.int8)
+        self.lock_count = np.zeros(n, dtype=np.int64)
+
+        # Recovery completion (RecoveryCompletionStatus)
+        self.distance_cleared = np.zeros(n, dtype=bool)
+        self.color_normal = np.zeros(n, dtype=bool)
+        self.tendroid_at_rest = np.ones(n, dtype=bool)
+
+    @property
+    def pair_count(self) -> int:
+        return self.creature_count * self.tendroid_count
+
+    def pair_index(self, creature_idx, tendroid_idx):
+        """Flattened pair index (scalars or arrays)."""
+        return np.asarray(creature_idx) * self.tendroid_count + np.asarray(tendroid_idx)
+
+    def _pairs(self, pairs) -> np.ndarray:
+        return np.asarray(pairs, dtype=np.int64).reshape(-1)
+
+    def _creature_rows(self, creature_positions) -> np.ndarray:
+        """Per-pair creature positions from [creatures, 3] positions."""
+        positions = np.asarray(creature_positions, dtype=np.float64).reshape(-1, 3)
+        return np.repeat(positions, self.tendroid_count, axis=0)
+
+    # =========================================================================
+    # Contact events
+    # =========================================================================
+
+    def start_tracking(self, pairs, contact_points, surface_normals, creature_positions, deflection=0.0):
+        """
+        start_recovery_tracking for contacting pairs (tracker part).
+
+        Args:
+            pairs: Pair indices
+            contact_points: [n, 3] contact positions
+            surface_normals: [n, 3] normals pointing away from the tendroid
+            creature_positions: [n, 3] creature position per pair
+            deflection: Scalar or [n] distance the tendroid was pushed in
+        """
+        pairs = self._pairs(pairs)
+        if pairs.size == 0:
+            return
+        contact = np.asarray(contact_points, dtype=np.float64).reshape(-1, 3)
+        normals = np.asarray(surface_normals, dtype=np.float64).reshape(-1, 3)
+        creature = np.asarray(creature_positions, dtype=np.float64).reshape(-1, 3)
+        deflection = np.broadcast_to(np.asarray(deflection, dtype=np.float64), pairs.shape)
+
+        self.surface_current[pairs] = contact
+        self.surface_rest[pairs] = contact + normals * deflection[:, None]
+        self.surface_normal[pairs] = normals
+
+        initial = _norm(creature - contact)
+        self.phase[pairs] = PHASE_TRACKING
+        self.current_distance[pairs] = initial
+        self.threshold_distance[pairs] = self.threshold
+        self.min_distance[pairs] = initial
+        self.max_distance[pairs] = initial
+        self.update_count[pairs] = 1
+
+    def apply_repulsion(
+        self,
+        pairs,
+        creature_positions,
+        tendroid_positions,
+        tendroid_radii=6.0,
+        approach_velocity=0.0,
+        mass: float = 1.0,
+        delta_time: float = 0.016,
+    ) -> np.ndarray:
+        """
+        calculate_repulsion -> velocity_from_force -> apply_initial_velocity.
+
+        Args:
+            pairs: Pair indices
+            creature_positions: [n, 3] creature position per pair
+            tendroid_positions: [n, 3] tendroid center per pair
+            tendroid_radii: Scalar or [n] tendroid radius
+            approach_velocity: Scalar or [n] speed toward the tendroid
+            mass: Creature mass
+            delta_time: Impulse time step
+
+        Returns:
+            [n, 3] repulsion force per pair
+        """
+        pairs = self._pairs(pairs)
+        config = self.repulsion_config
+        creature = np.asarray(creature_positions, dtype=np.float64).reshape(-1, 3)
+        tendroid = np.asarray(tendroid_positions, dtype=np.float64).reshape(-1, 3)
+        radii = np.broadcast_to(np.asarray(tendroid_radii, dtype=np.float64), pairs.shape)
+        approach = np.broadcast_to(np.asarray(approach_velocity, dtype=np.float64), pairs.shape)
+
+        # calculate_surface_normal_from_contact (horizontal)
+        dx = creature[:, 0] - tendroid[:, 0]
+        dz = creature[:, 2] - tendroid[:, 2]
+        horizontal = np.sqrt(dx * dx + dz * dz)
+        centered = horizontal < AXIS_EPSILON
+        safe = np.where(centered, 1.0, horizontal)
+        normals = np.zeros((pairs.size, 3))
+        normals[:, 0] = np.where(centered, 1.0, dx / safe)
+        normals[:, 2] = np.where(centered, 0.0, dz / safe)
+        penetration = np.where(centered, radii, radii - horizontal)
+
+        # compute_repulsion_force
+        magnitude = np.full(pairs.size, config.base_force)
+        magnitude = magnitude + np.where(penetration > 0, penetration * config.penetration_multiplier, 0.0)
+        magnitude = magnitude + np.where(approach > 0, approach * config.velocity_multiplier, 0.0)
+        magnitude = np.maximum(config.min_force, np.minimum(config.max_force, magnitude))
+        force = normals * magnitude[:, None]
+
+        # velocity_from_force + apply_initial_velocity
+        velocity = force * (delta_time / mass)
+        speed = _norm(velocity)
+        self.velocity[pairs] = velocity
+        self.initial_velocity[pairs] = velocity
+        self.elapsed_time[pairs] = 0.0
+        self.distance_traveled[pairs] = 0.0
+        self.velocity_active[pairs] = speed > 0.0
+        self.velocity_stopped[pairs] = speed == 0.0
+        return force
+
+    def lock_on_contact(self, pairs):
+        """lock_input_on_contact for contacting pairs."""
+        pairs = self._pairs(pairs)
+        self.locked[pairs] = True
+        self.lock_reason[pairs] = REASON_CONTACT
+        self.lock_count[pairs] += 1
+
+    def reset(self, pairs=None):
+        """
+        reset_recovery_context + reset_velocity for pairs (all if None).
+
+        Lock state is left to the completion step, as in the helpers.
+        """
+        pairs = slice(None) if pairs is None else self._pairs(pairs)
+        self.phase[pairs] = PHASE_INACTIVE
+        self.current_distance[pairs] = np.inf
+        self.min_distance[pairs] = np.inf
+        self.max_distance[pairs] = 0.0
+        self.update_count[pairs] = 0
+
+        self.surface_current[pairs] = 0.0
+        self.surface_rest[pairs] = 0.0
+        self.surface_normal[pairs] = (1.0, 0.0, 0.0)
+
+        self.velocity[pairs] = 0.0
+        self.initial_velocity[pairs] = 0.0
+        self.elapsed_time[pairs] = 0.0
+        self.distance_traveled[pairs] = 0.0
+        self.velocity_active[pairs] = False
+        self.velocity_stopped[pairs] = True
+
+    # =========================================================================
+    # Per-frame steps
+    # =========================================================================
+
+    def update_surfaces(self, surface_positions, surface_normals=None, pairs=None):
+        """
+        update_surface_point: move surface points as tendroids return.
+
+        Args:
+            surface_positions: New current positions ([n, 3])
+            surface_normals: Optional new normals ([n, 3])
+            pairs: Pair indices the rows belong to (all pairs if None)
+        """
+        index = slice(None) if pairs is None else self._pairs(pairs)
+        self.surface_current[index] = np.asarray(surface_positions, dtype=np.float64).reshape(-1, 3)
+        if surface_normals is not None:
+            self.surface_normal[index] = np.asarray(surface_normals, dtype=np.float64).reshape(-1, 3)
+
+    def update_distances(self, creature_positions):
+        """
+        update_distance for every tracking pair.
+
+        Args:
+            creature_positions: [creatures, 3] creature positions
+        """
+        tracking = self.phase == PHASE_TRACKING
+        if not tracking.any():
+            return
+        creature = self._creature_rows(creature_positions)[tracking]
+        distance = _norm(creature - self.surface_current[tracking])
+
+        self.current_distance[tracking] = distance
+        self.min_distance[tracking] = np.minimum(self.min_distance[tracking], distance)
+        self.max_distance[tracking] = np.maximum(self.max_distance[tracking], distance)
+        self.update_count[tracking] += 1
+        crossed = np.flatnonzero(tracking)[distance > self.threshold_distance[tracking]]
+        self.phase[crossed] = PHASE_THRESHOLD_CROSSED
+
+    def _decay_factor(self, elapsed: np.ndarray, traveled: np.ndarray) -> np.ndarray:
+        """_calculate_decay_factor for arrays."""
+        config = self.velocity_config
+
+        if config.fade_duration > 0:
+            time_factor = np.exp(-config.decay_rate * (elapsed / config.fade_duration))
+        else:
+            time_factor = np.full(elapsed.shape, 0.0 if config.fade_mode == VelocityFadeMode.TIME_BASED else 1.0)
+
+        if config.fade_distance > 0:
+            dist_factor = np.exp(-config.decay_rate * (traveled / config.fade_distance))
+        else:
+            dist_factor = np.full(traveled.shape, 0.0 if config.fade_mode == VelocityFadeMode.DISTANCE_BASED else 1.0)
+
+        if config.fade_mode == VelocityFadeMode.TIME_BASED:
+            return time_factor
+        if config.fade_mode == VelocityFadeMode.DISTANCE_BASED:
+            return dist_factor
+        return np.minimum(time_factor, dist_factor)
+
+    def update_velocities(self, delta_time: float):
+        """update_velocity for every active pair."""
+        moving = self.velocity_active & ~self.velocity_stopped
+        if not moving.any():
+            return
+        config = self.velocity_config
+        index = np.flatnonzero(moving)
+
+        elapsed = self.elapsed_time[index] + delta_time
+        traveled = self.distance_traveled[index] + _norm(self.velocity[index]) * delta_time
+        velocity = self.initial_velocity[index] * self._decay_factor(elapsed, traveled)[:, None]
+
+        if config.drag_coefficient > 0:
+            velocity = velocity * max(0.0, 1.0 - config.drag_coefficient * delta_time)
+
+        stopped = _norm(velocity) < config.velocity_epsilon
+        velocity[stopped] = 0.0
+
+        self.velocity[index] = velocity
+        self.elapsed_time[index] = elapsed
+        self.distance_traveled[index] = traveled
+        self.velocity_active[index] = ~stopped
+        self.velocity_stopped[index] = stopped
+
+    def sync_locks_from_color(self, color_states):
+        """
+        sync_lock_from_color_state for every pair.
+
+        Args:
+            color_states: [pairs] color state codes
+        """
+        color = np.asarray(color_states).reshape(-1)
+
+        normal = color == COLOR_NORMAL
+        self.locked[normal] = False
+        self.lock_reason[normal] = REASON_NONE
+
+        for code, reason in ((COLOR_SHOCKED, REASON_REPELLING), (COLOR_RECOVERING, REASON_RECOVERING)):
+            state = color == code
+            newly = state & ~self.locked
+            self.lock_count[newly] += 1
+            self.lock_reason[state & self.locked] = reason
+            self.locked[newly] = True
+            # A fresh shock lock starts as CONTACT; a stray recovery lock as RECOVERING
+            self.lock_reason[newly] = REASON_CONTACT if code == COLOR_SHOCKED else REASON_RECOVERING
+
+    def update_completion(self, color_states) -> np.ndarray:
+        """
+        update_completion_status + process_recovery_completion for all pairs.
+
+        Args:
+            color_states: [pairs] color state codes
+
+        Returns:
+            Indices of pairs that completed recovery this step
+        """
+        color = np.asarray(color_states).reshape(-1)
+
+        self.distance_cleared = (
+            (self.phase == PHASE_THRESHOLD_CROSSED)
+            | (self.phase == PHASE_COMPLETE)
+            | (self.current_distance > self.threshold_distance)
+        )
+        self.color_normal = color == COLOR_NORMAL
+        self.tendroid_at_rest = _norm(self.surface_current - self.surface_rest) <= self.rest_tolerance
+
+        complete = self.distance_cleared & self.color_normal & self.velocity_stopped & self.tendroid_at_rest
+        unlock = complete & self.locked
+
+        # Still locked: RECOVERING while the tracker is active
+        recovering = self.locked & ~unlock & (self.phase == PHASE_TRACKING)
+        self.lock_reason[recovering] = REASON_RECOVERING
+
+        # unlock_input_on_recovery_complete + finalize_recovery
+        self.locked[unlock] = False
+        self.lock_reason[unlock] = REASON_NONE
+        self.phase[unlock] = PHASE_COMPLETE
+        self.recovery_count[unlock] += 1
+        return np.flatnonzero(unlock)
+
+    def step(self, delta_time: float, creature_positions, color_states, surface_positions=None) -> np.ndarray:
+        """
+        Advance every pair one frame.
+
+        Order per pair: surface update, update_distance, update_velocity,
+        then completion / unlock.
+
+        Args:
+            delta_time: Frame time
+            creature_positions: [creatures, 3] creature positions
+            color_states: [pairs] color state codes
+            surface_positions: Optional [pairs, 3] moved surface points
+
+        Returns:
+            Indices of pairs that completed recovery this frame
+        """
+        if surface_positions is not None:
+            self.update_surfaces(surface_positions)
+        self.update_distances(creature_positions)
+        self.update_velocities(delta_time)
+        return self.update_completion(color_states)
+
+    # =========================================================================
+    # Queries
+    # =========================================================================
+
+    def creature_input_locked(self) -> np.ndarray:
+        """[creatures] True if any of the creature's pairs holds a lock."""
+        return self.locked.reshape(self.creature_count, self.tendroid_count).any(axis=1)
+
+    def tracker_status(self, pair: int) -> ApproachTrackerStatus:
+        return ApproachTrackerStatus(
+            phase=RecoveryPhase(int(self.phase[pair]) + 1),
+            current_distance=float(self.current_distance[pair]),
+            threshold_distance=float(self.threshold_distance[pair]),
+            min_distance_recorded=float(self.min_distance[pair]),
+            max_distance_recorded=float(self.max_distance[pair]),
+            update_count=int(self.update_count[pair]),
+            recovery_count=int(self.recovery_count[pair]),
+        )
+
+    def surface_point(self, pair: int) -> TendroidSurfacePoint:
+        cx, cy, cz = (float(v) for v in self.surface_current[pair])
+        rx, ry, rz = (float(v) for v in self.surface_rest[pair])
+        nx, ny, nz = (float(v) for v in self.surface_normal[pair])
+        return TendroidSurfacePoint(cx, cy, cz, rx, ry, rz, nx, ny, nz)
+
+    def velocity_status(self, pair: int) -> VelocityFadeStatus:
+        vx, vy, vz = (float(v) for v in self.velocity[pair])
+        ix, iy, iz = (float(v) for v in self.initial_velocity[pair])
+        return VelocityFadeStatus(
+            velocity_x=vx, velocity_y=vy, velocity_z=vz,
+            initial_velocity_x=ix, initial_velocity_y=iy, initial_velocity_z=iz,
+            elapsed_time=float(self.elapsed_time[pair]),
+            distance_traveled=float(self.distance_traveled[pair]),
+            is_active=bool(self.velocity_active[pair]),
+            is_stopped=bool(self.velocity_stopped[pair]),
+        )
+
+    def lock_status(self, pair: int) -> InputLockStatus:
+        return InputLockStatus(
+            is_locked=bool(self.locked[pair]),
+            reason=InputLockReason(int(self.lock_reason[pair]) + 1),
+            lock_count=int(self.lock_count[pair]),
+        )
+
+    def completion_status(self, pair: int) -> RecoveryCompletionStatus:
+        return RecoveryCompletionStatus(
+            distance_cleared=bool(self.distance_cleared[pair]),
+            color_normal=bool(self.color_normal[pair]),
+            velocity_stopped=bool(self.velocity_stopped[pair]),
+            tendroid_at_rest=bool(self.tendroid_at_rest[pair]),
+            rest_tolerance=self.rest_tolerance,
+        )
@@ -8,10 +8,15 @@ from .tendroid_factory import V2TendroidFactory
 from .animation_controller import V2AnimationController
 from .manager import V2SceneManager
 from .tendroid_wrapper import V2TendroidWrapper
+from .gpu_frame_pipeline import GPUFramePipeline
+from .scene_cache import SceneCache, scene_cache_key
 
 __all__ = [
     "V2TendroidFactory",
     "V2AnimationController",
     "V2SceneManager",
     "V2TendroidWrapper",
+    "GPUFramePipeline",
+    "SceneCache",
+    "scene_cache_key",
 ]
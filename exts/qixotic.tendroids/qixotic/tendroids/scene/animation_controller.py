@@ -3,14 +3,22 @@ V2 Animation Controller - Update loop for tendroids and bubbles
 
 Manages per-frame updates with wave effects and bubble system integration.
 GPU bubble physics fully supported with proper state synchronization.
+
+Optionally the simulation runs at a fixed rate (FixedStepScheduler) and
+the batch deform / bubble visuals blend the last two sim steps at
+render rate.
 """
 
 import time
+from contextlib import nullcontext
 
 import carb
+import numpy as np
 
 from ..animation import WaveConfig, WaveController
 from ..bubbles import DEFAULT_V2_BUBBLE_CONFIG
+from ..utils.frame_profiler import FrameProfiler
+from .fixed_step_scheduler import FixedStepScheduler
 
 
 class V2AnimationController:
@@ -28,7 +36,15 @@ class V2AnimationController:
     self.bubble_manager = None
     self.gpu_bubble_adapter = None
     self.batch_deformer = None
+    self.frame_pipeline = None  # Captured GPU frame graph (optional)
+    self.frustum_culler = None  # Viewport culling / LOD for the batch deform
+    self.deflection_manager = None  # BatchDeflectionManager bound to the batch deform
+    self.output_pipeline = None  # Double-buffered async mesh handoff (optional)
     self.creature_controller = None  # Interactive creature
+    self.scheduler = None  # FixedStepScheduler (None = one sim step per update)
+    self.deform_interpolator = None  # Render-rate blend of fixed-step deform inputs
+    self.partitioned_field = None  # Multi-GPU PartitionedField (replaces GPU bubbles + batch deform)
+    self._bubble_states = []  # Host [prev, latest] (phases, positions, radii)
     self.update_subscription = None
     self.is_running = False
 
@@ -47,12 +63,51 @@ class V2AnimationController:
     self._last_profile_time = 0
     self._profile_interval = 1.0
     self._profile_frame_start = 0
+    self.profiler = None  # Per-stage FrameProfiler while profiling
 
   def set_tendroids(self, tendroids: list, tendroid_data: list = None):
     """Set tendroids to animate."""
     self.tendroids = tendroids
     self.tendroid_data = tendroid_data or []
 
+  def set_output_pipeline(self, output_pipeline):
+    """Set PipelinedDeformOutput (deform output handed off on its own stream)."""
+    self.output_pipeline = output_pipeline
+
+  def set_frustum_culler(self, culler):
+    """Set the FrustumCuller fed from the active viewport each frame."""
+    self.frustum_culler = culler
+
+  def _update_frustum_culler(self):
+    """Stage the active viewport camera for this frame's cull and switch LOD meshes."""
+    from ..utils.viewport_camera import get_active_camera_view
+
+    view_projection, position = get_active_camera_view()
+    self.frustum_culler.begin_frame(view_projection, position)
+    if self.batch_deformer and self.batch_deformer.is_built:
+      self.frustum_culler.switch_lod_meshes(self.batch_deformer)
+
+  def set_deflection_manager(self, deflection_manager):
+    """Set the BatchDeflectionManager fed the creature position each frame."""
+    self.deflection_manager = deflection_manager
+
+  def _update_deflection(self, dt: float):
+    """
+    Feed the creature position to the deflection manager.
+
+    With a frame pipeline only the staging buffer is written (the graph
+    runs the launch); otherwise the launch is queued here, ahead of the
+    batch deform that reads its angles.
+    """
+    if not self.deflection_manager:
+      return
+    creature_positions = [self.creature_controller.get_position()] if self.creature_controller else []
+    with self._stage("deflection"):
+      if self.frame_pipeline:
+        self.deflection_manager.set_creatures(creature_positions)
+      else:
+        self.deflection_manager.compute_deflections_multi(creature_positions, None, dt, download=False)
+
   def set_bubble_manager(self, bubble_manager):
     """Set bubble manager for animation updates."""
     self.bubble_manager = bubble_manager
@@ -68,6 +123,45 @@ class V2AnimationController:
     self.batch_deformer = batch_deformer
     if batch_deformer:
       carb.log_info("[GPU] Batch deformation enabled")
+    self._update_deform_interpolator()
+
+  def set_fixed_step(self, rate_hz: float = None, max_substeps: int = 5):
+    """
+    Run the simulation at a fixed rate, decoupled from display rate.
+
+    Args:
+        rate_hz: Sim steps per second (e.g. 30/60), or None to step
+            once per update event with the event's dt
+        max_substeps: Most sim steps per update event
+    """
+    if rate_hz:
+      self.scheduler = FixedStepScheduler(rate_hz, max_substeps)
+      carb.log_info(f"[AnimationController] Fixed-step simulation at {self.scheduler.rate_hz:.0f} Hz")
+    else:
+      self.scheduler = None
+    self._update_deform_interpolator()
+
+  def _update_deform_interpolator(self):
+    """Create / drop the deform interpolator to match scheduler + deformer."""
+    if self.deform_interpolator:
+      self.deform_interpolator.destroy()
+      self.deform_interpolator = None
+    self._bubble_states = []
+    if self.scheduler and self.batch_deformer:
+      from ..core.deform_interpolator import DeformInterpolator
+      self.deform_interpolator = DeformInterpolator(self.batch_deformer)
+
+  def set_partitioned_field(self, field):
+    """Set a multi-GPU field (runs bubbles, deflection and deform per device)."""
+    self.partitioned_field = field
+    if field:
+      carb.log_info(f"[GPU] Field partitioned over {len(field.partitions)} devices")
+
+  def set_frame_pipeline(self, frame_pipeline):
+    """Set captured GPU frame pipeline (replaces per-stage launches)."""
+    self.frame_pipeline = frame_pipeline
+    if frame_pipeline:
+      carb.log_info("[GPU] Frame pipeline enabled - CUDA graph replay")
 
   def set_creature_controller(self, creature_controller):
     """Set creature controller for interactive gameplay."""
@@ -102,12 +196,21 @@ class V2AnimationController:
     self.is_running = True
     self._frame_count = 0
     self._absolute_time = 0.0
+    if self.scheduler:
+      self.scheduler.reset()
+    if self.deform_interpolator:
+      self.deform_interpolator.reset()
+    self._bubble_states = []
 
     self._profiling_enabled = enable_profiling
     if enable_profiling:
       self._profile_samples = []
       self._last_profile_time = time.perf_counter()
       self._profile_frame_start = 0
+      device = self.batch_deformer.device if self.batch_deformer else None
+      self.profiler = FrameProfiler(device=device)
+    else:
+      self.profiler = None
 
     carb.log_info("[V2AnimationController] Started")
 
@@ -120,9 +223,15 @@ class V2AnimationController:
     self.is_running = False
     self._profiling_enabled = False
 
+    # Show the last in-flight frame
+    if self.output_pipeline:
+      self.output_pipeline.flush()
+
     if self._profile_samples:
       self._log_profile_summary()
       self._profile_samples = []
+    if self.profiler:
+      self.profiler.log_summary()
 
     carb.log_info("[V2AnimationController] Stopped")
 
@@ -133,6 +242,8 @@ class V2AnimationController:
 
       if self._profiling_enabled:
         self._sample_performance()
+      if self.profiler and self.is_running:
+        self.profiler.begin_frame()
 
       dt = 1.0 / 60.0
       if event and hasattr(event, 'payload'):
@@ -140,87 +251,259 @@ class V2AnimationController:
         if isinstance(payload, dict):
           dt = payload.get('dt', dt)
 
-      self._absolute_time += dt
-
-      # Update wave motion
-      self.wave_controller.update(dt)
-      wave_state = self.wave_controller.get_wave_state()
-
-      # GPU path
-      if self.gpu_bubble_adapter:
-        self._update_gpu_path(dt, wave_state)
-      # CPU fallback
-      elif self.bubble_manager:
-        self.bubble_manager.update(dt, self.tendroids, self.wave_controller)
-        # Update interactive creature (Phase 1) - CPU path
-        if self.creature_controller:
-          bubble_positions = self.bubble_manager.get_bubble_positions()
-          bubble_radii = self.bubble_manager.get_bubble_radii()
-          collision_data = self.creature_controller.update(dt, bubble_positions, bubble_radii, wave_state)
-          # Handle collisions (extract tendroid name from tuple)
-          for tendroid_name, collision_dir in collision_data:
-            self.bubble_manager.pop_bubble(tendroid_name)
-      # No bubbles - wave only
+      if self.scheduler:
+        self._update_fixed_step(dt)
       else:
-        for tendroid in self.tendroids:
-          tendroid.apply_wave_only_with_state(wave_state)
-        # Update interactive creature (Phase 1) - no bubbles
-        if self.creature_controller:
-          self.creature_controller.update(dt, wave_state=wave_state)
+        self._step(dt)
+
+      if self.profiler:
+        self.profiler.end_frame()
 
     except Exception as e:
       carb.log_error(f"[V2AnimationController] Update error: {e}")
       import traceback
       traceback.print_exc()
 
+  def _update_wave(self, dt: float) -> dict:
+    """Advance wave motion and return its state."""
+    self._absolute_time += dt
+    with self._stage("wave_update"):
+      self.wave_controller.update(dt)
+      return self.wave_controller.get_wave_state()
+
+  def _step(self, dt: float):
+    """One full wave → bubble → deform → creature → visuals step."""
+    wave_state = self._update_wave(dt)
+
+    # Multi-GPU field
+    if self.partitioned_field:
+      self._update_partitioned_path(dt, wave_state)
+    # GPU path
+    elif self.gpu_bubble_adapter:
+      self._update_gpu_path(dt, wave_state)
+    # CPU fallback
+    elif self.bubble_manager:
+      self.bubble_manager.update(dt, self.tendroids, self.wave_controller)
+      # Update interactive creature (Phase 1) - CPU path
+      if self.creature_controller:
+        bubble_positions = self.bubble_manager.get_bubble_positions()
+        bubble_radii = self.bubble_manager.get_bubble_radii()
+        popped, _ = self.creature_controller.update(dt, bubble_positions, bubble_radii, wave_state)
+        # Handle collisions (extract tendroid name from tuple)
+        for tendroid_name, collision_dir in popped:
+          self.bubble_manager.pop_bubble(tendroid_name)
+    # No bubbles - wave only
+    else:
+      for tendroid in self.tendroids:
+        tendroid.apply_wave_only_with_state(wave_state)
+      # Update interactive creature (Phase 1) - no bubbles
+      if self.creature_controller:
+        self.creature_controller.update(dt, wave_state=wave_state)
+
   def _update_gpu_path(self, dt: float, wave_state: dict):
     """
     GPU bubble update - single download, GPU is source of truth.
 
     Flow: GPU physics → Download once → Batch deform → Update visuals → Update particles
+
+    With a frame pipeline, physics, deform params, deform and particle
+    kernels all run from one graph replay up front.
     """
+    # Camera for culling / LOD (runs inside the deform or the graph)
+    if self.frustum_culler:
+      with self._stage("camera_cull_setup"):
+        self._update_frustum_culler()
+
+    # Creature deflection (bend read by the deform below)
+    self._update_deflection(dt)
+
     # 1. Update physics on GPU
-    self.gpu_bubble_adapter.update_gpu(
-      dt=dt,
-      config=DEFAULT_V2_BUBBLE_CONFIG,
-      wave_state=wave_state
-    )
+    with self._stage("bubble_physics"):
+      if self.frame_pipeline:
+        # Concurrent bubble limit runs inside the graph
+        self.frame_pipeline.step(dt, wave_state)
+      else:
+        self.gpu_bubble_adapter.update_gpu(
+          dt=dt,
+          config=DEFAULT_V2_BUBBLE_CONFIG,
+          wave_state=wave_state
+        )
 
     # 2. Download GPU state ONCE (single memory transfer)
-    phases, positions, radii = self.gpu_bubble_adapter.gpu_manager.get_bubble_states()
+    with self._stage("state_download"):
+      phases, positions, radii = self.gpu_bubble_adapter.gpu_manager.get_bubble_states()
 
     # 3. Build name-indexed dicts for easy lookup
-    name_to_id = self.gpu_bubble_adapter._name_to_id
+    with self._stage("bubble_dicts"):
+      bubble_data = self._bubble_dicts(phases, positions, radii)
+
+    # 4. Apply deformations - PIPELINE output, BATCH, or per-tendroid fallback
+    if self.frame_pipeline:
+      with self._stage("mesh_write"):
+        self._write_pipeline_output()
+    elif self.batch_deformer and self.batch_deformer.is_built:
+      self._apply_batch_deformation(bubble_data, wave_state)
+    else:
+      with self._stage("per_tendroid_deform"):
+        self._apply_deformations_gpu(bubble_data, wave_state)
+
+    # 5. Update interactive creature with bubble collision detection
+    with self._stage("creature"):
+      self._update_creature_gpu(dt, bubble_data, wave_state)
 
+    # 6. Update visuals using GPU state
+    with self._stage("visuals"):
+      self._update_visuals_gpu(bubble_data)
+
+    # 7. Update particle system
+    self._update_particles(dt)
+
+  def _update_partitioned_path(self, dt: float, wave_state: dict):
+    """
+    One step of a PartitionedField.
+
+    Every device's physics and deform are queued before the first
+    bubble download, so partitions run concurrently.
+    """
+    field = self.partitioned_field
+    creature_positions = [self.creature_controller.get_position()] if self.creature_controller else []
+
+    with self._stage("bubble_physics"):
+      field.update(dt, DEFAULT_V2_BUBBLE_CONFIG, wave_state, creature_positions)
+    with self._stage("batch_deform_fabric"):
+      field.deform_and_write(self._fabric_stage_id())
+    with self._stage("state_download"):
+      bubble_data = field.bubble_data()
+
+    with self._stage("creature"):
+      self._update_creature_gpu(dt, bubble_data, wave_state)
+    with self._stage("visuals"):
+      self._update_visuals_gpu(bubble_data)
+    self._update_particles(dt)
+
+  def _update_fixed_step(self, frame_dt: float):
+    """
+    Fixed-rate simulation, render-rate deform and bubble visuals.
+
+    Bubbles, particles and the creature (deflection / proximity) run
+    for every whole step the scheduler owes; the batch deform and
+    bubble transforms then blend the last two steps at scheduler.alpha,
+    one step behind the latest sim state. Paths without a batch
+    deformer (or with the captured frame pipeline, which replays
+    deform inside its graph) run whole steps only.
+    """
+    steps = self.scheduler.advance(frame_dt)
+    step_dt = self.scheduler.step_dt
+
+    interpolate = (
+      self.gpu_bubble_adapter and self.deform_interpolator and not self.frame_pipeline
+      and self.batch_deformer and self.batch_deformer.is_built
+    )
+    if not interpolate:
+      for _ in range(steps):
+        self._step(step_dt)
+      return
+
+    if self.frustum_culler:
+      with self._stage("camera_cull_setup"):
+        self._update_frustum_culler()
+
+    for _ in range(steps):
+      wave_state = self._update_wave(step_dt)
+
+      with self._stage("bubble_physics"):
+        self.gpu_bubble_adapter.update_gpu(
+          dt=step_dt,
+          config=DEFAULT_V2_BUBBLE_CONFIG,
+          wave_state=wave_state
+        )
+
+      with self._stage("state_download"):
+        phases, positions, radii = self.gpu_bubble_adapter.gpu_manager.get_bubble_states()
+        self._push_bubble_states(phases, positions, radii)
+      with self._stage("bubble_dicts"):
+        bubble_data = self._bubble_dicts(phases, positions, radii)
+
+      self._update_deflection(step_dt)
+      self._update_deform_params(bubble_data, wave_state)
+      self.deform_interpolator.commit()
+
+      with self._stage("creature"):
+        self._update_creature_gpu(step_dt, bubble_data, wave_state)
+      self._update_particles(step_dt)
+
+    if not self._bubble_states:
+      return
+    alpha = self.scheduler.alpha
+
+    with self.deform_interpolator.interpolated(alpha):
+      self._deform_and_write()
+
+    with self._stage("visuals"):
+      self._update_visuals_gpu(self._interpolated_bubble_data(alpha))
+
+  def _push_bubble_states(self, phases, positions, radii):
+    """Keep host copies of the previous and latest sim bubble states."""
+    state = (np.array(phases), np.array(positions, dtype=np.float32), np.array(radii, dtype=np.float32))
+    self._bubble_states = (self._bubble_states + [state])[-2:]
+
+  def _interpolated_bubble_data(self, alpha: float) -> dict:
+    """Bubble dicts blended between the last two sim steps."""
+    prev = self._bubble_states[0]
+    phases, positions, radii = self._bubble_states[-1]
+    if prev[1].shape != positions.shape:
+      return self._bubble_dicts(phases, positions, radii)
+
+    # Bubbles only rise: a drop (pop / respawn) snaps to the latest step
+    blend = positions[:, 1] >= prev[1][:, 1]
+    positions = np.where(blend[:, None], prev[1] + (positions - prev[1]) * alpha, positions)
+    radii = np.where(blend, prev[2] + (radii - prev[2]) * alpha, radii)
+    return self._bubble_dicts(phases, positions, radii)
+
+  def _bubble_dicts(self, phases, positions, radii) -> dict:
+    """Name-indexed {phase, position, radius} from downloaded GPU state."""
     bubble_data = { }
-    for name, bubble_id in name_to_id.items():
+    for name, bubble_id in self.gpu_bubble_adapter._name_to_id.items():
       bubble_data[name] = {
         'phase': int(phases[bubble_id]),
         'position': tuple(positions[bubble_id]),
         'radius': float(radii[bubble_id])
       }
+    return bubble_data
 
-    # 4. Apply deformations - BATCH or fallback to per-tendroid
-    if self.batch_deformer and self.batch_deformer.is_built:
-      self._apply_batch_deformation(bubble_data, wave_state)
-    else:
-      self._apply_deformations_gpu(bubble_data, wave_state)
+  def _update_particles(self, dt: float):
+    """Advance the pop particle system (or sync it after a graph replay)."""
+    if self.bubble_manager and self.bubble_manager.particle_manager:
+      with self._stage("particles"):
+        stage_id = self._fabric_stage_id()
+        if self.frame_pipeline:
+          self.bubble_manager.particle_manager.sync_after_gpu_update(stage_id)
+        else:
+          self.bubble_manager.particle_manager.update(dt, stage_id)
 
-    # 5. Update interactive creature with bubble collision detection
+  def _stage(self, name: str):
+    """Profiler scope for one frame stage (no-op when not profiling)."""
+    if self.profiler is None or not self._profiling_enabled:
+      return nullcontext()
+    return self.profiler.stage(name)
+
+  def _update_creature_gpu(self, dt: float, bubble_data: dict, wave_state: dict):
+    """Creature update + bubble pops from GPU bubble state."""
     if self.creature_controller:
-      # Extract positions and radii for active bubbles
+      # Extract positions and radii for active bubbles (GPU grid reads them on device)
       bubble_positions = {}
       bubble_radii = {}
-      for name, data in bubble_data.items():
-        if data['phase'] > 0:  # Active bubble
-          bubble_positions[name] = data['position']
-          bubble_radii[name] = data['radius']
+      if not self.creature_controller.uses_gpu_bubble_collisions:
+        for name, data in bubble_data.items():
+          if data['phase'] > 0:  # Active bubble
+            bubble_positions[name] = data['position']
+            bubble_radii[name] = data['radius']
       
       # Update creature and get list of popped bubbles with collision data
-      collision_data = self.creature_controller.update(dt, bubble_positions, bubble_radii, wave_state)
+      popped, _ = self.creature_controller.update(dt, bubble_positions, bubble_radii, wave_state)
       
       # Trigger pop for collided bubbles with particle effects
-      for tendroid_name, collision_dir in collision_data:
+      for tendroid_name, collision_dir in popped:
         # Get bubble data before popping for particle creation
         if tendroid_name in bubble_data:
           bubble_pos = bubble_data[tendroid_name]['position']
@@ -237,14 +520,22 @@ class V2AnimationController:
             )
           
           # Set bubble to popped state
-          self.gpu_bubble_adapter.pop_bubble(tendroid_name)
+          (self.partitioned_field or self.gpu_bubble_adapter).pop_bubble(tendroid_name)
 
-    # 6. Update visuals using GPU state
-    self._update_visuals_gpu(bubble_data)
+  def _fabric_stage_id(self):
+    """Stage ID for Fabric writes, or None when the CPU write path is selected."""
+    return self._stage_id if self._use_fabric_write else None
 
-    # 7. Update particle system
-    if self.bubble_manager and self.bubble_manager.particle_manager:
-      self.bubble_manager.particle_manager.update(dt)
+  def _write_pipeline_output(self):
+    """Hand the frame pipeline's deformed points to the meshes."""
+    if self.output_pipeline and self.output_pipeline.present(self._fabric_stage_id()):
+      return
+    if self._use_fabric_write and self._stage_id is not None:
+      if self.batch_deformer.copy_output_to_fabric(self._stage_id):
+        return
+      self.batch_deformer.apply_to_meshes_fabric(self._stage_id)
+    else:
+      self.batch_deformer.apply_to_meshes(self.batch_deformer.out_points_gpu.numpy())
 
   def _apply_batch_deformation(self, bubble_data: dict, wave_state: dict):
     """
@@ -253,23 +544,56 @@ class V2AnimationController:
     MUCH faster than per-tendroid: 1 kernel launch instead of N.
     Supports both CPU and Fabric GPU write paths.
     """
-    # Update batch deformer state from GPU bubble data
-    self.batch_deformer.update_states(
-      bubble_data=bubble_data,
-      wave_state=wave_state,
-      default_config=DEFAULT_V2_BUBBLE_CONFIG
-    )
+    self._update_deform_params(bubble_data, wave_state)
+    self._deform_and_write()
+
+  def _update_deform_params(self, bubble_data: dict, wave_state: dict):
+    """Update batch deformer state - on device when GPU bubbles are live."""
+    with self._stage("deform_params"):
+      gpu_manager = self.gpu_bubble_adapter.gpu_manager if self.gpu_bubble_adapter else None
+      if gpu_manager:
+        self.batch_deformer.update_states_gpu(
+          bubble_gpu_manager=gpu_manager,
+          wave_state=wave_state,
+          default_config=DEFAULT_V2_BUBBLE_CONFIG
+        )
+      else:
+        self.batch_deformer.update_states(
+          bubble_data=bubble_data,
+          wave_state=wave_state,
+          default_config=DEFAULT_V2_BUBBLE_CONFIG
+        )
 
-    # Single kernel launch for ALL vertices
-    all_points = self.batch_deformer.deform_all()
+  def _deform_and_write(self):
+    """Run the batch deform and hand its output to the meshes."""
+    # Pipelined: deform into out_points, hand off on the present stream
+    if self.output_pipeline:
+      with self._stage("batch_deform"):
+        self.batch_deformer.deform_all(download=False)
+      with self._stage("mesh_write"):
+        if self.output_pipeline.present(self._fabric_stage_id()):
+          return
+        self.batch_deformer.apply_to_meshes(self.batch_deformer.out_points_gpu.numpy())
+      return
 
     # Apply to meshes - choose write path
     if self._use_fabric_write and self._stage_id is not None:
-      # Fabric GPU path (zero-copy)
-      self.batch_deformer.apply_to_meshes_fabric(self._stage_id)
+      # Fabric GPU path - kernel writes straight into Fabric buffers
+      with self._stage("batch_deform_fabric"):
+        if self.batch_deformer.deform_to_fabric(self._stage_id):
+          return
+
+      # Fabric host-staged fallback (single download, per-mesh Set)
+      with self._stage("batch_deform"):
+        self.batch_deformer.deform_all(download=False)
+      with self._stage("mesh_write"):
+        self.batch_deformer.apply_to_meshes_fabric(self._stage_id)
     else:
       # CPU path (fallback)
-      self.batch_deformer.apply_to_meshes(all_points)
+      with self._stage("batch_deform"):
+        all_points = self.batch_deformer.deform_all()
+      with self._stage("mesh_write"):
+        self.batch_deformer.apply_to_meshes(all_points)
 
   def _apply_deformations_gpu(self, bubble_data: dict, wave_state: dict):
     """
@@ -330,6 +654,12 @@ class V2AnimationController:
 
     from pxr import Gf, UsdGeom
 
+    # Instanced mode: per-bubble loop below only tracks state/pop events
+    if self.bubble_manager.uses_instancer and self.gpu_bubble_adapter:
+      self.bubble_manager.render_instances_gpu(
+        self.gpu_bubble_adapter.gpu_manager, self._fabric_stage_id()
+      )
+
     for name in self.bubble_manager._bubbles:
       state = self.bubble_manager._bubbles[name]
 
@@ -439,20 +769,44 @@ class V2AnimationController:
     carb.log_info("=" * 50)
 
   def get_profile_data(self) -> dict | None:
-    """Get profiling data."""
-    if not self._profile_samples:
+    """
+    Get profiling data.
+
+    Returns:
+        FPS samples and summary, plus 'stages' (per-stage host/device
+        percentiles, see FrameProfiler.get_profile_data), or None
+    """
+    if not self._profile_samples and self.profiler is None:
       return None
 
+    data = {'samples': self._profile_samples}
     fps_values = [s['fps'] for s in self._profile_samples]
-    return {
-      'samples': self._profile_samples,
-      'avg_fps': sum(fps_values) / len(fps_values),
-      'min_fps': min(fps_values),
-      'max_fps': max(fps_values)
-    }
+    if fps_values:
+      data.update({
+        'avg_fps': sum(fps_values) / len(fps_values),
+        'min_fps': min(fps_values),
+        'max_fps': max(fps_values)
+      })
+    if self.profiler:
+      data['stages'] = self.profiler.get_profile_data()['stages']
+    return data
+
+  def export_profile_trace(self, path: str) -> bool:
+    """Write the per-stage ring buffer as a Chrome trace JSON file."""
+    if self.profiler is None:
+      return False
+    return self.profiler.export_chrome_trace(path)
+
+  def publish_profile_stats(self):
+    """Publish per-stage p50/p95 to carb settings."""
+    if self.profiler:
+      self.profiler.publish_stats()
 
   def shutdown(self):
     """Cleanup on shutdown."""
     self.stop()
+    if self.deform_interpolator:
+      self.deform_interpolator.destroy()
+      self.deform_interpolator = None
     self.tendroids.clear()
     self.tendroid_data.clear()
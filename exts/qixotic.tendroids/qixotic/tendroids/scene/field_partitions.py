@@ -0,0 +1,378 @@
+"""
+Field Partitions - split the tendroid field across GPUs by sea floor tiles
+
+Tendroids are binned into square XZ tiles; whole tiles are handed out
+in row-major order so each device gets a compact band of roughly equal
+tendroid count. Every partition runs its own pipeline on its device:
+
+    bubbles -> deform params (+ deflection) -> batch deform
+
+Partitions on the render device scatter straight into Fabric; remote
+partitions deform into out_points_gpu and peer-copy it to the render
+device (PeerPointsDelivery). The creature is broadcast to every
+partition whose tiles it is near, and only their compact hit lists come
+back to be merged, so no bubble or tendroid state crosses devices.
+"""
+
+import math
+
+import carb
+import warp as wp
+from pxr import Gf
+
+from ..bubbles import create_gpu_bubble_system
+from ..core import BatchWarpDeformer
+from ..utils.slot_arena import SlotTable
+
+# Fabric batch tag stride between partitions (max tendroids per partition)
+FABRIC_INDEX_STRIDE = 1 << 20
+
+# Creature range beyond a partition's tendroid bases that can still hit
+# it (bubble drift above the tips + tendroid avoidance range)
+PARTITION_QUERY_MARGIN = 100.0
+
+
+def cuda_devices() -> list:
+  """Warp aliases of every CUDA device ("cuda:0", ...)."""
+  return [f"cuda:{i}" for i in range(wp.get_cuda_device_count())]
+
+
+def partition_by_tiles(positions: list, device_count: int, tile_size: float) -> list:
+  """
+  Split tendroid positions into device_count groups of whole XZ tiles.
+
+  Tiles are walked row-major (z, then x) and closed into a group when
+  it reaches its share of the remaining tendroids, so groups are
+  contiguous bands balanced by count. Fewer occupied tiles than devices
+  leaves trailing groups empty.
+
+  Args:
+      positions: (x, y, z) per tendroid
+      device_count: Number of groups
+      tile_size: Tile edge length in world units
+
+  Returns:
+      device_count sorted lists of indices into positions
+  """
+  device_count = max(int(device_count), 1)
+  tiles = {}
+  for i, position in enumerate(positions):
+    key = (math.floor(position[2] / tile_size), math.floor(position[0] / tile_size))
+    tiles.setdefault(key, []).append(i)
+
+  groups, current = [], []
+  remaining = len(positions)
+  for key in sorted(tiles):
+    members = tiles[key]
+    parts_left = device_count - len(groups)
+    target = remaining / parts_left
+
+    # Close early when adding this tile overshoots more than stopping short
+    if current and parts_left > 1 and len(current) + len(members) - target > target - len(current):
+      groups.append(sorted(current))
+      remaining -= len(current)
+      current = []
+      parts_left -= 1
+      target = remaining / parts_left
+
+    current.extend(members)
+    if parts_left > 1 and len(current) >= target:
+      groups.append(sorted(current))
+      remaining -= len(current)
+      current = []
+
+  if current:
+    groups.append(sorted(current))
+  return groups + [[] for _ in range(device_count - len(groups))]
+
+
+class FieldPartition:
+  """
+  One device's share of the field: bubbles, deformer and deflection.
+
+  Slots are private to the partition (bubble id == deformer slot ==
+  deflection index, as on a single device).
+  """
+
+  def __init__(self, index: int, device: str, tendroids: list, tendroid_data: list):
+    """
+    Args:
+        index: Partition number (sets the Fabric tag base)
+        device: Warp device running this partition
+        tendroids: Tendroids in this partition's tiles
+        tendroid_data: Builder data matching tendroids
+    """
+    self.index = index
+    self.device = device
+    self.tendroids = tendroids
+    self.tendroid_data = tendroid_data
+    self.slots = SlotTable()
+    self.bubbles = None
+    self.deformer = None
+    self.deflection = None
+    self.delivery = None  # PeerPointsDelivery when not on the render device
+
+  @property
+  def remote(self) -> bool:
+    """True if deformed points must be peer-copied to the render device."""
+    return self.delivery is not None
+
+  def build(self, bubble_config, render_device: str, active_set: bool = True,
+            use_deflection: bool = True) -> bool:
+    """
+    Allocate every device buffer for this partition.
+
+    Remote partitions use stored rest points (the render-device scatter
+    needs the per-vertex tendroid ids).
+
+    Returns:
+        True if the partition has a built deformer
+    """
+    if not self.tendroids:
+      return False
+
+    self.bubbles = create_gpu_bubble_system(
+      self.tendroids, bubble_config, slots=self.slots, device=self.device
+    )
+
+    remote = self.device != render_device
+    self.deformer = BatchWarpDeformer(
+      device=self.device,
+      procedural=False,
+      slots=self.slots,
+      active_set=active_set,
+      fabric_index_base=self.index * FABRIC_INDEX_STRIDE
+    )
+    for tendroid, data in zip(self.tendroids, self.tendroid_data):
+      self.deformer.register_tendroid(tendroid, data['base_points'], geometry=data)
+    self.deformer.build()
+    self.deformer.bind_bubble_slots(self.bubbles._name_to_id)
+
+    if use_deflection:
+      from ..deflection import BatchDeflectionManager
+      self.deflection = BatchDeflectionManager(device=self.device)
+      self.deflection.register_tendroids(self.tendroids)
+      if not self.deformer.bind_deflection(self.deflection.angles_gpu, self.deflection.axes_gpu):
+        carb.log_warn(f"[FieldPartition] {self.device}: deflection arrays do not match deformer")
+        self.deflection = None
+
+    if remote:
+      from ..core.peer_points_delivery import PeerPointsDelivery
+      self.delivery = PeerPointsDelivery(self.deformer, render_device)
+    return self.deformer.is_built
+
+  def update(self, dt: float, bubble_config, wave_state: dict, creature_positions: list):
+    """Queue bubble physics, deflection and deform params (no sync)."""
+    self.bubbles.update_gpu(dt=dt, config=bubble_config, wave_state=wave_state)
+    if self.deflection:
+      self.deflection.compute_deflections_multi(creature_positions, None, dt, download=False)
+    self.deformer.update_states_gpu(
+      bubble_gpu_manager=self.bubbles.gpu_manager,
+      wave_state=wave_state,
+      default_config=bubble_config
+    )
+
+  def deform_and_write(self, stage_id) -> None:
+    """Deform and hand the points to the meshes (Fabric when stage_id is set)."""
+    deformer = self.deformer
+    if stage_id is not None:
+      if not self.remote and deformer.deform_to_fabric(stage_id):
+        return
+      deformer.deform_all(download=False)
+      if self.remote and self.delivery.deliver(stage_id):
+        return
+      if not self.remote:
+        deformer.apply_to_meshes_fabric(stage_id)
+        return
+    deformer.apply_to_meshes(deformer.deform_all())
+
+  def bubble_data(self) -> dict:
+    """Name-indexed {phase, position, radius} (one download, syncs the device)."""
+    phases, positions, radii = self.bubbles.gpu_manager.get_bubble_states()
+    return {
+      name: {
+        'phase': int(phases[bubble_id]),
+        'position': tuple(positions[bubble_id]),
+        'radius': float(radii[bubble_id])
+      }
+      for name, bubble_id in self.bubbles._name_to_id.items()
+    }
+
+  def destroy(self):
+    """Release this partition's device buffers."""
+    if self.delivery:
+      self.delivery.destroy()
+      self.delivery = None
+    if self.deformer:
+      self.deformer.unbind_deflection()
+      self.deformer.destroy()
+      self.deformer = None
+    if self.deflection:
+      self.deflection.destroy()
+      self.deflection = None
+    if self.bubbles:
+      self.bubbles.destroy()
+      self.bubbles = None
+
+
+class PartitionedField:
+  """
+  Tendroid field spread over several devices.
+
+  Usage:
+      field = PartitionedField(["cuda:0", "cuda:1"], render_device="cuda:0")
+      field.build(tendroids, tendroid_data, bubble_config)
+
+      # Each frame:
+      field.update(dt, bubble_config, wave_state, [creature_position])
+      field.deform_and_write(stage_id)
+      bubble_data = field.bubble_data()
+  """
+
+  def __init__(self, devices: list, render_device: str = "cuda:0", tile_size: float = 100.0):
+    """
+    Args:
+        devices: Warp devices to spread the field over
+        render_device: Device holding the Fabric points buffers
+        tile_size: Sea floor tile edge length (world units)
+    """
+    self.devices = list(devices)
+    self.render_device = render_device
+    self.tile_size = tile_size
+    self.partitions = []
+    self._partition_of = {}  # tendroid name -> FieldPartition
+
+  def build(self, tendroids: list, tendroid_data: list, bubble_config,
+            active_set: bool = True, use_deflection: bool = True) -> bool:
+    """
+    Tile the field and build one pipeline per non-empty partition.
+
+    Returns:
+        True if at least one partition was built
+    """
+    groups = partition_by_tiles(
+      [tuple(t.position) for t in tendroids], len(self.devices), self.tile_size
+    )
+    for index, (device, members) in enumerate(zip(self.devices, groups)):
+      if not members:
+        continue
+      partition = FieldPartition(
+        index, device, [tendroids[i] for i in members], [tendroid_data[i] for i in members]
+      )
+      if not partition.build(bubble_config, self.render_device, active_set, use_deflection):
+        partition.destroy()
+        continue
+      self.partitions.append(partition)
+      for tendroid in partition.tendroids:
+        self._partition_of[tendroid.name] = partition
+
+    carb.log_info(
+      "[PartitionedField] " + ", ".join(
+        f"{p.device}: {len(p.tendroids)} tendroids" for p in self.partitions
+      )
+    )
+    return bool(self.partitions)
+
+  def update(self, dt: float, bubble_config, wave_state: dict, creature_positions: list = None):
+    """Queue every partition's simulation step (devices run concurrently)."""
+    for partition in self.partitions:
+      partition.update(dt, bubble_config, wave_state, creature_positions or [])
+
+  def deform_and_write(self, stage_id):
+    """Queue every partition's deform and mesh handoff."""
+    for partition in self.partitions:
+      partition.deform_and_write(stage_id)
+
+  def bubble_data(self) -> dict:
+    """Merged name-indexed bubble states of all partitions."""
+    bubble_data = {}
+    for partition in self.partitions:
+      bubble_data.update(partition.bubble_data())
+    return bubble_data
+
+  def pop_bubble(self, tendroid_name: str):
+    """Pop a tendroid's bubble on whichever device owns it."""
+    partition = self._partition_of.get(tendroid_name)
+    if partition:
+      partition.bubbles.pop_bubble(tendroid_name)
+
+  def update_bubble_config(self, bubble_config) -> int:
+    """Rescale per-bubble lifecycle params live (see BubblePhysicsAdapter.update_config)."""
+    return sum(p.bubbles.update_config(p.tendroids, bubble_config) for p in self.partitions)
+
+  def update_deform_params(self, max_amplitude: float = None, bulge_width: float = None) -> int:
+    """Patch deform shape params on every device."""
+    return sum(p.deformer.update_deform_params(max_amplitude, bulge_width) for p in self.partitions)
+
+  def create_interaction_grid(self):
+    """Creature grid spanning every partition (see PartitionedInteractionGrid)."""
+    return PartitionedInteractionGrid(self.partitions)
+
+  def destroy(self):
+    """Release every partition."""
+    for partition in self.partitions:
+      partition.destroy()
+    self.partitions = []
+    self._partition_of = {}
+
+
+class PartitionedInteractionGrid:
+  """
+  CreatureInteractionGrid per partition behind the single-grid check().
+
+  The creature is broadcast only to partitions whose tendroid bounds
+  (plus PARTITION_QUERY_MARGIN) it overlaps; those launch concurrently
+  and their hit lists are merged. Velocity impulses from each partition
+  add up; popped bubbles and tendroid interactions are disjoint by name.
+  """
+
+  def __init__(self, partitions: list, query_margin: float = PARTITION_QUERY_MARGIN):
+    from ..controllers.creature_interaction_grid import CreatureInteractionGrid
+
+    self.query_margin = query_margin
+    self._grids = []
+    for partition in partitions:
+      grid = CreatureInteractionGrid(device=partition.device)
+      grid.set_tendroids(partition.tendroids)
+      grid.bind_bubbles(partition.bubbles.gpu_manager, partition.bubbles._id_to_name)
+      xs = [t.position[0] for t in partition.tendroids]
+      zs = [t.position[2] for t in partition.tendroids]
+      self._grids.append((grid, (min(xs), max(xs), min(zs), max(zs))))
+
+  @property
+  def has_bubbles(self) -> bool:
+    return any(grid.has_bubbles for grid, _ in self._grids)
+
+  def _near(self, bounds, position, creature_radius: float) -> bool:
+    reach = self.query_margin + creature_radius
+    min_x, max_x, min_z, max_z = bounds
+    return (min_x - reach <= position[0] <= max_x + reach
+            and min_z - reach <= position[2] <= max_z + reach)
+
+  def check(self, position, velocity, creature_radius: float) -> tuple:
+    """
+    Same contract as CreatureInteractionGrid.check, over all devices.
+
+    Returns:
+        (new_velocity, popped, interactions)
+    """
+    launched = [
+      grid for grid, bounds in self._grids
+      if self._near(bounds, position, creature_radius)
+      and grid.launch(position, velocity, creature_radius)
+    ]
+
+    base = Gf.Vec3f(velocity[0], velocity[1], velocity[2])
+    new_velocity, popped, interactions = Gf.Vec3f(base), [], {}
+    for grid in launched:
+      grid_velocity, grid_popped, grid_interactions = grid.read_results()
+      new_velocity += grid_velocity - base
+      popped.extend(grid_popped)
+      interactions.update(grid_interactions)
+    return new_velocity, popped, interactions
+
+  def destroy(self):
+    """Release every partition's grid."""
+    for grid, _ in self._grids:
+      grid.destroy()
+    self._grids = []
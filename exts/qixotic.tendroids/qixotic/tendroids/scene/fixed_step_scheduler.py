@@ -0,0 +1,84 @@
+"""
+Fixed Step Scheduler - Accumulator for fixed-rate simulation
+
+Render frames feed their dt into an accumulator that is drained in whole
+fixed steps, so simulation cost and results no longer depend on display
+rate. The leftover fraction (alpha) blends the last two sim states at
+render time.
+"""
+
+import carb
+
+
+class FixedStepScheduler:
+  """
+  Accumulator-based substepping for a fixed simulation rate.
+
+  Usage:
+      scheduler = FixedStepScheduler(rate_hz=60.0)
+
+      # Each render frame:
+      for _ in range(scheduler.advance(frame_dt)):
+          simulate(scheduler.step_dt)
+      render(scheduler.alpha)  # 0 = previous sim state, 1 = latest
+  """
+
+  def __init__(self, rate_hz: float = 60.0, max_substeps: int = 5):
+    """
+    Args:
+        rate_hz: Simulation steps per second
+        max_substeps: Most steps run for one render frame; time beyond
+            that is dropped so a long hitch slows the sim instead of
+            snowballing into ever longer frames
+    """
+    self.rate_hz = 60.0
+    self.step_dt = 1.0 / 60.0
+    self.max_substeps = max(int(max_substeps), 1)
+    self.set_rate(rate_hz)
+
+    self._accumulator = 0.0
+    self.total_steps = 0
+    self.dropped_time = 0.0
+
+  def set_rate(self, rate_hz: float):
+    """Change the simulation rate (keeps accumulated time)."""
+    if rate_hz <= 0.0:
+      carb.log_warn(f"[FixedStepScheduler] Invalid rate {rate_hz} Hz, keeping {self.rate_hz} Hz")
+      return
+    self.rate_hz = float(rate_hz)
+    self.step_dt = 1.0 / self.rate_hz
+
+  def advance(self, frame_dt: float) -> int:
+    """
+    Accumulate one render frame and count the sim steps it owes.
+
+    Args:
+        frame_dt: Render frame time in seconds
+
+    Returns:
+        Number of step_dt steps to run this frame (0..max_substeps)
+    """
+    self._accumulator += max(float(frame_dt), 0.0)
+
+    # Small epsilon so frame_dt == step_dt always yields one step
+    steps = int((self._accumulator + 1e-9) / self.step_dt)
+    if steps > self.max_substeps:
+      dropped = (steps - self.max_substeps) * self.step_dt
+      self.dropped_time += dropped
+      self._accumulator -= dropped
+      steps = self.max_substeps
+
+    self._accumulator = max(self._accumulator - steps * self.step_dt, 0.0)
+    self.total_steps += steps
+    return steps
+
+  @property
+  def alpha(self) -> float:
+    """Blend factor from the previous to the latest sim state."""
+    return min(self._accumulator / self.step_dt, 1.0)
+
+  def reset(self):
+    """Clear accumulated time and counters."""
+    self._accumulator = 0.0
+    self.total_steps = 0
+    self.dropped_time = 0.0
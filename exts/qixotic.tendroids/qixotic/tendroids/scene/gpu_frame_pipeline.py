@@ -0,0 +1,258 @@
+"""
+GPU Frame Pipeline - CUDA graph of the per-frame simulation chain
+
+Captures bubble physics + concurrent limit → per-tendroid deform params → deflection →
+batch deform (bulge + bend + wave) → particles once with wp.ScopedCapture and replays it as a
+CUDA graph each tick. dt and wave state reach the kernels through small
+device buffers fed from pinned host memory, so replay needs no new
+launch arguments and almost no Python dispatch.
+"""
+
+import carb
+import warp as wp
+
+from ..core.device_wave_state import DeviceWaveState
+
+FRAME_PARAM_COUNT = 1  # [0] = dt
+
+
+class GPUFramePipeline:
+  """
+  Captured per-frame GPU work for the batch tendroid scene.
+
+  The graph is re-captured automatically when any array it references
+  is reallocated or a baked launch scalar (bubble config) changes.
+
+  Usage:
+      pipeline = GPUFramePipeline(gpu_manager, batch_deformer, particle_gpu)
+      pipeline.configure(bubble_config)
+
+      # Each frame:
+      pipeline.step(dt, wave_state)
+      # ...then host-side follow-up (visuals, Fabric handoff, particle sync)
+  """
+
+  def __init__(
+    self,
+    bubble_gpu_manager,
+    batch_deformer,
+    particle_gpu_manager=None,
+    device: str = "cuda:0",
+    use_graph: bool = True
+  ):
+    """
+    Args:
+        bubble_gpu_manager: BubbleGPUManager with live bubble state
+        batch_deformer: Built BatchWarpDeformer (bubble slots bound)
+        particle_gpu_manager: Optional PopParticleGPUManager
+        device: Warp device
+        use_graph: Capture and replay as a CUDA graph (CUDA devices only)
+    """
+    self.bubble_gpu_manager = bubble_gpu_manager
+    self.batch_deformer = batch_deformer
+    self.particle_gpu_manager = particle_gpu_manager
+    self.device = device
+    self.use_graph = use_graph and device.startswith("cuda")
+
+    # Optional deflection stage: callable(frame_params_gpu) that enqueues kernels
+    self._deflection_stage = None
+
+    # Baked launch scalars from bubble config
+    self._rise_speed = 0.0
+    self._released_rise_speed = 0.0
+    self._respawn_delay = 0.0
+    self._diameter_multiplier = 1.0
+    self._max_concurrent_active = 0  # 0 = no limit
+
+    # Device-resident per-frame inputs
+    self.frame_params_gpu = wp.zeros(FRAME_PARAM_COUNT, dtype=float, device=device)
+    self._frame_staging = wp.zeros(
+      FRAME_PARAM_COUNT, dtype=float, device="cpu", pinned=device.startswith("cuda")
+    )
+    self._frame_staging_np = self._frame_staging.numpy()
+    self.wave_state = batch_deformer.wave_state or DeviceWaveState(device=device)
+
+    # Graph state
+    self._graph = None
+    self._graph_key = None
+    self._warmed_up = False
+
+  def configure(self, bubble_config):
+    """
+    Bake bubble config values used as launch scalars.
+
+    Changing them invalidates the captured graph.
+    """
+    self._rise_speed = bubble_config.rise_speed
+    self._released_rise_speed = bubble_config.released_rise_speed
+    self._respawn_delay = bubble_config.respawn_delay
+    self._diameter_multiplier = bubble_config.diameter_multiplier
+    self._max_concurrent_active = getattr(bubble_config, "max_concurrent_active", None) or 0
+    self.invalidate()
+
+  def set_deflection_stage(self, launch_fn):
+    """
+    Insert a deflection stage just before batch deform.
+
+    Args:
+        launch_fn: Callable(frame_params_gpu) that only enqueues device
+            work (no host sync, no allocation), or None to remove. A bound
+            method whose owner has capture_key() (BatchDeflectionManager.
+            launch_frame) re-captures when that key changes.
+    """
+    self._deflection_stage = launch_fn
+    self.invalidate()
+
+  def attach_deflection(self, deflection_manager) -> bool:
+    """
+    Run a BatchDeflectionManager inside the graph and bend with its output.
+
+    The manager must be registered with the deformer's tendroid list so
+    per-tendroid indices line up. Creature positions are staged each
+    frame with deflection_manager.set_creatures().
+
+    Returns:
+        True if the deformer is now reading the manager's device arrays
+    """
+    if deflection_manager is None:
+      self.batch_deformer.unbind_deflection()
+      self.set_deflection_stage(None)
+      return False
+
+    bound = self.batch_deformer.bind_deflection(
+      deflection_manager.angles_gpu, deflection_manager.axes_gpu
+    )
+    if not bound:
+      carb.log_warn("[GPUFramePipeline] Deflection arrays do not match deformer, bend disabled")
+      return False
+
+    self.set_deflection_stage(deflection_manager.launch_frame)
+    return True
+
+  def _sync_deflection_binding(self):
+    """Re-bind deflection output after a live add reallocated either side."""
+    manager = getattr(self._deflection_stage, "__self__", None)
+    angles = getattr(manager, "angles_gpu", None)
+    if angles is None or self.batch_deformer.bend_angle_gpu is angles:
+      return
+    if not self.batch_deformer.bind_deflection(angles, manager.axes_gpu):
+      carb.log_warn("[GPUFramePipeline] Deflection arrays no longer match deformer, bend disabled")
+      self.set_deflection_stage(None)
+
+  def invalidate(self):
+    """Drop the captured graph; the next step re-captures."""
+    self._graph = None
+    self._graph_key = None
+
+  def step(self, dt: float, wave_state: dict):
+    """
+    Run one simulation frame on the device.
+
+    Host work is limited to writing two pinned buffers and either one
+    graph launch or the equivalent eager launches.
+    """
+    self._frame_staging_np[0] = dt
+    self.wave_state.write_staging(wave_state)
+
+    if not self.use_graph:
+      self._enqueue_frame()
+      return
+
+    # First frame runs eagerly so all kernel modules are loaded before capture
+    if not self._warmed_up:
+      self._enqueue_frame()
+      self._warmed_up = True
+      return
+
+    self._sync_deflection_binding()
+    key = self._capture_key()
+    if self._graph is None or key != self._graph_key:
+      self._capture(key)
+      if self._graph is None:
+        return
+
+    wp.capture_launch(self._graph)
+
+  def _capture(self, key):
+    """Record the frame sequence into a CUDA graph, or fall back to eager."""
+    try:
+      with wp.ScopedCapture(device=self.device) as capture:
+        self._enqueue_frame()
+      self._graph = capture.graph
+      self._graph_key = key
+      # Capture records the work without running it - replay this frame
+      wp.capture_launch(self._graph)
+      carb.log_info("[GPUFramePipeline] Frame graph captured")
+    except Exception as e:
+      carb.log_warn(f"[GPUFramePipeline] Graph capture failed, running eagerly: {e}")
+      self.use_graph = False
+      self._graph = None
+      self._enqueue_frame()
+
+  def _enqueue_frame(self):
+    """Enqueue the full frame: inputs → bubbles → params → deflection → deform → particles."""
+    # Per-frame inputs (pinned host → device, captured as memcpy nodes)
+    wp.copy(self.frame_params_gpu, self._frame_staging)
+    self.wave_state.copy_to_device()
+
+    # 1. Bubble physics
+    self.bubble_gpu_manager.launch_update_frame(
+      self.frame_params_gpu,
+      self.wave_state.params_gpu,
+      self._rise_speed,
+      self._released_rise_speed,
+      self._respawn_delay
+    )
+    if self._max_concurrent_active > 0:
+      self.bubble_gpu_manager.launch_concurrent_limit(
+        self._max_concurrent_active, self._respawn_delay
+      )
+
+    # 2. Per-tendroid deform params from bubble state
+    self.batch_deformer.launch_state_update(
+      self.bubble_gpu_manager, self._diameter_multiplier
+    )
+
+    # 3. Deflection (bend angles/axes read by the deform below)
+    if self._deflection_stage:
+      self._deflection_stage(self.frame_params_gpu)
+
+    # 4. Batch deform into out_points_gpu
+    self.batch_deformer.deform_all(download=False)
+
+    # 5. Particles
+    if self.particle_gpu_manager:
+      self.particle_gpu_manager.launch_update_frame(self.frame_params_gpu)
+
+  def _capture_key(self) -> tuple:
+    """Identity of every buffer and scalar baked into the graph."""
+    bubbles = self.bubble_gpu_manager
+    deformer = self.batch_deformer
+    arrays = [
+      bubbles.y_positions_gpu, bubbles.phases_gpu, bubbles.world_y_gpu,
+      bubbles.current_radius_gpu, bubbles.respawn_timers_gpu,
+      bubbles.ages_gpu, bubbles.limit_flags_gpu,
+      bubbles.limit_keys_gpu, bubbles.limit_order_gpu,
+      deformer.out_points_gpu, deformer.bubble_y_gpu, deformer.bubble_radius_gpu,
+      deformer.wave_dx_gpu, deformer.wave_dz_gpu,
+      deformer.bend_angle_gpu, deformer.bend_axis_gpu,
+    ]
+    if self.particle_gpu_manager:
+      arrays.append(self.particle_gpu_manager.alive_flags_gpu)
+    stage_owner = getattr(self._deflection_stage, "__self__", None)
+    stage_key = stage_owner.capture_key() if hasattr(stage_owner, "capture_key") else ()
+    return tuple(a.ptr if a is not None else 0 for a in arrays) + (
+      self._rise_speed, self._released_rise_speed,
+      self._respawn_delay, self._diameter_multiplier,
+      self._max_concurrent_active,
+      id(self._deflection_stage),
+      bubbles.max_bubbles,
+    ) + deformer.capture_key() + stage_key
+
+  def destroy(self):
+    """Release graph and device buffers."""
+    self._graph = None
+    self._graph_key = None
+    self.frame_params_gpu = None
+    self._frame_staging = None
+    self._frame_staging_np = None
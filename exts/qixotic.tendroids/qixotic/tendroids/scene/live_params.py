@@ -0,0 +1,72 @@
+"""
+Live Parameters - which tuning changes can patch a running scene
+
+Each changed value is routed to the cheapest update that applies it:
+- launch scalars: read from the shared bubble config every frame
+  (nothing to upload; a captured frame graph re-bakes them)
+- bubble lifecycle: one BubblePhysicsAdapter.update_config scatter
+- deform shape: BatchWarpDeformer.update_deform_params column uploads
+
+Anything else changes topology or buffer sizes (mesh resolution,
+tendroid count, particle pools, materials) and needs a rebuild, as does
+any key or section not routed here.
+"""
+
+# Bubble config fields read as per-frame launch / spray parameters
+BUBBLE_LAUNCH_KEYS = frozenset({
+  "rise_speed", "released_rise_speed", "drift_speed", "diameter_multiplier",
+  "respawn_delay", "max_concurrent_active", "auto_respawn", "hide_until_clear",
+  "particles_per_pop", "particle_speed", "particle_lifetime", "particle_size",
+  "particle_spread", "debug_logging",
+})
+
+# Launch scalars baked into GPUFramePipeline.configure()
+PIPELINE_KEYS = frozenset({
+  "rise_speed", "released_rise_speed", "respawn_delay", "diameter_multiplier",
+  "max_concurrent_active",
+})
+
+# Bubble config fields baked per bubble at registration
+BUBBLE_LIFECYCLE_KEYS = frozenset({
+  "spawn_height_pct", "max_diameter_pct", "min_pop_height", "max_pop_height",
+})
+
+# tendroids_config.json sections only read while the scene is built
+REBUILD_SECTIONS = (
+  "tendroid_geometry", "tendroid_spawning", "sea_floor", "environment", "tendroid_animation",
+)
+
+# Sections routed key by key (see update_bubble_params) and file metadata
+LIVE_SECTIONS = ("bubble_system",)
+METADATA_KEYS = ("$schema", "title", "description")
+
+
+def changed_values(old: dict, new: dict) -> dict:
+  """Keys of new whose value differs from old (added keys included)."""
+  old = old or {}
+  return {key: value for key, value in (new or {}).items() if old.get(key) != value}
+
+
+def diff_config(old: dict, new: dict) -> tuple:
+  """
+  Compare two tendroids_config.json loads.
+
+  Args:
+      old: Config the scene was built / last updated with
+      new: Freshly loaded config
+
+  Returns:
+      (bubble_changes, rebuild): changed bubble_system values, and True
+      if a build-time or unrouted section changed
+  """
+  old, new = old or {}, new or {}
+  routed = set(LIVE_SECTIONS) | set(METADATA_KEYS)
+  sections = set(REBUILD_SECTIONS) | (set(old) | set(new)) - routed
+  rebuild = any(old.get(section) != new.get(section) for section in sections)
+  bubble_changes = changed_values(old.get("bubble_system"), new.get("bubble_system"))
+  return bubble_changes, rebuild
+
+
+def is_live_bubble_key(key: str) -> bool:
+  """True if a bubble config field can change without a rebuild."""
+  return key in BUBBLE_LAUNCH_KEYS or key in BUBBLE_LIFECYCLE_KEYS
@@ -5,16 +5,24 @@ Orchestrates scene creation, animation, and cleanup.
 GPU-accelerated bubble physics integrated for maximum performance.
 """
 
+import copy
+
 import carb
 import omni.usd
+import warp as wp
 from pxr import UsdGeom
 
 from .animation_controller import V2AnimationController
 from .tendroid_factory import V2TendroidFactory
 from .tendroid_wrapper import V2TendroidWrapper
 from ..bubbles import V2BubbleManager, create_gpu_bubble_system
+from ..config import ConfigLoader
 from ..core import BatchWarpDeformer, V2WarpDeformer
-from ..environment import SeaFloorController, get_height_at
+from ..environment import SeaFloorController, get_height_at, get_heights_at
+from ..environment.sea_floor_helper import get_height_map
+from .live_params import PIPELINE_KEYS, BUBBLE_LIFECYCLE_KEYS, diff_config, is_live_bubble_key
+from .scene_cache import SceneCache, scene_cache_key
+from ..utils.slot_arena import SlotTable
 
 
 class V2SceneManager:
@@ -30,6 +38,12 @@ class V2SceneManager:
     self.tendroids = []
     self.tendroid_data = []
     self.bubble_manager = None
+
+    # Shared slots: deformer slot == GPU bubble id for every tendroid
+    self.tendroid_slots = SlotTable()
+
+    # Batched pipeline device: Warp "cpu" (threaded deform) on hosts without CUDA
+    self.device = "cuda:0" if wp.is_cuda_available() else "cpu"
     self.animation_controller = V2AnimationController()
     self._sea_floor_created = False
 
@@ -39,15 +53,54 @@ class V2SceneManager:
 
     # Batch deformation
     self.batch_deformer = None
+    self.use_procedural_deform = False  # Feature flag: rebuild rest pose in-kernel
+    self.use_active_set_deform = True  # Feature flag: skip resting tendroids
+    self.use_analytic_normals = False  # Feature flag: deformed normals (stored rest pose)
+    self.use_frustum_culling = False  # Feature flag: viewport cull + LOD rate (needs active set)
+    self.use_lod_meshes = True  # Feature flag: reduced-segment mesh per LOD level (with culling)
+    self.frustum_culler = None
+    self.lod_variants = {}  # Tendroid name -> LOD variant wrappers (level 1, 2, ...)
+
+    # Creature bends nearby tendroids (device angles read by the batch deform)
+    self.use_gpu_deflection = True  # Feature flag (CUDA batch deformer only)
+    self.deflection_manager = None
+
+    # Scene cache: reuse geometry across launches (same config + args = same layout)
+    self.use_scene_cache = False  # Feature flag
+
+    # Captured GPU frame graph (bubbles → deform → particles)
+    self.use_gpu_frame_pipeline = False  # Feature flag
+    self.frame_pipeline = None
+
+    # Overlap next frame's deform with this frame's mesh handoff
+    self.use_pipelined_output = False  # Feature flag (meshes lag one frame on the USD path)
+    self.output_pipeline = None
+
+    # Fixed-rate simulation, deform interpolated at render rate
+    self.use_fixed_step_sim = False  # Feature flag (render lags one sim step)
+    self.fixed_step_rate = 60.0
+
+    # Multi-GPU: tendroids split by sea floor XZ tiles, one pipeline per device
+    self.use_multi_gpu_partitions = False  # Feature flag (no live add / remove or instanced bubbles)
+    self.partition_devices = None  # None = every CUDA device; the first one renders
+    self.partition_tile_size = 100.0
+    self.partitioned_field = None
 
     # Interactive creature (Phase 1)
     self.creature_controller = None
 
-  def _ensure_sea_floor(self, stage):
-    """Create sea floor if not present."""
+    # Creature vs. tendroid / bubble hash grid pass (GPU)
+    self.use_gpu_creature_interactions = False  # Feature flag (enables tendroid avoidance / shock)
+    self.creature_interactions = None
+
+    # Config the running scene reflects (reload_config diffs against it)
+    self._applied_config = copy.deepcopy(ConfigLoader.load_json())
+
+  def _ensure_sea_floor(self, stage, height_map=None):
+    """Create sea floor if not present (from a cached height map if given)."""
     if not self._sea_floor_created and stage:
       try:
-        SeaFloorController.create_sea_floor(stage)
+        SeaFloorController.create_sea_floor(stage, height_map=height_map)
         self._sea_floor_created = True
       except Exception as e:
         carb.log_error(f"[V2SceneManager] Sea floor failed: {e}")
@@ -68,7 +121,9 @@ class V2SceneManager:
 
       self.gpu_bubble_adapter = create_gpu_bubble_system(
         self.tendroids,
-        config
+        config,
+        slots=self.tendroid_slots,
+        device=self.device
       )
 
       # Pass GPU adapter to animation controller
@@ -87,28 +142,179 @@ class V2SceneManager:
       return
 
     try:
-      self.batch_deformer = BatchWarpDeformer(device="cuda:0")
+      self.batch_deformer = BatchWarpDeformer(
+        device=self.device,
+        procedural=self.use_procedural_deform,
+        slots=self.tendroid_slots,
+        # CPU: full deform split over worker threads beats a serial active set
+        active_set=self.use_active_set_deform and self.device != "cpu",
+        analytic_normals=self.use_analytic_normals
+      )
 
       # Register all tendroids
       for tendroid, data in zip(self.tendroids, self.tendroid_data):
         self.batch_deformer.register_tendroid(
           tendroid,
-          data['base_points']
+          data['base_points'],
+          geometry=data
         )
 
       # Build GPU arrays
       self.batch_deformer.build()
 
+      if self.use_frustum_culling and self.use_active_set_deform:
+        from ..core.frustum_culler import FrustumCuller
+        self.frustum_culler = FrustumCuller(device=self.batch_deformer.device)
+        self.batch_deformer.attach_culler(self.frustum_culler)
+        self.animation_controller.set_frustum_culler(self.frustum_culler)
+        if self.use_lod_meshes:
+          self._create_lod_variants(
+            omni.usd.get_context().get_stage(), zip(self.tendroids, self.tendroid_data)
+          )
+
+      if self.use_gpu_deflection:
+        self._initialize_deflection()
+
+      # Link tendroids to GPU bubble slots for device-side state updates
+      if self.gpu_bubble_adapter:
+        self.batch_deformer.bind_bubble_slots(self.gpu_bubble_adapter._name_to_id)
+
+      if self.use_pipelined_output and self.batch_deformer.device.startswith("cuda"):
+        from ..core.deform_pipeline import PipelinedDeformOutput
+        self.output_pipeline = PipelinedDeformOutput(self.batch_deformer)
+        self.animation_controller.set_output_pipeline(self.output_pipeline)
+
       # Pass to animation controller
       self.animation_controller.set_batch_deformer(self.batch_deformer)
 
       carb.log_info(
         f"[GPU] Batch deformer initialized: {self.batch_deformer.total_vertices} vertices"
+        f" on {self.batch_deformer.device}"
       )
     except Exception as e:
       carb.log_error(f"[GPU] Failed to initialize batch deformer: {e}")
       self.batch_deformer = None
 
+  def _initialize_deflection(self):
+    """Bend the batch deform with a BatchDeflectionManager (slot-indexed)."""
+    if not self.batch_deformer.device.startswith("cuda"):
+      carb.log_info("[GPU] Deflection needs a CUDA batch deformer, bend disabled")
+      return
+
+    from ..deflection import BatchDeflectionManager
+    self.deflection_manager = BatchDeflectionManager(device=self.batch_deformer.device)
+    self.deflection_manager.register_tendroids(self.tendroids)
+    if not self.batch_deformer.bind_deflection(
+      self.deflection_manager.angles_gpu, self.deflection_manager.axes_gpu
+    ):
+      carb.log_warn("[GPU] Deflection arrays do not match batch deformer, bend disabled")
+      self.deflection_manager.destroy()
+      self.deflection_manager = None
+      return
+    for variants in self.lod_variants.values():
+      for variant in variants:
+        self._add_deflection(variant, self.tendroid_slots.slot_of(variant.name))
+    self.animation_controller.set_deflection_manager(self.deflection_manager)
+
+  def _create_lod_variants(self, stage, pairs):
+    """
+    Build a reduced-segment mesh per culled LOD level for each tendroid.
+
+    Each variant takes its own slot in the batch deformer (and the
+    deflection manager, added by the caller); the culler shows one level
+    per tendroid and only that one is deformed.
+
+    Args:
+        stage: USD stage
+        pairs: (tendroid, builder data) to add variants for
+    """
+    from ..builders import V2TendroidBuilder
+
+    levels = self.frustum_culler.level_count
+    for tendroid, data in pairs:
+      variants = []
+      for level in range(1, levels):
+        variant_data = V2TendroidBuilder.create_lod_variant(
+          stage, data, level, get_height_fn=get_height_at, get_heights_fn=get_heights_at
+        )
+        variant = self._create_warp_tendroid(stage, variant_data) if variant_data else None
+        if variant is None:
+          break
+        if self.batch_deformer.add_lod_variant(
+          tendroid.name, level, variant, variant_data['base_points'], geometry=variant_data
+        ) is None:
+          variant.deformer.destroy()
+          break
+        variants.append(variant)
+      if variants:
+        self.lod_variants[tendroid.name] = variants
+
+  def _remove_lod_variants(self, name: str):
+    """Release a removed tendroid's LOD variant slots (after the deformer dropped them)."""
+    for variant in self.lod_variants.pop(name, []):
+      slot = self.tendroid_slots.slot_of(variant.name)
+      if self.deflection_manager and slot is not None:
+        self.deflection_manager.remove_tendroid(slot)
+      self.tendroid_slots.release(variant.name)
+      variant.deformer.destroy()
+
+  def _initialize_frame_pipeline(self):
+    """Capture the per-frame GPU chain into a replayable graph."""
+    if not self.gpu_bubble_adapter or not self.batch_deformer:
+      return
+
+    try:
+      from ..bubbles import DEFAULT_V2_BUBBLE_CONFIG
+      from .gpu_frame_pipeline import GPUFramePipeline
+
+      particle_gpu = None
+      if self.bubble_manager and self.bubble_manager.particle_manager:
+        particle_gpu = self.bubble_manager.particle_manager.gpu_manager
+
+      self.frame_pipeline = GPUFramePipeline(
+        bubble_gpu_manager=self.gpu_bubble_adapter.gpu_manager,
+        batch_deformer=self.batch_deformer,
+        particle_gpu_manager=particle_gpu,
+        device=self.batch_deformer.device
+      )
+      self.frame_pipeline.configure(DEFAULT_V2_BUBBLE_CONFIG)
+      if self.deflection_manager:
+        self.frame_pipeline.attach_deflection(self.deflection_manager)
+
+      self.animation_controller.set_frame_pipeline(self.frame_pipeline)
+    except Exception as e:
+      carb.log_error(f"[GPU] Failed to initialize frame pipeline: {e}")
+      self.frame_pipeline = None
+
+  def _initialize_partitions(self) -> bool:
+    """Spread bubbles, deflection and deform over several GPUs by sea floor tiles."""
+    try:
+      from ..bubbles import DEFAULT_V2_BUBBLE_CONFIG
+      from .field_partitions import PartitionedField, cuda_devices
+
+      devices = self.partition_devices or cuda_devices()
+      if len(devices) < 2:
+        carb.log_warn("[GPU] Multi-GPU partitions need 2+ CUDA devices, using one device")
+        return False
+      if self.bubble_manager and self.bubble_manager.uses_instancer:
+        carb.log_warn("[GPU] Instanced bubble visuals read one device, not drawn with partitions")
+
+      field = PartitionedField(devices, render_device=devices[0], tile_size=self.partition_tile_size)
+      if not field.build(
+        self.tendroids, self.tendroid_data, DEFAULT_V2_BUBBLE_CONFIG,
+        active_set=self.use_active_set_deform
+      ):
+        field.destroy()
+        return False
+
+      self.partitioned_field = field
+      self.animation_controller.set_partitioned_field(field)
+      return True
+    except Exception as e:
+      carb.log_error(f"[GPU] Failed to partition field: {e}")
+      self.partitioned_field = None
+      return False
+
   def _initialize_creature(self, stage, tendroid_data: list = None):
     """Initialize interactive creature controller."""
     try:
@@ -132,6 +338,9 @@ class V2SceneManager:
         start_position=start_pos
       )
 
+      if self.use_gpu_creature_interactions:
+        self._initialize_creature_interactions()
+
       # Pass to animation controller
       self.animation_controller.set_creature_controller(self.creature_controller)
 
@@ -142,6 +351,29 @@ class V2SceneManager:
       traceback.print_exc()
       self.creature_controller = None
 
+  def _initialize_creature_interactions(self):
+    """Attach the GPU interaction grid (tendroids + GPU bubbles) to the creature."""
+    try:
+      from ..controllers.creature_interaction_grid import CreatureInteractionGrid
+
+      if self.partitioned_field:
+        self.creature_interactions = self.partitioned_field.create_interaction_grid()
+        self.creature_controller.set_interaction_grid(self.creature_interactions)
+        carb.log_info("[Creature] GPU interaction grid enabled on every partition")
+        return
+
+      self.creature_interactions = CreatureInteractionGrid(device=self.device)
+      self.creature_interactions.set_tendroids(self.tendroids)
+      if self.gpu_bubble_adapter and self.gpu_bubble_adapter.gpu_manager:
+        self.creature_interactions.bind_bubbles(
+          self.gpu_bubble_adapter.gpu_manager, self.gpu_bubble_adapter._id_to_name
+        )
+      self.creature_controller.set_interaction_grid(self.creature_interactions)
+      carb.log_info("[Creature] GPU interaction grid enabled")
+    except Exception as e:
+      carb.log_error(f"[Creature] GPU interaction grid failed: {e}")
+      self.creature_interactions = None
+
   def create_tendroids(
     self,
     count: int = None,
@@ -176,19 +408,31 @@ class V2SceneManager:
         carb.log_error("[V2SceneManager] No USD stage")
         return False
 
-      self._ensure_sea_floor(stage)
+      cache_key, cache = None, None
+      if self.use_scene_cache:
+        cache_key = scene_cache_key(
+          count=count, spawn_area=spawn_area, radius_range=radius_range,
+          radial_segments=radial_segments, height_segments=height_segments
+        )
+        cache = SceneCache.load(SceneCache.path_for(cache_key), cache_key)
+
+      self._ensure_sea_floor(stage, cache.height_map if cache else None)
       self._ensure_parent_prim(stage, "/World/Tendroids")
       self.clear_tendroids(stage)
 
-      self.tendroid_data = V2TendroidFactory.create_batch(
-        stage=stage,
-        count=count,
-        spawn_area=spawn_area,
-        radius_range=radius_range,
-        radial_segments=radial_segments,
-        height_segments=height_segments,
-        get_height_fn=get_height_at
-      )
+      if cache:
+        self.tendroid_data = cache.restore_tendroids(stage)
+      else:
+        self.tendroid_data = V2TendroidFactory.create_batch(
+          stage=stage,
+          count=count,
+          spawn_area=spawn_area,
+          radius_range=radius_range,
+          radial_segments=radial_segments,
+          height_segments=height_segments,
+          get_height_fn=get_height_at,
+          get_heights_fn=get_heights_at
+        )
 
       self.tendroids = []
       for data in self.tendroid_data:
@@ -196,22 +440,34 @@ class V2SceneManager:
         if tendroid:
           self.tendroids.append(tendroid)
 
+      if cache_key and not cache and self.tendroids and get_height_map() is not None:
+        SceneCache.from_scene(
+          cache_key, get_height_map(), self.tendroid_data, self.tendroids
+        ).save(SceneCache.path_for(cache_key))
+
       self.animation_controller.set_tendroids(
         self.tendroids,
         self.tendroid_data
       )
 
-      self.bubble_manager = V2BubbleManager(stage)
+      self.bubble_manager = V2BubbleManager(stage, device=self.device)
       for tendroid in self.tendroids:
         self.bubble_manager.register_tendroid(tendroid)
       self.animation_controller.set_bubble_manager(self.bubble_manager)
 
-      # Initialize GPU bubbles after everything is set up
-      if self.use_gpu_bubbles:
-        self._initialize_gpu_bubbles()
+      # Multi-GPU field replaces the single-device bubbles + batch deformer
+      partitioned = self.use_multi_gpu_partitions and self._initialize_partitions()
+      if not partitioned:
+        # Initialize GPU bubbles after everything is set up
+        if self.use_gpu_bubbles:
+          self._initialize_gpu_bubbles()
+
+        # Initialize batch deformation
+        self._initialize_batch_deformer()
 
-      # Initialize batch deformation
-      self._initialize_batch_deformer()
+        # Optional: capture bubbles → deform → particles as one GPU graph
+        if self.use_gpu_frame_pipeline:
+          self._initialize_frame_pipeline()
 
       # Initialize interactive creature (Phase 1)
       self._initialize_creature(stage, self.tendroid_data)
@@ -235,7 +491,9 @@ class V2SceneManager:
         cylinder_radius=data['radius'],
         cylinder_length=data['length'],
         max_amplitude=data.get('max_amplitude', 0.8),
-        bulge_width=data.get('bulge_width', 0.9)
+        bulge_width=data.get('bulge_width', 0.9),
+        device=self.device,
+        height_factors=data.get('height_factors')
       )
 
       tendroid = V2TendroidWrapper(
@@ -257,6 +515,165 @@ class V2SceneManager:
       )
       return None
 
+  def add_tendroid(
+    self,
+    position: tuple,
+    radius: float = 10.0,
+    length: float = 100.0,
+    radial_segments: int = 24,
+    height_segments: int = 48,
+    name: str = None
+  ):
+    """
+    Add one tendroid to the running scene.
+
+    Only the new tendroid is uploaded: it takes a slot from the shared
+    table (reusing a removed tendroid's slot when free) in the bubble
+    system and the batch deformer, which captured frame graphs pick up
+    through their capture keys.
+
+    Returns:
+        The tendroid name, or None on failure
+    """
+    if self.partitioned_field:
+      carb.log_warn("[V2SceneManager] Live add is not supported on a partitioned field")
+      return None
+
+    try:
+      stage = omni.usd.get_context().get_stage()
+      if not stage:
+        return None
+
+      self._ensure_parent_prim(stage, "/World/Tendroids")
+
+      if name is None:
+        index = len(self.tendroid_data)
+        taken = {d['name'] for d in self.tendroid_data}
+        while f"Tendroid_{index:02d}" in taken:
+          index += 1
+        name = f"Tendroid_{index:02d}"
+
+      from ..builders import V2TendroidBuilder
+      data = V2TendroidBuilder.create_tendroid(
+        stage=stage,
+        name=name,
+        position=position,
+        radius=radius,
+        length=length,
+        radial_segments=radial_segments,
+        height_segments=height_segments,
+        get_height_fn=get_height_at,
+        get_heights_fn=get_heights_at
+      )
+      if not data:
+        return None
+
+      tendroid = self._create_warp_tendroid(stage, data)
+      if not tendroid:
+        stage.RemovePrim(data['base_path'])
+        return None
+
+      self.tendroid_data.append(data)
+      self.tendroids.append(tendroid)
+      self.animation_controller.set_tendroids(self.tendroids, self.tendroid_data)
+
+      if self.bubble_manager:
+        self.bubble_manager.register_tendroid(tendroid)
+
+      bubble_id = -1
+      if self.gpu_bubble_adapter:
+        from ..bubbles import DEFAULT_V2_BUBBLE_CONFIG
+        self.gpu_bubble_adapter.register_tendroid(tendroid, DEFAULT_V2_BUBBLE_CONFIG)
+        bubble_id = self.gpu_bubble_adapter._name_to_id.get(name, -1)
+
+      if self.output_pipeline:
+        self.output_pipeline.flush(apply=False)
+      if self.batch_deformer:
+        slot = self.batch_deformer.add_tendroid(
+          tendroid, data['base_points'], geometry=data, bubble_id=bubble_id
+        )
+        if slot is None:
+          carb.log_warn(f"[V2SceneManager] {name} not batched - procedural rebuild failed")
+        else:
+          if self.frustum_culler and self.use_lod_meshes:
+            self._create_lod_variants(stage, [(tendroid, data)])
+          if self.deflection_manager:
+            self._add_deflection(tendroid, slot)
+            for variant in self.lod_variants.get(name, []):
+              self._add_deflection(variant, self.tendroid_slots.slot_of(variant.name))
+      if self.creature_interactions:
+        self.creature_interactions.set_tendroids(self.tendroids)
+
+      carb.log_info(f"[V2SceneManager] Added {name} ({len(self.tendroids)} tendroids)")
+      return name
+
+    except Exception as e:
+      carb.log_error(f"[V2SceneManager] Add tendroid failed: {e}")
+      return None
+
+  def remove_tendroid(self, name: str) -> bool:
+    """
+    Remove one tendroid from the running scene.
+
+    Frees its slot and vertex range for the next add_tendroid; the
+    other tendroids are not re-uploaded.
+
+    Returns:
+        True if the tendroid existed
+    """
+    if self.partitioned_field:
+      carb.log_warn("[V2SceneManager] Live remove is not supported on a partitioned field")
+      return False
+
+    index = next(
+      (i for i, t in enumerate(self.tendroids) if t.name == name), None
+    )
+    if index is None:
+      return False
+
+    tendroid = self.tendroids.pop(index)
+    data = next((d for d in self.tendroid_data if d['name'] == name), None)
+    if data is not None:
+      self.tendroid_data.remove(data)
+
+    if self.output_pipeline:
+      self.output_pipeline.flush(apply=False)
+    slot = self.tendroid_slots.slot_of(name)
+    if self.deflection_manager and slot is not None:
+      self.deflection_manager.remove_tendroid(slot)
+    if self.batch_deformer:
+      self.batch_deformer.remove_tendroid(name)
+    self._remove_lod_variants(name)
+    if self.gpu_bubble_adapter:
+      self.gpu_bubble_adapter.unregister_tendroid(name)
+    if self.bubble_manager:
+      self.bubble_manager.unregister_tendroid(name)
+    self.tendroid_slots.release(name)
+    if self.creature_interactions:
+      self.creature_interactions.set_tendroids(self.tendroids)
+
+    if getattr(tendroid, 'deformer', None):
+      tendroid.deformer.destroy()
+
+    ctx = omni.usd.get_context()
+    stage = ctx.get_stage() if ctx else None
+    if stage and data and data.get('base_path'):
+      if stage.GetPrimAtPath(data['base_path']).IsValid():
+        stage.RemovePrim(data['base_path'])
+
+    carb.log_info(f"[V2SceneManager] Removed {name} ({len(self.tendroids)} tendroids)")
+    return True
+
+  def _add_deflection(self, tendroid, slot: int):
+    """Write one live-added tendroid into the deflection manager and re-bind."""
+    self.deflection_manager.add_tendroid(tendroid, index=slot)
+    # Either side may have reallocated its per-tendroid arrays
+    if not self.batch_deformer.bind_deflection(
+      self.deflection_manager.angles_gpu, self.deflection_manager.axes_gpu
+    ):
+      carb.log_warn("[V2SceneManager] Deflection arrays no longer match deformer, bend disabled")
+      self.batch_deformer.unbind_deflection()
+
   def create_single_tendroid(
     self,
     position: tuple = (0, 0, 0),
@@ -288,7 +705,8 @@ class V2SceneManager:
         length=length,
         radial_segments=radial_segments,
         height_segments=height_segments,
-        get_height_fn=get_height_at
+        get_height_fn=get_height_at,
+        get_heights_fn=get_heights_at
       )
 
       if data:
@@ -310,12 +728,109 @@ class V2SceneManager:
 
   def start_animation(self, enable_profiling: bool = False):
     """Start animation loop."""
+    self.animation_controller.set_fixed_step(self.fixed_step_rate if self.use_fixed_step_sim else None)
     self.animation_controller.start(enable_profiling=enable_profiling)
 
   def stop_animation(self):
     """Stop animation loop."""
     self.animation_controller.stop()
 
+  def update_bubble_params(self, **values) -> bool:
+    """
+    Apply bubble config changes to the running scene without a rebuild.
+
+    Launch scalars (rise speeds, respawn delay, ...) take effect next
+    frame; lifecycle values (pop height range, spawn / max-size heights)
+    are patched into the per-bubble device arrays in one scatter.
+
+    Args:
+        **values: V2BubbleConfig field -> new value
+
+    Returns:
+        True if everything applied live; False if a value changes
+        topology (stored on the config, applied by the next
+        clear_tendroids + create_tendroids) or is not a V2BubbleConfig
+        field (nothing routes it live)
+    """
+    from ..bubbles import DEFAULT_V2_BUBBLE_CONFIG
+    config = self.bubble_manager.config if self.bubble_manager else DEFAULT_V2_BUBBLE_CONFIG
+
+    rebuild = []
+    for key, value in values.items():
+      if not hasattr(config, key):
+        carb.log_warn(f"[V2SceneManager] Unknown bubble parameter: {key}")
+        rebuild.append(key)
+        continue
+      setattr(config, key, value)
+      if not is_live_bubble_key(key):
+        rebuild.append(key)
+
+    if BUBBLE_LIFECYCLE_KEYS.intersection(values):
+      self._refresh_bubble_lifecycle(config)
+    if self.frame_pipeline and PIPELINE_KEYS.intersection(values):
+      self.frame_pipeline.configure(config)
+
+    if rebuild:
+      carb.log_warn(f"[V2SceneManager] Rebuild needed to apply: {', '.join(rebuild)}")
+    return not rebuild
+
+  def update_deform_params(self, max_amplitude: float = None, bulge_width: float = None) -> int:
+    """
+    Change every tendroid's bulge shape in place (no mesh regeneration).
+
+    Args:
+        max_amplitude: Maximum radial expansion fraction (None = keep)
+        bulge_width: Gaussian width multiplier (None = keep)
+
+    Returns:
+        Number of tendroids updated
+    """
+    for tendroid, data in zip(self.tendroids, self.tendroid_data):
+      if max_amplitude is not None:
+        tendroid.deformer.max_amplitude = data['max_amplitude'] = float(max_amplitude)
+      if bulge_width is not None:
+        tendroid.deformer.bulge_width = data['bulge_width'] = float(bulge_width)
+
+    if self.batch_deformer:
+      self.batch_deformer.update_deform_params(max_amplitude, bulge_width)
+    if self.partitioned_field:
+      self.partitioned_field.update_deform_params(max_amplitude, bulge_width)
+
+    # Bubbles grow to the bulge's max radius
+    if max_amplitude is not None:
+      from ..bubbles import DEFAULT_V2_BUBBLE_CONFIG
+      config = self.bubble_manager.config if self.bubble_manager else DEFAULT_V2_BUBBLE_CONFIG
+      self._refresh_bubble_lifecycle(config)
+    return len(self.tendroids)
+
+  def _refresh_bubble_lifecycle(self, config):
+    """Re-derive per-bubble lifecycle parameters on CPU and GPU."""
+    if self.bubble_manager:
+      self.bubble_manager.refresh_config()
+    if self.gpu_bubble_adapter:
+      self.gpu_bubble_adapter.update_config(self.tendroids, config)
+    if self.partitioned_field:
+      self.partitioned_field.update_bubble_config(config)
+
+  def reload_config(self) -> bool:
+    """
+    Re-read tendroids_config.json and apply bubble_system changes live.
+
+    Returns:
+        True if the scene now reflects the file; False if a build-time
+        or unrouted section (geometry, spawning, sea floor, environment,
+        animation, ...) or a topology / unknown bubble value changed
+        and the scene needs a rebuild
+    """
+    new = ConfigLoader.reload()
+    bubble_changes, rebuild = diff_config(self._applied_config, new)
+    self._applied_config = copy.deepcopy(new)
+
+    live = self.update_bubble_params(**bubble_changes) if bubble_changes else True
+    if rebuild:
+      carb.log_warn("[V2SceneManager] Config change needs a rebuild (geometry / spawning / environment)")
+    return live and not rebuild
+
   def clear_tendroids(self, stage=None):
     """Remove all tendroids from scene."""
     if not stage:
@@ -334,17 +849,55 @@ class V2SceneManager:
     for tendroid in self.tendroids:
       if hasattr(tendroid, 'deformer') and tendroid.deformer:
         tendroid.deformer.destroy()
+    for variants in self.lod_variants.values():
+      for variant in variants:
+        variant.deformer.destroy()
+    self.lod_variants.clear()
 
     if self.bubble_manager:
       self.bubble_manager.clear_all()
       self.bubble_manager = None
 
+    # Interaction grid reads the GPU bubble arrays
+    if self.creature_interactions:
+      if self.creature_controller:
+        self.creature_controller.set_interaction_grid(None)
+      self.creature_interactions.destroy()
+      self.creature_interactions = None
+
+    if self.partitioned_field:
+      self.animation_controller.set_partitioned_field(None)
+      self.partitioned_field.destroy()
+      self.partitioned_field = None
+
     # Clean up GPU resources
     if self.gpu_bubble_adapter:
       self.gpu_bubble_adapter.destroy()
       self.gpu_bubble_adapter = None
 
+    # Drain async mesh handoff before anything it reads is freed
+    if self.output_pipeline:
+      self.animation_controller.set_output_pipeline(None)
+      self.output_pipeline.destroy()
+      self.output_pipeline = None
+
+    # Clean up frame pipeline before the buffers it references
+    if self.frame_pipeline:
+      self.animation_controller.set_frame_pipeline(None)
+      self.frame_pipeline.destroy()
+      self.frame_pipeline = None
+
     # Clean up batch deformer
+    if self.frustum_culler:
+      self.animation_controller.set_frustum_culler(None)
+      self.frustum_culler.destroy()
+      self.frustum_culler = None
+
+    if self.deflection_manager:
+      self.animation_controller.set_deflection_manager(None)
+      self.deflection_manager.destroy()
+      self.deflection_manager = None
+
     if self.batch_deformer:
       self.batch_deformer.destroy()
       self.batch_deformer = None
@@ -356,6 +909,7 @@ class V2SceneManager:
 
     self.tendroids.clear()
     self.tendroid_data.clear()
+    self.tendroid_slots.clear()
     self.animation_controller.set_tendroids([], [])
 
   def get_tendroid_count(self) -> int:
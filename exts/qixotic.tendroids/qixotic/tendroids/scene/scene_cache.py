@@ -0,0 +1,268 @@
+"""
+Scene Cache - Memory-mapped tendroid scene geometry for fast startup
+
+A created scene (sea floor height map, tendroid placements, conformed
+rest points, normals, triangle indices, height factors) is written to
+one binary file keyed by a hash of tendroids_config.json plus the
+create_tendroids() arguments. The next launch with the same key maps
+the file and rebuilds the USD meshes and deformers straight from it,
+skipping noise generation, placement, cylinder generation and terrain
+conforming.
+
+File layout (little endian):
+    [0..7]    magic b"TNDSCENE"
+    [8..11]   format version (uint32)
+    [12..15]  header length in bytes (uint32)
+    [16..]    UTF-8 JSON header: key, per-tendroid params, array table
+    then each array at a 64-byte aligned offset (np.memmap on load)
+
+Per-tendroid arrays are concatenated; vertex_offsets / face_offsets
+(length tendroids + 1) delimit each tendroid's slice.
+"""
+
+import hashlib
+import json
+import os
+import struct
+from pathlib import Path
+
+import carb
+import numpy as np
+
+CACHE_MAGIC = b"TNDSCENE"
+CACHE_VERSION = 1
+
+_PREAMBLE = struct.Struct("<8sII")
+_ALIGN = 64
+
+# create_tendroid() fields stored in the header (everything but arrays / prims)
+_PARAM_KEYS = (
+  'name', 'position', 'radius', 'length',
+  'deform_start_height', 'flare_height',
+  'flare_height_percent', 'flare_radius_multiplier',
+  'radial_segments', 'height_segments',
+  'max_amplitude', 'bulge_width',
+)
+
+
+def default_cache_dir() -> Path:
+  """TENDROIDS_CACHE_DIR, else ~/.cache/qixotic.tendroids."""
+  env = os.environ.get("TENDROIDS_CACHE_DIR")
+  return Path(env) if env else Path.home() / ".cache" / "qixotic.tendroids"
+
+
+def scene_cache_key(**create_args) -> str:
+  """
+  Hash of the loaded JSON config, create arguments and format version.
+
+  Args:
+      **create_args: create_tendroids() arguments that shape the scene
+
+  Returns:
+      Hex digest used as file name and validated on load
+  """
+  from ..config import ConfigLoader
+
+  payload = json.dumps(
+    {
+      "version": CACHE_VERSION,
+      "config": ConfigLoader.load_json(),
+      "args": create_args,
+    },
+    sort_keys=True,
+    default=list,
+  )
+  return hashlib.sha256(payload.encode("utf-8")).hexdigest()
+
+
+class SceneCache:
+  """
+  One cached scene: header params plus (memory-mapped) arrays.
+
+  Usage:
+      key = scene_cache_key(count=count, ...)
+      cache = SceneCache.load(SceneCache.path_for(key), key)
+      if cache:
+        data = cache.restore_tendroids(stage)
+      else:
+        ...build...
+        SceneCache.from_scene(key, height_map, data, tendroids).save(path)
+  """
+
+  def __init__(self, key: str, params: list, arrays: dict):
+    """
+    Args:
+        key: scene_cache_key() the contents belong to
+        params: Per-tendroid scalar dicts (_PARAM_KEYS)
+        arrays: height_map, points, normals, height_factors,
+          face_indices, vertex_offsets, face_offsets
+    """
+    self.key = key
+    self.params = params
+    self.arrays = arrays
+
+  @staticmethod
+  def path_for(key: str, cache_dir: Path = None) -> Path:
+    """Cache file for a key."""
+    return Path(cache_dir or default_cache_dir()) / f"scene_{key[:32]}.tndcache"
+
+  @property
+  def height_map(self) -> np.ndarray:
+    return self.arrays['height_map']
+
+  @classmethod
+  def from_scene(cls, key: str, height_map, tendroid_data: list, tendroids: list):
+    """
+    Gather a built scene.
+
+    Args:
+        key: scene_cache_key()
+        height_map: Host sea floor height map
+        tendroid_data: V2TendroidBuilder result dicts
+        tendroids: Wrappers (for deformer height factors), matched by name
+
+    Returns:
+        SceneCache (not yet written)
+    """
+    deformers = {t.name: t.deformer for t in tendroids}
+    params, points, normals, factors, faces = [], [], [], [], []
+
+    for data in tendroid_data:
+      deformer = deformers.get(data['name'])
+      if deformer is None:
+        continue
+      mesh = data['mesh_prim']
+      params.append({
+        k: (list(data[k]) if k == 'position' else data[k])
+        for k in _PARAM_KEYS if k in data
+      })
+      points.append(np.asarray(data['base_points'], dtype=np.float32).reshape(-1, 3))
+      normals.append(np.asarray(mesh.GetNormalsAttr().Get(), dtype=np.float32).reshape(-1, 3))
+      factors.append(np.asarray(deformer.height_factors_np, dtype=np.float32))
+      faces.append(np.asarray(mesh.GetFaceVertexIndicesAttr().Get(), dtype=np.int32))
+
+    def offsets(chunks):
+      return np.concatenate([[0], np.cumsum([len(c) for c in chunks])]).astype(np.int64)
+
+    def concat(chunks, shape, dtype):
+      return np.concatenate(chunks) if chunks else np.zeros(shape, dtype=dtype)
+
+    arrays = {
+      'height_map': np.asarray(height_map, dtype=np.float32),
+      'points': concat(points, (0, 3), np.float32),
+      'normals': concat(normals, (0, 3), np.float32),
+      'height_factors': concat(factors, (0,), np.float32),
+      'face_indices': concat(faces, (0,), np.int32),
+      'vertex_offsets': offsets(points),
+      'face_offsets': offsets(faces),
+    }
+    return cls(key, params, arrays)
+
+  def save(self, path: Path) -> bool:
+    """
+    Write atomically (temp file + rename).
+
+    Returns:
+        True if written
+    """
+    path = Path(path)
+    table, cursor = {}, 0
+    for name, array in self.arrays.items():
+      array = np.ascontiguousarray(array)
+      self.arrays[name] = array
+      table[name] = {"offset": cursor, "dtype": array.dtype.str, "shape": list(array.shape)}
+      cursor += -(-array.nbytes // _ALIGN) * _ALIGN
+
+    header = json.dumps({"key": self.key, "tendroids": self.params, "arrays": table}).encode("utf-8")
+    data_start = -(-(_PREAMBLE.size + len(header)) // _ALIGN) * _ALIGN
+
+    try:
+      path.parent.mkdir(parents=True, exist_ok=True)
+      tmp = path.with_suffix(path.suffix + ".tmp")
+      with open(tmp, "wb") as f:
+        f.write(_PREAMBLE.pack(CACHE_MAGIC, CACHE_VERSION, len(header)))
+        f.write(header)
+        for name, array in self.arrays.items():
+          f.seek(data_start + table[name]["offset"])
+          f.write(array.tobytes())
+        f.truncate(data_start + cursor)
+      os.replace(tmp, path)
+      carb.log_info(f"[SceneCache] Wrote {len(self.params)} tendroids to {path}")
+      return True
+    except OSError as e:
+      carb.log_warn(f"[SceneCache] Could not write {path}: {e}")
+      return False
+
+  @classmethod
+  def load(cls, path: Path, key: str):
+    """
+    Map a cache file if it exists and matches key and version.
+
+    Returns:
+        SceneCache with read-only np.memmap arrays, or None
+    """
+    path = Path(path)
+    if not path.is_file():
+      return None
+
+    try:
+      with open(path, "rb") as f:
+        magic, version, header_len = _PREAMBLE.unpack(f.read(_PREAMBLE.size))
+        if magic != CACHE_MAGIC or version != CACHE_VERSION:
+          carb.log_info(f"[SceneCache] Ignoring {path}: format {version}")
+          return None
+        header = json.loads(f.read(header_len).decode("utf-8"))
+
+      if header.get("key") != key:
+        return None
+
+      data_start = -(-(_PREAMBLE.size + header_len) // _ALIGN) * _ALIGN
+      arrays = {}
+      for name, entry in header["arrays"].items():
+        shape = tuple(entry["shape"])
+        if int(np.prod(shape)) == 0:
+          arrays[name] = np.zeros(shape, dtype=np.dtype(entry["dtype"]))
+          continue
+        arrays[name] = np.memmap(
+          path, dtype=np.dtype(entry["dtype"]), mode="r",
+          offset=data_start + entry["offset"], shape=shape
+        )
+      return cls(key, header["tendroids"], arrays)
+
+    except (OSError, ValueError, KeyError, struct.error) as e:
+      carb.log_warn(f"[SceneCache] Unreadable cache {path}: {e}")
+      return None
+
+  def tendroid_arrays(self, index: int) -> tuple:
+    """(points, normals, height_factors, face_indices) views for one tendroid."""
+    v0, v1 = self.arrays['vertex_offsets'][index:index + 2]
+    f0, f1 = self.arrays['face_offsets'][index:index + 2]
+    return (
+      self.arrays['points'][v0:v1],
+      self.arrays['normals'][v0:v1],
+      self.arrays['height_factors'][v0:v1],
+      self.arrays['face_indices'][f0:f1],
+    )
+
+  def restore_tendroids(self, stage, parent_path: str = "/World/Tendroids") -> list:
+    """
+    Recreate the cached tendroids on the stage.
+
+    Returns:
+        V2TendroidBuilder-style dicts with an extra 'height_factors'
+        entry consumed by V2WarpDeformer
+    """
+    from ..builders import V2TendroidBuilder
+
+    restored = []
+    for i, params in enumerate(self.params):
+      points, normals, factors, faces = self.tendroid_arrays(i)
+      data = V2TendroidBuilder.create_tendroid_from_arrays(
+        stage, params, points, normals, faces, parent_path=parent_path
+      )
+      if data:
+        data['height_factors'] = factors
+        restored.append(data)
+
+    carb.log_info(f"[SceneCache] Restored {len(restored)}/{len(self.params)} tendroids")
+    return restored
@@ -5,9 +5,10 @@ Creates batches of V2 tendroids with randomized positions and proper spacing.
 """
 
 import carb
-import math
 import random
 
+import numpy as np
+
 from ..builders import V2TendroidBuilder
 from ..config import get_config_value
 
@@ -29,7 +30,8 @@ class V2TendroidFactory:
         radial_segments: int = 24,
         height_segments: int = 48,
         max_attempts: int = None,
-        get_height_fn = None
+        get_height_fn = None,
+        get_heights_fn = None
     ) -> list:
         """
         Create multiple tendroids with randomized positions and sizes.
@@ -46,6 +48,7 @@ class V2TendroidFactory:
             height_segments: Vertical resolution
             max_attempts: Max position attempts per tendroid
             get_height_fn: Terrain height query function
+            get_heights_fn: Batched terrain query (preferred when given)
         
         Returns:
             List of tendroid data dicts from V2TendroidBuilder
@@ -78,7 +81,8 @@ class V2TendroidFactory:
         )
         
         tendroids = []
-        positions = []  # (x, z, base_radius) for interference checking
+        positions = np.zeros((max(count, 0), 3), dtype=np.float64)  # (x, z, base_radius) rows
+        placed = 0
         width, depth = spawn_area
         
         # Use uniform radius for GPU batching optimization
@@ -99,7 +103,8 @@ class V2TendroidFactory:
                 radial_segments=radial_segments,
                 height_segments=height_segments,
                 parent_path=parent_path,
-                get_height_fn=get_height_fn
+                get_height_fn=get_height_fn,
+                get_heights_fn=get_heights_fn
             )
             
             if tendroid_data:
@@ -124,16 +129,17 @@ class V2TendroidFactory:
                 z = random.uniform(-depth / 2, depth / 2)
                 
                 if V2TendroidFactory._check_interference(
-                    x, z, base_radius, positions, spacing_mult
+                    x, z, base_radius, positions[:placed], spacing_mult
                 ):
                     position_found = True
-                    positions.append((x, z, base_radius))
+                    positions[placed] = (x, z, base_radius)
+                    placed += 1
                     break
             
             if not position_found:
                 carb.log_warn(
                     f"[V2TendroidFactory] Could not place tendroid {i} "
-                    f"after {max_attempts} attempts (have {len(positions)} placed, "
+                    f"after {max_attempts} attempts (have {placed} placed, "
                     f"spawn_area={width}x{depth}, spacing={spacing_mult})"
                 )
                 continue
@@ -152,13 +158,14 @@ class V2TendroidFactory:
                 radial_segments=radial_segments,
                 height_segments=height_segments,
                 parent_path=parent_path,
-                get_height_fn=get_height_fn
+                get_height_fn=get_height_fn,
+                get_heights_fn=get_heights_fn
             )
             
             if tendroid_data:
                 tendroids.append(tendroid_data)
             else:
-                positions.pop()  # Remove failed position
+                placed -= 1  # Remove failed position
                 carb.log_warn(f"[V2TendroidFactory] Failed to create tendroid {i}")
         
         carb.log_info(
@@ -171,28 +178,30 @@ class V2TendroidFactory:
         x: float,
         z: float,
         base_radius: float,
-        existing_positions: list,
+        existing_positions,
         spacing_multiplier: float
     ) -> bool:
         """
         Check if position interferes with existing tendroids.
         
+        Vectorized over all placed tendroids, so large batches avoid an
+        O(n) Python loop per placement attempt.
+        
         Args:
             x, z: Position to check
             base_radius: Flared base radius
-            existing_positions: List of (x, z, base_radius)
+            existing_positions: [M, 3] array (or list) of (x, z, base_radius)
             spacing_multiplier: Extra spacing factor
         
         Returns:
             True if position is valid (no interference)
         """
-        for ex, ez, existing_radius in existing_positions:
-            dx = x - ex
-            dz = z - ez
-            distance = math.sqrt(dx * dx + dz * dz)
-            min_separation = spacing_multiplier * (base_radius + existing_radius)
-            
-            if distance < min_separation:
-                return False
+        existing = np.asarray(existing_positions, dtype=np.float64).reshape(-1, 3)
+        if existing.shape[0] == 0:
+            return True
+        
+        dx = x - existing[:, 0]
+        dz = z - existing[:, 1]
+        min_separation = spacing_multiplier * (base_radius + existing[:, 2])
         
-        return True
+        return bool(np.all(dx * dx + dz * dz >= min_separation * min_separation))
@@ -20,11 +20,25 @@ class BubbleControls:
         bubble_manager: V2BubbleManager to bind (can be set later)
     """
     self.bubble_manager = bubble_manager
+    self.update_fn = None  # Callable(**values), e.g. V2SceneManager.update_bubble_params
 
   def set_bubble_manager(self, bubble_manager):
     """Bind to a bubble manager for live updates."""
     self.bubble_manager = bubble_manager
 
+  def set_update_fn(self, update_fn):
+    """Route changes through a live-update call (patches GPU bubble state)."""
+    self.update_fn = update_fn
+
+  def _apply(self, key: str, value: float):
+    """Apply one parameter change live, or to the bound config."""
+    if self.update_fn:
+      self.update_fn(**{key: value})
+      return
+    cfg = self._get_config()
+    if cfg:
+      setattr(cfg, key, value)
+
   def _get_config(self):
     """Get config from bubble manager or return None."""
     if self.bubble_manager:
@@ -88,36 +102,24 @@ class BubbleControls:
 
   def _on_rise_speed_changed(self, value: float):
     """Handle rise speed change."""
-    cfg = self._get_config()
-    if cfg:
-      cfg.rise_speed = value
+    self._apply("rise_speed", value)
 
   def _on_released_speed_changed(self, value: float):
     """Handle released rise speed change."""
-    cfg = self._get_config()
-    if cfg:
-      cfg.released_rise_speed = value
+    self._apply("released_rise_speed", value)
 
   def _on_diameter_mult_changed(self, value: float):
     """Handle diameter multiplier change."""
-    cfg = self._get_config()
-    if cfg:
-      cfg.diameter_multiplier = value
+    self._apply("diameter_multiplier", value)
 
   def _on_min_pop_changed(self, value: float):
     """Handle min pop height change."""
-    cfg = self._get_config()
-    if cfg:
-      cfg.min_pop_height = value
+    self._apply("min_pop_height", value)
 
   def _on_max_pop_changed(self, value: float):
     """Handle max pop height change."""
-    cfg = self._get_config()
-    if cfg:
-      cfg.max_pop_height = value
+    self._apply("max_pop_height", value)
 
   def _on_respawn_delay_changed(self, value: float):
     """Handle respawn delay change."""
-    cfg = self._get_config()
-    if cfg:
-      cfg.respawn_delay = value
+    self._apply("respawn_delay", value)
@@ -37,6 +37,7 @@ class V2ControlPanel:
         self.spawn_controls = SpawnControls()
         self.wave_controls = WaveControls()
         self.bubble_controls = BubbleControls()
+        self.bubble_controls.set_update_fn(self.scene_manager.update_bubble_params)
         self.creature_controls = CreatureControls()
         self.action_buttons = ActionButtons(
             self.scene_manager,
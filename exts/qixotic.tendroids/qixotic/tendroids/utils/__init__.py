@@ -2,7 +2,9 @@
 V2 Utils - Helper functions and utilities
 """
 
-from .material_helper import apply_material
+from .material_helper import apply_material, apply_display_color_material
 from .fabric_helper import FabricHelper
+from .slot_arena import RangeAllocator, SlotTable
+from .frame_profiler import FrameProfiler
 
-__all__ = ["apply_material", "FabricHelper"]
+__all__ = ["apply_material", "apply_display_color_material", "FabricHelper", "RangeAllocator", "SlotTable", "FrameProfiler"]
@@ -19,6 +19,12 @@ class FabricHelper:
     _cached_stage = None
     _cached_stage_id = None
     
+    # Custom Fabric attribute identifying a mesh's slot in the batch deformer
+    BATCH_INDEX_ATTR = "tendroidBatchIndex"
+    
+    # Custom Fabric attribute identifying a mesh's slot in BatchedColorEffects
+    COLOR_INDEX_ATTR = "tendroidColorIndex"
+    
     @staticmethod
     def get_usdrt_stage(stage_id):
         """
@@ -91,6 +97,25 @@ class FabricHelper:
         Returns:
             usdrt.UsdAttribute for points, or None if failed
         """
+        return FabricHelper._get_mesh_attribute(usdrt_stage, mesh_path, "points")
+    
+    @staticmethod
+    def get_fabric_normals_attribute(usdrt_stage, mesh_path):
+        """
+        Get Fabric-backed normals attribute for mesh.
+        
+        Args:
+            usdrt_stage: USDRT stage handle
+            mesh_path: Prim path to mesh
+        
+        Returns:
+            usdrt.UsdAttribute for normals, or None if failed
+        """
+        return FabricHelper._get_mesh_attribute(usdrt_stage, mesh_path, "normals")
+    
+    @staticmethod
+    def _get_mesh_attribute(usdrt_stage, mesh_path, name: str):
+        """Fabric attribute of a mesh prim, logging what is missing."""
         from usdrt import Sdf
         
         try:
@@ -101,22 +126,222 @@ class FabricHelper:
                 )
                 return None
             
-            points_attr = prim.GetAttribute("points")
-            if not points_attr:
+            attr = prim.GetAttribute(name)
+            if not attr:
                 carb.log_error(
-                    f"[FabricHelper] Points attribute not found: {mesh_path}"
+                    f"[FabricHelper] {name.capitalize()} attribute not found: {mesh_path}"
                 )
                 return None
             
-            return points_attr
+            return attr
+            
+        except Exception as e:
+            carb.log_error(
+                f"[FabricHelper] Failed to get {name} attribute for "
+                f"{mesh_path}: {e}"
+            )
+            return None
+    
+    @staticmethod
+    def tag_batch_index(usdrt_stage, mesh_path, index: int) -> bool:
+        """
+        Tag a Fabric mesh with its batch deformer slot.
+        
+        The tag lets a single Fabric selection be mapped back to
+        tendroid indices on the GPU without any path lookups.
+        
+        Args:
+            usdrt_stage: USDRT stage handle
+            mesh_path: Prim path to mesh
+            index: Tendroid index in the batch
+        
+        Returns:
+            True if the tag was written
+        """
+        from usdrt import Sdf
+        
+        try:
+            prim = usdrt_stage.GetPrimAtPath(Sdf.Path(mesh_path))
+            if not prim:
+                return False
+            
+            attr = prim.CreateAttribute(
+                FabricHelper.BATCH_INDEX_ATTR, Sdf.ValueTypeNames.Int, True
+            )
+            attr.Set(index)
+            return True
             
         except Exception as e:
             carb.log_error(
-                f"[FabricHelper] Failed to get points attribute for "
+                f"[FabricHelper] Failed to tag batch index for "
                 f"{mesh_path}: {e}"
             )
+            return False
+    
+    @staticmethod
+    def select_batch_meshes(usdrt_stage, device: str = "cuda:0", with_normals: bool = False):
+        """
+        Select all batch-tagged meshes with writable points on a device.
+        
+        Args:
+            usdrt_stage: USDRT stage handle
+            device: Device the points buffers should live on
+            with_normals: Also require writable vertex normals
+        
+        Returns:
+            usdrt selection, or None if no tagged meshes are in Fabric
+        """
+        from usdrt import Sdf, Usd
+        
+        try:
+            require_attrs = [
+                (Sdf.ValueTypeNames.Point3fArray, "points", Usd.Access.ReadWrite),
+                (Sdf.ValueTypeNames.Int, FabricHelper.BATCH_INDEX_ATTR, Usd.Access.Read),
+            ]
+            if with_normals:
+                require_attrs.append(
+                    (Sdf.ValueTypeNames.Normal3fArray, "normals", Usd.Access.ReadWrite)
+                )
+            selection = usdrt_stage.SelectPrims(
+                require_attrs=require_attrs,
+                device=device
+            )
+            if selection.GetCount() == 0:
+                return None
+            return selection
+            
+        except Exception as e:
+            carb.log_error(f"[FabricHelper] Batch mesh selection failed: {e}")
             return None
     
+    @staticmethod
+    def tag_color_index(usdrt_stage, mesh_path, index: int) -> bool:
+        """
+        Tag a Fabric mesh with its BatchedColorEffects slot.
+        
+        Args:
+            usdrt_stage: USDRT stage handle
+            mesh_path: Prim path to mesh
+            index: Instance index in the color batch
+        
+        Returns:
+            True if the tag was written
+        """
+        from usdrt import Sdf
+        
+        try:
+            prim = usdrt_stage.GetPrimAtPath(Sdf.Path(mesh_path))
+            if not prim:
+                return False
+            
+            attr = prim.CreateAttribute(
+                FabricHelper.COLOR_INDEX_ATTR, Sdf.ValueTypeNames.Int, True
+            )
+            attr.Set(index)
+            return True
+            
+        except Exception as e:
+            carb.log_error(
+                f"[FabricHelper] Failed to tag color index for "
+                f"{mesh_path}: {e}"
+            )
+            return False
+    
+    @staticmethod
+    def select_color_meshes(usdrt_stage, device: str = "cuda:0"):
+        """
+        Select all color-tagged meshes with a writable displayColor.
+        
+        Args:
+            usdrt_stage: USDRT stage handle
+            device: Device the displayColor buffers should live on
+        
+        Returns:
+            usdrt selection, or None if no tagged meshes are in Fabric
+        """
+        from usdrt import Sdf, Usd
+        
+        try:
+            selection = usdrt_stage.SelectPrims(
+                require_attrs=[
+                    (Sdf.ValueTypeNames.Color3fArray, "primvars:displayColor", Usd.Access.ReadWrite),
+                    (Sdf.ValueTypeNames.Int, FabricHelper.COLOR_INDEX_ATTR, Usd.Access.Read),
+                ],
+                device=device
+            )
+            if selection.GetCount() == 0:
+                return None
+            return selection
+            
+        except Exception as e:
+            carb.log_error(f"[FabricHelper] Color mesh selection failed: {e}")
+            return None
+    
+    @staticmethod
+    def tag_instancer(usdrt_stage, instancer_path, tag_attr: str) -> bool:
+        """
+        Tag a PointInstancer in Fabric so it can be selected on its own.
+
+        Each GPU-driven instancer uses its own tag attribute name, since
+        a Fabric selection matches on attribute presence, not value.
+
+        Args:
+            usdrt_stage: USDRT stage handle
+            instancer_path: Prim path to the PointInstancer
+            tag_attr: Tag attribute name unique to this instancer
+
+        Returns:
+            True if the tag was written
+        """
+        from usdrt import Sdf
+
+        try:
+            prim = usdrt_stage.GetPrimAtPath(Sdf.Path(instancer_path))
+            if not prim:
+                return False
+
+            attr = prim.CreateAttribute(tag_attr, Sdf.ValueTypeNames.Int, True)
+            attr.Set(1)
+            return True
+
+        except Exception as e:
+            carb.log_error(
+                f"[FabricHelper] Failed to tag instancer {instancer_path}: {e}"
+            )
+            return False
+
+    @staticmethod
+    def select_instancer(usdrt_stage, tag_attr: str, device: str = "cuda:0"):
+        """
+        Select a tagged PointInstancer with writable positions and scales.
+
+        Args:
+            usdrt_stage: USDRT stage handle
+            tag_attr: Tag attribute written by tag_instancer()
+            device: Device the instance buffers should live on
+
+        Returns:
+            usdrt selection with exactly one prim, or None
+        """
+        from usdrt import Sdf, Usd
+
+        try:
+            selection = usdrt_stage.SelectPrims(
+                require_attrs=[
+                    (Sdf.ValueTypeNames.Point3fArray, "positions", Usd.Access.ReadWrite),
+                    (Sdf.ValueTypeNames.Float3Array, "scales", Usd.Access.ReadWrite),
+                    (Sdf.ValueTypeNames.Int, tag_attr, Usd.Access.Read),
+                ],
+                device=device
+            )
+            if selection.GetCount() != 1:
+                return None
+            return selection
+
+        except Exception as e:
+            carb.log_error(f"[FabricHelper] Instancer selection failed: {e}")
+            return None
+
     @staticmethod
     def clear_cache():
         """Clear cached stage handle (call on stage changes)."""
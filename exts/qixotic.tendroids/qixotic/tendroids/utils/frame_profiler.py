@@ -0,0 +1,277 @@
+"""
+Per-stage frame profiler
+
+Named scoped stages record host time (perf_counter) and, on a CUDA
+device, device time between two timing events on the current stream.
+Device timings are resolved a few frames later so timing never adds a
+sync to the frame being measured.
+
+Results live in a fixed-size ring buffer (one row per frame, one column
+per stage) and are reduced to percentiles on request. They can be
+exported as a Chrome trace (chrome://tracing, Perfetto) or published
+to carb settings for live display.
+"""
+
+import json
+import time
+from contextlib import contextmanager
+
+import carb
+import numpy as np
+
+# Columns in the ring buffer (stage names beyond this are ignored)
+MAX_STAGES = 32
+
+# Frames to wait before reading a frame's device events
+DEVICE_RESOLVE_LAG = 3
+
+PERCENTILES = (50, 95, 99)
+
+
+class FrameProfiler:
+    """
+    Ring-buffered host + device stage timings.
+
+    Usage:
+        profiler = FrameProfiler(device="cuda:0")
+
+        profiler.begin_frame()
+        with profiler.stage("batch_deform"):
+            ...
+        profiler.end_frame()
+
+        profiler.get_profile_data()
+        profiler.export_chrome_trace("frame_trace.json")
+    """
+
+    def __init__(self, capacity: int = 600, device: str = None):
+        """
+        Args:
+            capacity: Frames kept in the ring buffer
+            device: Warp CUDA device for event timing (host only if None)
+        """
+        self.capacity = int(capacity)
+        self.device = device if device and device.startswith("cuda") else None
+
+        self.stage_names = []
+        self._stage_index = {}
+
+        # [frame, stage] milliseconds; NaN = stage did not run
+        self._host_ms = np.full((self.capacity, MAX_STAGES), np.nan)
+        self._device_ms = np.full((self.capacity, MAX_STAGES), np.nan)
+        self._host_start_ms = np.full((self.capacity, MAX_STAGES), np.nan)
+        self._frame_ids = np.full(self.capacity, -1, dtype=np.int64)
+        self._frame_start_ms = np.zeros(self.capacity)
+
+        self._frame = -1
+        self._row = -1
+        self._frame_origin = 0.0
+        self._epoch = time.perf_counter()
+
+        self._event_pool = []
+        self._pending = []  # (frame, row, column, start_event, end_event)
+
+    def begin_frame(self):
+        """Start a new ring buffer row."""
+        self._frame += 1
+        self._row = self._frame % self.capacity
+        self._host_ms[self._row] = np.nan
+        self._device_ms[self._row] = np.nan
+        self._host_start_ms[self._row] = np.nan
+        self._frame_ids[self._row] = self._frame
+        self._frame_origin = time.perf_counter()
+        self._frame_start_ms[self._row] = (self._frame_origin - self._epoch) * 1000.0
+
+    def end_frame(self):
+        """Resolve device timings of frames that are old enough."""
+        if self._pending:
+            self._resolve_device(self._frame - DEVICE_RESOLVE_LAG)
+
+    @contextmanager
+    def stage(self, name: str):
+        """
+        Time a named stage of the current frame.
+
+        Device time covers the work enqueued on the device's current
+        stream inside the block.
+        """
+        column = self._column(name)
+        if column is None or self._row < 0:
+            yield
+            return
+
+        start_event = self._record_event() if self.device else None
+        t0 = time.perf_counter()
+        try:
+            yield
+        finally:
+            t1 = time.perf_counter()
+            row = self._row
+            # Repeated stages in one frame accumulate (trace start = first run)
+            if np.isnan(self._host_start_ms[row, column]):
+                self._host_start_ms[row, column] = (t0 - self._frame_origin) * 1000.0
+            previous = self._host_ms[row, column]
+            elapsed = (t1 - t0) * 1000.0
+            self._host_ms[row, column] = elapsed if np.isnan(previous) else previous + elapsed
+            if start_event is not None:
+                self._pending.append((self._frame, row, column, start_event, self._record_event()))
+
+    def _column(self, name: str):
+        column = self._stage_index.get(name)
+        if column is None:
+            if len(self.stage_names) >= MAX_STAGES:
+                return None
+            column = len(self.stage_names)
+            self._stage_index[name] = column
+            self.stage_names.append(name)
+        return column
+
+    def _record_event(self):
+        import warp as wp
+
+        event = self._event_pool.pop() if self._event_pool else wp.Event(self.device, enable_timing=True)
+        wp.get_stream(self.device).record_event(event)
+        return event
+
+    def _resolve_device(self, up_to_frame: int):
+        """Read elapsed times for pending frames <= up_to_frame."""
+        import warp as wp
+
+        remaining = []
+        for entry in self._pending:
+            frame, row, column, start_event, end_event = entry
+            if frame > up_to_frame:
+                remaining.append(entry)
+                continue
+            # Row may have been reused if the buffer wrapped
+            if self._frame_ids[row] == frame:
+                elapsed = wp.get_event_elapsed_time(start_event, end_event)
+                previous = self._device_ms[row, column]
+                self._device_ms[row, column] = elapsed if np.isnan(previous) else previous + elapsed
+            self._event_pool.extend((start_event, end_event))
+        self._pending = remaining
+
+    def flush(self):
+        """Resolve every pending device timing (synchronizes)."""
+        if self._pending:
+            self._resolve_device(self._frame)
+
+    def _valid_rows(self) -> np.ndarray:
+        return np.nonzero(self._frame_ids >= 0)[0]
+
+    @staticmethod
+    def _summarize(values: np.ndarray) -> dict:
+        values = values[~np.isnan(values)]
+        if values.size == 0:
+            return None
+        summary = {'mean': float(values.mean()), 'max': float(values.max())}
+        for p, v in zip(PERCENTILES, np.percentile(values, PERCENTILES)):
+            summary[f'p{p}'] = float(v)
+        return summary
+
+    def get_profile_data(self) -> dict:
+        """
+        Percentiles per stage over the ring buffer.
+
+        Returns:
+            {'frames': n, 'stages': {name: {'host_ms': {...},
+             'device_ms': {...} or None, 'count': runs}}}
+        """
+        self.flush()
+        rows = self._valid_rows()
+        stages = {}
+        for column, name in enumerate(self.stage_names):
+            host = self._host_ms[rows, column]
+            stages[name] = {
+                'host_ms': self._summarize(host),
+                'device_ms': self._summarize(self._device_ms[rows, column]),
+                'count': int(np.count_nonzero(~np.isnan(host))),
+            }
+        return {'frames': int(rows.size), 'stages': stages}
+
+    def export_chrome_trace(self, path: str) -> bool:
+        """
+        Write buffered frames as Chrome trace events.
+
+        Host stages go on thread 0. Device durations go on thread 1 and
+        are placed at their host start, because event timings carry no
+        absolute GPU timestamp.
+
+        Returns:
+            True if written
+        """
+        self.flush()
+        events = []
+        for row in sorted(self._valid_rows(), key=lambda r: self._frame_ids[r]):
+            frame_us = self._frame_start_ms[row] * 1000.0
+            for column, name in enumerate(self.stage_names):
+                start = self._host_start_ms[row, column]
+                if np.isnan(start):
+                    continue
+                ts = frame_us + start * 1000.0
+                args = {'frame': int(self._frame_ids[row])}
+                events.append({
+                    'name': name, 'cat': 'host', 'ph': 'X', 'pid': 0, 'tid': 0,
+                    'ts': ts, 'dur': float(self._host_ms[row, column]) * 1000.0, 'args': args,
+                })
+                device = self._device_ms[row, column]
+                if not np.isnan(device):
+                    events.append({
+                        'name': name, 'cat': 'device', 'ph': 'X', 'pid': 0, 'tid': 1,
+                        'ts': ts, 'dur': float(device) * 1000.0, 'args': args,
+                    })
+
+        trace = {
+            'traceEvents': events,
+            'displayTimeUnit': 'ms',
+            'otherData': {'source': 'qixotic.tendroids FrameProfiler'},
+        }
+        try:
+            with open(path, 'w') as f:
+                json.dump(trace, f)
+            carb.log_info(f"[FrameProfiler] Wrote {len(events)} trace events to {path}")
+            return True
+        except OSError as e:
+            carb.log_error(f"[FrameProfiler] Trace export failed: {e}")
+            return False
+
+    def publish_stats(self, prefix: str = "/exts/qixotic.tendroids/profile"):
+        """
+        Publish p50 / p95 per stage to carb settings (<prefix>/<stage>/...).
+
+        Settings can be watched from UI widgets or read by external tools.
+        """
+        import carb.settings
+
+        settings = carb.settings.get_settings()
+        for name, stage in self.get_profile_data()['stages'].items():
+            for kind in ('host_ms', 'device_ms'):
+                summary = stage[kind]
+                if summary is None:
+                    continue
+                for key in ('p50', 'p95'):
+                    settings.set_float(f"{prefix}/{name}/{kind}/{key}", summary[key])
+
+    def log_summary(self):
+        """Log a per-stage percentile table."""
+        data = self.get_profile_data()
+        carb.log_info(f"[PROFILE] Stages over {data['frames']} frames (ms: p50 / p95 / p99)")
+        for name, stage in data['stages'].items():
+            host = stage['host_ms']
+            if host is None:
+                continue
+            line = f"  {name:<20} host {host['p50']:.3f} / {host['p95']:.3f} / {host['p99']:.3f}"
+            device = stage['device_ms']
+            if device is not None:
+                line += f"  device {device['p50']:.3f} / {device['p95']:.3f} / {device['p99']:.3f}"
+            carb.log_info(line)
+
+    def reset(self):
+        """Drop all samples (keeps stage names and the event pool)."""
+        self.flush()
+        self._host_ms[:] = np.nan
+        self._device_ms[:] = np.nan
+        self._host_start_ms[:] = np.nan
+        self._frame_ids[:] = -1
+        self._frame = -1
+        self._row = -1
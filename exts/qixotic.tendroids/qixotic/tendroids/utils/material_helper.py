@@ -54,3 +54,57 @@ def _get_or_create_tendroid_material(stage) -> UsdShade.Material:
     
     carb.log_info(f"[V2Material] Created tendroid material: {mat_path}")
     return material
+
+
+def apply_display_color_material(stage, mesh_prim):
+    """
+    Apply the shared material that shades each mesh by its displayColor.
+    
+    One material serves every tendroid; per-instance color comes from
+    the mesh's displayColor primvar (see BatchedColorEffects).
+    
+    Args:
+        stage: USD stage
+        mesh_prim: The mesh prim to apply material to
+    """
+    material = _get_or_create_display_color_material(stage)
+    UsdShade.MaterialBindingAPI(mesh_prim).Bind(material)
+
+
+def _get_or_create_display_color_material(stage) -> UsdShade.Material:
+    """Get existing displayColor-driven material or create it."""
+    mat_path = "/World/Looks/V2_Tendroid_DisplayColor_Mat"
+    
+    mat_prim = stage.GetPrimAtPath(mat_path)
+    if mat_prim.IsValid():
+        return UsdShade.Material(mat_prim)
+    
+    looks_path = "/World/Looks"
+    if not stage.GetPrimAtPath(looks_path).IsValid():
+        UsdGeom.Scope.Define(stage, looks_path)
+    
+    material = UsdShade.Material.Define(stage, mat_path)
+    
+    # Primvar reader feeding diffuseColor
+    reader = UsdShade.Shader.Define(stage, f"{mat_path}/DisplayColorReader")
+    reader.CreateIdAttr("UsdPrimvarReader_float3")
+    reader.CreateInput("varname", Sdf.ValueTypeNames.Token).Set("displayColor")
+    reader.CreateInput("fallback", Sdf.ValueTypeNames.Float3).Set(
+        Gf.Vec3f(0.9, 0.4, 0.5)
+    )
+    reader_output = reader.CreateOutput("result", Sdf.ValueTypeNames.Float3)
+    
+    shader = UsdShade.Shader.Define(stage, f"{mat_path}/Shader")
+    shader.CreateIdAttr("UsdPreviewSurface")
+    shader.CreateInput("diffuseColor", Sdf.ValueTypeNames.Color3f).ConnectToSource(
+        reader_output
+    )
+    shader.CreateInput("roughness", Sdf.ValueTypeNames.Float).Set(0.4)
+    shader.CreateInput("metallic", Sdf.ValueTypeNames.Float).Set(0.1)
+    
+    material.CreateSurfaceOutput().ConnectToSource(
+        shader.ConnectableAPI(), "surface"
+    )
+    
+    carb.log_info(f"[V2Material] Created displayColor material: {mat_path}")
+    return material
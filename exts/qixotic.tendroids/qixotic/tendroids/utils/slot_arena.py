@@ -0,0 +1,172 @@
+"""
+Slot and range allocation for live tendroid add/remove
+
+SlotTable hands out stable per-tendroid slot indices (lowest free slot
+first). Sharing one table between BatchWarpDeformer, BubblePhysicsAdapter
+and BatchDeflectionManager keeps deformer slot == bubble id ==
+deflection index, so a tendroid's state can be written in place.
+
+RangeAllocator places variable-size vertex ranges in a growable arena
+with first-fit reuse of freed ranges, so inserting or removing one
+tendroid only touches that tendroid's vertices.
+
+Pure Python - device arrays are (re)allocated by the owning manager
+when capacity grows.
+"""
+
+import bisect
+import heapq
+
+
+class SlotTable:
+    """
+    Name -> slot index with freed-slot reuse.
+
+    capacity is the high-water slot count (per-tendroid array length);
+    freed slots below it are reused before it grows.
+    """
+
+    def __init__(self):
+        self._name_to_slot = {}
+        self._slot_names = []  # slot -> name (None = free)
+        self._free = []  # min-heap of released slots
+
+    def acquire(self, name: str) -> int:
+        """Slot for name, allocating one if it is new (idempotent)."""
+        slot = self._name_to_slot.get(name)
+        if slot is not None:
+            return slot
+
+        if self._free:
+            slot = heapq.heappop(self._free)
+            self._slot_names[slot] = name
+        else:
+            slot = len(self._slot_names)
+            self._slot_names.append(name)
+
+        self._name_to_slot[name] = slot
+        return slot
+
+    def release(self, name: str):
+        """Free name's slot; returns it, or None if name is unknown."""
+        slot = self._name_to_slot.pop(name, None)
+        if slot is None:
+            return None
+        self._slot_names[slot] = None
+        heapq.heappush(self._free, slot)
+        return slot
+
+    def slot_of(self, name: str):
+        """Slot for name, or None."""
+        return self._name_to_slot.get(name)
+
+    def name_of(self, slot: int):
+        """Name in slot, or None if free / out of range."""
+        if 0 <= slot < len(self._slot_names):
+            return self._slot_names[slot]
+        return None
+
+    def items(self):
+        """(name, slot) pairs for every occupied slot."""
+        return self._name_to_slot.items()
+
+    def clear(self):
+        """Release every slot and reset capacity."""
+        self._name_to_slot.clear()
+        self._slot_names.clear()
+        self._free.clear()
+
+    @property
+    def capacity(self) -> int:
+        """Slots ever handed out (occupied + free)."""
+        return len(self._slot_names)
+
+    def __len__(self) -> int:
+        return len(self._name_to_slot)
+
+    def __contains__(self, name) -> bool:
+        return name in self._name_to_slot
+
+
+class RangeAllocator:
+    """
+    First-fit allocator of contiguous [start, start + size) ranges.
+
+    extent is the end of the highest live range (kernel launch size);
+    capacity doubles whenever an allocation would pass it.
+    """
+
+    def __init__(self, capacity: int = 0):
+        self.capacity = max(0, capacity)
+        self.extent = 0
+        self._free_starts = []  # sorted
+        self._free_sizes = {}  # start -> size
+
+    def allocate(self, size: int) -> int:
+        """
+        Reserve size slots; returns the start.
+
+        Reuses the first freed range that fits, otherwise appends at
+        extent (growing capacity). Check capacity afterwards to see
+        whether backing arrays must grow.
+        """
+        if size <= 0:
+            return self.extent
+
+        for i, start in enumerate(self._free_starts):
+            free_size = self._free_sizes[start]
+            if free_size < size:
+                continue
+            del self._free_starts[i]
+            del self._free_sizes[start]
+            if free_size > size:
+                self._insert_free(start + size, free_size - size)
+            return start
+
+        start = self.extent
+        self.extent += size
+        if self.extent > self.capacity:
+            capacity = max(self.capacity, 1)
+            while capacity < self.extent:
+                capacity *= 2
+            self.capacity = capacity
+        return start
+
+    def free(self, start: int, size: int):
+        """Return a range; merges neighbours and trims the extent."""
+        if size <= 0:
+            return
+
+        i = bisect.bisect_left(self._free_starts, start)
+
+        # Merge with the following free range
+        if i < len(self._free_starts) and self._free_starts[i] == start + size:
+            size += self._free_sizes.pop(self._free_starts[i])
+            del self._free_starts[i]
+
+        # Merge with the preceding free range
+        if i > 0:
+            prev = self._free_starts[i - 1]
+            if prev + self._free_sizes[prev] == start:
+                size += self._free_sizes.pop(prev)
+                del self._free_starts[i - 1]
+                start = prev
+
+        if start + size >= self.extent:
+            self.extent = start
+        else:
+            self._insert_free(start, size)
+
+    def _insert_free(self, start: int, size: int):
+        bisect.insort(self._free_starts, start)
+        self._free_sizes[start] = size
+
+    def free_ranges(self) -> list:
+        """Sorted (start, size) free ranges below extent."""
+        return [(s, self._free_sizes[s]) for s in self._free_starts]
+
+    def clear(self):
+        """Drop every range (capacity is kept)."""
+        self.extent = 0
+        self._free_starts.clear()
+        self._free_sizes.clear()
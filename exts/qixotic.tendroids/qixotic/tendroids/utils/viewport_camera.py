@@ -0,0 +1,45 @@
+"""
+Active viewport camera access
+
+Returns the active viewport camera's view-projection matrix and
+position for FrustumCuller. Kept out of the culler so the kernel
+module does not depend on Kit viewport APIs.
+"""
+
+import carb
+
+
+def get_active_camera_view(stage=None):
+    """
+    Active viewport camera as (view_projection, position).
+
+    Args:
+        stage: USD stage (defaults to the current context stage)
+
+    Returns:
+        (Gf.Matrix4d, (x, y, z)), or (None, None) if no viewport camera
+        is available (headless, camera prim missing)
+    """
+    try:
+        import omni.usd
+        from omni.kit.viewport.utility import get_active_viewport
+        from pxr import Usd, UsdGeom
+
+        viewport = get_active_viewport()
+        if viewport is None:
+            return None, None
+
+        if stage is None:
+            stage = omni.usd.get_context().get_stage()
+        prim = stage.GetPrimAtPath(viewport.camera_path) if stage else None
+        if not prim or not prim.IsValid():
+            return None, None
+
+        # GfCamera includes the camera prim's world transform
+        frustum = UsdGeom.Camera(prim).GetCamera(Usd.TimeCode.Default()).frustum
+        view_projection = frustum.ComputeViewMatrix() * frustum.ComputeProjectionMatrix()
+        position = frustum.GetPosition()
+        return view_projection, (position[0], position[1], position[2])
+    except Exception as e:
+        carb.log_verbose(f"[viewport_camera] No active camera: {e}")
+        return None, None
@@ -16,6 +16,12 @@ Usage:
     
     # Run with coverage
     python run_tests.py --cov
+    
+    # Run scaling benchmarks (CUDA) against stored baselines
+    python run_tests.py --bench
+    
+    # Record this GPU's benchmark baselines
+    python run_tests.py --bench --update-baselines
 """
 
 import sys
@@ -57,6 +63,11 @@ def main():
     # Get any command line args (skip script name)
     args = sys.argv[1:] if len(sys.argv) > 1 else ["-v"]
     
+    # --bench: only the benchmark suite, with opt-in enabled
+    if "--bench" in args:
+        args = [a for a in args if a != "--bench"]
+        args = ["tests/test_benchmarks.py", "--run-benchmarks"] + (args or ["-v"])
+    
     exit_code = run_tests(args)
     
     print("=" * 60)
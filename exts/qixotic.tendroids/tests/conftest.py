@@ -7,7 +7,7 @@ Mocks Omniverse modules to allow testing outside the runtime.
 
 import sys
 from pathlib import Path
-from types import ModuleType
+from types import ModuleType, SimpleNamespace
 from unittest.mock import MagicMock
 
 import pytest
@@ -161,6 +161,156 @@ def pytest_configure(config):
   config.addinivalue_line(
     "markers", "gpu: marks tests requiring GPU/CUDA"
   )
+  config.addinivalue_line(
+    "markers", "requires_cuda(devices=1): skip unless Warp sees that many CUDA devices"
+  )
+  config.addinivalue_line(
+    "markers", "benchmark: marks scaling benchmarks (run with --run-benchmarks)"
+  )
+  config.benchmark_results = []
+
+
+def pytest_addoption(parser):
+  """Benchmark options (see tests/test_benchmarks.py)."""
+  group = parser.getgroup("tendroids benchmarks")
+  group.addoption(
+    "--run-benchmarks", action="store_true", default=False,
+    help="run @pytest.mark.benchmark scaling sweeps",
+  )
+  group.addoption(
+    "--update-baselines", action="store_true", default=False,
+    help="record measured throughput as the device's new baselines",
+  )
+  group.addoption(
+    "--benchmark-tolerance", type=float, default=None,
+    help="allowed fractional drop below baseline (default: from baseline file)",
+  )
+
+
+def pytest_collection_modifyitems(config, items):
+  """Skip CUDA tests without enough devices, and benchmarks unless requested."""
+  for item in items:
+    marker = item.get_closest_marker("requires_cuda")
+    if marker is None:
+      continue
+    devices = marker.kwargs.get("devices", 1)
+    if cuda_device_count() < devices:
+      reason = "requires CUDA" if devices == 1 else f"requires {devices} CUDA devices"
+      item.add_marker(pytest.mark.skip(reason=reason))
+
+  if config.getoption("--run-benchmarks") or config.getoption("--update-baselines"):
+    return
+  skip = pytest.mark.skip(reason="benchmark (use --run-benchmarks)")
+  for item in items:
+    if "benchmark" in item.keywords:
+      item.add_marker(skip)
+
+
+def pytest_terminal_summary(terminalreporter, exitstatus, config):
+  """Throughput table for benchmarks that ran."""
+  results = getattr(config, "benchmark_results", None)
+  if not results:
+    return
+  terminalreporter.section("tendroids benchmarks")
+  for r in results:
+    missing = "-" if config.getoption("--update-baselines") else "MISSING"
+    baseline = f"{r['baseline']:.3g}" if r['baseline'] else missing
+    terminalreporter.write_line(
+      f"{r['name']:<44} {r['throughput']:>11.3g} {r['unit']:<14}"
+      f" baseline {baseline:>9}  {r['ms']:.3f} ms/iter"
+    )
+
+
+# =============================================================================
+# GPU
+# =============================================================================
+
+_cuda_devices = None
+
+
+def cuda_device_count() -> int:
+  """CUDA devices Warp can see (0 without Warp or CUDA); probed once."""
+  global _cuda_devices
+  if _cuda_devices is None:
+    try:
+      import warp as wp
+      wp.init()
+      _cuda_devices = wp.get_cuda_device_count()
+    except Exception:
+      _cuda_devices = 0
+  return _cuda_devices
+
+
+@pytest.fixture(params=["cpu", pytest.param("cuda:0", marks=pytest.mark.requires_cuda)])
+def device(request):
+  """Warp device to run on: "cpu" always, "cuda:0" when CUDA is available."""
+  pytest.importorskip("warp")
+  return request.param
+
+
+@pytest.fixture
+def batch_deformer():
+  """
+  Factory for a built BatchWarpDeformer over builder cylinders.
+
+  Tendroid i is named t{i} and stands at positions[i] (default (i, 0, 0)).
+  Keyword arguments not listed go to BatchWarpDeformer (device,
+  active_set, procedural, analytic_normals, cpu_threads, ...).
+
+  Args (of the returned callable):
+      count: Tendroid count (when positions / meshes are not given)
+      positions: Per-tendroid base positions
+      radial, height: Segments; height may be one value per tendroid
+      radius, length, flare_height_percent, flare_radius_multiplier:
+          CylinderGenerator shape
+      max_amplitude, bulge_width: V2WarpDeformer parameters
+      geometry: Register builder geometry (needed for procedural mode)
+      meshes: Explicit (points, geometry) per tendroid instead of
+          generated cylinders; geometry supplies radius and length
+  """
+
+  def _create(
+    count=3, positions=None, radial=8, height=10,
+    radius=2.0, length=40.0, flare_height_percent=15.0, flare_radius_multiplier=2.0,
+    max_amplitude=0.8, bulge_width=0.9, geometry=False, meshes=None, **kwargs
+  ):
+    from qixotic.tendroids.builders.cylinder_generator import CylinderGenerator
+    from qixotic.tendroids.core.batch_warp_deformer import BatchWarpDeformer
+    from qixotic.tendroids.core.warp_deformer import V2WarpDeformer
+
+    if meshes is None:
+      if positions is not None:
+        count = len(positions)
+      heights = height if isinstance(height, (list, tuple)) else [height] * count
+      meshes = []
+      for h in heights:
+        points, _, _, _ = CylinderGenerator.create_cylinder_arrays(
+          radius, length, radial, h, flare_height_percent, flare_radius_multiplier
+        )
+        meshes.append((points, {
+          'radius': radius, 'length': length,
+          'radial_segments': radial, 'height_segments': h,
+          'flare_height_percent': flare_height_percent,
+          'flare_radius_multiplier': flare_radius_multiplier,
+          'flare_height': length * flare_height_percent / 100.0,
+        }))
+    if positions is None:
+      positions = [(float(i), 0.0, 0.0) for i in range(len(meshes))]
+
+    deformer = BatchWarpDeformer(**kwargs)
+    device = kwargs.get("device", "cuda:0")
+    for i, ((points, data), position) in enumerate(zip(meshes, positions)):
+      tendroid = SimpleNamespace(
+        name=f"t{i}", position=position, radius=data['radius'], length=data['length'],
+        deformer=V2WarpDeformer(
+          points, data['radius'], data['length'], max_amplitude, bulge_width, device=device
+        ),
+      )
+      deformer.register_tendroid(tendroid, points, geometry=data if geometry else None)
+    deformer.build()
+    return deformer
+
+  return _create
 
 
 # =============================================================================
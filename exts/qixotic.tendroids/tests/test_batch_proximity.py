@@ -0,0 +1,92 @@
+"""
+Tests for Batched Proximity State Manager
+
+Verifies device state codes, pair index decoding, and (on CUDA)
+parity of the batched kernel with ProximityStateManager.
+
+Run with: python -m pytest tests/test_batch_proximity.py -v
+"""
+
+import math
+
+import pytest
+
+
+class TestStateCodes:
+  """Device state code mapping."""
+
+  def test_round_trip_all_states(self):
+    """Every ProximityState survives code conversion."""
+    from qixotic.tendroids.proximity import ProximityState, state_from_code, state_to_code
+
+    for state in ProximityState:
+      assert state_from_code(state_to_code(state)) == state
+
+  def test_idle_is_zero(self):
+    """Zeroed device buffers start every pair in IDLE."""
+    from qixotic.tendroids.proximity import ProximityState, state_to_code
+
+    assert state_to_code(ProximityState.IDLE) == 0
+
+  def test_codes_are_dense(self):
+    """Codes cover 0..4 with no gaps."""
+    from qixotic.tendroids.proximity import ProximityState, state_to_code
+
+    codes = sorted(state_to_code(s) for s in ProximityState)
+    assert codes == list(range(len(ProximityState)))
+
+
+class TestPairDecoding:
+  """Creature-major pair index decoding."""
+
+  def test_decode_pairs(self):
+    """Flattened index c * T + t decodes to (c, t)."""
+    from qixotic.tendroids.proximity import decode_pair_indices
+
+    assert decode_pair_indices([0, 3, 7, 11], 4) == [(0, 0), (0, 3), (1, 3), (2, 3)]
+
+  def test_decode_empty(self):
+    """No events decode to no pairs."""
+    from qixotic.tendroids.proximity import decode_pair_indices
+
+    assert decode_pair_indices([], 4) == []
+
+
+@pytest.mark.gpu
+@pytest.mark.requires_cuda
+class TestBatchParity:
+  """Batched kernel must match the host state manager."""
+
+  def test_matches_host_manager(self):
+    """Two creatures sweeping past two tendroids produce the same events, in order."""
+    from qixotic.tendroids.proximity import (
+      BatchProximityStateManager,
+      ProximityStateManager,
+    )
+
+    tendroids = [(0.0, 0.0, 0.0), (1.0, 0.0, 0.0)]
+    radii = [0.05, 0.05]
+
+    batch = BatchProximityStateManager()
+    batch.configure_tendroids(tendroids, radii)
+    host = ProximityStateManager()
+
+    for frame in range(60):
+      s = frame / 59.0
+      creatures = [(-0.5 + 2.0 * s, 0.5, 0.02), (0.5, 0.5, 1.0 - 1.0 * s)]
+
+      batch_events = batch.update(creatures)
+
+      host_events = []
+      for c, cp in enumerate(creatures):
+        for t, tp in enumerate(tendroids):
+          dist = math.hypot(cp[0] - tp[0], cp[2] - tp[2]) - radii[t]
+          event = host.update(c, t, dist)
+          if event:
+            host_events.append(event)
+
+      def key(e):
+        return (e.creature_idx, e.tendroid_idx, e.previous_state.value, e.new_state.value)
+
+      # Host loop order is pair order, which the batch events follow
+      assert list(map(key, batch_events)) == list(map(key, host_events))
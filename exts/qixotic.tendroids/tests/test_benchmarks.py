@@ -0,0 +1,307 @@
+"""
+Headless scaling benchmarks for the GPU kernels and managers
+
+Sweeps scene size through BatchWarpDeformer.deform_all, BubbleGPUManager,
+PopParticleGPUManager, the proximity hash grid query and
+BatchDeflectionManager, all outside Kit (conftest mocks carb / omni /
+pxr). Each case reports throughput (items per second of device time
+measured host-side around a synchronize) and fails if it drops more
+than the tolerance below the stored baseline for this GPU.
+
+Baselines live in tests/benchmark_baselines.json, keyed by device name,
+so numbers from different GPUs never compare against each other. A case
+with no baseline for this GPU fails (after reporting its throughput)
+until one is recorded with --update-baselines, so a new device cannot
+silently skip the regression check.
+
+Run with:
+    python -m pytest tests/test_benchmarks.py --run-benchmarks
+    python -m pytest tests/test_benchmarks.py --update-baselines
+"""
+
+import json
+import time
+import types
+from pathlib import Path
+
+import pytest
+
+BASELINE_PATH = Path(__file__).parent / "benchmark_baselines.json"
+
+DEFAULT_TOLERANCE = 0.25
+WARMUP_ITERATIONS = 3
+MIN_ITERATIONS = 10
+MIN_SECONDS = 0.25
+
+DT = 1.0 / 60.0
+
+
+pytestmark = [
+  pytest.mark.benchmark,
+  pytest.mark.gpu,
+  pytest.mark.requires_cuda,
+]
+
+
+# =============================================================================
+# BASELINES
+# =============================================================================
+
+def _load_baselines() -> dict:
+  if not BASELINE_PATH.is_file():
+    return {"tolerance": DEFAULT_TOLERANCE, "devices": {}}
+  with open(BASELINE_PATH) as f:
+    return json.load(f)
+
+
+@pytest.fixture(scope="module")
+def baselines(request):
+  """Stored baselines; rewritten at module end with --update-baselines."""
+  data = _load_baselines()
+  yield data
+  if request.config.getoption("--update-baselines"):
+    with open(BASELINE_PATH, "w") as f:
+      json.dump(data, f, indent=2, sort_keys=True)
+      f.write("\n")
+
+
+@pytest.fixture(scope="module")
+def device_name() -> str:
+  import warp as wp
+  return wp.get_device("cuda:0").name
+
+
+@pytest.fixture
+def bench(request, baselines, device_name):
+  """
+  Time a frame callable and check its throughput.
+
+  Usage:
+      bench("deform_all[t=64]", step, items=vertex_count, unit="vertices/s")
+  """
+  import warp as wp
+
+  config = request.config
+  tolerance = config.getoption("--benchmark-tolerance")
+  if tolerance is None:
+    tolerance = baselines.get("tolerance", DEFAULT_TOLERANCE)
+  device_baselines = baselines.setdefault("devices", {}).setdefault(device_name, {})
+
+  def run(name: str, step, items: int, unit: str) -> float:
+    for _ in range(WARMUP_ITERATIONS):
+      step()
+    wp.synchronize()
+
+    # Batches of iterations until MIN_SECONDS; best batch resists noise
+    best, iterations, elapsed_total = None, 0, 0.0
+    while iterations < MIN_ITERATIONS or elapsed_total < MIN_SECONDS:
+      t0 = time.perf_counter()
+      for _ in range(MIN_ITERATIONS):
+        step()
+      wp.synchronize()
+      elapsed = (time.perf_counter() - t0) / MIN_ITERATIONS
+      best = elapsed if best is None else min(best, elapsed)
+      iterations += MIN_ITERATIONS
+      elapsed_total += elapsed * MIN_ITERATIONS
+
+    throughput = items / best
+    baseline = device_baselines.get(name)
+    config.benchmark_results.append({
+      'name': name, 'throughput': throughput, 'unit': unit,
+      'baseline': baseline, 'ms': best * 1000.0,
+    })
+
+    if config.getoption("--update-baselines"):
+      device_baselines[name] = throughput
+    elif not baseline:
+      pytest.fail(
+        f"{name}: no baseline for {device_name} in {BASELINE_PATH.name} "
+        f"(measured {throughput:.3g} {unit}; record with --update-baselines)",
+        pytrace=False,
+      )
+    else:
+      floor = baseline * (1.0 - tolerance)
+      assert throughput >= floor, (
+        f"{name}: {throughput:.3g} {unit} is below baseline {baseline:.3g} "
+        f"(-{tolerance:.0%} floor {floor:.3g}) on {device_name}"
+      )
+    return throughput
+
+  return run
+
+
+# =============================================================================
+# SCENE HELPERS
+# =============================================================================
+
+def _grid_positions(count: int, spacing: float = 12.0) -> list:
+  """Tendroid bases on a square XZ grid centered on the origin."""
+  side = max(1, int(count ** 0.5 + 0.999))
+  offset = (side - 1) * spacing * 0.5
+  return [
+    ((i % side) * spacing - offset, 0.0, (i // side) * spacing - offset)
+    for i in range(count)
+  ]
+
+
+def _tendroids(count: int) -> list:
+  return [
+    types.SimpleNamespace(name=f"t{i}", position=p, radius=2.0, length=40.0)
+    for i, p in enumerate(_grid_positions(count))
+  ]
+
+
+# =============================================================================
+# BENCHMARKS
+# =============================================================================
+
+@pytest.mark.parametrize("resolution", [(16, 32), (32, 64)])
+@pytest.mark.parametrize("tendroid_count", [16, 128, 512])
+def test_batch_deform(bench, tendroid_count, resolution):
+  """BatchWarpDeformer.deform_all (batch_deform_kernel) vs. tendroids x vertices."""
+  import numpy as np
+  from qixotic.tendroids.builders.cylinder_generator import CylinderGenerator
+  from qixotic.tendroids.core.batch_warp_deformer import BatchWarpDeformer
+  from qixotic.tendroids.core.warp_deformer import V2WarpDeformer
+
+  radial, height = resolution
+  points, _, _, _ = CylinderGenerator.create_cylinder_arrays(2.0, 40.0, radial, height, 15.0, 2.0)
+  deformer = BatchWarpDeformer()
+  for tendroid in _tendroids(tendroid_count):
+    tendroid.deformer = V2WarpDeformer(points, 2.0, 40.0, 0.8, 0.9)
+    deformer.register_tendroid(tendroid, points)
+  deformer.build()
+  assert deformer.is_built
+
+  rng = np.random.default_rng(0)
+  deformer.bubble_y_gpu.assign(rng.uniform(0.0, 40.0, tendroid_count).astype(np.float32))
+  deformer.bubble_radius_gpu.assign(np.full(tendroid_count, 3.0, dtype=np.float32))
+
+  bench(
+    f"deform_all[t={tendroid_count},r={radial}x{height}]",
+    lambda: deformer.deform_all(download=False),
+    items=deformer.total_vertices, unit="vertices/s",
+  )
+
+
+@pytest.mark.parametrize("bubble_count", [256, 4096, 65536])
+def test_bubble_update(bench, bubble_count):
+  """BubbleGPUManager.update_all vs. bubble count."""
+  import numpy as np
+  from qixotic.tendroids.bubbles import BubbleGPUManager
+
+  manager = BubbleGPUManager(max_bubbles=bubble_count, device="cuda:0")
+  rng = np.random.default_rng(0)
+  spawn_ys = rng.uniform(0.0, 30.0, bubble_count)
+  assert manager.register_bubbles(
+    np.arange(bubble_count),
+    np.array(_grid_positions(bubble_count)),
+    np.full(bubble_count, 40.0),
+    np.full(bubble_count, 2.0),
+    spawn_ys,
+    np.full(bubble_count, 80.0),
+    np.full(bubble_count, 20.0),
+    np.full(bubble_count, 4.0),
+  ) == bubble_count
+
+  wave = {'enabled': True, 'displacement': 0.3, 'amplitude': 1.0, 'dir_x': 1.0, 'dir_z': 0.0}
+  bench(
+    f"bubble_update_all[b={bubble_count}]",
+    lambda: manager.update_all(DT, 10.0, 15.0, 1.0, wave_state=wave),
+    items=bubble_count, unit="bubbles/s",
+  )
+
+
+@pytest.mark.parametrize("particle_count", [1024, 16384, 65536])
+def test_pop_particle_update(bench, particle_count):
+  """PopParticleGPUManager.update (kernel + dead-slot readback) vs. particle count."""
+  from qixotic.tendroids.bubbles import PopParticleGPUManager
+
+  manager = PopParticleGPUManager(max_particles=particle_count, device="cuda:0")
+  # Lifetimes far beyond the run so the live count stays constant
+  manager.spawn_spray(
+    (0.0, 50.0, 0.0), [0.0, 1.0, 0.0], particle_count,
+    particle_speed=5.0, particle_spread=60.0, base_lifetime=1.0e6, return_slots=False,
+  )
+
+  bench(
+    f"pop_particle_update[p={particle_count}]",
+    lambda: manager.update(DT),
+    items=particle_count, unit="particles/s",
+  )
+
+
+@pytest.mark.parametrize("tendroid_count", [256, 4096])
+@pytest.mark.parametrize("creature_count", [1, 64, 4096])
+def test_proximity_query(bench, creature_count, tendroid_count):
+  """ProximityHashGrid rebuild + proximity_check_kernel vs. creatures x tendroids."""
+  import numpy as np
+  import warp as wp
+  from qixotic.tendroids.proximity import GridConfig, ProximityHashGrid, proximity_check_kernel
+
+  detection_radius = 8.0
+  grid = ProximityHashGrid(GridConfig(dim_x=128, dim_y=64, dim_z=128, cell_size=detection_radius))
+  assert grid.initialize()
+
+  tendroid_positions = _grid_positions(tendroid_count)
+  extent = max(abs(p[0]) for p in tendroid_positions) + detection_radius
+  rng = np.random.default_rng(0)
+  creatures = np.column_stack([
+    rng.uniform(-extent, extent, creature_count),
+    rng.uniform(0.0, 40.0, creature_count),
+    rng.uniform(-extent, extent, creature_count),
+  ])
+  grid.register_tendroids(tendroid_positions)
+  grid.register_creatures([tuple(p) for p in creatures])
+  grid.rebuild(detection_radius)
+
+  radii = wp.full(tendroid_count, 2.0, dtype=float, device="cuda:0")
+  detected = wp.zeros(creature_count, dtype=int, device="cuda:0")
+  nearest = wp.zeros(creature_count, dtype=int, device="cuda:0")
+  distances = wp.zeros(creature_count, dtype=float, device="cuda:0")
+
+  def step():
+    grid.rebuild(detection_radius)
+    wp.launch(
+      proximity_check_kernel, dim=creature_count,
+      inputs=[
+        grid.get_grid_id(), grid.get_creature_positions_gpu(),
+        grid.get_tendroid_positions_gpu(), radii, detection_radius,
+        detected, nearest, distances,
+      ],
+      device="cuda:0",
+    )
+
+  bench(
+    f"proximity_query[c={creature_count},t={tendroid_count}]",
+    step, items=creature_count, unit="queries/s",
+  )
+  grid.destroy()
+
+
+@pytest.mark.parametrize("tendroid_count", [128, 1024, 8192])
+@pytest.mark.parametrize("creature_count", [1, 8, 64])
+def test_batch_deflection(bench, creature_count, tendroid_count):
+  """BatchDeflectionManager.compute_deflections_multi vs. tendroids x creatures."""
+  import numpy as np
+  from qixotic.tendroids.deflection.batch_deflection_manager import BatchDeflectionManager
+
+  manager = BatchDeflectionManager(device="cuda:0")
+  manager.register_tendroids(_tendroids(tendroid_count))
+  assert manager.uses_gpu and manager.is_built
+
+  extent = max(abs(p[0]) for p in _grid_positions(tendroid_count)) + 5.0
+  rng = np.random.default_rng(0)
+  positions = [
+    (float(x), float(y), float(z)) for x, y, z in zip(
+      rng.uniform(-extent, extent, creature_count),
+      rng.uniform(0.0, 40.0, creature_count),
+      rng.uniform(-extent, extent, creature_count),
+    )
+  ]
+
+  bench(
+    f"batch_deflection[c={creature_count},t={tendroid_count}]",
+    lambda: manager.compute_deflections_multi(positions, None, DT, download=False),
+    items=creature_count * tendroid_count, unit="pairs/s",
+  )
@@ -0,0 +1,176 @@
+"""
+Parity tests for the vectorized scene build
+
+The NumPy cylinder generator, terrain conform and BatchWarpDeformer.build
+must reproduce the per-vertex loops they replaced: same points, normals,
+heights and face indices, and the same vertex / tendroid id layout.
+
+Run with: python -m pytest tests/test_build_parity.py -v
+"""
+
+import math
+
+import pytest
+
+np = pytest.importorskip("numpy")
+
+from qixotic.tendroids.builders.cylinder_generator import CylinderGenerator
+from qixotic.tendroids.builders.terrain_conform import conform_base_to_terrain
+
+# (radius, length, radial, height, flare %, flare multiplier)
+SHAPES = [
+  (2.0, 40.0, 24, 48, 15.0, 2.0),
+  (1.5, 25.0, 7, 10, 33.0, 1.4),
+  (2.0, 40.0, 8, 12, 0.0, 2.0),  # flare_height == 0
+]
+BASE = (5.0, 1.0, -3.0)
+
+
+def _terrain(x, z):
+  return 1.0 + 0.3 * math.sin(0.7 * x) + 0.2 * math.cos(1.3 * z)
+
+
+def _loop_cylinder(radius, length, radial_segments, height_segments, flare_height_percent, flare_radius_multiplier):
+  """The original ring loop of create_cylinder_points."""
+  points, normals, heights = [], [], []
+  flare_height = length * (flare_height_percent / 100.0)
+  max_flare_radius = radius * flare_radius_multiplier
+  for h in range(height_segments + 1):
+    y = (h / height_segments) * length
+    if y < flare_height:
+      t = y / flare_height
+      flare_factor = 0.5 * (1.0 - math.cos(t * math.pi))
+      current_radius = max_flare_radius + (radius - max_flare_radius) * flare_factor
+    else:
+      current_radius = radius
+    for r in range(radial_segments):
+      angle = (r / radial_segments) * 2.0 * math.pi
+      cos_a, sin_a = math.cos(angle), math.sin(angle)
+      points.append((current_radius * cos_a, y, current_radius * sin_a))
+      normals.append((cos_a, 0.0, sin_a))
+      heights.append(y)
+  return points, normals, heights, flare_height
+
+
+def _loop_faces(radial_segments, height_segments):
+  """The original quad loop of create_face_indices."""
+  counts, indices = [], []
+  for h in range(height_segments):
+    for r in range(radial_segments):
+      v0 = h * radial_segments + r
+      v1 = h * radial_segments + ((r + 1) % radial_segments)
+      v2 = (h + 1) * radial_segments + ((r + 1) % radial_segments)
+      v3 = (h + 1) * radial_segments + r
+      counts.extend([3, 3])
+      indices.extend([v0, v2, v1, v0, v3, v2])
+  return counts, indices
+
+
+def _loop_conform(vertices, base_position, flare_height, radial_segments, height_segments, get_height_fn):
+  """The original per-ring loop of conform_base_to_terrain."""
+  total_height = vertices[-1][1]
+  segment_height = total_height / height_segments if height_segments > 0 else 1.0
+  flare_segments = int(math.ceil(flare_height / segment_height)) if segment_height > 0 else 0
+  flare_segments = min(flare_segments, height_segments)
+
+  modified = [tuple(v) for v in vertices]
+  for seg_idx in range(flare_segments + 1):
+    blend = (1.0 - seg_idx / flare_segments) ** 2 if flare_segments > 0 else 0.0
+    for i in range(radial_segments):
+      vert_idx = seg_idx * radial_segments + i
+      if vert_idx >= len(vertices):
+        break
+      x, y, z = vertices[vert_idx]
+      terrain_height = get_height_fn(base_position[0] + x, base_position[2] + z)
+      modified[vert_idx] = (x, y + (terrain_height - base_position[1]) * blend, z)
+  return modified
+
+
+def _loop_height_factors(points, cylinder_length):
+  """The original per-vertex loop of V2WarpDeformer.__init__."""
+  factors = []
+  for p in points:
+    if cylinder_length > 0:
+      ratio = max(0.0, min(1.0, p[1] / cylinder_length))
+      factors.append(ratio * ratio * (3.0 - 2.0 * ratio))
+    else:
+      factors.append(0.0)
+  return factors
+
+
+class TestCylinderParity:
+  """create_cylinder_arrays / create_face_arrays vs. the loops."""
+
+  @pytest.mark.parametrize("shape", SHAPES)
+  def test_arrays_match_loop(self, shape):
+    points, normals, heights, deform_start = CylinderGenerator.create_cylinder_arrays(*shape)
+    loop_points, loop_normals, loop_heights, loop_start = _loop_cylinder(*shape)
+
+    assert points.shape == (len(loop_points), 3)
+    np.testing.assert_allclose(points, loop_points, atol=1e-5)
+    np.testing.assert_allclose(normals, loop_normals, atol=1e-6)
+    np.testing.assert_allclose(heights, loop_heights, atol=1e-5)
+    assert deform_start == pytest.approx(loop_start)
+
+  @pytest.mark.parametrize("shape", SHAPES)
+  def test_faces_match_loop(self, shape):
+    radial, height = shape[2], shape[3]
+    counts, indices = CylinderGenerator.create_face_arrays(radial, height)
+    loop_counts, loop_indices = _loop_faces(radial, height)
+
+    assert counts.tolist() == loop_counts
+    assert indices.tolist() == loop_indices
+    assert CylinderGenerator.create_face_indices(radial, height) == (loop_counts, loop_indices)
+
+
+class TestTerrainConformParity:
+  """Vectorized flare conform vs. the ring loop."""
+
+  @pytest.mark.parametrize("shape", SHAPES)
+  def test_matches_loop(self, shape):
+    radial, height = shape[2], shape[3]
+    loop_points, _, _, flare_height = _loop_cylinder(*shape)
+    points, _, _, _ = CylinderGenerator.create_cylinder_arrays(*shape)
+
+    conformed = conform_base_to_terrain(points, BASE, flare_height, radial, height, _terrain)
+    expected = _loop_conform(loop_points, BASE, flare_height, radial, height, _terrain)
+
+    np.testing.assert_allclose(conformed, expected, atol=1e-5)
+
+  def test_zero_flare_leaves_points(self):
+    shape = SHAPES[2]
+    points, _, _, flare_height = CylinderGenerator.create_cylinder_arrays(*shape)
+    assert flare_height == 0.0
+
+    conformed = conform_base_to_terrain(points, BASE, flare_height, shape[2], shape[3], _terrain)
+
+    np.testing.assert_array_equal(conformed, points)
+
+
+class TestBatchBuildParity:
+  """Vectorized BatchWarpDeformer.build vs. the per-vertex gather."""
+
+  HEIGHTS = (6, 11, 4)
+
+  def test_layout_matches_loop(self, batch_deformer):
+    pytest.importorskip("warp")
+
+    deformer = batch_deformer(height=self.HEIGHTS, device="cpu", active_set=False)
+
+    loop_points, loop_factors, loop_ids = [], [], []
+    for i, tendroid in enumerate(deformer.tendroids):
+      base_points = tendroid.deformer.base_points_gpu.numpy()
+      for point in base_points:
+        loop_points.append(tuple(point))
+        loop_ids.append(i)
+      loop_factors.extend(_loop_height_factors(base_points, tendroid.length))
+
+    total = len(loop_points)
+    counts = [(h + 1) * 8 for h in self.HEIGHTS]
+    assert deformer.total_vertices == total
+    assert deformer.vertex_counts == counts
+    assert deformer.vertex_offsets == [0, counts[0], counts[0] + counts[1]]
+    np.testing.assert_allclose(deformer.base_points_gpu.numpy()[:total], loop_points, atol=1e-6)
+    np.testing.assert_allclose(deformer.height_factors_gpu.numpy()[:total], loop_factors, atol=1e-6)
+    assert deformer.vertex_tendroid_ids_gpu.numpy()[:total].tolist() == loop_ids
+    assert set(deformer.vertex_tendroid_ids_gpu.numpy()[total:].tolist()) <= {-1}
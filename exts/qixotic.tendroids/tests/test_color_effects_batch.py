@@ -0,0 +1,102 @@
+"""
+Tests for batched color effects
+
+On CUDA, BatchedColorEffects must track one ColorEffectController per
+instance (the Python reference) through shocks and recovery in every
+fade mode.
+
+Run with: python -m pytest tests/test_color_effects_batch.py -v
+"""
+
+import pytest
+
+from qixotic.tendroids.contact.color_effect_controller import ColorEffectController
+from qixotic.tendroids.contact.color_effect_helpers import ColorConfig, ColorEffectState
+from qixotic.tendroids.contact.color_fade_helpers import FadeConfig, FadeMode, apply_easing
+
+
+@pytest.mark.gpu
+@pytest.mark.requires_cuda
+class TestBatchedColorParity:
+    """Kernel state machine vs. ColorEffectController."""
+
+    @pytest.mark.parametrize("mode", [FadeMode.DISTANCE, FadeMode.SPEED, FadeMode.TIME])
+    def test_matches_controllers(self, mode):
+        import numpy as np
+        from qixotic.tendroids.contact.batched_color_effects import BatchedColorEffects
+
+        count, frames, dt = 64, 60, 1.0 / 60.0
+        config = ColorConfig(recovery_duration=0.5)
+        rng = np.random.default_rng(7)
+
+        effects = BatchedColorEffects(count, config=config, fade_config=FadeConfig(mode=mode))
+        controllers = [
+            ColorEffectController(config=config, fade_config=FadeConfig(mode=mode))
+            for _ in range(count)
+        ]
+        elapsed = np.zeros(count)
+
+        for _ in range(frames):
+            shocked = np.flatnonzero(rng.random(count) < 0.05)
+            distances = rng.uniform(0.0, 25.0, count).astype(np.float32)
+            speeds = rng.uniform(0.0, 60.0, count).astype(np.float32)
+
+            effects.trigger_shock(shocked)
+            effects.update(dt, distances, speeds)
+
+            for i, controller in enumerate(controllers):
+                if i in shocked:
+                    controller.on_contact()
+                # Recovery time: 0 on the frame recovery starts, then + dt
+                if controller.status.state == ColorEffectState.RECOVERING:
+                    elapsed[i] += dt
+                else:
+                    elapsed[i] = 0.0
+                controller.update(float(distances[i]), float(speeds[i]), float(elapsed[i]))
+
+            for i, controller in enumerate(controllers):
+                got = effects.status(i)
+                ref = controller.status
+                assert got.state == ref.state
+                assert got.shock_count == ref.shock_count
+                np.testing.assert_allclose(got.current_color, ref.current_color, atol=1e-5)
+
+        assert effects.count_in_state(ColorEffectState.NORMAL) < count, "scene should shock instances"
+        effects.destroy()
+
+    @pytest.mark.parametrize("easing", ["ease_in", "ease_out", "ease_in_out"])
+    def test_easing(self, easing):
+        import numpy as np
+        from qixotic.tendroids.contact.batched_color_effects import BatchedColorEffects
+
+        config = ColorConfig()
+        fade = FadeConfig(mode=FadeMode.DISTANCE, fade_start_distance=6.0, fade_end_distance=20.0)
+        effects = BatchedColorEffects(1, config=config, fade_config=fade, easing=easing)
+
+        effects.trigger_shock([0])
+        effects.update(0.0, [21.0])  # Exits shock; fade is already complete
+        assert effects.status(0).state == ColorEffectState.NORMAL
+
+        effects.trigger_shock([0])
+        effects.update(0.0, [15.0])
+        effects.update(0.0, [9.0])
+        status = effects.status(0)
+        t = apply_easing((9.0 - 6.0) / 14.0, easing)
+        expected = np.array(config.shock_color) + (np.array(config.normal_color) - np.array(config.shock_color)) * t
+        assert status.state == ColorEffectState.RECOVERING
+        assert status.recovery_progress == pytest.approx(t, abs=1e-6)
+        np.testing.assert_allclose(status.current_color, expected, atol=1e-5)
+        effects.destroy()
+
+    def test_reset(self):
+        from qixotic.tendroids.contact.batched_color_effects import BatchedColorEffects
+
+        effects = BatchedColorEffects(4)
+        effects.trigger_shock([0, 2])
+        effects.update(0.0, [0.0] * 4)
+        assert effects.count_in_state(ColorEffectState.SHOCKED) == 2
+
+        effects.reset()
+        assert effects.count_in_state(ColorEffectState.NORMAL) == 4
+        assert effects.status(2).shock_count == 1
+        effects.destroy()
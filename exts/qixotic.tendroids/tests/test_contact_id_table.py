@@ -0,0 +1,164 @@
+"""
+Tests for integer-ID contact classification and reduction
+
+The ID-table path must select the same creature-tendroid contacts as
+path-pattern filtering and reduce them per (creature, tendroid) pair.
+
+Run with: python -m pytest tests/test_contact_id_table.py -v
+"""
+
+import types
+
+import pytest
+
+np = pytest.importorskip("numpy")
+
+from qixotic.tendroids.contact.contact_handler import ContactHandler
+from qixotic.tendroids.contact.contact_id_table import (KIND_CREATURE, KIND_NONE, KIND_TENDROID, ContactIdTable,
+                                                        reduce_contact_report)
+
+CREATURE = '/World/Creature/Body'
+TENDROIDS = ['/World/Tendroids/T0/mesh', '/World/Tendroids/T1/mesh']
+GROUND = '/World/Ground'
+
+
+def _encoder():
+  """Stand-in for sdfPathToInt: a stable int per path."""
+  ids = {}
+  return lambda path: ids.setdefault(path, 1000 + len(ids))
+
+
+def _table():
+  table = ContactIdTable(encode_path=_encoder())
+  table.register(CREATURE, KIND_CREATURE, 0)
+  for i, path in enumerate(TENDROIDS):
+    table.register(path, KIND_TENDROID, i)
+  return table
+
+
+def _header(table, path0, path1, count, offset):
+  return types.SimpleNamespace(
+    actor0=table._encode(path0), actor1=table._encode(path1),
+    num_contact_data=count, contact_data_offset=offset,
+  )
+
+
+def _contact(position, normal, impulse=1.0, separation=0.0):
+  return types.SimpleNamespace(position=position, normal=normal, impulse=impulse, separation=separation)
+
+
+class TestContactIdTable:
+  """Registration and lookup."""
+
+  def test_lookup_registered(self):
+    table = _table()
+    assert table.lookup(table._encode(TENDROIDS[1])) == (KIND_TENDROID, 1)
+    assert table.lookup(table._encode(GROUND)) == (KIND_NONE, -1)
+    assert table.path_of(KIND_CREATURE, 0) == CREATURE
+
+  def test_collider_preferred_over_actor(self):
+    table = _table()
+    header = types.SimpleNamespace(collider0=table._encode(TENDROIDS[0]), actor0=table._encode(GROUND))
+    assert table.lookup_actor(header, 0) == (KIND_TENDROID, 0)
+
+  def test_unregister(self):
+    table = _table()
+    table.unregister(KIND_TENDROID, 0)
+    assert table.lookup(table._encode(TENDROIDS[0])) == (KIND_NONE, -1)
+    assert len(table) == 2
+
+
+class TestReduceContactReport:
+  """Per-pair reduction."""
+
+  def _report(self, table):
+    headers = [
+      _header(table, CREATURE, TENDROIDS[0], 2, 0),
+      _header(table, GROUND, TENDROIDS[0], 1, 2),
+      _header(table, TENDROIDS[1], CREATURE, 1, 3),
+      _header(table, CREATURE, TENDROIDS[0], 1, 4),
+    ]
+    data = [
+      _contact((0.0, 0.0, 0.0), (1.0, 0.0, 0.0), 1.0, -0.1),
+      _contact((2.0, 0.0, 0.0), (1.0, 0.0, 0.0), 2.0, -0.3),
+      _contact((9.0, 9.0, 9.0), (0.0, 1.0, 0.0), 5.0, -1.0),
+      _contact((5.0, 5.0, 5.0), (0.0, 0.0, 1.0), 0.5, 0.0),
+      _contact((4.0, 0.0, 0.0), (0.0, 1.0, 0.0), 3.0, -0.2),
+    ]
+    return headers, data
+
+  def test_pairs_reduced(self):
+    table = _table()
+    records = reduce_contact_report(*self._report(table), table)
+
+    assert len(records) == 2
+    assert list(records.tendroid_index) == [0, 1]
+    assert list(records.contact_count) == [3, 1]
+    np.testing.assert_allclose(records.contact_point[0], [2.0, 0.0, 0.0])
+    np.testing.assert_allclose(records.impulse, [6.0, 0.5])
+    np.testing.assert_allclose(records.separation, [-0.3, 0.0])
+    expected = np.array([2.0, 1.0, 0.0]) / np.sqrt(5.0)
+    np.testing.assert_allclose(records.surface_normal[0], expected, atol=1e-6)
+
+  def test_normal_flipped_when_tendroid_is_actor0(self):
+    table = _table()
+    records = reduce_contact_report(*self._report(table), table)
+    np.testing.assert_allclose(records.surface_normal[1], [0.0, 0.0, -1.0])
+
+  def test_structured_array_matches_list(self):
+    table = _table()
+    headers, data = self._report(table)
+    dtype = [('position', 'f4', 3), ('normal', 'f4', 3), ('impulse', 'f4'), ('separation', 'f4')]
+    array = np.array(
+      [(c.position, c.normal, c.impulse, c.separation) for c in data], dtype=dtype
+    )
+
+    expected = reduce_contact_report(headers, data, table)
+    records = reduce_contact_report(headers, array, table)
+    np.testing.assert_allclose(records.contact_point, expected.contact_point)
+    np.testing.assert_allclose(records.surface_normal, expected.surface_normal)
+    np.testing.assert_allclose(records.impulse, expected.impulse)
+
+  def test_vector_impulse_magnitude(self):
+    table = _table()
+    headers = [_header(table, CREATURE, TENDROIDS[0], 1, 0)]
+    data = [_contact((0.0, 0.0, 0.0), (1.0, 0.0, 0.0), impulse=(3.0, 4.0, 0.0))]
+    np.testing.assert_allclose(reduce_contact_report(headers, data, table).impulse, [5.0])
+
+  def test_no_matches(self):
+    table = _table()
+    headers = [_header(table, GROUND, TENDROIDS[0], 1, 0)]
+    assert len(reduce_contact_report(headers, [_contact((0, 0, 0), (0, 1, 0))], table)) == 0
+
+
+class TestHandlerIdPath:
+  """ContactHandler with an ID table registered."""
+
+  def test_one_event_per_pair(self):
+    table = _table()
+    headers, data = TestReduceContactReport()._report(table)
+    handler = ContactHandler()
+    handler.set_id_table(table)
+    events = []
+    handler.add_listener(events.append)
+
+    handler._on_contact_report(headers, data)
+
+    assert [(e.tendroid_path, e.contact_count) for e in events] == [(TENDROIDS[0], 3), (TENDROIDS[1], 1)]
+    assert events[0].creature_path == CREATURE
+    assert handler.contact_count == 4
+    assert len(handler.last_records) == 2
+
+  def test_empty_table_uses_patterns(self):
+    handler = ContactHandler()
+    handler.set_id_table(ContactIdTable(encode_path=str))
+    events = []
+    handler.add_listener(events.append)
+    header = types.SimpleNamespace(
+      actor0=CREATURE, actor1=TENDROIDS[0], num_contact_data=1, contact_data_offset=0
+    )
+
+    handler._on_contact_report([header], [_contact((0.0, 0.0, 0.0), (1.0, 0.0, 0.0))])
+
+    assert len(events) == 1
+    assert handler.last_records is None
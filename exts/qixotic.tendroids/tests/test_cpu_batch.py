@@ -0,0 +1,61 @@
+"""
+Tests for the batch deformer on Warp's CPU device
+
+Chunked multithreaded launches must match a single inline launch, and
+the CPU result must match CUDA when it is available.
+
+Run with: python -m pytest tests/test_cpu_batch.py -v
+"""
+
+import pytest
+
+pytest.importorskip("warp")
+
+
+def _randomized(batch_deformer, device="cpu", cpu_threads=1, count=32, analytic_normals=False):
+  """Large enough to split into chunks, with randomized deform inputs."""
+  import numpy as np
+
+  deformer = batch_deformer(
+    count=count, radial=24, height=48, device=device, active_set=False,
+    analytic_normals=analytic_normals, cpu_threads=cpu_threads,
+  )
+  rng = np.random.default_rng(7)
+  deformer.bubble_y_gpu.assign(rng.uniform(5.0, 35.0, count).astype(np.float32))
+  deformer.bubble_radius_gpu.assign(rng.uniform(2.0, 4.0, count).astype(np.float32))
+  deformer.wave_dx_gpu.assign(rng.uniform(-1.0, 1.0, count).astype(np.float32))
+  return deformer
+
+
+class TestCPUBatchDeform:
+  """Threaded CPU launches."""
+
+  def test_uses_threads_on_cpu_only(self, batch_deformer):
+    assert _randomized(batch_deformer, cpu_threads=4, count=2).uses_cpu_threads
+    assert not _randomized(batch_deformer, cpu_threads=1, count=2).uses_cpu_threads
+
+  @pytest.mark.parametrize("analytic_normals", [False, True])
+  def test_chunked_matches_inline(self, batch_deformer, analytic_normals):
+    import numpy as np
+
+    inline = _randomized(batch_deformer, cpu_threads=1, analytic_normals=analytic_normals)
+    threaded = _randomized(batch_deformer, cpu_threads=4, analytic_normals=analytic_normals)
+    assert threaded.total_vertices >= 2 * 16384
+
+    expected = inline.deform_all().copy()
+    threaded.deform_all()  # first launch inline (module load)
+    np.testing.assert_allclose(threaded.deform_all(), expected, atol=1e-6)
+    if analytic_normals:
+      np.testing.assert_allclose(
+        threaded.out_normals_gpu.numpy(), inline.out_normals_gpu.numpy(), atol=1e-6
+      )
+    threaded.destroy()
+
+  @pytest.mark.gpu
+  @pytest.mark.requires_cuda
+  def test_cpu_matches_cuda(self, batch_deformer):
+    import numpy as np
+
+    cpu = _randomized(batch_deformer, cpu_threads=4, count=4)
+    cuda = _randomized(batch_deformer, device="cuda:0", count=4)
+    np.testing.assert_allclose(cpu.deform_all(), cuda.deform_all(), atol=1e-4)
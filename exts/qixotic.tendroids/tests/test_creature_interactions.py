@@ -0,0 +1,169 @@
+"""
+Tests for the GPU creature interaction grid
+
+On CUDA, CreatureInteractionGrid.check must match check_bubble_collisions
+followed by check_tendroid_interactions (the Python reference) for
+velocity, popped bubbles and tendroid interactions.
+
+Run with: python -m pytest tests/test_creature_interactions.py -v
+"""
+
+import types
+
+import pytest
+
+from tests.test_mocks import MockVec3f
+
+
+class Vec3f(MockVec3f):
+  """MockVec3f with the operators the reference helpers use."""
+
+  def __neg__(self):
+    return Vec3f(-self.x, -self.y, -self.z)
+
+  def __add__(self, other):
+    return Vec3f(self.x + other.x, self.y + other.y, self.z + other.z)
+
+  def __sub__(self, other):
+    return Vec3f(self.x - other.x, self.y - other.y, self.z - other.z)
+
+  def __mul__(self, scalar):
+    return Vec3f(self.x * scalar, self.y * scalar, self.z * scalar)
+
+  def __truediv__(self, scalar):
+    return Vec3f(self.x / scalar, self.y / scalar, self.z / scalar)
+
+
+@pytest.fixture
+def gf_vec3f(monkeypatch):
+  """Real arithmetic for Gf.Vec3f in both implementations."""
+  from qixotic.tendroids.controllers import creature_interaction_grid, creature_update_helpers
+
+  gf = types.SimpleNamespace(Vec3f=Vec3f)
+  monkeypatch.setattr(creature_update_helpers, "Gf", gf)
+  monkeypatch.setattr(creature_interaction_grid, "Gf", gf)
+  return Vec3f
+
+
+def _scene(rng, tendroid_count, bubble_count):
+  """Tendroids and bubbles scattered around a creature at the origin."""
+  import numpy as np
+
+  tendroids = [
+    types.SimpleNamespace(
+      name=f"t{i}",
+      position=tuple(float(v) for v in rng.uniform(-60.0, 60.0, 3)),
+      radius=float(rng.uniform(1.0, 4.0)),
+    )
+    for i in range(tendroid_count)
+  ]
+  phases = rng.integers(0, 5, bubble_count).astype(np.int32)
+  positions = rng.uniform(-25.0, 25.0, (bubble_count, 3)).astype(np.float32)
+  radii = rng.uniform(0.5, 5.0, bubble_count).astype(np.float32)
+  return tendroids, phases, positions, radii
+
+
+def _bubble_manager(phases, positions, radii):
+  import warp as wp
+
+  return types.SimpleNamespace(
+    max_bubbles=len(phases),
+    active_count=len(phases),
+    phases_gpu=wp.array(phases, dtype=int, device="cuda:0"),
+    world_x_gpu=wp.array(positions[:, 0], dtype=float, device="cuda:0"),
+    world_y_gpu=wp.array(positions[:, 1], dtype=float, device="cuda:0"),
+    world_z_gpu=wp.array(positions[:, 2], dtype=float, device="cuda:0"),
+    current_radius_gpu=wp.array(radii, dtype=float, device="cuda:0"),
+  )
+
+
+@pytest.mark.gpu
+@pytest.mark.requires_cuda
+class TestInteractionParity:
+  """Grid results vs. the Python reference scans."""
+
+  @pytest.mark.parametrize("seed", [0, 1, 2])
+  def test_matches_reference(self, gf_vec3f, seed):
+    import numpy as np
+    from qixotic.tendroids.controllers.creature_interaction_grid import CreatureInteractionGrid
+    from qixotic.tendroids.controllers.creature_update_helpers import (
+      check_bubble_collisions,
+      check_tendroid_interactions,
+    )
+
+    rng = np.random.default_rng(seed)
+    tendroids, phases, positions, radii = _scene(rng, 300, 200)
+    position = gf_vec3f(0.0, 0.0, 0.0)
+    velocity = gf_vec3f(*rng.uniform(-20.0, 20.0, 3))
+    creature_radius = 6.0
+
+    # Reference: dicts of active bubbles keyed by name
+    names = {i: f"b{i}" for i in range(len(phases))}
+    bubble_positions = {names[i]: tuple(positions[i]) for i in range(len(phases)) if phases[i] > 0}
+    bubble_radii = {names[i]: float(radii[i]) for i in range(len(phases)) if phases[i] > 0}
+    ref_velocity, ref_popped = check_bubble_collisions(
+      position, creature_radius, bubble_positions, bubble_radii, velocity
+    )
+    ref_velocity, ref_interactions = check_tendroid_interactions(
+      position, ref_velocity, creature_radius, tendroids
+    )
+
+    grid = CreatureInteractionGrid()
+    assert grid.set_tendroids(tendroids)
+    grid.bind_bubbles(_bubble_manager(phases, positions, radii), names)
+    new_velocity, popped, interactions = grid.check(position, velocity, creature_radius)
+
+    assert ref_popped or ref_interactions, "scene should produce hits"
+    np.testing.assert_allclose(tuple(new_velocity), tuple(ref_velocity), atol=1e-3)
+    assert sorted(n for n, _ in popped) == sorted(n for n, _ in ref_popped)
+    assert interactions.keys() == ref_interactions.keys()
+    for name, ref in ref_interactions.items():
+      got = interactions[name]
+      assert got['type'] == ref['type']
+      assert got['distance'] == pytest.approx(ref['distance'], abs=1e-3)
+      if ref['type'] == 'avoidance':
+        assert got['avoidance_factor'] == pytest.approx(ref['avoidance_factor'], abs=1e-4)
+        np.testing.assert_allclose(got['avoidance_direction'], ref['avoidance_direction'], atol=1e-4)
+    grid.destroy()
+
+  def test_tendroids_only_skips_bubbles(self, gf_vec3f):
+    from qixotic.tendroids.controllers.creature_interaction_grid import CreatureInteractionGrid
+
+    # One tendroid straight ahead, creature moving into it
+    tendroid = types.SimpleNamespace(name="t0", position=(0.0, 0.0, 10.0), radius=2.0)
+    grid = CreatureInteractionGrid()
+    assert grid.set_tendroids([tendroid])
+    assert not grid.has_bubbles
+
+    velocity, popped, interactions = grid.check(
+      gf_vec3f(0.0, 0.0, 0.0), gf_vec3f(0.0, 0.0, 5.0), 6.0
+    )
+    assert popped == []
+    assert interactions['t0']['type'] == 'avoidance'
+    assert tuple(velocity) == pytest.approx((0.0, 0.0, 5.0))
+
+    # Inside contact distance: shock pushes the creature back
+    velocity, _, interactions = grid.check(
+      gf_vec3f(0.0, 0.0, 5.0), gf_vec3f(0.0, 0.0, 5.0), 6.0
+    )
+    assert interactions['t0']['type'] == 'shock'
+    assert velocity[2] == pytest.approx(5.0 - 25.0)
+    grid.destroy()
+
+  def test_hit_list_overflow_is_clamped(self, gf_vec3f):
+    import numpy as np
+    from qixotic.tendroids.controllers.creature_interaction_grid import CreatureInteractionGrid
+
+    count = 64
+    phases = np.ones(count, dtype=np.int32)
+    positions = np.zeros((count, 3), dtype=np.float32)
+    radii = np.full(count, 2.0, dtype=np.float32)
+
+    grid = CreatureInteractionGrid(max_hits=16)
+    grid.bind_bubbles(_bubble_manager(phases, positions, radii), {i: f"b{i}" for i in range(count)})
+    velocity, popped, _ = grid.check(gf_vec3f(0.0, 0.0, 0.0), gf_vec3f(0.0, 0.0, 0.0), 6.0)
+
+    # Every hit still adds its impulse; only the report is truncated
+    assert len(popped) == 16
+    assert velocity[1] == pytest.approx(5.0 * count, rel=1e-4)
+    grid.destroy()
@@ -0,0 +1,119 @@
+"""
+Tests for creature deflection driving the batch deform
+
+A BatchDeflectionManager bound to a BatchWarpDeformer must bend only the
+tendroids the creature is near, and V2SceneManager must wire one into
+the single-device batch deform and feed it the creature each frame.
+
+Run with: python -m pytest tests/test_deflection_binding.py -v
+"""
+
+import types
+
+import pytest
+
+NEAR_AND_FAR = [(0.0, 0.0, 0.0), (100.0, 0.0, 0.0)]
+CREATURE = (1.0, 30.0, 0.0)  # Beside tendroid 0, 3/4 up its length
+
+
+def _split(points, deformer):
+  """Per-tendroid slices of a deform_all result."""
+  return [
+    points[start:start + count]
+    for start, count in zip(deformer.vertex_offsets, deformer.vertex_counts)
+  ]
+
+
+@pytest.mark.gpu
+@pytest.mark.requires_cuda
+class TestDeflectionBinding:
+  """Bound deflection output bends the deformed points."""
+
+  @pytest.mark.parametrize("active_set", [False, True])
+  def test_bend_moves_only_near_tendroid(self, batch_deformer, active_set):
+    import numpy as np
+    from qixotic.tendroids.deflection import BatchDeflectionManager
+
+    deformer = batch_deformer(positions=NEAR_AND_FAR, active_set=active_set)
+    deflection = BatchDeflectionManager(device=deformer.device)
+    deflection.register_tendroids(deformer.tendroids)
+    assert deformer.bind_deflection(deflection.angles_gpu, deflection.axes_gpu)
+
+    rest = deformer.deform_all().copy()
+    for _ in range(5):
+      deflection.compute_deflections_multi([CREATURE], None, 0.2, download=False)
+    angles, _ = deflection.download()
+    bent = deformer.deform_all()
+
+    assert angles[0] > 0.0
+    assert angles[1] == 0.0
+    near_rest, far_rest = _split(rest, deformer)
+    near_bent, far_bent = _split(bent, deformer)
+    assert np.abs(near_bent - near_rest).max() > 1e-2
+    np.testing.assert_allclose(far_bent, far_rest, atol=1e-6)
+
+
+@pytest.mark.gpu
+@pytest.mark.requires_cuda
+class TestSceneManagerDeflection:
+  """Single-device scene wiring."""
+
+  def _manager(self):
+    from qixotic.tendroids.builders.cylinder_generator import CylinderGenerator
+    from qixotic.tendroids.core.warp_deformer import V2WarpDeformer
+    from qixotic.tendroids.scene.manager import V2SceneManager
+
+    manager = V2SceneManager()
+    manager.device = "cuda:0"
+    for i, position in enumerate(NEAR_AND_FAR):
+      points, _, _, flare_height = CylinderGenerator.create_cylinder_arrays(2.0, 40.0, 8, 10)
+      data = {
+        'name': f"t{i}", 'position': position, 'base_points': points,
+        'radius': 2.0, 'length': 40.0, 'radial_segments': 8, 'height_segments': 10,
+        'flare_height_percent': 15.0, 'flare_radius_multiplier': 2.0,
+        'flare_height': flare_height,
+      }
+      manager.tendroid_data.append(data)
+      manager.tendroids.append(types.SimpleNamespace(
+        name=data['name'], position=position, radius=2.0, length=40.0,
+        deformer=V2WarpDeformer(points, 2.0, 40.0, 0.8, 0.9, device=manager.device),
+      ))
+    return manager
+
+  def test_batch_deformer_reads_deflection(self):
+    manager = self._manager()
+
+    manager._initialize_batch_deformer()
+
+    deflection = manager.deflection_manager
+    assert deflection is not None
+    assert manager.batch_deformer.bend_angle_gpu is deflection.angles_gpu
+    assert manager.animation_controller.deflection_manager is deflection
+
+  def test_creature_position_fed_each_frame(self):
+    import numpy as np
+
+    manager = self._manager()
+    manager._initialize_batch_deformer()
+    controller = manager.animation_controller
+    controller.creature_controller = types.SimpleNamespace(get_position=lambda: CREATURE)
+    deformer = manager.batch_deformer
+
+    rest = deformer.deform_all().copy()
+    for _ in range(5):
+      controller._update_deflection(0.2)
+    bent = deformer.deform_all()
+
+    near_rest, far_rest = _split(rest, deformer)
+    near_bent, far_bent = _split(bent, deformer)
+    assert np.abs(near_bent - near_rest).max() > 1e-2
+    np.testing.assert_allclose(far_bent, far_rest, atol=1e-6)
+
+  def test_disabled_by_flag(self):
+    manager = self._manager()
+    manager.use_gpu_deflection = False
+
+    manager._initialize_batch_deformer()
+
+    assert manager.deflection_manager is None
+    assert manager.batch_deformer.bend_angle_gpu is manager.batch_deformer._own_bend_angle_gpu
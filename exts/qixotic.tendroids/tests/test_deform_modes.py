@@ -0,0 +1,70 @@
+"""
+Tests for the batch deform launch table
+
+Every target / rest pose / active set / normals combination the
+BatchWarpDeformer can hit must map to a kernel whose inputs line up
+with its signature.
+
+Run with: python -m pytest tests/test_deform_modes.py -v
+"""
+
+import itertools
+
+import pytest
+
+pytest.importorskip("warp")
+
+from qixotic.tendroids.core.deform_modes import DEFORM_MODES, select_mode
+
+
+class _Names:
+  """Stand-in deformer: every array attribute is its own name."""
+
+  def __getattr__(self, name):
+    return name
+
+
+def _outputs(target, normals):
+  if target == 'scatter':
+    return ['source', 'dest']
+  return ['points', 'normals'] if normals else ['points']
+
+
+COMBINATIONS = [
+  (target, procedural, active, normals)
+  for target, procedural, active, normals in itertools.product(
+    ('points', 'fabric', 'scatter'), (False, True), (False, True), (False, True)
+  )
+  if not (normals and (procedural or target == 'scatter'))
+]
+
+
+class TestDeformModes:
+  """DEFORM_MODES coverage and input layout."""
+
+  def test_every_combination_has_a_mode(self):
+    assert set(DEFORM_MODES) == set(COMBINATIONS)
+
+  @pytest.mark.parametrize("key", COMBINATIONS)
+  def test_inputs_match_kernel_signature(self, key):
+    target, procedural, active, normals = key
+    mode = DEFORM_MODES[key]
+
+    inputs = mode.inputs(_Names(), _outputs(target, normals))
+
+    assert len(inputs) == len(mode.kernel.adj.args)
+    assert mode.active == active
+    for output in _outputs(target, normals):
+      assert output in inputs
+
+  def test_vertex_arrays_lead_threaded_modes(self):
+    for key, mode in DEFORM_MODES.items():
+      if not mode.vertex_arrays:
+        continue
+      assert key[:3] == ('points', False, False)
+      inputs = mode.inputs(_Names(), _outputs('points', key[3]))
+      assert inputs[0] == 'base_points_gpu'
+      assert inputs[mode.vertex_arrays - 1] == 'vertex_tendroid_ids_gpu'
+
+  def test_procedural_ignores_normals(self):
+    assert select_mode('points', True, True, normals=True) is DEFORM_MODES[('points', True, True, False)]
@@ -0,0 +1,91 @@
+"""
+Tests for analytic normals in the batch deform kernel
+
+On CUDA, normals written by batch_deform_normals_kernel must match the
+rest normals at rest and finite-difference normals of the deformed mesh
+under bulge, bend and wave sway.
+
+Run with: python -m pytest tests/test_deform_normals.py -v
+"""
+
+import pytest
+
+RADIAL, HEIGHT = 96, 240
+
+
+def _cylinder(batch_deformer, analytic_normals=True):
+  """One unflared cylinder: the rest surface has radial normals."""
+  return batch_deformer(
+    count=1, radial=RADIAL, height=HEIGHT, flare_height_percent=0.0,
+    analytic_normals=analytic_normals,
+  )
+
+
+def _mesh_normals(points):
+  """Central-difference normals on interior rings of the cylinder grid."""
+  import numpy as np
+
+  grid = points.reshape(HEIGHT + 1, RADIAL, 3)
+  along = grid[2:] - grid[:-2]
+  around = np.roll(grid, -1, axis=1)[1:-1] - np.roll(grid, 1, axis=1)[1:-1]
+  normals = np.cross(along, around)
+  return normals / np.linalg.norm(normals, axis=2, keepdims=True)
+
+
+@pytest.mark.gpu
+@pytest.mark.requires_cuda
+class TestAnalyticNormals:
+  """batch_deform_normals_kernel output."""
+
+  def test_rest_normals_match_builder(self, batch_deformer):
+    import numpy as np
+    from qixotic.tendroids.builders.cylinder_generator import CylinderGenerator
+
+    deformer = _cylinder(batch_deformer)
+    _, normals, _, _ = CylinderGenerator.create_cylinder_arrays(2.0, 40.0, RADIAL, HEIGHT, 0.0)
+    deformer.deform_all()
+    np.testing.assert_allclose(deformer.out_normals_gpu.numpy()[:len(normals)], normals, atol=1e-6)
+
+  def test_matches_finite_differences(self, batch_deformer):
+    import numpy as np
+
+    deformer = _cylinder(batch_deformer)
+    deformer.bubble_y_gpu.assign(np.array([18.0], dtype=np.float32))
+    deformer.bubble_radius_gpu.assign(np.array([3.2], dtype=np.float32))
+    deformer.wave_dx_gpu.assign(np.array([1.5], dtype=np.float32))
+    deformer.wave_dz_gpu.assign(np.array([-0.8], dtype=np.float32))
+    deformer.bend_angle_gpu.assign(np.array([0.35], dtype=np.float32))
+    deformer.bend_axis_gpu.assign(np.array([[0.6, 0.0, 0.8]], dtype=np.float32))
+
+    points = deformer.deform_all()
+    count = (HEIGHT + 1) * RADIAL
+    analytic = deformer.out_normals_gpu.numpy()[:count].reshape(HEIGHT + 1, RADIAL, 3)[1:-1]
+    np.testing.assert_allclose(analytic, _mesh_normals(points[:count]), atol=2e-3)
+    np.testing.assert_allclose(np.linalg.norm(analytic, axis=2), 1.0, atol=1e-5)
+
+  def test_points_unchanged_by_normals(self, batch_deformer):
+    import numpy as np
+
+    outputs = []
+    for analytic_normals in (False, True):
+      deformer = _cylinder(batch_deformer, analytic_normals)
+      deformer.bubble_y_gpu.assign(np.array([10.0], dtype=np.float32))
+      deformer.bubble_radius_gpu.assign(np.array([3.0], dtype=np.float32))
+      outputs.append(deformer.deform_all())
+    np.testing.assert_allclose(outputs[0], outputs[1], atol=1e-6)
+
+  def test_active_set_matches_full_deform(self, batch_deformer):
+    import numpy as np
+
+    normals = []
+    for active_set in (False, True):
+      deformer = batch_deformer(count=2, radial=16, height=24, active_set=active_set, analytic_normals=True)
+      deformer.bubble_y_gpu.assign(np.array([14.0, 22.0], dtype=np.float32))
+      deformer.bubble_radius_gpu.assign(np.array([3.0, 3.4], dtype=np.float32))
+      deformer.bend_angle_gpu.assign(np.array([0.2, 0.0], dtype=np.float32))
+      deformer.bend_axis_gpu.assign(np.array([[1.0, 0.0, 0.0], [1.0, 0.0, 0.0]], dtype=np.float32))
+      deformer.deform_all()
+      deformer.deform_all()  # clean tendroids keep their normals
+      assert deformer.analytic_normals
+      normals.append(deformer.out_normals_gpu.numpy()[:deformer.total_vertices])
+    np.testing.assert_allclose(normals[1], normals[0], atol=1e-6)
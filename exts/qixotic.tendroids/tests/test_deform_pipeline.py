@@ -0,0 +1,67 @@
+"""
+Tests for the pipelined (double-buffered) deform output
+
+On CUDA, the USD path must apply each frame's points exactly once and
+one frame late, in order.
+
+Run with: python -m pytest tests/test_deform_pipeline.py -v
+"""
+
+import pytest
+
+
+def _recording(batch_deformer, active_set):
+  deformer = batch_deformer(count=2, active_set=active_set)
+
+  # Record what the pipeline hands to the meshes
+  deformer.applied = []
+  deformer.apply_to_meshes = lambda points, dirty=None: deformer.applied.append(
+    (points.copy(), None if dirty is None else dirty.copy())
+  )
+  return deformer
+
+
+@pytest.mark.gpu
+@pytest.mark.requires_cuda
+class TestPipelinedOutput:
+  """Host path ordering and dirty-flag snapshots."""
+
+  @pytest.mark.parametrize("active_set", [False, True])
+  def test_frames_arrive_one_late_in_order(self, batch_deformer, active_set):
+    import numpy as np
+    from qixotic.tendroids.core.deform_pipeline import PipelinedDeformOutput
+
+    deformer = _recording(batch_deformer, active_set)
+    pipeline = PipelinedDeformOutput(deformer)
+    expected = []
+
+    for frame in range(4):
+      deformer.bubble_y_gpu.assign(np.array([5.0 * frame, 0.0], dtype=np.float32))
+      deformer.bubble_radius_gpu.assign(np.array([3.0, 2.0], dtype=np.float32))
+      expected.append(deformer.deform_all(download=True))
+      assert pipeline.present(None)
+      assert len(deformer.applied) == frame  # previous frame only
+
+    pipeline.flush()
+    assert len(deformer.applied) == 4
+    n = deformer.total_vertices
+    for (points, _), reference in zip(deformer.applied, expected):
+      np.testing.assert_allclose(points, reference[:n], atol=1e-6)
+
+    if active_set:
+      # Frame 0 forces both dirty; later frames only the bubbled tendroid
+      assert [int(d[:2].sum()) for _, d in deformer.applied] == [2, 1, 1, 1]
+
+  def test_layout_change_drops_pending(self, batch_deformer):
+    from qixotic.tendroids.core.deform_pipeline import PipelinedDeformOutput
+
+    deformer = _recording(batch_deformer, False)
+    pipeline = PipelinedDeformOutput(deformer)
+    deformer.deform_all(download=False)
+    pipeline.present(None)
+
+    deformer.remove_tendroid("t1")
+    deformer.deform_all(download=False)
+    pipeline.present(None)
+    pipeline.flush()
+    assert len(deformer.applied) == 1
@@ -23,6 +23,9 @@ from qixotic.tendroids.controllers.envelope_collision import (
     calculate_approach_velocity,
     is_glancing_contact,
     is_head_on_contact,
+    closest_points_between_segments,
+    capsule_capsule_collision,
+    tendroid_capsule,
 )
 from qixotic.tendroids.controllers.envelope_constants import (
     ENVELOPE_RADIUS,
@@ -464,3 +467,57 @@ class TestWaveMotionContact:
         
         # Should have mix of contact and no-contact
         assert any(contacts) and not all(contacts)
+
+
+# =============================================================================
+# Capsule vs Capsule (creature envelope vs tendroid)
+# =============================================================================
+
+class TestCapsuleCapsuleCollision:
+    """Segment-segment closest points and capsule overlap."""
+
+    def test_crossing_segments_meet_in_middle(self):
+        """Perpendicular crossing segments share their midpoint."""
+        a, b, s, t = closest_points_between_segments(
+            Vec3(-1, 0, 0), Vec3(1, 0, 0), Vec3(0, -1, 0), Vec3(0, 1, 0)
+        )
+        assert s == pytest.approx(0.5)
+        assert t == pytest.approx(0.5)
+        assert (a - b).length() == pytest.approx(0.0)
+
+    def test_parallel_segments_distance(self):
+        """Parallel segments report their separation."""
+        a, b, _, _ = closest_points_between_segments(
+            Vec3(0, 0, 0), Vec3(0, 10, 0), Vec3(3, 2, 0), Vec3(3, 8, 0)
+        )
+        assert (a - b).length() == pytest.approx(3.0)
+
+    def test_creature_beside_tendroid_hits(self, creature_capsule):
+        """Envelope overlapping a tendroid cylinder is a cylinder contact."""
+        tendroid = tendroid_capsule((10.0, 0.0, 0.0), 100.0, 5.0)
+        result = capsule_capsule_collision(creature_capsule, tendroid)
+
+        # Axis distance 10 - (6 + 5)
+        assert result.hit
+        assert result.distance == pytest.approx(-1.0)
+        assert result.contact_type == "cylinder"
+        assert result.contact_normal.x == pytest.approx(-1.0)
+
+    def test_creature_above_tendroid_touches_cap(self, creature_capsule):
+        """Envelope just above the tip contacts cap_b."""
+        tendroid = tendroid_capsule((0.0, 0.0, 0.0), 40.0, 2.0)
+        result = capsule_capsule_collision(creature_capsule, tendroid)
+
+        # Tip at y=40, envelope axis at y=50: 10 - (2 + 6)
+        assert result.hit is False
+        assert result.distance == pytest.approx(2.0)
+        assert result.contact_type == "cap_b"
+
+    def test_matches_point_test_for_zero_length_capsule(self, simple_capsule):
+        """A zero-height capsule behaves like a sphere."""
+        sphere = Capsule(center=Vec3(4, 0, 1), axis=Vec3(0, 0, 1), half_height=0.0, radius=1.0)
+        capsule_result = capsule_capsule_collision(sphere, simple_capsule, CONTACT_OFFSET)
+        sphere_result = sphere_capsule_collision(Vec3(4, 0, 1), 1.0, simple_capsule, CONTACT_OFFSET)
+
+        assert capsule_result.distance == pytest.approx(sphere_result.distance)
+        assert capsule_result.contact_type == sphere_result.contact_type
@@ -0,0 +1,91 @@
+"""
+Tests for multi-GPU field partitioning
+
+Tile partitioning must keep whole tiles together and balance counts;
+with two CUDA devices, a remote partition's deform must match the
+render device's and its scatter tables must mirror onto the render
+device.
+
+Run with: python -m pytest tests/test_field_partitions.py -v
+"""
+
+import math
+
+import pytest
+
+pytest.importorskip("warp")  # scene package pulls in the deformers
+
+from qixotic.tendroids.scene.field_partitions import partition_by_tiles
+
+
+def _grid_positions(nx=10, nz=10, spacing=10.0):
+  return [(x * spacing + 5.0, 0.0, z * spacing + 5.0) for z in range(nz) for x in range(nx)]
+
+
+class TestPartitionByTiles:
+  """XZ tile grouping."""
+
+  @pytest.mark.parametrize("devices", [1, 2, 3, 4])
+  def test_covers_every_tendroid_once(self, devices):
+    groups = partition_by_tiles(_grid_positions(), devices, 25.0)
+    assert len(groups) == devices
+    assert sorted(i for group in groups for i in group) == list(range(100))
+
+  @pytest.mark.parametrize("devices", [2, 3, 4])
+  def test_balanced(self, devices):
+    sizes = [len(group) for group in partition_by_tiles(_grid_positions(), devices, 25.0)]
+    assert max(sizes) - min(sizes) <= 12  # one tile-row segment of slack
+
+  def test_tiles_not_split(self):
+    positions = _grid_positions()
+    groups = partition_by_tiles(positions, 3, 25.0)
+    owner = {}
+    for g, group in enumerate(groups):
+      for i in group:
+        x, _, z = positions[i]
+        owner.setdefault((math.floor(x / 25.0), math.floor(z / 25.0)), set()).add(g)
+    assert all(len(parts) == 1 for parts in owner.values())
+
+  def test_fewer_tiles_than_devices(self):
+    assert partition_by_tiles([(1.0, 0.0, 1.0)] * 5, 3, 10.0) == [[0, 1, 2, 3, 4], [], []]
+
+  def test_empty_field(self):
+    assert partition_by_tiles([], 2, 10.0) == [[], []]
+
+
+def _bubbled(batch_deformer, device, fabric_index_base=0):
+  import numpy as np
+
+  deformer = batch_deformer(
+    height=12, device=device, active_set=False, fabric_index_base=fabric_index_base
+  )
+  deformer.bubble_y_gpu.assign(np.array([12.0, 20.0, 28.0], dtype=np.float32))
+  deformer.bubble_radius_gpu.assign(np.array([3.0, 3.5, 4.0], dtype=np.float32))
+  return deformer
+
+
+@pytest.mark.gpu
+@pytest.mark.requires_cuda(devices=2)
+class TestRemotePartition:
+  """Deform on cuda:1, deliver to cuda:0."""
+
+  def test_remote_deform_matches_render_device(self, batch_deformer):
+    import numpy as np
+
+    local = _bubbled(batch_deformer, "cuda:0").deform_all()
+    remote = _bubbled(batch_deformer, "cuda:1", fabric_index_base=1 << 20).deform_all()
+    np.testing.assert_allclose(remote, local, atol=1e-5)
+
+  def test_scatter_tables_mirrored(self, batch_deformer):
+    import numpy as np
+    from qixotic.tendroids.core.peer_points_delivery import PeerPointsDelivery
+
+    deformer = _bubbled(batch_deformer, "cuda:1", fabric_index_base=1 << 20)
+    delivery = PeerPointsDelivery(deformer, render_device="cuda:0")
+    assert delivery._ensure_tables()
+    assert str(delivery._vertex_tendroid_ids.device) == "cuda:0"
+    np.testing.assert_array_equal(
+      delivery._vertex_tendroid_ids.numpy(), deformer.vertex_tendroid_ids_gpu.numpy()
+    )
+    np.testing.assert_array_equal(delivery._vertex_offsets.numpy(), deformer.vertex_offsets_gpu.numpy())
+    delivery.destroy()
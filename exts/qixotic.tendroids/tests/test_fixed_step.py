@@ -0,0 +1,122 @@
+"""
+Tests for fixed-rate simulation with render-rate interpolation
+
+FixedStepScheduler must run a display-rate independent number of sim
+steps; on CUDA, DeformInterpolator must blend the batch deformer's
+inputs between the last two committed steps.
+
+Run with: python -m pytest tests/test_fixed_step.py -v
+"""
+
+import pytest
+
+pytest.importorskip("warp")  # scene package pulls in the deformers
+
+from qixotic.tendroids.scene.fixed_step_scheduler import FixedStepScheduler
+
+
+class TestFixedStepScheduler:
+  """Accumulator substepping."""
+
+  @pytest.mark.parametrize("display_hz", [30.0, 60.0, 144.0, 240.0])
+  def test_steps_independent_of_display_rate(self, display_hz):
+    scheduler = FixedStepScheduler(rate_hz=60.0)
+    steps = sum(scheduler.advance(1.0 / display_hz) for _ in range(int(display_hz * 2)))
+    assert abs(steps - 120) <= 1
+    assert 0.0 <= scheduler.alpha < 1.0
+
+  def test_matching_rate_steps_every_frame(self):
+    scheduler = FixedStepScheduler(rate_hz=60.0)
+    assert [scheduler.advance(1.0 / 60.0) for _ in range(100)] == [1] * 100
+
+  def test_alpha_is_leftover_fraction(self):
+    scheduler = FixedStepScheduler(rate_hz=30.0)
+    assert scheduler.advance(1.0 / 60.0) == 0
+    assert scheduler.alpha == pytest.approx(0.5)
+    assert scheduler.advance(1.0 / 120.0) == 0
+    assert scheduler.alpha == pytest.approx(0.75)
+    assert scheduler.advance(1.0 / 60.0) == 1
+    assert scheduler.alpha == pytest.approx(0.25)
+
+  def test_frame_drop_clamped(self):
+    scheduler = FixedStepScheduler(rate_hz=60.0, max_substeps=4)
+    assert scheduler.advance(0.5) == 4
+    assert scheduler.dropped_time == pytest.approx(0.5 - 4.0 / 60.0, abs=1e-9)
+    assert scheduler.alpha < 1.0
+
+  def test_same_steps_for_any_frame_pacing(self):
+    smooth, hitchy = FixedStepScheduler(60.0), FixedStepScheduler(60.0)
+    smooth_steps = sum(smooth.advance(0.01) for _ in range(50))
+    hitchy_steps = sum(hitchy.advance(dt) for dt in [0.05, 0.002, 0.048, 0.03, 0.07] * 2 + [0.05, 0.05])
+    assert smooth_steps == hitchy_steps == 30
+
+  def test_invalid_rate_kept(self):
+    scheduler = FixedStepScheduler(rate_hz=30.0)
+    scheduler.set_rate(0.0)
+    assert scheduler.rate_hz == 30.0
+
+
+def _set_inputs(deformer, bubble_y, radius, wave_dx, bend):
+  import numpy as np
+
+  deformer.bubble_y_gpu.assign(np.array(bubble_y, dtype=np.float32))
+  deformer.bubble_radius_gpu.assign(np.array(radius, dtype=np.float32))
+  deformer.wave_dx_gpu.assign(np.array(wave_dx, dtype=np.float32))
+  deformer.bend_angle_gpu.assign(np.array(bend, dtype=np.float32))
+  deformer.bend_axis_gpu.assign(np.array([[1.0, 0.0, 0.0]] * 2, dtype=np.float32))
+
+
+@pytest.mark.gpu
+@pytest.mark.requires_cuda
+class TestDeformInterpolator:
+  """Blended deform inputs between two committed sim steps."""
+
+  def test_blends_and_snaps_respawned_bubbles(self, batch_deformer):
+    import numpy as np
+    from qixotic.tendroids.core.deform_interpolator import DeformInterpolator
+
+    deformer = batch_deformer(count=2, active_set=False)
+    interpolator = DeformInterpolator(deformer)
+
+    _set_inputs(deformer, [10.0, 30.0], [3.0, 3.0], [0.0, 1.0], [0.0, 0.2])
+    interpolator.commit()
+    _set_inputs(deformer, [14.0, 5.0], [4.0, 2.5], [2.0, 3.0], [0.4, 0.2])
+    interpolator.commit()
+
+    with interpolator.interpolated(0.25):
+      np.testing.assert_allclose(deformer.bubble_y_gpu.numpy(), [11.0, 5.0], atol=1e-6)
+      np.testing.assert_allclose(deformer.bubble_radius_gpu.numpy(), [3.25, 2.5], atol=1e-6)
+      np.testing.assert_allclose(deformer.wave_dx_gpu.numpy(), [0.5, 1.5], atol=1e-6)
+      np.testing.assert_allclose(deformer.bend_angle_gpu.numpy(), [0.1, 0.2], atol=1e-6)
+
+    # Latest step's bend stays in the deformer's own arrays
+    np.testing.assert_allclose(deformer.bend_angle_gpu.numpy(), [0.4, 0.2], atol=1e-6)
+
+  def test_end_points_match_sim_steps(self, batch_deformer):
+    import numpy as np
+    from qixotic.tendroids.core.deform_interpolator import DeformInterpolator
+
+    deformer = batch_deformer(count=2, active_set=False)
+    interpolator = DeformInterpolator(deformer)
+    steps = []
+    for y in (8.0, 12.0):
+      _set_inputs(deformer, [y, y], [3.0, 3.0], [y * 0.1, 0.0], [0.0, 0.0])
+      interpolator.commit()
+      steps.append(deformer.deform_all().copy())
+
+    for alpha, expected in ((0.0, steps[0]), (1.0, steps[1])):
+      with interpolator.interpolated(alpha):
+        np.testing.assert_allclose(deformer.deform_all(), expected, atol=1e-5)
+
+  def test_first_commit_holds_state(self, batch_deformer):
+    import numpy as np
+    from qixotic.tendroids.core.deform_interpolator import DeformInterpolator
+
+    deformer = batch_deformer(count=2, active_set=False)
+    interpolator = DeformInterpolator(deformer)
+    assert not interpolator.ready
+
+    _set_inputs(deformer, [6.0, 9.0], [3.0, 3.0], [0.0, 0.0], [0.0, 0.0])
+    interpolator.commit()
+    with interpolator.interpolated(0.5):
+      np.testing.assert_allclose(deformer.bubble_y_gpu.numpy(), [6.0, 9.0], atol=1e-6)
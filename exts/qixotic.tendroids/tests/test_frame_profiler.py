@@ -0,0 +1,67 @@
+"""
+Tests for the per-stage frame profiler (host timing path)
+
+Run with: python -m pytest tests/test_frame_profiler.py -v
+"""
+
+import json
+
+import pytest
+
+pytest.importorskip("numpy")
+
+from qixotic.tendroids.utils.frame_profiler import FrameProfiler
+
+
+def _run_frames(profiler, frames, stages=("physics", "deform")):
+  for _ in range(frames):
+    profiler.begin_frame()
+    for name in stages:
+      with profiler.stage(name):
+        pass
+    profiler.end_frame()
+
+
+class TestFrameProfiler:
+  """Ring buffer, percentiles and trace export."""
+
+  def test_stage_percentiles(self):
+    profiler = FrameProfiler(capacity=16)
+    _run_frames(profiler, 10)
+
+    data = profiler.get_profile_data()
+    assert data['frames'] == 10
+    assert list(data['stages']) == ["physics", "deform"]
+    host = data['stages']['deform']['host_ms']
+    assert data['stages']['deform']['count'] == 10
+    assert 0.0 <= host['p50'] <= host['p95'] <= host['p99'] <= host['max']
+    assert data['stages']['deform']['device_ms'] is None  # host-only profiler
+
+  def test_ring_buffer_wraps(self):
+    profiler = FrameProfiler(capacity=4)
+    _run_frames(profiler, 9)
+    assert profiler.get_profile_data()['frames'] == 4
+
+  def test_repeated_stage_accumulates(self):
+    profiler = FrameProfiler(capacity=4)
+    _run_frames(profiler, 1, stages=("write", "write"))
+    assert profiler.get_profile_data()['stages']['write']['count'] == 1
+
+  def test_stage_outside_frame_is_ignored(self):
+    profiler = FrameProfiler(capacity=4)
+    with profiler.stage("early"):
+      pass
+    assert profiler.get_profile_data()['frames'] == 0
+
+  def test_chrome_trace(self, tmp_path):
+    profiler = FrameProfiler(capacity=8)
+    _run_frames(profiler, 3)
+    path = tmp_path / "trace.json"
+
+    assert profiler.export_chrome_trace(str(path))
+    events = json.loads(path.read_text())['traceEvents']
+    assert len(events) == 6
+    assert {e['name'] for e in events} == {"physics", "deform"}
+    assert all(e['ph'] == 'X' and e['dur'] >= 0.0 for e in events)
+    frames = [e['args']['frame'] for e in events]
+    assert frames == sorted(frames)
@@ -0,0 +1,216 @@
+"""
+Tests for frustum culling and distance LOD
+
+Plane extraction runs on the host; the skip-flag tests need CUDA. The
+LOD mesh variant tests run on every available device.
+
+Run with: python -m pytest tests/test_frustum_culling.py -v
+"""
+
+import pytest
+
+
+def _ortho(half_extent):
+  """View-projection mapping a cube of +/- half_extent to clip space."""
+  import numpy as np
+  return np.diag([1.0 / half_extent] * 3 + [1.0])
+
+
+def _inside(planes, point):
+  import numpy as np
+  return bool(np.all(planes[:, :3] @ np.asarray(point) + planes[:, 3] >= 0.0))
+
+
+class TestFrustumPlanes:
+  """Plane extraction from a row-vector view-projection."""
+
+  def setup_method(self):
+    pytest.importorskip("warp")
+
+  def test_identity_is_clip_cube(self):
+    import numpy as np
+    from qixotic.tendroids.core.frustum_culler import frustum_planes
+
+    planes = frustum_planes(np.identity(4))
+    assert planes.shape == (6, 4)
+    assert _inside(planes, (0.0, 0.0, 0.0))
+    assert _inside(planes, (0.99, -0.99, 0.5))
+    assert not _inside(planes, (1.5, 0.0, 0.0))
+    assert not _inside(planes, (0.0, 0.0, -1.5))
+
+  def test_planes_are_normalized(self):
+    import numpy as np
+    from qixotic.tendroids.core.frustum_culler import frustum_planes
+
+    planes = frustum_planes(_ortho(250.0))
+    np.testing.assert_allclose(np.linalg.norm(planes[:, :3], axis=1), 1.0, atol=1e-6)
+    assert _inside(planes, (249.0, 0.0, 0.0))
+    assert not _inside(planes, (251.0, 0.0, 0.0))
+
+  def test_lod_interval_count_checked(self):
+    from qixotic.tendroids.core.frustum_culler import FrustumCuller
+
+    with pytest.raises(ValueError):
+      FrustumCuller(device="cpu", lod_distances=(100.0,), lod_intervals=(1,))
+
+
+NEAR_AND_FAR = [(0.0, 0.0, 0.0), (1000.0, 0.0, 0.0)]
+
+
+@pytest.mark.gpu
+@pytest.mark.requires_cuda
+class TestCulledDeform:
+  """Skip flags gate the active-set work list."""
+
+  def test_offscreen_tendroid_waits(self, batch_deformer):
+    """Off screen with interval 0 never deforms until culling is off."""
+    from qixotic.tendroids.core.frustum_culler import FrustumCuller
+
+    deformer = batch_deformer(positions=NEAR_AND_FAR, active_set=True)
+    culler = FrustumCuller(offscreen_interval=0)
+    assert deformer.attach_culler(culler)
+
+    culler.begin_frame(_ortho(100.0), (0.0, 20.0, 0.0))
+    deformer.deform_all()
+    assert list(deformer.get_dirty_flags()[:2]) == [1, 0]
+
+    culler.begin_frame()
+    deformer.deform_all()
+    assert list(deformer.get_dirty_flags()[:2]) == [0, 1]
+
+  def test_distant_tendroid_runs_at_lod_rate(self, batch_deformer):
+    """LOD 1 runs every other frame, staggered by slot."""
+    from qixotic.tendroids.core.frustum_culler import FrustumCuller
+
+    deformer = batch_deformer(positions=NEAR_AND_FAR, active_set=True)
+    culler = FrustumCuller(lod_distances=(600.0,), lod_intervals=(1, 2))
+    deformer.attach_culler(culler)
+
+    culler.begin_frame(_ortho(2000.0), (0.0, 20.0, 0.0))
+    deformer.deform_all()
+    assert list(deformer.get_lod_levels()[:2]) == [0, 1]
+    assert list(deformer.get_dirty_flags()[:2]) == [1, 0]
+
+    culler.begin_frame(_ortho(2000.0), (0.0, 20.0, 0.0))
+    deformer.deform_all()
+    assert list(deformer.get_dirty_flags()[:2]) == [0, 1]
+
+  def test_attach_requires_active_set(self):
+    from qixotic.tendroids.core.batch_warp_deformer import BatchWarpDeformer
+    from qixotic.tendroids.core.frustum_culler import FrustumCuller
+
+    assert not BatchWarpDeformer(active_set=False).attach_culler(FrustumCuller())
+
+
+def _add_variant(deformer, name, level, device):
+  """Register a 6x5-segment mesh of tendroid name as LOD level."""
+  import types
+  from qixotic.tendroids.builders.cylinder_generator import CylinderGenerator
+  from qixotic.tendroids.core.warp_deformer import V2WarpDeformer
+
+  tendroid = deformer.tendroids[deformer.name_to_index[name]]
+  points, _, _, _ = CylinderGenerator.create_cylinder_arrays(2.0, 40.0, 6, 5)
+  variant = types.SimpleNamespace(
+    name=f"{name}_lod{level}", position=tendroid.position, radius=2.0, length=40.0,
+    deformer=V2WarpDeformer(points, 2.0, 40.0, 0.8, 0.9, device=device),
+  )
+  return deformer.add_lod_variant(name, level, variant, points)
+
+
+class TestLodSegments:
+  """Reduced segment counts per level."""
+
+  def test_halves_per_level_with_floor(self):
+    from qixotic.tendroids.builders.tendroid_builder import V2TendroidBuilder
+
+    assert V2TendroidBuilder.lod_segments(24, 48, 0) == (24, 48)
+    assert V2TendroidBuilder.lod_segments(24, 48, 1) == (12, 24)
+    assert V2TendroidBuilder.lod_segments(24, 48, 3) == (6, 6)
+    assert V2TendroidBuilder.lod_segments(24, 48, 5) == (6, 4)
+    assert V2TendroidBuilder.lod_segments(4, 2, 2) == (4, 2)  # never above full resolution
+
+
+class TestLodVariants:
+  """One deformed (shown) mesh per tendroid."""
+
+  def _culled(self, batch_deformer, device, lod_intervals=(1, 4)):
+    from qixotic.tendroids.core.frustum_culler import FrustumCuller
+
+    deformer = batch_deformer(positions=NEAR_AND_FAR, active_set=True, device=device)
+    culler = FrustumCuller(
+      device=device, lod_distances=(600.0,), lod_intervals=lod_intervals, switch_interval=1
+    )
+    assert deformer.attach_culler(culler)
+    variants = [_add_variant(deformer, f"t{i}", 1, device) for i in range(2)]
+    return deformer, culler, variants
+
+  def _frame(self, deformer, culler):
+    culler.begin_frame(_ortho(2000.0), (0.0, 20.0, 0.0))
+    switched = culler.switch_lod_meshes(deformer)
+    deformer.deform_all()
+    return switched, deformer.get_dirty_flags()
+
+  def test_variants_take_own_slots(self, batch_deformer, device):
+    deformer, _, variants = self._culled(batch_deformer, device)
+
+    assert None not in variants
+    assert len(set(variants) | {0, 1}) == 4
+    assert deformer.has_lod_variants
+    assert [deformer.vertex_counts[s] for s in variants] == [36, 36]
+    assert _add_variant(deformer, "t0", 1, device) == variants[0]
+
+  def test_only_shown_level_deforms(self, batch_deformer, device):
+    deformer, culler, (near_lod, far_lod) = self._culled(batch_deformer, device)
+
+    switched, dirty = self._frame(deformer, culler)
+    assert switched == 0
+    assert list(deformer.get_lod_levels()[:2]) == [0, 1]
+    assert [dirty[0], dirty[1], dirty[near_lod], dirty[far_lod]] == [1, 1, 0, 0]
+
+    # Far tendroid switches to its variant, which catches up at once
+    switched, dirty = self._frame(deformer, culler)
+    assert switched == 1
+    assert [dirty[0], dirty[1], dirty[near_lod], dirty[far_lod]] == [0, 0, 0, 1]
+
+    # Culling off: everything back to level 0
+    culler.begin_frame()
+    deformer.deform_all()
+    culler.begin_frame()
+    assert culler.switch_lod_meshes(deformer) == 1
+    deformer.deform_all()
+    dirty = deformer.get_dirty_flags()
+    assert [dirty[1], dirty[far_lod]] == [0, 0]  # level 0 output still current
+
+  def test_switch_toggles_visibility(self, batch_deformer, device, monkeypatch):
+    from qixotic.tendroids.core.batch_warp_deformer import BatchWarpDeformer
+
+    calls = []
+    monkeypatch.setattr(
+      BatchWarpDeformer, "_set_mesh_visible",
+      staticmethod(lambda tendroid, visible: calls.append((tendroid.name, visible)))
+    )
+    deformer, culler, _ = self._culled(batch_deformer, device)
+
+    self._frame(deformer, culler)
+    self._frame(deformer, culler)
+    assert calls == [("t1", False), ("t1_lod1", True)]
+
+  def test_variants_follow_tendroid_bubble(self, batch_deformer, device):
+    deformer, _, (near_lod, far_lod) = self._culled(batch_deformer, device)
+
+    deformer.bind_bubble_slots({"t0": 3, "t1": 5})
+
+    ids = deformer.tendroid_bubble_ids_gpu.numpy()
+    assert [ids[0], ids[1], ids[near_lod], ids[far_lod]] == [3, 5, 3, 5]
+
+  def test_remove_takes_variants(self, batch_deformer, device):
+    deformer, _, (near_lod, far_lod) = self._culled(batch_deformer, device)
+
+    assert deformer.remove_tendroid("t1")
+
+    assert "t1_lod1" not in deformer.name_to_index
+    assert deformer.vertex_counts[far_lod] == 0
+    assert deformer.lod_variant_gpu.numpy()[far_lod] == -1
+    assert deformer.remove_tendroid("t0_lod1")
+    assert not deformer.has_lod_variants
+    assert deformer.lod_variant_gpu.numpy()[[0, near_lod]].tolist() == [-1, -1]
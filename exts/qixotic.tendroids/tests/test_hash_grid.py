@@ -36,6 +36,9 @@ class MockWarpArray:
   def shape(self):
     return self._shape
 
+  def assign(self, data):
+    self._data = list(data)
+
   def numpy(self):
     return self._data
 
@@ -88,6 +91,18 @@ class MockWarp:
   def kernel(func):
     return func  # Return function unchanged
 
+  @staticmethod
+  def func(func):
+    return func
+
+  @staticmethod
+  def constant(value):
+    return value
+
+  @staticmethod
+  def copy(dest, src, dest_offset=0, src_offset=0, count=0):
+    pass
+
 
 # ============================================================================
 # Test Configuration
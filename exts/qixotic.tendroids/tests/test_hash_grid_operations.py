@@ -35,6 +35,9 @@ class MockWarpArray:
   def shape(self):
     return self._shape
 
+  def assign(self, data):
+    self._data = list(data)
+
 
 class MockHashGrid:
   """Mock warp.HashGrid."""
@@ -82,6 +85,18 @@ class MockWarp:
   def kernel(func):
     return func
 
+  @staticmethod
+  def func(func):
+    return func
+
+  @staticmethod
+  def constant(value):
+    return value
+
+  @staticmethod
+  def copy(dest, src, dest_offset=0, src_offset=0, count=0):
+    pass
+
 
 # Install mocks
 sys.modules['warp'] = MockWarp
@@ -0,0 +1,126 @@
+"""
+Tests for live parameter updates
+
+Config diffs must route bubble changes live and flag build-time
+sections; on CUDA, in-place deformer and bubble patches must match a
+scene built with the new values and keep the device buffers.
+
+Run with: python -m pytest tests/test_live_params.py -v
+"""
+
+import pytest
+
+pytest.importorskip("warp")  # scene package pulls in the deformers
+
+from qixotic.tendroids.scene.live_params import diff_config, is_live_bubble_key
+
+
+class TestConfigDiff:
+  """tendroids_config.json change routing."""
+
+  def test_bubble_changes_only(self):
+    old = {"bubble_system": {"rise_speed": 60.0, "min_pop_height": 150.0}, "sea_floor": {"seed": 42}}
+    new = {"bubble_system": {"rise_speed": 80.0, "min_pop_height": 150.0}, "sea_floor": {"seed": 42}}
+    assert diff_config(old, new) == ({"rise_speed": 80.0}, False)
+
+  def test_build_time_section_needs_rebuild(self):
+    old = {"tendroid_geometry": {"radial_resolution": 32}}
+    new = {"tendroid_geometry": {"radial_resolution": 48}}
+    assert diff_config(old, new) == ({}, True)
+
+  def test_animation_section_needs_rebuild(self):
+    old = {"tendroid_animation": {"wave_speed": 40.0}}
+    new = {"tendroid_animation": {"wave_speed": 55.0}}
+    assert diff_config(old, new) == ({}, True)
+
+  def test_unrouted_section_needs_rebuild(self):
+    assert diff_config({}, {"lighting": {"exposure": 1.0}}) == ({}, True)
+    assert diff_config({"title": "a"}, {"title": "b"}) == ({}, False)
+
+  def test_live_keys(self):
+    assert is_live_bubble_key("rise_speed")
+    assert is_live_bubble_key("max_pop_height")
+    assert not is_live_bubble_key("max_particles")
+    assert not is_live_bubble_key("resolution")
+
+
+# bubble_system keys in tendroids_config.json without a V2BubbleConfig field
+JSON_ONLY_BUBBLE_KEYS = {
+  "max_diameter": 24.0, "min_diameter": 4.0, "emission_threshold": 0.8,
+  "release_threshold": 0.9, "enabled": False, "metallic": 0.5, "roughness": 0.4,
+  "use_warp_particles": False,
+}
+
+
+class TestSceneRouting:
+  """V2SceneManager reports unrouted changes as needing a rebuild."""
+
+  @pytest.mark.parametrize("key", sorted(JSON_ONLY_BUBBLE_KEYS))
+  def test_unknown_bubble_key_needs_rebuild(self, key):
+    from qixotic.tendroids.bubbles import DEFAULT_V2_BUBBLE_CONFIG
+    from qixotic.tendroids.scene.manager import V2SceneManager
+
+    assert V2SceneManager().update_bubble_params(**{key: JSON_ONLY_BUBBLE_KEYS[key]}) is False
+    assert not hasattr(DEFAULT_V2_BUBBLE_CONFIG, key)
+
+  def test_reload_animation_change_needs_rebuild(self, monkeypatch):
+    import copy
+    from qixotic.tendroids.config import ConfigLoader
+    from qixotic.tendroids.scene.manager import V2SceneManager
+
+    manager = V2SceneManager()
+    new = copy.deepcopy(manager._applied_config)
+    new.setdefault("tendroid_animation", {})["wave_speed"] = 99.0
+    monkeypatch.setattr(ConfigLoader, "reload", classmethod(lambda cls: new))
+
+    assert manager.reload_config() is False
+    assert manager._applied_config == new
+
+
+def _deform(deformer):
+  import numpy as np
+
+  deformer.bubble_y_gpu.assign(np.array([12.0, 20.0, 28.0], dtype=np.float32))
+  deformer.bubble_radius_gpu.assign(np.array([3.0, 3.5, 4.0], dtype=np.float32))
+  return deformer.deform_all().copy()
+
+
+@pytest.mark.gpu
+@pytest.mark.requires_cuda
+class TestLiveUpdates:
+  """In-place device patches vs. rebuilt state."""
+
+  @pytest.mark.parametrize("active_set", [False, True])
+  def test_deform_params_match_rebuild(self, batch_deformer, active_set):
+    import numpy as np
+
+    deformer = batch_deformer(height=12, active_set=active_set)
+    buffer = deformer.max_amplitude_gpu
+    _deform(deformer)
+
+    assert deformer.update_deform_params(max_amplitude=1.3, bulge_width=0.6) == 3
+    assert deformer.max_amplitude_gpu is buffer
+    assert all(t.deformer.max_amplitude == pytest.approx(1.3) for t in deformer.tendroids)
+
+    rebuilt = batch_deformer(height=12, max_amplitude=1.3, bulge_width=0.6, active_set=active_set)
+    np.testing.assert_allclose(_deform(deformer), _deform(rebuilt), atol=1e-5)
+
+  def test_bubble_params_leave_state(self):
+    import numpy as np
+    from qixotic.tendroids.bubbles.bubble_gpu_manager import BubbleGPUManager
+
+    manager = BubbleGPUManager(max_bubbles=4)
+    manager.register_bubbles(
+      [0, 1, 2], [(0.0, 0.0, 0.0)] * 3, [40.0] * 3, [2.0] * 3,
+      [4.0] * 3, [200.0] * 3, [24.0] * 3, [3.6] * 3,
+    )
+    manager.update_bubble_states([1], [15.0], [2])
+
+    assert manager.update_bubble_params([1, 2, 9], [5.0, 6.0, 7.0], [300.0, 310.0, 0.0],
+                                        [20.0, 22.0, 0.0], [4.0, 4.2, 0.0]) == 2
+    np.testing.assert_allclose(manager.pop_heights_gpu.numpy()[:3], [200.0, 300.0, 310.0])
+    np.testing.assert_allclose(manager.spawn_heights_gpu.numpy()[:3], [4.0, 5.0, 6.0])
+    np.testing.assert_allclose(manager.max_radii_gpu.numpy()[:3], [3.6, 4.0, 4.2], rtol=1e-6)
+    assert manager.phases_gpu.numpy()[:3].tolist() == [1, 2, 1]
+    np.testing.assert_allclose(manager.y_positions_gpu.numpy()[:3], [4.0, 15.0, 4.0])
+    manager.destroy()
@@ -0,0 +1,109 @@
+"""
+Tests for the device free-list and dead-list of pop particles
+
+Verifies (on CPU, and on CUDA when available) that spawn_spray pops
+slots from the device stack without handing one out twice, that expired
+particles come back through collect_dead_slots, and that the host free
+count mirrors the device one.
+
+Run with: python -m pytest tests/test_pop_particle_free_list.py -v
+"""
+
+import pytest
+
+
+def _manager(device, max_particles=8):
+  from qixotic.tendroids.bubbles.pop_particle_gpu_manager import PopParticleGPUManager
+  return PopParticleGPUManager(max_particles=max_particles, device=device)
+
+
+def _spray(manager, count, lifetime=1.0):
+  return manager.spawn_spray((0.0, 1.0, 0.0), [0.0, 0.5, 0.0], count, 2.0, 45.0, lifetime)
+
+
+def _device_free_count(manager):
+  return int(manager.free_count_gpu.numpy()[0])
+
+
+class TestPopParticleFreeList:
+  """Slot lifecycle through the device stack."""
+
+  def test_spawn_beyond_capacity(self, device):
+    """Only the free slots are claimed, each once."""
+    manager = _manager(device, 8)
+
+    slots = _spray(manager, 12)
+
+    assert sorted(slots) == list(range(8))
+    assert manager.get_free_count() == 0
+    assert _device_free_count(manager) == 0
+    assert _spray(manager, 3) == []
+    assert manager.alive_flags_gpu.numpy().tolist() == [1] * 8
+
+  def test_expired_particles_collected(self, device):
+    """Particles past their lifetime come back through the dead list."""
+    import warp as wp
+
+    manager = _manager(device, 8)
+    slots = _spray(manager, 4)
+    lifetimes = manager.lifetimes_gpu.numpy()
+    short = slots[:2]
+    lifetimes[short] = 0.01
+    manager.lifetimes_gpu.assign(wp.array(lifetimes, dtype=float, device=manager.device))
+
+    dead = manager.update(0.05)
+
+    assert sorted(dead) == sorted(short)
+    assert manager.active_slots == set(slots[2:])
+    assert manager.get_free_count() == 6
+    assert _device_free_count(manager) == 6
+    assert manager.collect_dead_slots() == []
+
+  def test_frame_pipeline_update_collects(self, device):
+    """launch_update_frame + collect_dead_slots frees every expired slot."""
+    import warp as wp
+
+    manager = _manager(device, 8)
+    slots = _spray(manager, 5, lifetime=0.1)
+    frame_params = wp.array([0.5], dtype=float, device=manager.device)
+
+    manager.launch_update_frame(frame_params)
+    dead = manager.collect_dead_slots()
+
+    assert sorted(dead) == sorted(slots)
+    assert manager.get_free_count() == 8
+    assert _device_free_count(manager) == 8
+
+  def test_slot_never_handed_out_twice(self, device):
+    """Interleaved spawns and deaths never reuse a live slot."""
+    manager = _manager(device, 16)
+    live = set()
+
+    for frame in range(40):
+      spawned = _spray(manager, 1 + frame % 7, lifetime=0.3)
+      assert len(spawned) == len(set(spawned))
+      assert not live & set(spawned)
+      live.update(spawned)
+
+      dead = manager.update(0.1)
+      assert set(dead) <= live
+      live.difference_update(dead)
+
+      assert manager.active_slots == live
+      assert manager.get_free_count() == 16 - len(live)
+      assert _device_free_count(manager) == manager.get_free_count()
+
+    free = manager.free_list_gpu.numpy()[:manager.get_free_count()].tolist()
+    assert len(set(free)) == len(free)
+    assert not live & set(free)
+
+  def test_clear_all_refills_stack(self, device):
+    """clear_all returns every slot to the device stack."""
+    manager = _manager(device, 8)
+    _spray(manager, 6)
+
+    manager.clear_all()
+
+    assert manager.get_free_count() == 8
+    assert _device_free_count(manager) == 8
+    assert sorted(_spray(manager, 8)) == list(range(8))
@@ -0,0 +1,126 @@
+"""
+Tests for the procedural batch deform mode
+
+Verifies terrain offset extraction from builder cylinders and (on
+CUDA) that procedural rest-pose reconstruction matches the stored
+base points deform output.
+
+Run with: python -m pytest tests/test_procedural_deform.py -v
+"""
+
+import pytest
+
+
+def _geometry(radius=2.0, length=40.0, radial=8, height=12):
+  return {
+    'radius': radius,
+    'length': length,
+    'radial_segments': radial,
+    'height_segments': height,
+    'flare_height_percent': 15.0,
+    'flare_radius_multiplier': 2.0,
+    'flare_height': length * 0.15,
+  }
+
+
+def _points(geometry):
+  from qixotic.tendroids.builders.cylinder_generator import CylinderGenerator
+
+  points, _, _, _ = CylinderGenerator.create_cylinder_arrays(
+    geometry['radius'], geometry['length'],
+    geometry['radial_segments'], geometry['height_segments'],
+    geometry['flare_height_percent'], geometry['flare_radius_multiplier']
+  )
+  return points
+
+
+def _conformed(geometry, position=(5.0, 1.0, -3.0)):
+  from qixotic.tendroids.builders.terrain_conform import conform_base_to_terrain
+
+  return conform_base_to_terrain(
+    _points(geometry), position, geometry['flare_height'],
+    geometry['radial_segments'], geometry['height_segments'],
+    lambda x, z: 1.0 + 0.1 * x - 0.05 * z
+  )
+
+
+class TestTerrainOffsets:
+  """Host-side flare offset table extraction."""
+
+  def test_flat_cylinder_has_no_offsets(self):
+    """Unconformed points produce an empty table."""
+    pytest.importorskip("warp")
+    from qixotic.tendroids.core.procedural_deform_kernel import extract_terrain_offsets
+
+    geometry = _geometry()
+    offsets, rings = extract_terrain_offsets(_points(geometry), geometry)
+
+    assert rings == 0
+    assert offsets.size == 0
+
+  def test_conformed_offsets_cover_flare_only(self):
+    """Offsets stop at the flare and rebuild the conformed Y."""
+    pytest.importorskip("warp")
+    from qixotic.tendroids.core.procedural_deform_kernel import extract_terrain_offsets
+
+    geometry = _geometry()
+    rest = _points(geometry)
+    conformed = _conformed(geometry)
+    offsets, rings = extract_terrain_offsets(conformed, geometry)
+
+    radial = geometry['radial_segments']
+    assert 0 < rings < geometry['height_segments'] + 1
+    assert offsets.size == rings * radial
+    assert rest[:rings * radial, 1] + offsets == pytest.approx(conformed[:rings * radial, 1], abs=1e-5)
+
+  def test_rejects_non_builder_points(self):
+    """Points that are not the parametric cylinder are refused."""
+    pytest.importorskip("warp")
+    from qixotic.tendroids.core.procedural_deform_kernel import extract_terrain_offsets
+
+    geometry = _geometry()
+    points = _points(geometry)
+    points[5, 0] += 1.0
+
+    assert extract_terrain_offsets(points, geometry) is None
+    assert extract_terrain_offsets(points[:-1], geometry) is None
+
+
+@pytest.mark.gpu
+@pytest.mark.requires_cuda
+class TestProceduralParity:
+  """Procedural and stored modes deform identically."""
+
+  def _deformer(self, batch_deformer, procedural, specs, pass_geometry=True):
+    return batch_deformer(
+      meshes=[(points, geometry) for geometry, points in specs],
+      geometry=pass_geometry, procedural=procedural,
+    )
+
+  def test_matches_stored_rest_points(self, batch_deformer):
+    """Bulged, waved tendroids of different resolutions agree."""
+    import numpy as np
+
+    g0 = _geometry()
+    g1 = _geometry(radius=1.5, length=30.0, radial=6, height=20)
+    specs = [(g0, _conformed(g0)), (g1, _points(g1))]
+
+    outputs = []
+    for procedural in (False, True):
+      deformer = self._deformer(batch_deformer, procedural, specs)
+      assert deformer.procedural == procedural
+
+      deformer.bubble_y_gpu.assign(np.array([10.0, 20.0], dtype=np.float32))
+      deformer.bubble_radius_gpu.assign(np.array([3.0, 2.5], dtype=np.float32))
+      deformer.wave_dx_gpu.assign(np.array([0.5, -0.3], dtype=np.float32))
+      outputs.append(deformer.deform_all())
+
+    np.testing.assert_allclose(outputs[1], outputs[0], atol=1e-4)
+
+  def test_falls_back_without_geometry(self, batch_deformer):
+    """Missing builder data keeps the stored path."""
+    g0 = _geometry()
+    deformer = self._deformer(batch_deformer, True, [(g0, _points(g0))], pass_geometry=False)
+
+    assert not deformer.procedural
+    assert deformer.base_points_gpu is not None
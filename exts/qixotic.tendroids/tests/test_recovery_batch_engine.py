@@ -0,0 +1,168 @@
+"""
+Tests for the structure-of-arrays recovery engine
+
+RecoveryBatchEngine must reproduce the scalar approach tracker, velocity
+fade, repulsion, input lock and recovery completion helpers pair by pair.
+
+Run with: python -m pytest tests/test_recovery_batch_engine.py -v
+"""
+
+import sys
+from unittest.mock import MagicMock
+
+import pytest
+
+np = pytest.importorskip("numpy")
+
+# The recovery package imports proximity (Warp kernels) on load
+try:
+    import warp  # noqa: F401
+except ImportError:
+    sys.modules['warp'] = MagicMock()
+
+from qixotic.tendroids.contact.approach_tracker_helpers import (
+    ApproachTrackerStatus,
+    TendroidSurfacePoint,
+    start_tracking,
+    update_distance,
+    update_surface_point,
+    calculate_distance_to_surface,
+)
+from qixotic.tendroids.contact.color_effect_helpers import ColorEffectState, ColorEffectStatus
+from qixotic.tendroids.contact.input_lock_helpers import (
+    InputLockStatus,
+    lock_input_on_contact,
+    sync_lock_from_color_state,
+)
+from qixotic.tendroids.contact.repulsion_helpers import calculate_repulsion
+from qixotic.tendroids.contact.velocity_fade_helpers import (
+    FadeMode,
+    VelocityFadeConfig,
+    VelocityFadeStatus,
+    apply_initial_velocity,
+    update_velocity,
+    velocity_from_force,
+)
+from qixotic.tendroids.proximity.proximity_state import ProximityState
+from qixotic.tendroids.recovery.recovery_batch_engine import RecoveryBatchEngine
+from qixotic.tendroids.recovery.recovery_integration_helpers import RecoveryContext
+from qixotic.tendroids.recovery.recovery_state_controller import (
+    RecoveryCompletionStatus,
+    process_recovery_completion,
+    update_completion_status,
+)
+
+COLOR_STATES = [ColorEffectState.NORMAL, ColorEffectState.SHOCKED, ColorEffectState.RECOVERING]
+
+
+class _ScalarPair:
+    """One pair driven by the scalar helpers."""
+
+    def __init__(self, threshold):
+        self.tracker = ApproachTrackerStatus(threshold_distance=threshold)
+        self.surface = TendroidSurfacePoint()
+        self.velocity = VelocityFadeStatus()
+        self.lock = InputLockStatus()
+
+
+def _assert_pair_matches(engine, pair, ref):
+    tracker = engine.tracker_status(pair)
+    assert tracker.phase == ref.tracker.phase
+    assert tracker.update_count == ref.tracker.update_count
+    assert tracker.recovery_count == ref.tracker.recovery_count
+    for field in ('current_distance', 'min_distance_recorded', 'max_distance_recorded'):
+        assert getattr(tracker, field) == pytest.approx(getattr(ref.tracker, field), rel=1e-12)
+
+    velocity = engine.velocity_status(pair)
+    assert velocity.is_active == ref.velocity.is_active
+    assert velocity.is_stopped == ref.velocity.is_stopped
+    np.testing.assert_allclose(velocity.velocity, ref.velocity.velocity, rtol=1e-12, atol=1e-15)
+    assert velocity.distance_traveled == pytest.approx(ref.velocity.distance_traveled, rel=1e-12)
+
+    assert engine.lock_status(pair) == ref.lock
+
+
+@pytest.mark.parametrize("fade_mode", [FadeMode.TIME_BASED, FadeMode.DISTANCE_BASED, FadeMode.HYBRID])
+def test_step_matches_scalar_helpers(fade_mode):
+    rng = np.random.default_rng(3)
+    creatures, tendroids, frames, dt = 3, 5, 80, 1.0 / 60.0
+    config = VelocityFadeConfig(fade_mode=fade_mode, drag_coefficient=0.5)
+    engine = RecoveryBatchEngine(creatures, tendroids, threshold=0.15, velocity_config=config)
+    refs = [_ScalarPair(0.15) for _ in range(engine.pair_count)]
+
+    creature_pos = rng.uniform(-0.3, 0.3, (creatures, 3))
+    tendroid_pos = rng.uniform(-0.3, 0.3, (tendroids, 3))
+
+    for _ in range(frames):
+        creature_pos += rng.normal(scale=0.01, size=creature_pos.shape)
+
+        # Contact events
+        pairs = np.flatnonzero(rng.random(engine.pair_count) < 0.04)
+        if pairs.size:
+            c, t = pairs // tendroids, pairs % tendroids
+            contact = tendroid_pos[t] + rng.normal(scale=0.01, size=(pairs.size, 3))
+            normals = rng.normal(size=(pairs.size, 3))
+            normals /= np.linalg.norm(normals, axis=1, keepdims=True)
+            deflection = rng.uniform(0.0, 0.05, pairs.size)
+            approach = rng.uniform(-1.0, 20.0, pairs.size)
+
+            engine.start_tracking(pairs, contact, normals, creature_pos[c], deflection)
+            engine.apply_repulsion(pairs, creature_pos[c], tendroid_pos[t], 0.06, approach)
+            engine.lock_on_contact(pairs)
+
+            for k, p in enumerate(pairs):
+                ref = refs[p]
+                cp, n, d = contact[k], normals[k], deflection[k]
+                ref.surface = TendroidSurfacePoint(*cp, *(cp + n * d), *n)
+                distance = calculate_distance_to_surface(tuple(creature_pos[c[k]]), ref.surface)
+                ref.tracker = start_tracking(ref.tracker, 0.15, distance)
+                result = calculate_repulsion(
+                    tuple(creature_pos[c[k]]), tuple(tendroid_pos[t[k]]), 0.06, float(approach[k])
+                )
+                ref.velocity = apply_initial_velocity(ref.velocity, velocity_from_force(result.force_vector))
+                ref.lock = lock_input_on_contact(ref.lock)
+
+        # Tendroid surfaces relax toward rest
+        surfaces = engine.surface_current + (engine.surface_rest - engine.surface_current) * 0.2
+        colors = rng.integers(0, 3, engine.pair_count)
+        completed = set(engine.step(dt, creature_pos, colors, surface_positions=surfaces).tolist())
+
+        for p, ref in enumerate(refs):
+            ref.surface = update_surface_point(ref.surface, tuple(surfaces[p]))
+            ref.tracker = update_distance(ref.tracker, tuple(creature_pos[p // tendroids]), ref.surface)
+            ref.velocity = update_velocity(ref.velocity, dt, config)
+
+            context = RecoveryContext(ref.tracker, ref.surface, ProximityState.IDLE)
+            color = ColorEffectStatus(state=COLOR_STATES[colors[p]])
+            completion = update_completion_status(RecoveryCompletionStatus(), context, color, ref.velocity)
+            ref.lock, context, did_complete = process_recovery_completion(completion, ref.lock, context)
+            ref.tracker = context.tracker_status
+
+            assert (p in completed) == did_complete
+            assert engine.completion_status(p).is_complete == completion.is_complete
+            _assert_pair_matches(engine, p, ref)
+
+
+def test_sync_locks_from_color():
+    engine = RecoveryBatchEngine(2, 3)
+    rng = np.random.default_rng(0)
+    refs = [InputLockStatus() for _ in range(engine.pair_count)]
+
+    for _ in range(20):
+        colors = rng.integers(0, 3, engine.pair_count)
+        engine.sync_locks_from_color(colors)
+        for p in range(engine.pair_count):
+            refs[p] = sync_lock_from_color_state(refs[p], ColorEffectStatus(state=COLOR_STATES[colors[p]]))
+            assert engine.lock_status(p) == refs[p]
+
+
+def test_creature_input_locked_reduces_over_tendroids():
+    engine = RecoveryBatchEngine(3, 4)
+    engine.lock_on_contact([engine.pair_index(1, 2)])
+    assert engine.creature_input_locked().tolist() == [False, True, False]
+
+    engine.reset()
+    # Reset leaves the lock for the completion step to release
+    completed = engine.step(0.016, np.zeros((3, 3)), np.zeros(engine.pair_count, dtype=int))
+    assert completed.tolist() == [engine.pair_index(1, 2)]
+    assert not engine.creature_input_locked().any()
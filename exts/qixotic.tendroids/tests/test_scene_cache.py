@@ -0,0 +1,88 @@
+"""
+Tests for the memory-mapped scene cache
+
+Round-trips a fake two-tendroid scene through a cache file.
+
+Run with: python -m pytest tests/test_scene_cache.py -v
+"""
+
+import types
+from unittest.mock import MagicMock
+
+import pytest
+
+np = pytest.importorskip("numpy")
+pytest.importorskip("warp")  # scene package pulls in the deformers
+
+from qixotic.tendroids.scene.scene_cache import (
+  CACHE_MAGIC, SceneCache, scene_cache_key,
+)
+
+
+def _scene(sizes=(12, 20)):
+  """Builder-style dicts + wrappers with deterministic arrays."""
+  rng = np.random.default_rng(3)
+  data, tendroids = [], []
+  for i, n in enumerate(sizes):
+    mesh = MagicMock()
+    mesh.GetNormalsAttr().Get.return_value = rng.normal(size=(n, 3)).astype(np.float32)
+    mesh.GetFaceVertexIndicesAttr().Get.return_value = np.arange(3 * n, dtype=np.int32) % n
+    name = f"Tendroid_{i:02d}"
+    data.append({
+      'name': name, 'position': (float(i), -2.0, 3.0),
+      'radius': 8.0, 'length': 120.0,
+      'deform_start_height': 18.0, 'flare_height': 18.0,
+      'flare_height_percent': 15.0, 'flare_radius_multiplier': 2.0,
+      'radial_segments': 4, 'height_segments': n // 4 - 1,
+      'max_amplitude': 0.8, 'bulge_width': 0.9,
+      'mesh_prim': mesh,
+      'base_points': rng.normal(size=(n, 3)).astype(np.float32),
+    })
+    tendroids.append(types.SimpleNamespace(
+      name=name,
+      deformer=types.SimpleNamespace(height_factors_np=rng.uniform(size=n).astype(np.float32)),
+    ))
+  return data, tendroids
+
+
+class TestSceneCache:
+  """Write, map and validate."""
+
+  def test_round_trip(self, tmp_path):
+    data, tendroids = _scene()
+    height_map = np.arange(12, dtype=np.float32).reshape(3, 4)
+    path = tmp_path / "scene.tndcache"
+
+    assert SceneCache.from_scene("k1", height_map, data, tendroids).save(path)
+    assert path.read_bytes()[:8] == CACHE_MAGIC
+
+    cache = SceneCache.load(path, "k1")
+    assert cache is not None
+    np.testing.assert_array_equal(cache.height_map, height_map)
+    assert [p['name'] for p in cache.params] == ["Tendroid_00", "Tendroid_01"]
+    assert cache.params[1]['position'] == [1.0, -2.0, 3.0]
+
+    for i, (d, t) in enumerate(zip(data, tendroids)):
+      points, normals, factors, faces = cache.tendroid_arrays(i)
+      np.testing.assert_array_equal(points, d['base_points'])
+      np.testing.assert_array_equal(normals, d['mesh_prim'].GetNormalsAttr().Get())
+      np.testing.assert_array_equal(factors, t.deformer.height_factors_np)
+      np.testing.assert_array_equal(faces, d['mesh_prim'].GetFaceVertexIndicesAttr().Get())
+
+  def test_key_mismatch_is_miss(self, tmp_path):
+    data, tendroids = _scene()
+    path = tmp_path / "scene.tndcache"
+    SceneCache.from_scene("k1", np.zeros((2, 2)), data, tendroids).save(path)
+
+    assert SceneCache.load(path, "other") is None
+    assert SceneCache.load(tmp_path / "missing.tndcache", "k1") is None
+
+  def test_corrupt_file_is_miss(self, tmp_path):
+    path = tmp_path / "scene.tndcache"
+    path.write_bytes(b"not a cache")
+    assert SceneCache.load(path, "k1") is None
+
+  def test_key_tracks_arguments(self):
+    a = scene_cache_key(count=10, radial_segments=24)
+    assert a == scene_cache_key(count=10, radial_segments=24)
+    assert a != scene_cache_key(count=11, radial_segments=24)
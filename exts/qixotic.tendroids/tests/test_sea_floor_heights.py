@@ -0,0 +1,148 @@
+"""
+Tests for sea floor height generation and batched queries
+
+get_heights_at must match the scalar get_height_at on both the NumPy
+and the Warp sampling paths, and the host and device fBm builds must
+reproduce noise.pnoise2.
+
+Run with: python -m pytest tests/test_sea_floor_heights.py -v
+"""
+
+import pytest
+
+np = pytest.importorskip("numpy")
+
+from qixotic.tendroids.environment import perlin_noise
+from qixotic.tendroids.environment import sea_floor_helper as helper
+from qixotic.tendroids.environment.sea_floor_config import SeaFloorConfig
+
+
+@pytest.fixture
+def height_map():
+  """Random 13x17 floor installed as the cached height map."""
+  config = SeaFloorConfig(width=160.0, depth=120.0, resolution_x=16, resolution_y=12)
+  rng = np.random.default_rng(7)
+  saved = (helper._height_map, helper._height_map_gpu, helper._config)
+
+  helper._height_map = rng.uniform(-16.0, 16.0, (13, 17))
+  helper._height_map_gpu = None
+  helper._config = config
+  yield config
+
+  helper._height_map, helper._height_map_gpu, helper._config = saved
+
+
+def _query_points(config, count=200):
+  rng = np.random.default_rng(11)
+  xs = rng.uniform(-0.6 * config.width, 0.6 * config.width, count)  # some outside
+  zs = rng.uniform(-0.6 * config.depth, 0.6 * config.depth, count)
+  xs[:2] = [config.width / 2.0, -config.width / 2.0]  # exact edges
+  zs[:2] = [config.depth / 2.0, -config.depth / 2.0]
+  return xs, zs
+
+
+def _loop_heights(noise, config):
+  """The original per-cell, per-octave pnoise2 loop."""
+  heights = np.zeros((config.resolution_y + 1, config.resolution_x + 1))
+  for y_idx in range(config.resolution_y + 1):
+    for x_idx in range(config.resolution_x + 1):
+      x = -config.width / 2.0 + x_idx * config.grid_spacing_x
+      z = -config.depth / 2.0 + y_idx * config.grid_spacing_y
+      height, amplitude, frequency, max_amplitude = 0.0, config.amplitude, config.frequency, 0.0
+      for _ in range(config.octaves):
+        height += noise.pnoise2(
+          x * frequency, z * frequency, octaves=1, repeatx=1024, repeaty=1024, base=config.seed
+        ) * amplitude
+        max_amplitude += amplitude
+        amplitude *= 0.5
+        frequency *= 2.0
+      heights[y_idx, x_idx] = height / max_amplitude * config.amplitude
+  return heights
+
+
+class TestPerlinPort:
+  """perlin_noise vs. the noise package."""
+
+  def test_pnoise2_matches_package(self):
+    noise = pytest.importorskip("noise")
+    rng = np.random.default_rng(3)
+    xs = rng.uniform(-300.0, 300.0, 500)
+    ys = rng.uniform(-300.0, 300.0, 500)
+    xs[:4] = [0.0, -1.0, 255.5, 1023.75]  # lattice points, wrap edges
+
+    expected = [noise.pnoise2(float(x), float(y), repeatx=1024, repeaty=1024) for x, y in zip(xs, ys)]
+    np.testing.assert_allclose(perlin_noise.pnoise2(xs, ys), expected, atol=1e-6)
+
+  def test_fbm_matches_loop(self):
+    noise = pytest.importorskip("noise")
+    config = SeaFloorConfig(width=160.0, depth=120.0, resolution_x=16, resolution_y=12, seed=0)
+
+    np.testing.assert_allclose(perlin_noise.fbm_heights(config), _loop_heights(noise, config), atol=1e-5)
+
+  def test_fbm_is_normalized(self, height_map):
+    heights = perlin_noise.fbm_heights(height_map)
+
+    assert heights.shape == (13, 17)
+    assert np.abs(heights).max() <= height_map.amplitude
+    assert heights.std() > 0.0
+
+
+class TestHostHeights:
+  """NumPy batched lookup."""
+
+  def test_matches_scalar(self, height_map):
+    xs, zs = _query_points(height_map)
+    expected = [helper.get_height_at(x, z) for x, z in zip(xs, zs)]
+    np.testing.assert_allclose(helper.get_heights_at(xs, zs), expected, atol=1e-9)
+
+  def test_uninitialized_is_zero(self, height_map):
+    helper._height_map = None
+    assert np.all(helper.get_heights_at([0.0, 5.0], [0.0, 5.0]) == 0.0)
+
+
+class TestDeviceHeights:
+  """Warp generation and sampling kernels."""
+
+  def setup_method(self):
+    pytest.importorskip("warp")
+
+  def test_kernel_matches_scalar(self, height_map):
+    import warp as wp
+
+    helper._height_map_gpu = wp.array(
+      helper._height_map.astype(np.float32), dtype=float, device="cpu"
+    )
+    xs, zs = _query_points(height_map)
+    expected = [helper.get_height_at(x, z) for x, z in zip(xs, zs)]
+
+    result = helper.get_heights_at(
+      wp.array(xs.astype(np.float32), dtype=float, device="cpu"),
+      wp.array(zs.astype(np.float32), dtype=float, device="cpu"),
+    )
+    np.testing.assert_allclose(result.numpy(), expected, atol=1e-3)
+
+  def test_generated_map_is_normalized(self, height_map):
+    assert helper._generate_height_map_gpu(height_map)
+
+    heights = helper._height_map
+    assert heights.shape == (13, 17)
+    assert np.abs(heights).max() <= height_map.amplitude
+    assert heights.std() > 0.0
+
+  def test_generated_map_matches_host_fbm(self, height_map):
+    assert helper._generate_height_map_gpu(height_map)
+
+    np.testing.assert_allclose(
+      helper._height_map, perlin_noise.fbm_heights(height_map), atol=1e-3
+    )
+
+  def test_host_generation_uploads_map(self, height_map):
+    height_map.gpu_generation = False
+
+    helper.initialize_height_map(height_map)
+
+    assert helper._height_map_gpu is not None
+    np.testing.assert_allclose(helper._height_map_gpu.numpy(), helper._height_map, atol=1e-5)
+    xs, zs = _query_points(height_map, count=helper.GPU_SAMPLE_THRESHOLD)
+    expected = helper._sample_heights_host(xs, zs)
+    np.testing.assert_allclose(helper.get_heights_at(xs, zs), expected, atol=1e-3)
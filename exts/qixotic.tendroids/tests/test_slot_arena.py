@@ -0,0 +1,106 @@
+"""
+Tests for live tendroid slot and vertex range allocation
+
+Pure Python - SlotTable and RangeAllocator back BatchWarpDeformer,
+BubblePhysicsAdapter and BatchDeflectionManager add/remove.
+
+Run with: python -m pytest tests/test_slot_arena.py -v
+"""
+
+from qixotic.tendroids.utils.slot_arena import RangeAllocator, SlotTable
+
+
+class TestSlotTable:
+  """Name -> slot with freed-slot reuse."""
+
+  def test_acquire_is_idempotent(self):
+    """Same name keeps its slot."""
+    slots = SlotTable()
+
+    assert slots.acquire("a") == 0
+    assert slots.acquire("b") == 1
+    assert slots.acquire("a") == 0
+    assert len(slots) == 2
+    assert slots.capacity == 2
+
+  def test_released_slot_is_reused_lowest_first(self):
+    """Freed slots are handed out before capacity grows."""
+    slots = SlotTable()
+    for name in "abcd":
+      slots.acquire(name)
+
+    assert slots.release("c") == 2
+    assert slots.release("a") == 0
+    assert "a" not in slots
+    assert slots.name_of(2) is None
+
+    assert slots.acquire("e") == 0
+    assert slots.acquire("f") == 2
+    assert slots.acquire("g") == 4
+    assert slots.capacity == 5
+
+  def test_release_unknown_and_clear(self):
+    """Unknown names are ignored; clear resets capacity."""
+    slots = SlotTable()
+    slots.acquire("a")
+
+    assert slots.release("missing") is None
+    slots.clear()
+    assert len(slots) == 0
+    assert slots.capacity == 0
+    assert slots.acquire("b") == 0
+
+
+class TestRangeAllocator:
+  """First-fit vertex ranges in a doubling arena."""
+
+  def test_append_grows_capacity_by_doubling(self):
+    """Ranges pack from zero; capacity doubles past the extent."""
+    arena = RangeAllocator(capacity=8)
+
+    assert arena.allocate(5) == 0
+    assert arena.allocate(5) == 5
+    assert arena.extent == 10
+    assert arena.capacity == 16
+
+  def test_freed_range_is_reused_first_fit(self):
+    """A smaller insert lands in the hole and splits it."""
+    arena = RangeAllocator()
+    a = arena.allocate(10)
+    b = arena.allocate(10)
+    arena.allocate(10)
+
+    arena.free(b, 10)
+    assert arena.free_ranges() == [(10, 10)]
+
+    assert arena.allocate(4) == 10
+    assert arena.free_ranges() == [(14, 6)]
+    assert arena.allocate(8) == 30
+    assert a == 0
+
+  def test_free_coalesces_and_trims_extent(self):
+    """Neighbouring holes merge; a hole at the end shrinks the extent."""
+    arena = RangeAllocator()
+    starts = [arena.allocate(4) for _ in range(4)]
+
+    arena.free(starts[1], 4)
+    arena.free(starts[2], 4)
+    assert arena.free_ranges() == [(4, 8)]
+
+    arena.free(starts[3], 4)
+    assert arena.free_ranges() == []
+    assert arena.extent == 4
+
+  def test_zero_size_and_clear(self):
+    """Empty tendroids take no space; clear keeps capacity."""
+    arena = RangeAllocator()
+    arena.allocate(6)
+
+    assert arena.allocate(0) == 6
+    assert arena.extent == 6
+
+    capacity = arena.capacity
+    arena.clear()
+    assert arena.extent == 0
+    assert arena.capacity == capacity
+    assert arena.allocate(3) == 0